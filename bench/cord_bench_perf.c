@@ -0,0 +1,143 @@
+#define _GNU_SOURCE
+#include "cord_bench_perf.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+static const struct
+{
+    uint32_t type;
+    uint64_t config;
+} cord_bench_perf_events[CORD_BENCH_PERF_COUNT] = {
+    [CORD_BENCH_PERF_CYCLES]       = { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    [CORD_BENCH_PERF_INSTRUCTIONS] = { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    [CORD_BENCH_PERF_LLC_MISSES]   = { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+    [CORD_BENCH_PERF_L1D_MISSES]   = { PERF_TYPE_HW_CACHE,
+                                       PERF_COUNT_HW_CACHE_L1D |
+                                       (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                       (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+};
+
+// User space only: the microbenchmarks measure library code, not the kernel
+static int cord_bench_perf_event_open(uint32_t type, uint64_t config)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+void cord_bench_perf_open(cord_bench_perf_t *perf)
+{
+    memset(perf, 0, sizeof(cord_bench_perf_t));
+
+    for (uint32_t e = 0; e < CORD_BENCH_PERF_COUNT; e++)
+    {
+        perf->fds[e] = cord_bench_perf_event_open(cord_bench_perf_events[e].type, cord_bench_perf_events[e].config);
+    }
+}
+
+void cord_bench_perf_close(cord_bench_perf_t *perf)
+{
+    for (uint32_t e = 0; e < CORD_BENCH_PERF_COUNT; e++)
+    {
+        if (perf->fds[e] >= 0)
+        {
+            close(perf->fds[e]);
+            perf->fds[e] = -1;
+        }
+    }
+}
+
+void cord_bench_perf_start(cord_bench_perf_t *perf)
+{
+    for (uint32_t e = 0; e < CORD_BENCH_PERF_COUNT; e++)
+    {
+        perf->values[e] = 0;
+        if (perf->fds[e] >= 0)
+        {
+            ioctl(perf->fds[e], PERF_EVENT_IOC_RESET, 0);
+            ioctl(perf->fds[e], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+void cord_bench_perf_stop(cord_bench_perf_t *perf)
+{
+    for (uint32_t e = 0; e < CORD_BENCH_PERF_COUNT; e++)
+    {
+        if (perf->fds[e] < 0)
+        {
+            continue;
+        }
+
+        ioctl(perf->fds[e], PERF_EVENT_IOC_DISABLE, 0);
+
+        // value, time enabled, time running
+        uint64_t data[3];
+        if (read(perf->fds[e], data, sizeof(data)) != sizeof(data))
+        {
+            continue;
+        }
+
+        // Scale up if the PMU was multiplexed between the events
+        if (data[2] && data[2] < data[1])
+        {
+            perf->values[e] = (uint64_t)((double)data[0] * (double)data[1] / (double)data[2]);
+        }
+        else
+        {
+            perf->values[e] = data[0];
+        }
+    }
+}
+
+uint64_t cord_bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+uint64_t cord_bench_cpu_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+int cord_bench_pin_cpu(int cpu)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+
+    return sched_setaffinity(0, sizeof(set), &set) == 0 ? 0 : -1;
+}
+
+const char *cord_bench_per_op(char *buf, size_t len, const cord_bench_perf_t *perf,
+                              cord_bench_perf_event_t event, uint64_t ops, int precision)
+{
+    if (!cord_bench_perf_has(perf, event) || ops == 0)
+    {
+        snprintf(buf, len, "-");
+    }
+    else
+    {
+        snprintf(buf, len, "%.*f", precision, (double)perf->values[event] / (double)ops);
+    }
+
+    return buf;
+}
@@ -0,0 +1,69 @@
+#ifndef CORD_BENCH_PERF_H
+#define CORD_BENCH_PERF_H
+
+#include <cord_type.h>
+
+//
+// Benchmark helpers: wall / CPU clocks and hardware counters (perf_event_open)
+//
+// The counters follow the calling thread and count user space only (exclude_kernel),
+// which perf_event_paranoid <= 2 allows; counters the machine or the container does
+// not expose are reported as "-".
+//
+
+typedef enum
+{
+    CORD_BENCH_PERF_CYCLES = 0,
+    CORD_BENCH_PERF_INSTRUCTIONS,
+    CORD_BENCH_PERF_LLC_MISSES,
+    CORD_BENCH_PERF_L1D_MISSES,
+    CORD_BENCH_PERF_COUNT
+} cord_bench_perf_event_t;
+
+typedef struct
+{
+    int fds[CORD_BENCH_PERF_COUNT];            // -1 = not available
+    uint64_t values[CORD_BENCH_PERF_COUNT];    // Scaled for multiplexing, valid after stop
+} cord_bench_perf_t;
+
+void cord_bench_perf_open(cord_bench_perf_t *perf);
+void cord_bench_perf_close(cord_bench_perf_t *perf);
+
+void cord_bench_perf_start(cord_bench_perf_t *perf);
+void cord_bench_perf_stop(cord_bench_perf_t *perf);
+
+static inline bool cord_bench_perf_has(const cord_bench_perf_t *perf, cord_bench_perf_event_t event)
+{
+    return perf->fds[event] >= 0;
+}
+
+uint64_t cord_bench_now_ns(void);
+uint64_t cord_bench_cpu_ns(void);              // CPU time of the process (user + system)
+
+// Warns on stdout when the benchmark was compiled without optimisation
+static inline void cord_bench_warn_unoptimized(void)
+{
+#ifndef __OPTIMIZE__
+    CORD_LOG("Warning: built without optimisation (CMAKE_BUILD_TYPE=Debug?), the numbers are not representative\n");
+#endif
+}
+
+// Pins the calling thread; returns 0 on success, -1 on failure
+int cord_bench_pin_cpu(int cpu);
+
+// Formats value / ops into buf with the given precision, or "-" when the counter is missing
+const char *cord_bench_per_op(char *buf, size_t len, const cord_bench_perf_t *perf,
+                              cord_bench_perf_event_t event, uint64_t ops, int precision);
+
+// Deterministic pseudo random numbers (xorshift64*), seed must not be 0
+static inline uint64_t cord_bench_rand(uint64_t *state)
+{
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+#endif // CORD_BENCH_PERF_H
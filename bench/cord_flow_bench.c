@@ -0,0 +1,1290 @@
+//
+// cord_flow_bench - microbenchmarks of the tables, header parsers and checksums
+//
+// Every case runs for a fixed time after a warm-up and reports Mops (million lookups,
+// parses or checksums per second, i.e. Mpps for one operation per packet), ns/op and,
+// where perf_event_open is permitted, cycles, instructions, L1D and LLC misses per op.
+//
+// - ipv4_lpm / ipv6_lpm: single and batched lookups against synthetic (uniform prefix
+//   lengths) and real-shaped (Internet routing table prefix length mix) route tables
+// - l2_cam:   single and batched lookups at load factors 0.25 - 4 entries per bucket
+// - parse:    cord_header_* chains over common encapsulations
+// - checksum: cord_calculate_*_checksum over 64, 512 and 1500 byte frames
+// - ring:     MPMC stress of cord_ring_t (and of the AF_XDP UMEM frame ring when built
+//             in): several producer and consumer threads move tagged values with random
+//             burst sizes, and every value must come out exactly once (FAILED and a
+//             non-zero exit status otherwise)
+//
+// Lookup keys are spread over 1M entries so the tables are measured from memory, not
+// from the key set; pin the benchmark (-c) and disable frequency scaling for stable results.
+//
+// Usage: cord_flow_bench [-f filter] [-t ms] [-c cpu] [-l]
+//
+
+#include "cord_bench_perf.h"
+#include <table/cord_lpm.h>
+#include <table/cord_cam.h>
+#include <match/cord_match.h>
+#include <action/cord_action.h>
+#include <action/cord_tunnel.h>
+#include <memory/cord_ring.h>
+#include <cord_error.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <getopt.h>
+
+#define CORD_BENCH_KEYS             (1u << 20)  // Lookup keys per table (power of two)
+#define CORD_BENCH_BATCH            32          // Burst of the *_batch cases
+#define CORD_BENCH_PKTS             1024        // Packets per parse set (power of two)
+#define CORD_BENCH_PKT_SLOT         128
+#define CORD_BENCH_CSUM_PKTS        256         // Packets per checksum set (power of two)
+#define CORD_BENCH_CSUM_SLOT        2048
+#define CORD_BENCH_CALIBRATE_NS     10000000ULL
+#define CORD_BENCH_DEFAULT_MS       200
+#define CORD_BENCH_SEED             0x9E3779B97F4A7C15ULL
+#define CORD_BENCH_RING_THREADS     4           // Producers, and as many consumers
+#define CORD_BENCH_RING_SIZE        1024
+#define CORD_BENCH_RING_VALUES      (1u << 18)  // Per producer
+
+typedef uint64_t (*cord_bench_fn)(void *ctx, uint64_t ops);
+
+static struct
+{
+    const char *filter;
+    uint64_t target_ns;
+    bool list;
+    bool failed;                                // A stress case lost or duplicated values
+    cord_bench_perf_t perf;
+} bench;
+
+// Results are folded in here so the compiler cannot drop the measured work
+static volatile uint64_t cord_bench_sink;
+
+//
+// Runner
+//
+
+static bool cord_bench_match(const char *group, const char *name)
+{
+    char full[128];
+    snprintf(full, sizeof(full), "%s/%s", group, name);
+    return !bench.filter || strstr(full, bench.filter);
+}
+
+// True if any case of the group is selected (the group is set up only then)
+static bool cord_bench_wanted(const char *group, const char * const *names, uint32_t count)
+{
+    bool wanted = false;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (cord_bench_match(group, names[i]))
+        {
+            if (bench.list)
+                CORD_LOG("%s/%s\n", group, names[i]);
+            wanted = true;
+        }
+    }
+
+    return wanted && !bench.list;
+}
+
+static void cord_bench_header(void)
+{
+    CORD_LOG("%-44s %10s %9s %9s %9s %8s %8s\n", "Benchmark", "Mops", "ns/op", "cyc/op", "ins/op", "L1D/op", "LLC/op");
+}
+
+static void cord_bench_run(const char *group, const char *name, cord_bench_fn fn, void *ctx)
+{
+    if (!cord_bench_match(group, name))
+        return;
+
+    // Warm up and calibrate: double the ops until one pass takes CORD_BENCH_CALIBRATE_NS
+    uint64_t ops = 1024;
+    uint64_t elapsed = 0;
+    for (;;)
+    {
+        uint64_t start = cord_bench_now_ns();
+        cord_bench_sink += fn(ctx, ops);
+        elapsed = cord_bench_now_ns() - start;
+        if (elapsed >= CORD_BENCH_CALIBRATE_NS || ops >= (1ULL << 40))
+            break;
+        ops *= 2;
+    }
+
+    ops = (uint64_t)((double)ops * (double)bench.target_ns / (double)(elapsed ? elapsed : 1));
+    ops = (ops + CORD_BENCH_BATCH - 1) / CORD_BENCH_BATCH * CORD_BENCH_BATCH;
+
+    cord_bench_perf_start(&bench.perf);
+    uint64_t start = cord_bench_now_ns();
+    cord_bench_sink += fn(ctx, ops);
+    elapsed = cord_bench_now_ns() - start;
+    cord_bench_perf_stop(&bench.perf);
+
+    char full[128], cyc[16], ins[16], l1d[16], llc[16];
+    snprintf(full, sizeof(full), "%s/%s", group, name);
+
+    CORD_LOG("%-44s %10.2f %9.2f %9s %9s %8s %8s\n", full,
+             (double)ops * 1e3 / (double)elapsed, (double)elapsed / (double)ops,
+             cord_bench_per_op(cyc, sizeof(cyc), &bench.perf, CORD_BENCH_PERF_CYCLES, ops, 1),
+             cord_bench_per_op(ins, sizeof(ins), &bench.perf, CORD_BENCH_PERF_INSTRUCTIONS, ops, 1),
+             cord_bench_per_op(l1d, sizeof(l1d), &bench.perf, CORD_BENCH_PERF_L1D_MISSES, ops, 2),
+             cord_bench_per_op(llc, sizeof(llc), &bench.perf, CORD_BENCH_PERF_LLC_MISSES, ops, 2));
+}
+
+static void *cord_bench_alloc(size_t size)
+{
+    void *ptr = aligned_alloc(CORD_CACHE_LINE_SIZE, CORD_ALIGN_TO_CACHE_LINE(size));
+    if (!ptr)
+    {
+        CORD_ERROR("[cord_flow_bench] aligned_alloc");
+        CORD_EXIT(EXIT_FAILURE);
+    }
+
+    memset(ptr, 0, size);
+    return ptr;
+}
+
+// Prefix length drawn from a weight table indexed by depth
+static uint8_t cord_bench_pick_depth(uint64_t *rng, const uint32_t *weights, uint32_t max_depth)
+{
+    uint32_t total = 0;
+    for (uint32_t d = 0; d <= max_depth; d++)
+        total += weights[d];
+
+    uint32_t pick = (uint32_t)(cord_bench_rand(rng) % total);
+    for (uint32_t d = 0; d <= max_depth; d++)
+    {
+        if (pick < weights[d])
+            return (uint8_t)d;
+        pick -= weights[d];
+    }
+
+    return (uint8_t)max_depth;
+}
+
+//
+// IPv4 LPM
+//
+
+#define CORD_BENCH_IPV4_MAX_LONG    200         // Prefixes longer than /24 (one TBL8 group each)
+
+// Prefix length mix of the public IPv4 routing table, per 1000 routes
+static const uint32_t cord_bench_ipv4_internet[33] = {
+    [8] = 1, [9] = 1, [10] = 1, [11] = 2, [12] = 3, [13] = 4, [14] = 6, [15] = 7,
+    [16] = 14, [17] = 8, [18] = 13, [19] = 24, [20] = 42, [21] = 50, [22] = 105,
+    [23] = 80, [24] = 638, [25] = 1,
+};
+
+static const uint32_t cord_bench_ipv4_uniform[33] = {
+    [8] = 1, [9] = 1, [10] = 1, [11] = 1, [12] = 1, [13] = 1, [14] = 1, [15] = 1, [16] = 1,
+    [17] = 1, [18] = 1, [19] = 1, [20] = 1, [21] = 1, [22] = 1, [23] = 1, [24] = 1, [28] = 1,
+};
+
+typedef struct
+{
+    cord_ipv4_lpm_t *lpm;
+    uint32_t *keys;
+} cord_bench_ipv4_ctx_t;
+
+static uint64_t cord_bench_ipv4_lookup(void *ctx, uint64_t ops)
+{
+    cord_bench_ipv4_ctx_t *c = ctx;
+    uint64_t acc = 0;
+
+    for (uint64_t i = 0; i < ops; i++)
+        acc += cord_ipv4_lpm_lookup(c->lpm, c->keys[i & (CORD_BENCH_KEYS - 1)]);
+
+    return acc;
+}
+
+static uint64_t cord_bench_ipv4_lookup_batch(void *ctx, uint64_t ops)
+{
+    cord_bench_ipv4_ctx_t *c = ctx;
+    uint32_t next_hops[CORD_BENCH_BATCH];
+    uint64_t acc = 0;
+
+    for (uint64_t i = 0; i < ops; i += CORD_BENCH_BATCH)
+    {
+        cord_ipv4_lpm_lookup_batch(c->lpm, &c->keys[i & (CORD_BENCH_KEYS - 1)], next_hops, CORD_BENCH_BATCH);
+        acc += next_hops[0] + next_hops[CORD_BENCH_BATCH - 1];
+    }
+
+    return acc;
+}
+
+static void cord_bench_ipv4_lpm(const char *shape, const uint32_t *weights, uint32_t num_routes)
+{
+    static const char * const names[] = { "lookup", "lookup_batch" };
+    char group[64];
+    snprintf(group, sizeof(group), "ipv4_lpm/%s-%uk", shape, num_routes / 1000);
+
+    if (!cord_bench_wanted(group, names, 2))
+        return;
+
+    cord_bench_ipv4_ctx_t ctx;
+    ctx.lpm = cord_ipv4_lpm_create(num_routes);
+    if (!ctx.lpm)
+    {
+        CORD_LOG("%s: cord_ipv4_lpm_create failed, skipped\n", group);
+        return;
+    }
+
+    uint32_t *prefixes = cord_bench_alloc(num_routes * sizeof(uint32_t));
+    uint8_t *depths = cord_bench_alloc(num_routes);
+    uint64_t rng = CORD_BENCH_SEED ^ num_routes;
+    uint32_t added = 0, long_prefixes = 0;
+
+    while (added < num_routes)
+    {
+        uint8_t depth = cord_bench_pick_depth(&rng, weights, 32);
+        if (depth > 24 && long_prefixes >= CORD_BENCH_IPV4_MAX_LONG)
+            continue;
+
+        // Unicast space 1.0.0.0 - 223.255.255.255
+        uint32_t ip = (uint32_t)cord_bench_rand(&rng);
+        ip = ((ip % 223u) + 1u) << 24 | (ip & 0x00ffffffu);
+        ip &= depth ? ~0u << (32 - depth) : 0;
+
+        if (cord_ipv4_lpm_add(ctx.lpm, ip, depth, added & 0xffff) != 0)
+            continue;
+
+        long_prefixes += (depth > 24);
+        prefixes[added] = ip;
+        depths[added++] = depth;
+    }
+
+    // 90% of the keys inside a random route, the rest anywhere
+    ctx.keys = cord_bench_alloc(CORD_BENCH_KEYS * sizeof(uint32_t));
+    for (uint32_t i = 0; i < CORD_BENCH_KEYS; i++)
+    {
+        uint64_t r = cord_bench_rand(&rng);
+        if (r % 10)
+        {
+            uint32_t route = (uint32_t)((r >> 8) % added);
+            uint32_t host = (uint32_t)cord_bench_rand(&rng);
+            ctx.keys[i] = prefixes[route] | (depths[route] ? host & ~(~0u << (32 - depths[route])) : host);
+        }
+        else
+        {
+            ctx.keys[i] = (uint32_t)(r >> 32);
+        }
+    }
+
+    cord_bench_run(group, "lookup", cord_bench_ipv4_lookup, &ctx);
+    cord_bench_run(group, "lookup_batch", cord_bench_ipv4_lookup_batch, &ctx);
+
+    free(ctx.keys);
+    free(depths);
+    free(prefixes);
+    cord_ipv4_lpm_destroy(ctx.lpm);
+}
+
+//
+// IPv6 LPM
+//
+
+// Prefix length mix of the public IPv6 routing table, per 1000 routes
+static const uint32_t cord_bench_ipv6_internet[129] = {
+    [29] = 30, [32] = 200, [36] = 40, [40] = 80, [44] = 100, [48] = 520, [56] = 15, [64] = 15,
+};
+
+static const uint32_t cord_bench_ipv6_uniform[129] = {
+    [16] = 1, [20] = 1, [24] = 1, [28] = 1, [32] = 1, [36] = 1, [40] = 1, [44] = 1,
+    [48] = 1, [52] = 1, [56] = 1, [60] = 1, [64] = 1,
+};
+
+#define CORD_BENCH_IPV6_ALLOCATIONS 4096        // /29 blocks the real-shaped routes cluster in
+
+typedef struct
+{
+    cord_ipv6_lpm_t *lpm;
+    cord_ipv6_addr_t *keys;
+} cord_bench_ipv6_ctx_t;
+
+static uint64_t cord_bench_ipv6_lookup(void *ctx, uint64_t ops)
+{
+    cord_bench_ipv6_ctx_t *c = ctx;
+    uint64_t acc = 0;
+
+    for (uint64_t i = 0; i < ops; i++)
+        acc += cord_ipv6_lpm_lookup(c->lpm, &c->keys[i & (CORD_BENCH_KEYS - 1)]);
+
+    return acc;
+}
+
+static uint64_t cord_bench_ipv6_lookup_batch(void *ctx, uint64_t ops)
+{
+    cord_bench_ipv6_ctx_t *c = ctx;
+    uint32_t next_hops[CORD_BENCH_BATCH];
+    uint64_t acc = 0;
+
+    for (uint64_t i = 0; i < ops; i += CORD_BENCH_BATCH)
+    {
+        cord_ipv6_lpm_lookup_batch(c->lpm, &c->keys[i & (CORD_BENCH_KEYS - 1)], next_hops, CORD_BENCH_BATCH);
+        acc += next_hops[0] + next_hops[CORD_BENCH_BATCH - 1];
+    }
+
+    return acc;
+}
+
+static void cord_bench_ipv6_random(uint64_t *rng, cord_ipv6_addr_t *ip)
+{
+    uint64_t hi = cord_bench_rand(rng), lo = cord_bench_rand(rng);
+    memcpy(&ip->addr[0], &hi, 8);
+    memcpy(&ip->addr[8], &lo, 8);
+}
+
+static void cord_bench_ipv6_mask(cord_ipv6_addr_t *ip, uint8_t depth)
+{
+    for (uint32_t b = 0; b < 16; b++)
+    {
+        if (depth >= 8 * (b + 1))
+            continue;
+        ip->addr[b] &= (depth > 8 * b) ? (uint8_t)(0xff << (8 - (depth - 8 * b))) : 0;
+    }
+}
+
+static void cord_bench_ipv6_lpm(const char *shape, const uint32_t *weights, uint32_t num_routes, bool clustered)
+{
+    static const char * const names[] = { "lookup", "lookup_batch" };
+    char group[64];
+    snprintf(group, sizeof(group), "ipv6_lpm/%s-%uk", shape, num_routes / 1000);
+
+    if (!cord_bench_wanted(group, names, 2))
+        return;
+
+    cord_bench_ipv6_ctx_t ctx;
+    ctx.lpm = cord_ipv6_lpm_create(num_routes);
+    if (!ctx.lpm)
+    {
+        CORD_LOG("%s: cord_ipv6_lpm_create failed, skipped\n", group);
+        return;
+    }
+
+    cord_ipv6_addr_t *prefixes = cord_bench_alloc(num_routes * sizeof(cord_ipv6_addr_t));
+    cord_ipv6_addr_t *allocations = cord_bench_alloc(CORD_BENCH_IPV6_ALLOCATIONS * sizeof(cord_ipv6_addr_t));
+    uint8_t *depths = cord_bench_alloc(num_routes);
+    uint64_t rng = CORD_BENCH_SEED ^ (num_routes * 3);
+    uint32_t added = 0, failures = 0;
+
+    // Real-shaped tables cluster under RIR allocations (2000::/3), like the Internet table
+    for (uint32_t a = 0; a < CORD_BENCH_IPV6_ALLOCATIONS; a++)
+    {
+        cord_bench_ipv6_random(&rng, &allocations[a]);
+        allocations[a].addr[0] = 0x20 | (allocations[a].addr[0] & 0x1f);
+        cord_bench_ipv6_mask(&allocations[a], 29);
+    }
+
+    while (added < num_routes && failures < num_routes)
+    {
+        uint8_t depth = cord_bench_pick_depth(&rng, weights, 128);
+        cord_ipv6_addr_t ip;
+
+        cord_bench_ipv6_random(&rng, &ip);
+        if (clustered)
+        {
+            // Allocation bits above /29, random ones below
+            const cord_ipv6_addr_t *base = &allocations[cord_bench_rand(&rng) % CORD_BENCH_IPV6_ALLOCATIONS];
+            for (uint32_t b = 0; b < 4; b++)
+                ip.addr[b] = base->addr[b] | (ip.addr[b] & ((b < 3) ? 0 : 0x07));
+        }
+        cord_bench_ipv6_mask(&ip, depth);
+
+        if (cord_ipv6_lpm_add(ctx.lpm, &ip, depth, added & 0xffff) != 0)
+        {
+            failures++;
+            continue;
+        }
+
+        prefixes[added] = ip;
+        depths[added++] = depth;
+    }
+
+    if (added < num_routes)
+        CORD_LOG("%s: %u routes installed (TBL8 groups exhausted)\n", group, added);
+
+    ctx.keys = cord_bench_alloc(CORD_BENCH_KEYS * sizeof(cord_ipv6_addr_t));
+    for (uint32_t i = 0; i < CORD_BENCH_KEYS; i++)
+    {
+        cord_ipv6_addr_t *key = &ctx.keys[i];
+        cord_bench_ipv6_random(&rng, key);
+
+        uint64_t r = cord_bench_rand(&rng);
+        if (added && (r % 10))
+        {
+            uint32_t route = (uint32_t)((r >> 8) % added);
+            cord_ipv6_addr_t host = *key;
+            *key = prefixes[route];
+
+            // Host bits below the prefix length from the random address
+            for (uint32_t b = depths[route] / 8; b < 16; b++)
+            {
+                uint8_t keep = (b == depths[route] / 8 && depths[route] % 8) ? (uint8_t)(0xff << (8 - depths[route] % 8)) : 0;
+                key->addr[b] = (key->addr[b] & keep) | (host.addr[b] & (uint8_t)~keep);
+            }
+        }
+    }
+
+    cord_bench_run(group, "lookup", cord_bench_ipv6_lookup, &ctx);
+    cord_bench_run(group, "lookup_batch", cord_bench_ipv6_lookup_batch, &ctx);
+
+    free(ctx.keys);
+    free(depths);
+    free(allocations);
+    free(prefixes);
+    cord_ipv6_lpm_destroy(ctx.lpm);
+}
+
+//
+// L2 CAM
+//
+
+#define CORD_BENCH_CAM_BUCKETS      16384
+
+typedef struct
+{
+    cord_l2_cam_t *cam;
+    cord_mac_addr_t *macs;
+    const cord_mac_addr_t **mac_ptrs;
+    uint16_t *vlans;
+} cord_bench_cam_ctx_t;
+
+static uint64_t cord_bench_cam_lookup(void *ctx, uint64_t ops)
+{
+    cord_bench_cam_ctx_t *c = ctx;
+    uint64_t acc = 0;
+
+    for (uint64_t i = 0; i < ops; i++)
+    {
+        uint32_t k = (uint32_t)(i & (CORD_BENCH_KEYS - 1));
+        acc += cord_l2_cam_lookup(c->cam, &c->macs[k], c->vlans[k]);
+    }
+
+    return acc;
+}
+
+static uint64_t cord_bench_cam_lookup_batch(void *ctx, uint64_t ops)
+{
+    cord_bench_cam_ctx_t *c = ctx;
+    uint32_t ports[CORD_BENCH_BATCH];
+    uint64_t acc = 0;
+
+    for (uint64_t i = 0; i < ops; i += CORD_BENCH_BATCH)
+    {
+        uint32_t k = (uint32_t)(i & (CORD_BENCH_KEYS - 1));
+        cord_l2_cam_lookup_batch(c->cam, &c->mac_ptrs[k], &c->vlans[k], ports, CORD_BENCH_BATCH);
+        acc += ports[0] + ports[CORD_BENCH_BATCH - 1];
+    }
+
+    return acc;
+}
+
+static void cord_bench_l2_cam(double load_factor)
+{
+    static const char * const names[] = { "lookup", "lookup_batch" };
+    char group[64];
+    snprintf(group, sizeof(group), "l2_cam/load-%.2f", load_factor);
+
+    if (!cord_bench_wanted(group, names, 2))
+        return;
+
+    uint32_t num_entries = (uint32_t)(CORD_BENCH_CAM_BUCKETS * load_factor);
+
+    cord_bench_cam_ctx_t ctx;
+    ctx.cam = cord_l2_cam_create(CORD_BENCH_CAM_BUCKETS, num_entries);
+    if (!ctx.cam)
+    {
+        CORD_LOG("%s: cord_l2_cam_create failed, skipped\n", group);
+        return;
+    }
+
+    cord_mac_addr_t *entries = cord_bench_alloc(num_entries * sizeof(cord_mac_addr_t));
+    uint16_t *entry_vlans = cord_bench_alloc(num_entries * sizeof(uint16_t));
+    uint64_t rng = CORD_BENCH_SEED ^ num_entries;
+
+    for (uint32_t e = 0; e < num_entries; e++)
+    {
+        uint64_t r = cord_bench_rand(&rng);
+        memcpy(entries[e].addr, &r, 6);
+        entries[e].addr[0] &= 0xfe;         // Unicast
+        entry_vlans[e] = (uint16_t)((r >> 48) % 16 + 1);
+        cord_l2_cam_add(ctx.cam, &entries[e], e % 48, entry_vlans[e]);
+    }
+
+    // Learned stations only: every lookup hits
+    ctx.macs = cord_bench_alloc(CORD_BENCH_KEYS * sizeof(cord_mac_addr_t));
+    ctx.mac_ptrs = cord_bench_alloc(CORD_BENCH_KEYS * sizeof(cord_mac_addr_t *));
+    ctx.vlans = cord_bench_alloc(CORD_BENCH_KEYS * sizeof(uint16_t));
+    for (uint32_t i = 0; i < CORD_BENCH_KEYS; i++)
+    {
+        uint32_t e = (uint32_t)(cord_bench_rand(&rng) % num_entries);
+        ctx.macs[i] = entries[e];
+        ctx.mac_ptrs[i] = &ctx.macs[i];
+        ctx.vlans[i] = entry_vlans[e];
+    }
+
+    cord_bench_run(group, "lookup", cord_bench_cam_lookup, &ctx);
+    cord_bench_run(group, "lookup_batch", cord_bench_cam_lookup_batch, &ctx);
+
+    free(ctx.vlans);
+    free(ctx.mac_ptrs);
+    free(ctx.macs);
+    free(entry_vlans);
+    free(entries);
+    cord_l2_cam_destroy(ctx.cam);
+}
+
+//
+// Packet builders (parse and checksum sets)
+//
+
+static size_t cord_bench_put_eth(uint8_t *buf, uint16_t proto, uint64_t *rng)
+{
+    cord_eth_hdr_t *eth = (cord_eth_hdr_t *)buf;
+    uint64_t r = cord_bench_rand(rng);
+    memcpy(eth->h_dest.addr, &r, 6);
+    memcpy(eth->h_source.addr, (uint8_t *)&r + 2, 6);
+    eth->h_proto = cord_htons(proto);
+    return sizeof(cord_eth_hdr_t);
+}
+
+static size_t cord_bench_put_vlan(uint8_t *buf, uint16_t proto, uint64_t *rng)
+{
+    cord_vlan_hdr_t *vlan = (cord_vlan_hdr_t *)buf;
+    vlan->tci = cord_htons((uint16_t)(cord_bench_rand(rng) % 4094 + 1));
+    vlan->h_proto = cord_htons(proto);
+    return sizeof(cord_vlan_hdr_t);
+}
+
+static size_t cord_bench_put_ipv4(uint8_t *buf, uint8_t protocol, size_t payload_len, uint64_t *rng)
+{
+    cord_ipv4_hdr_t *ip = (cord_ipv4_hdr_t *)buf;
+    ip->version = 4;
+    ip->ihl = 5;
+    ip->tot_len = cord_htons((uint16_t)(sizeof(cord_ipv4_hdr_t) + payload_len));
+    ip->ttl = 64;
+    ip->protocol = protocol;
+    ip->saddr.addr = (uint32_t)cord_bench_rand(rng);
+    ip->daddr.addr = (uint32_t)cord_bench_rand(rng);
+    ip->check = cord_htons(cord_calculate_ipv4_checksum(ip));
+    return sizeof(cord_ipv4_hdr_t);
+}
+
+static size_t cord_bench_put_ipv6(uint8_t *buf, uint8_t nexthdr, size_t payload_len, uint64_t *rng)
+{
+    cord_ipv6_hdr_t *ip6 = (cord_ipv6_hdr_t *)buf;
+    ip6->version = 6;
+    ip6->payload_len = cord_htons((uint16_t)payload_len);
+    ip6->nexthdr = nexthdr;
+    ip6->hop_limit = 64;
+    cord_bench_ipv6_random(rng, &ip6->saddr);
+    cord_bench_ipv6_random(rng, &ip6->daddr);
+    return sizeof(cord_ipv6_hdr_t);
+}
+
+static size_t cord_bench_put_udp(uint8_t *buf, uint16_t dport, size_t len, uint64_t *rng)
+{
+    cord_udp_hdr_t *udp = (cord_udp_hdr_t *)buf;
+    udp->source = cord_htons((uint16_t)(cord_bench_rand(rng) | 1024));
+    udp->dest = cord_htons(dport);
+    udp->len = cord_htons((uint16_t)len);
+    return sizeof(cord_udp_hdr_t);
+}
+
+static size_t cord_bench_put_tcp(uint8_t *buf, uint64_t *rng)
+{
+    cord_tcp_hdr_t *tcp = (cord_tcp_hdr_t *)buf;
+    uint64_t r = cord_bench_rand(rng);
+    tcp->source = cord_htons((uint16_t)(r | 1024));
+    tcp->dest = cord_htons(443);
+    tcp->seq = (uint32_t)(r >> 32);
+    tcp->doff = 5;
+    tcp->ack = 1;
+    tcp->window = cord_htons(65535);
+    return sizeof(cord_tcp_hdr_t);
+}
+
+static void cord_bench_fill_payload(uint8_t *buf, size_t len, uint64_t *rng)
+{
+    for (size_t i = 0; i < len; i += 8)
+    {
+        uint64_t r = cord_bench_rand(rng);
+        memcpy(buf + i, &r, (len - i < 8) ? len - i : 8);
+    }
+}
+
+//
+// Header parsing chains
+//
+
+typedef enum
+{
+    CORD_BENCH_PARSE_IPV4_UDP = 0,
+    CORD_BENCH_PARSE_VLAN_IPV4_TCP,
+    CORD_BENCH_PARSE_IPV6_UDP,
+    CORD_BENCH_PARSE_VXLAN,
+    CORD_BENCH_PARSE_GTPU,
+    CORD_BENCH_PARSE_COUNT
+} cord_bench_parse_chain_t;
+
+static const char * const cord_bench_parse_names[CORD_BENCH_PARSE_COUNT] = {
+    "eth-ipv4-udp", "eth-vlan-ipv4-tcp", "eth-ipv6-udp", "eth-ipv4-udp-vxlan-eth-ipv4", "eth-ipv4-udp-gtpu"
+};
+
+typedef struct
+{
+    uint8_t *pkts;                        // CORD_BENCH_PKTS slots of CORD_BENCH_PKT_SLOT bytes
+} cord_bench_parse_ctx_t;
+
+static inline const uint8_t *cord_bench_pkt(const cord_bench_parse_ctx_t *c, uint64_t i)
+{
+    return c->pkts + (i & (CORD_BENCH_PKTS - 1)) * CORD_BENCH_PKT_SLOT;
+}
+
+static uint64_t cord_bench_parse_ipv4_udp(void *ctx, uint64_t ops)
+{
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < ops; i++)
+    {
+        cord_eth_hdr_t *eth = cord_header_eth(cord_bench_pkt(ctx, i));
+        cord_ipv4_hdr_t *ip = cord_header_ipv4_from_eth(eth);
+        if (cord_unlikely(!ip))
+            continue;
+        cord_udp_hdr_t *udp = cord_header_udp_ipv4(ip);
+        if (cord_likely(udp != NULL))
+            acc += udp->dest ^ ip->daddr.addr;
+    }
+    return acc;
+}
+
+static uint64_t cord_bench_parse_vlan_ipv4_tcp(void *ctx, uint64_t ops)
+{
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < ops; i++)
+    {
+        cord_eth_hdr_t *eth = cord_header_eth(cord_bench_pkt(ctx, i));
+        cord_vlan_hdr_t *vlan = cord_header_vlan(eth);
+        if (cord_unlikely(!vlan || cord_ntohs(vlan->h_proto) != CORD_ETH_P_IP))
+            continue;
+        cord_ipv4_hdr_t *ip = cord_header_ipv4(vlan + 1);
+        cord_tcp_hdr_t *tcp = cord_header_tcp_ipv4(ip);
+        if (cord_likely(tcp != NULL))
+            acc += tcp->dest ^ vlan->tci ^ ip->daddr.addr;
+    }
+    return acc;
+}
+
+static uint64_t cord_bench_parse_ipv6_udp(void *ctx, uint64_t ops)
+{
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < ops; i++)
+    {
+        cord_eth_hdr_t *eth = cord_header_eth(cord_bench_pkt(ctx, i));
+        cord_ipv6_hdr_t *ip6 = cord_header_ipv6_from_eth(eth);
+        if (cord_unlikely(!ip6))
+            continue;
+        cord_udp_hdr_t *udp = cord_header_udp_ipv6(ip6);
+        if (cord_likely(udp != NULL))
+            acc += udp->dest ^ ip6->daddr.addr[15];
+    }
+    return acc;
+}
+
+static uint64_t cord_bench_parse_vxlan(void *ctx, uint64_t ops)
+{
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < ops; i++)
+    {
+        cord_eth_hdr_t *eth = cord_header_eth(cord_bench_pkt(ctx, i));
+        cord_ipv4_hdr_t *ip = cord_header_ipv4_from_eth(eth);
+        if (cord_unlikely(!ip))
+            continue;
+        cord_udp_hdr_t *udp = cord_header_udp_ipv4(ip);
+        if (cord_unlikely(!udp))
+            continue;
+        cord_vxlan_hdr_t *vxlan = cord_header_vxlan(udp);
+        if (cord_unlikely(!vxlan))
+            continue;
+        cord_eth_hdr_t *inner_eth = cord_header_eth(vxlan + 1);
+        cord_ipv4_hdr_t *inner_ip = cord_header_ipv4_from_eth(inner_eth);
+        if (cord_likely(inner_ip != NULL))
+            acc += vxlan->vni[2] ^ inner_ip->daddr.addr;
+    }
+    return acc;
+}
+
+static uint64_t cord_bench_parse_gtpu(void *ctx, uint64_t ops)
+{
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < ops; i++)
+    {
+        cord_eth_hdr_t *eth = cord_header_eth(cord_bench_pkt(ctx, i));
+        cord_ipv4_hdr_t *ip = cord_header_ipv4_from_eth(eth);
+        if (cord_unlikely(!ip))
+            continue;
+        cord_udp_hdr_t *udp = cord_header_udp_ipv4(ip);
+        if (cord_unlikely(!udp))
+            continue;
+        cord_gtpu_hdr_t *gtpu = cord_header_gtpu(udp);
+        if (cord_likely(gtpu != NULL))
+            acc += gtpu->teid;
+    }
+    return acc;
+}
+
+static const cord_bench_fn cord_bench_parse_fns[CORD_BENCH_PARSE_COUNT] = {
+    cord_bench_parse_ipv4_udp, cord_bench_parse_vlan_ipv4_tcp, cord_bench_parse_ipv6_udp,
+    cord_bench_parse_vxlan, cord_bench_parse_gtpu
+};
+
+static void cord_bench_build_parse_pkt(uint8_t *pkt, cord_bench_parse_chain_t chain, uint64_t *rng)
+{
+    size_t off = 0;
+
+    switch (chain)
+    {
+        case CORD_BENCH_PARSE_IPV4_UDP:
+            off += cord_bench_put_eth(pkt, CORD_ETH_P_IP, rng);
+            off += cord_bench_put_ipv4(pkt + off, CORD_IPPROTO_UDP, 8 + 18, rng);
+            cord_bench_put_udp(pkt + off, 53, 8 + 18, rng);
+            break;
+
+        case CORD_BENCH_PARSE_VLAN_IPV4_TCP:
+            off += cord_bench_put_eth(pkt, CORD_ETH_P_8021Q, rng);
+            off += cord_bench_put_vlan(pkt + off, CORD_ETH_P_IP, rng);
+            off += cord_bench_put_ipv4(pkt + off, CORD_IPPROTO_TCP, sizeof(cord_tcp_hdr_t), rng);
+            cord_bench_put_tcp(pkt + off, rng);
+            break;
+
+        case CORD_BENCH_PARSE_IPV6_UDP:
+            off += cord_bench_put_eth(pkt, CORD_ETH_P_IPV6, rng);
+            off += cord_bench_put_ipv6(pkt + off, CORD_IPPROTO_UDP, 8, rng);
+            cord_bench_put_udp(pkt + off, 53, 8, rng);
+            break;
+
+        case CORD_BENCH_PARSE_VXLAN:
+        {
+            size_t inner = sizeof(cord_eth_hdr_t) + sizeof(cord_ipv4_hdr_t);
+            size_t udp_len = sizeof(cord_udp_hdr_t) + sizeof(cord_vxlan_hdr_t) + inner;
+            off += cord_bench_put_eth(pkt, CORD_ETH_P_IP, rng);
+            off += cord_bench_put_ipv4(pkt + off, CORD_IPPROTO_UDP, udp_len, rng);
+            off += cord_bench_put_udp(pkt + off, CORD_VXLAN_PORT, udp_len, rng);
+            cord_vxlan_hdr_t *vxlan = (cord_vxlan_hdr_t *)(pkt + off);
+            vxlan->flags = 0x08;
+            vxlan->vni[2] = (uint8_t)cord_bench_rand(rng);
+            off += sizeof(cord_vxlan_hdr_t);
+            off += cord_bench_put_eth(pkt + off, CORD_ETH_P_IP, rng);
+            cord_bench_put_ipv4(pkt + off, CORD_IPPROTO_ICMP, 0, rng);
+            break;
+        }
+
+        case CORD_BENCH_PARSE_GTPU:
+        default:
+        {
+            size_t udp_len = sizeof(cord_udp_hdr_t) + sizeof(cord_gtpu_hdr_t);
+            off += cord_bench_put_eth(pkt, CORD_ETH_P_IP, rng);
+            off += cord_bench_put_ipv4(pkt + off, CORD_IPPROTO_UDP, udp_len, rng);
+            off += cord_bench_put_udp(pkt + off, CORD_GTPU_PORT, udp_len, rng);
+            cord_gtpu_hdr_t *gtpu = (cord_gtpu_hdr_t *)(pkt + off);
+            gtpu->version_pt_reserved_e_s_pn = 0x30;
+            gtpu->message_type = 0xff;
+            gtpu->teid = (uint32_t)cord_bench_rand(rng);
+            break;
+        }
+    }
+}
+
+static void cord_bench_parse(void)
+{
+    if (!cord_bench_wanted("parse", cord_bench_parse_names, CORD_BENCH_PARSE_COUNT))
+        return;
+
+    cord_bench_parse_ctx_t ctx;
+    ctx.pkts = cord_bench_alloc(CORD_BENCH_PKTS * CORD_BENCH_PKT_SLOT);
+    uint64_t rng = CORD_BENCH_SEED;
+
+    for (uint32_t chain = 0; chain < CORD_BENCH_PARSE_COUNT; chain++)
+    {
+        if (!cord_bench_match("parse", cord_bench_parse_names[chain]))
+            continue;
+
+        memset(ctx.pkts, 0, CORD_BENCH_PKTS * CORD_BENCH_PKT_SLOT);
+        for (uint32_t p = 0; p < CORD_BENCH_PKTS; p++)
+            cord_bench_build_parse_pkt(ctx.pkts + p * CORD_BENCH_PKT_SLOT, chain, &rng);
+
+        cord_bench_run("parse", cord_bench_parse_names[chain], cord_bench_parse_fns[chain], &ctx);
+    }
+
+    free(ctx.pkts);
+}
+
+//
+// Checksums
+//
+
+typedef enum
+{
+    CORD_BENCH_CSUM_IPV4_HDR = 0,
+    CORD_BENCH_CSUM_ICMP_IPV4,
+    CORD_BENCH_CSUM_UDP_IPV4,
+    CORD_BENCH_CSUM_TCP_IPV4,
+    CORD_BENCH_CSUM_UDP_IPV6,
+    CORD_BENCH_CSUM_TCP_IPV6,
+    CORD_BENCH_CSUM_SCTP_IPV4,
+    CORD_BENCH_CSUM_COUNT
+} cord_bench_csum_t;
+
+static const char * const cord_bench_csum_names[CORD_BENCH_CSUM_COUNT] = {
+    "ipv4_hdr", "icmp_ipv4", "udp_ipv4", "tcp_ipv4", "udp_ipv6", "tcp_ipv6", "sctp_ipv4"
+};
+
+static const uint32_t cord_bench_frame_sizes[] = { 64, 512, 1500 };
+
+typedef struct
+{
+    uint8_t *pkts;                        // CORD_BENCH_CSUM_PKTS slots of CORD_BENCH_CSUM_SLOT bytes
+} cord_bench_csum_ctx_t;
+
+static inline const void *cord_bench_l3(const cord_bench_csum_ctx_t *c, uint64_t i)
+{
+    return c->pkts + (i & (CORD_BENCH_CSUM_PKTS - 1)) * CORD_BENCH_CSUM_SLOT + sizeof(cord_eth_hdr_t);
+}
+
+static uint64_t cord_bench_csum_ipv4_hdr(void *ctx, uint64_t ops)
+{
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < ops; i++)
+        acc += cord_calculate_ipv4_checksum(cord_bench_l3(ctx, i));
+    return acc;
+}
+
+static uint64_t cord_bench_csum_icmp_ipv4(void *ctx, uint64_t ops)
+{
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < ops; i++)
+        acc += cord_calculate_icmp_checksum_ipv4(cord_bench_l3(ctx, i));
+    return acc;
+}
+
+static uint64_t cord_bench_csum_udp_ipv4(void *ctx, uint64_t ops)
+{
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < ops; i++)
+        acc += cord_calculate_udp_checksum_ipv4(cord_bench_l3(ctx, i));
+    return acc;
+}
+
+static uint64_t cord_bench_csum_tcp_ipv4(void *ctx, uint64_t ops)
+{
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < ops; i++)
+        acc += cord_calculate_tcp_checksum_ipv4(cord_bench_l3(ctx, i));
+    return acc;
+}
+
+static uint64_t cord_bench_csum_udp_ipv6(void *ctx, uint64_t ops)
+{
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < ops; i++)
+        acc += cord_calculate_udp_checksum_ipv6(cord_bench_l3(ctx, i));
+    return acc;
+}
+
+static uint64_t cord_bench_csum_tcp_ipv6(void *ctx, uint64_t ops)
+{
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < ops; i++)
+        acc += cord_calculate_tcp_checksum_ipv6(cord_bench_l3(ctx, i));
+    return acc;
+}
+
+static uint64_t cord_bench_csum_sctp_ipv4(void *ctx, uint64_t ops)
+{
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < ops; i++)
+        acc += cord_calculate_sctp_checksum_ipv4(cord_bench_l3(ctx, i));
+    return acc;
+}
+
+static const cord_bench_fn cord_bench_csum_fns[CORD_BENCH_CSUM_COUNT] = {
+    cord_bench_csum_ipv4_hdr, cord_bench_csum_icmp_ipv4, cord_bench_csum_udp_ipv4, cord_bench_csum_tcp_ipv4,
+    cord_bench_csum_udp_ipv6, cord_bench_csum_tcp_ipv6, cord_bench_csum_sctp_ipv4
+};
+
+static void cord_bench_build_csum_pkt(uint8_t *pkt, cord_bench_csum_t kind, uint32_t frame_len, uint64_t *rng)
+{
+    bool ipv6 = (kind == CORD_BENCH_CSUM_UDP_IPV6 || kind == CORD_BENCH_CSUM_TCP_IPV6);
+    size_t l3_hdr = ipv6 ? sizeof(cord_ipv6_hdr_t) : sizeof(cord_ipv4_hdr_t);
+    size_t l4_len = frame_len - sizeof(cord_eth_hdr_t) - l3_hdr;
+    uint8_t protocol;
+
+    switch (kind)
+    {
+        case CORD_BENCH_CSUM_ICMP_IPV4:
+            protocol = CORD_IPPROTO_ICMP;
+            break;
+        case CORD_BENCH_CSUM_TCP_IPV4:
+        case CORD_BENCH_CSUM_TCP_IPV6:
+            protocol = CORD_IPPROTO_TCP;
+            break;
+        case CORD_BENCH_CSUM_SCTP_IPV4:
+            protocol = CORD_IPPROTO_SCTP;
+            break;
+        default:
+            protocol = CORD_IPPROTO_UDP;
+            break;
+    }
+
+    // A 64 byte frame cannot hold TCP over IPv6: the smallest valid segment instead
+    if (protocol == CORD_IPPROTO_TCP && l4_len < sizeof(cord_tcp_hdr_t))
+        l4_len = sizeof(cord_tcp_hdr_t);
+
+    size_t off = cord_bench_put_eth(pkt, ipv6 ? CORD_ETH_P_IPV6 : CORD_ETH_P_IP, rng);
+    cord_bench_fill_payload(pkt + off + l3_hdr, l4_len, rng);
+
+    if (ipv6)
+        off += cord_bench_put_ipv6(pkt + off, protocol, l4_len, rng);
+    else
+        off += cord_bench_put_ipv4(pkt + off, protocol, l4_len, rng);
+
+    if (protocol == CORD_IPPROTO_UDP)
+        cord_bench_put_udp(pkt + off, 4789, l4_len, rng);
+    else if (protocol == CORD_IPPROTO_TCP)
+        cord_bench_put_tcp(pkt + off, rng);
+}
+
+static void cord_bench_checksum(void)
+{
+    const uint32_t num_sizes = sizeof(cord_bench_frame_sizes) / sizeof(cord_bench_frame_sizes[0]);
+    char names[CORD_BENCH_CSUM_COUNT * 3][32];
+    const char *name_ptrs[CORD_BENCH_CSUM_COUNT * 3];
+    uint32_t kinds[CORD_BENCH_CSUM_COUNT * 3];
+    uint32_t sizes[CORD_BENCH_CSUM_COUNT * 3];
+    uint32_t count = 0;
+
+    // The IPv4 header checksum does not depend on the frame size
+    for (uint32_t k = 0; k < CORD_BENCH_CSUM_COUNT; k++)
+    {
+        for (uint32_t s = 0; s < num_sizes; s++)
+        {
+            if (k == CORD_BENCH_CSUM_IPV4_HDR && s > 0)
+                break;
+
+            if (k == CORD_BENCH_CSUM_IPV4_HDR)
+                snprintf(names[count], sizeof(names[0]), "%s", cord_bench_csum_names[k]);
+            else
+                snprintf(names[count], sizeof(names[0]), "%s-%u", cord_bench_csum_names[k], cord_bench_frame_sizes[s]);
+
+            name_ptrs[count] = names[count];
+            kinds[count] = k;
+            sizes[count++] = cord_bench_frame_sizes[s];
+        }
+    }
+
+    if (!cord_bench_wanted("checksum", name_ptrs, count))
+        return;
+
+    cord_bench_csum_ctx_t ctx;
+    ctx.pkts = cord_bench_alloc(CORD_BENCH_CSUM_PKTS * CORD_BENCH_CSUM_SLOT);
+    uint64_t rng = CORD_BENCH_SEED;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (!cord_bench_match("checksum", names[i]))
+            continue;
+
+        memset(ctx.pkts, 0, CORD_BENCH_CSUM_PKTS * CORD_BENCH_CSUM_SLOT);
+        for (uint32_t p = 0; p < CORD_BENCH_CSUM_PKTS; p++)
+            cord_bench_build_csum_pkt(ctx.pkts + p * CORD_BENCH_CSUM_SLOT, kinds[i], sizes[i], &rng);
+
+        cord_bench_run("checksum", names[i], cord_bench_csum_fns[kinds[i]], &ctx);
+    }
+
+    free(ctx.pkts);
+}
+
+//
+// Ring stress
+//
+
+typedef uint32_t (*cord_bench_ring_xfer_fn)(void *ring, uint64_t *vals, uint32_t n, bool bulk);
+
+typedef struct
+{
+    void *ring;
+    cord_bench_ring_xfer_fn enqueue;
+    cord_bench_ring_xfer_fn dequeue;
+    _Atomic uint32_t *seen;                     // Times each value was dequeued
+    _Atomic uint64_t dequeued;
+    _Atomic uint32_t next_id;                   // Producer / consumer index
+} cord_bench_ring_ctx_t;
+
+static uint32_t cord_bench_ring_enqueue(void *ring, uint64_t *vals, uint32_t n, bool bulk)
+{
+    void *objs[CORD_BENCH_BATCH];
+    for (uint32_t i = 0; i < n; i++)
+        objs[i] = (void *)(uintptr_t)vals[i];
+
+    return bulk ? cord_ring_enqueue_bulk(ring, objs, n) : cord_ring_enqueue_burst(ring, objs, n);
+}
+
+static uint32_t cord_bench_ring_dequeue(void *ring, uint64_t *vals, uint32_t n, bool bulk)
+{
+    void *objs[CORD_BENCH_BATCH];
+    uint32_t got = bulk ? cord_ring_dequeue_bulk(ring, objs, n) : cord_ring_dequeue_burst(ring, objs, n);
+
+    for (uint32_t i = 0; i < got; i++)
+        vals[i] = (uint64_t)(uintptr_t)objs[i];
+
+    return got;
+}
+
+#ifdef ENABLE_XDP_DATAPLANE
+static uint32_t cord_bench_frame_ring_enqueue(void *ring, uint64_t *vals, uint32_t n, bool bulk)
+{
+    (void)bulk;
+    return cord_xdp_frame_ring_enqueue_burst(ring, vals, n);
+}
+
+static uint32_t cord_bench_frame_ring_dequeue(void *ring, uint64_t *vals, uint32_t n, bool bulk)
+{
+    (void)bulk;
+    return cord_xdp_frame_ring_dequeue_burst(ring, vals, n);
+}
+#endif
+
+// Value v + 1 of producer p is p * CORD_BENCH_RING_VALUES + v + 1 (0 never travels)
+static void *cord_bench_ring_producer(void *arg)
+{
+    cord_bench_ring_ctx_t *c = (cord_bench_ring_ctx_t *)arg;
+    uint32_t id = atomic_fetch_add(&c->next_id, 1);
+    uint64_t rng = CORD_BENCH_SEED + id;
+    uint64_t base = (uint64_t)id * CORD_BENCH_RING_VALUES + 1;
+    uint64_t vals[CORD_BENCH_BATCH];
+    uint32_t v = 0;
+
+    while (v < CORD_BENCH_RING_VALUES)
+    {
+        uint64_t r = cord_bench_rand(&rng);
+        uint32_t n = 1 + (uint32_t)(r % CORD_BENCH_BATCH);
+        if (n > CORD_BENCH_RING_VALUES - v)
+            n = CORD_BENCH_RING_VALUES - v;
+
+        for (uint32_t i = 0; i < n; i++)
+            vals[i] = base + v + i;
+
+        uint32_t sent = c->enqueue(c->ring, vals, n, (r >> 32) & 1);
+        if (sent == 0)
+            sched_yield();
+
+        v += sent;
+    }
+
+    return NULL;
+}
+
+static void *cord_bench_ring_consumer(void *arg)
+{
+    cord_bench_ring_ctx_t *c = (cord_bench_ring_ctx_t *)arg;
+    const uint64_t total = (uint64_t)CORD_BENCH_RING_THREADS * CORD_BENCH_RING_VALUES;
+    uint64_t rng = CORD_BENCH_SEED ^ atomic_fetch_add(&c->next_id, 1);
+    uint64_t vals[CORD_BENCH_BATCH];
+
+    while (atomic_load_explicit(&c->dequeued, memory_order_relaxed) < total)
+    {
+        uint64_t r = cord_bench_rand(&rng);
+        uint32_t got = c->dequeue(c->ring, vals, 1 + (uint32_t)(r % CORD_BENCH_BATCH), (r >> 32) & 1);
+        if (got == 0)
+        {
+            sched_yield();
+            continue;
+        }
+
+        for (uint32_t i = 0; i < got; i++)
+        {
+            // Out of range values are counted as lost: the missing check catches them
+            if (vals[i] >= 1 && vals[i] <= total)
+                atomic_fetch_add_explicit(&c->seen[vals[i] - 1], 1, memory_order_relaxed);
+        }
+
+        atomic_fetch_add_explicit(&c->dequeued, got, memory_order_relaxed);
+    }
+
+    return NULL;
+}
+
+static void cord_bench_ring_stress(const char *name, void *ring, cord_bench_ring_xfer_fn enqueue, cord_bench_ring_xfer_fn dequeue)
+{
+    const uint64_t total = (uint64_t)CORD_BENCH_RING_THREADS * CORD_BENCH_RING_VALUES;
+    cord_bench_ring_ctx_t ctx = { .ring = ring, .enqueue = enqueue, .dequeue = dequeue };
+    pthread_t producers[CORD_BENCH_RING_THREADS];
+    pthread_t consumers[CORD_BENCH_RING_THREADS];
+
+    ctx.seen = calloc(total, sizeof(*ctx.seen));
+    if (!ctx.seen)
+    {
+        CORD_ERROR("[cord_flow_bench] calloc");
+        CORD_EXIT(EXIT_FAILURE);
+    }
+    atomic_init(&ctx.dequeued, 0);
+    atomic_init(&ctx.next_id, 0);
+
+    uint64_t start = cord_bench_now_ns();
+
+    for (uint32_t t = 0; t < CORD_BENCH_RING_THREADS; t++)
+        pthread_create(&producers[t], NULL, cord_bench_ring_producer, &ctx);
+    for (uint32_t t = 0; t < CORD_BENCH_RING_THREADS; t++)
+        pthread_create(&consumers[t], NULL, cord_bench_ring_consumer, &ctx);
+
+    for (uint32_t t = 0; t < CORD_BENCH_RING_THREADS; t++)
+        pthread_join(producers[t], NULL);
+    for (uint32_t t = 0; t < CORD_BENCH_RING_THREADS; t++)
+        pthread_join(consumers[t], NULL);
+
+    uint64_t elapsed = cord_bench_now_ns() - start;
+
+    uint64_t missing = 0;
+    uint64_t duplicated = 0;
+    for (uint64_t v = 0; v < total; v++)
+    {
+        uint32_t seen = atomic_load_explicit(&ctx.seen[v], memory_order_relaxed);
+        missing += (seen == 0);
+        duplicated += (seen > 1);
+    }
+
+    char full[128];
+    snprintf(full, sizeof(full), "ring/%s", name);
+
+    if (missing || duplicated)
+    {
+        CORD_LOG("%-44s FAILED: %lu values lost, %lu delivered more than once\n", full, missing, duplicated);
+        bench.failed = true;
+    }
+    else
+    {
+        CORD_LOG("%-44s %10.2f %9.2f  every value exactly once (%ux%u threads)\n", full,
+                 (double)total * 1e3 / (double)elapsed, (double)elapsed / (double)total,
+                 CORD_BENCH_RING_THREADS, CORD_BENCH_RING_THREADS);
+    }
+
+    free(ctx.seen);
+}
+
+static void cord_bench_ring(void)
+{
+    static const char * const names[] = {
+        "mpmc_exactly_once",
+#ifdef ENABLE_XDP_DATAPLANE
+        "xdp_frame_exactly_once",
+#endif
+    };
+
+    if (!cord_bench_wanted("ring", names, sizeof(names) / sizeof(names[0])))
+        return;
+
+    if (cord_bench_match("ring", "mpmc_exactly_once"))
+    {
+        cord_ring_t *ring = cord_ring_create(CORD_BENCH_RING_SIZE, CORD_RING_MPMC);
+        if (!ring)
+        {
+            CORD_LOG("[cord_flow_bench] cord_ring_create failed\n");
+            CORD_EXIT(EXIT_FAILURE);
+        }
+
+        cord_bench_ring_stress("mpmc_exactly_once", ring, cord_bench_ring_enqueue, cord_bench_ring_dequeue);
+        cord_ring_destroy(ring);
+    }
+
+#ifdef ENABLE_XDP_DATAPLANE
+    if (cord_bench_match("ring", "xdp_frame_exactly_once"))
+    {
+        struct cord_xdp_frame_ring *ring = cord_xdp_frame_ring_create(CORD_BENCH_RING_SIZE);
+        if (!ring)
+        {
+            CORD_LOG("[cord_flow_bench] cord_xdp_frame_ring_create failed\n");
+            CORD_EXIT(EXIT_FAILURE);
+        }
+
+        cord_bench_ring_stress("xdp_frame_exactly_once", ring, cord_bench_frame_ring_enqueue, cord_bench_frame_ring_dequeue);
+        cord_xdp_frame_ring_destroy(ring);
+    }
+#endif
+}
+
+//
+// Main
+//
+
+static void usage(const char *prog)
+{
+    CORD_LOG("Usage: %s [-f filter] [-t ms] [-c cpu] [-l]\n", prog);
+    CORD_LOG("  -f  Run only the benchmarks whose name contains filter (e.g. ipv4_lpm, batch)\n");
+    CORD_LOG("  -t  Measured time per benchmark in milliseconds (default %u)\n", CORD_BENCH_DEFAULT_MS);
+    CORD_LOG("  -c  Pin to the CPU\n");
+    CORD_LOG("  -l  List the benchmarks\n");
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t target_ms = CORD_BENCH_DEFAULT_MS;
+    int cpu = -1;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "f:t:c:lh")) != -1)
+    {
+        switch (opt)
+        {
+            case 'f': bench.filter = optarg; break;
+            case 't': target_ms = (uint32_t)strtoul(optarg, NULL, 10); break;
+            case 'c': cpu = atoi(optarg); break;
+            case 'l': bench.list = true; break;
+            default:
+                usage(argv[0]);
+                return (opt == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    bench.target_ns = (uint64_t)(target_ms ? target_ms : CORD_BENCH_DEFAULT_MS) * 1000000ULL;
+
+    if (cpu >= 0 && cord_bench_pin_cpu(cpu) != 0)
+    {
+        CORD_ERROR("[cord_flow_bench] sched_setaffinity");
+        return EXIT_FAILURE;
+    }
+
+    if (!bench.list)
+    {
+        cord_bench_warn_unoptimized();
+        cord_bench_perf_open(&bench.perf);
+        if (!cord_bench_perf_has(&bench.perf, CORD_BENCH_PERF_CYCLES))
+            CORD_LOG("Hardware counters not available (perf_event_paranoid or container), timing only\n");
+        cord_bench_header();
+    }
+
+    cord_bench_ipv4_lpm("uniform", cord_bench_ipv4_uniform, 1000);
+    cord_bench_ipv4_lpm("uniform", cord_bench_ipv4_uniform, 100000);
+    cord_bench_ipv4_lpm("internet", cord_bench_ipv4_internet, 900000);
+
+    cord_bench_ipv6_lpm("uniform", cord_bench_ipv6_uniform, 1000, false);
+    cord_bench_ipv6_lpm("internet", cord_bench_ipv6_internet, 20000, true);
+
+    cord_bench_l2_cam(0.25);
+    cord_bench_l2_cam(0.5);
+    cord_bench_l2_cam(1.0);
+    cord_bench_l2_cam(2.0);
+    cord_bench_l2_cam(4.0);
+
+    cord_bench_parse();
+    cord_bench_checksum();
+    cord_bench_ring();
+
+    if (!bench.list)
+        cord_bench_perf_close(&bench.perf);
+
+    return bench.failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
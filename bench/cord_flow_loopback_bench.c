@@ -0,0 +1,771 @@
+//
+// cord_flow_loopback_bench - end-to-end throughput of the flow points over a veth pair
+//
+// A sender thread pushes UDP frames through one flow point into one end of a veth pair
+// (created for the run, removed on exit) and a receiver thread pulls them out of the
+// other end through another:
+//
+// - l2_raw:    CordL2RawSocketFlowPoint -> CordL2RawSocketFlowPoint
+// - tpacketv3: CordL2RawSocketFlowPoint -> CordL2Tpacketv3FlowPoint (RX ring)
+// - l3_raw:    CordL3RawSocketFlowPoint -> CordL3RawSocketFlowPoint
+// - l4_udp:    CordL4UdpFlowPoint -> CordL4UdpFlowPoint over lo (127.0.0.1)
+// - xdp:       CordL2RawSocketFlowPoint -> CordXdpFlowPoint (ENABLE_XDP_DATAPLANE; the
+//              socket falls back to copy / generic SKB mode, which is what veth gets)
+//
+// Frame sizes are Ethernet frame sizes without the FCS; the l3_raw and l4_udp cases send
+// the same frame less the headers the kernel builds. The burst is the number of packets
+// the receiver takes per poll() wakeup (TPACKETv3 always takes a whole block). The sender
+// is not throttled, so the drop rate - frames accepted by tx() that never reached rx() -
+// shows where the receiver saturates. CPU/pkt is the CPU time of the process (both threads,
+// user + system, including the softirq work run in their context) per received packet.
+//
+// Needs CAP_NET_ADMIN and CAP_NET_RAW; without them only l4_udp runs. Pin the threads
+// (-c cpu: receiver on cpu, sender on cpu + 1) for stable results.
+//
+// Usage: cord_flow_loopback_bench [-f filter] [-t ms] [-c cpu] [-l]
+//
+
+#define _GNU_SOURCE
+#include "cord_bench_perf.h"
+#include <flow_point/cord_l2_raw_socket_flow_point.h>
+#include <flow_point/cord_l2_tpacketv3_flow_point.h>
+#include <flow_point/cord_l3_raw_socket_flow_point.h>
+#include <flow_point/cord_l4_udp_flow_point.h>
+#include <flow_point/cord_xdp_flow_point.h>
+#include <match/cord_match.h>
+#include <action/cord_action.h>
+#include <cord_error.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <poll.h>
+#include <time.h>
+#include <getopt.h>
+#include <linux/rtnetlink.h>
+#include <linux/if_link.h>
+#include <linux/veth.h>
+#include <linux/sockios.h>
+
+#define CORD_BENCH_IF_TX            "cordbench0"
+#define CORD_BENCH_IF_RX            "cordbench1"
+#define CORD_BENCH_UDP_PORT         47011
+#define CORD_BENCH_MAGIC            0x434F5244u     // "CORD", first payload word of every frame
+#define CORD_BENCH_HDR_LEN          (sizeof(cord_eth_hdr_t) + sizeof(cord_ipv4_hdr_t) + sizeof(cord_udp_hdr_t))
+#define CORD_BENCH_MAX_FRAME        2048
+#define CORD_BENCH_MAX_BURST        64
+#define CORD_BENCH_POLL_MS          10
+#define CORD_BENCH_DRAIN_MS         50              // Receiver keeps draining this long after the sender stops
+#define CORD_BENCH_DEFAULT_MS       500
+
+// TPACKETv3 RX ring: 64 x 256 KiB blocks
+#define CORD_BENCH_TPV3_BLOCK_SIZE  (1u << 18)
+#define CORD_BENCH_TPV3_FRAME_SIZE  2048
+#define CORD_BENCH_TPV3_BLOCK_NUM   64
+
+// AF_XDP socket
+#define CORD_BENCH_XDP_NUM_FRAMES   4096
+#define CORD_BENCH_XDP_FRAME_SIZE   4096
+#define CORD_BENCH_XDP_RING_SIZE    2048
+
+static const uint16_t cord_bench_frame_sizes[] = { 64, 512, 1514 };
+static const uint16_t cord_bench_bursts[] = { 1, 8, 32 };      // Up to CORD_BENCH_MAX_BURST
+
+typedef enum
+{
+    CORD_BENCH_L2_RAW = 0,
+    CORD_BENCH_TPACKETV3,
+    CORD_BENCH_L3_RAW,
+    CORD_BENCH_L4_UDP,
+    CORD_BENCH_XDP,
+    CORD_BENCH_BACKEND_COUNT
+} cord_bench_backend_t;
+
+static const char *cord_bench_backend_names[CORD_BENCH_BACKEND_COUNT] = {
+    "l2_raw", "tpacketv3", "l3_raw", "l4_udp", "xdp"
+};
+
+static struct
+{
+    const char *filter;
+    uint64_t target_ns;
+    int cpu;
+    bool list;
+    bool veth;                                  // Pair created (and to be removed)
+} bench = { .cpu = -1 };
+
+typedef struct
+{
+    cord_bench_backend_t backend;
+    uint16_t frame_size;
+    uint16_t burst;
+
+    CordFlowPoint *tx_fp;
+    CordFlowPoint *rx_fp;
+    int rx_fd;                                  // Receiver wait handle
+    struct cord_tpacketv3_ring *rx_ring;
+#ifdef ENABLE_XDP_DATAPLANE
+    struct cord_xdp_socket_info *xsk;
+#endif
+
+    atomic_bool stop;                           // Sender: stop sending
+    atomic_bool done;                           // Receiver: sender finished and drained
+
+    // Written by their own thread only, read after the joins
+    uint64_t sent;
+    uint64_t tx_busy;
+    uint64_t received;
+} cord_bench_run_t;
+
+//
+// veth pair (rtnetlink)
+//
+
+static struct rtattr *cord_bench_nl_put(struct nlmsghdr *nlh, uint16_t type, const void *data, size_t len)
+{
+    struct rtattr *rta = (struct rtattr *)((uint8_t *)nlh + NLMSG_ALIGN(nlh->nlmsg_len));
+    rta->rta_type = type;
+    rta->rta_len = (unsigned short)RTA_LENGTH(len);
+    if (len)
+        memcpy(RTA_DATA(rta), data, len);
+    nlh->nlmsg_len = NLMSG_ALIGN(nlh->nlmsg_len) + RTA_ALIGN(rta->rta_len);
+    return rta;
+}
+
+static void cord_bench_nl_nest_end(struct nlmsghdr *nlh, struct rtattr *nest)
+{
+    nest->rta_len = (unsigned short)((uint8_t *)nlh + nlh->nlmsg_len - (uint8_t *)nest);
+}
+
+// Sends the request and waits for the kernel's ack; returns 0 or -1 with errno set
+static int cord_bench_nl_request(struct nlmsghdr *nlh)
+{
+    int fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (fd < 0)
+        return -1;
+
+    nlh->nlmsg_flags |= NLM_F_REQUEST | NLM_F_ACK;
+    nlh->nlmsg_seq = 1;
+
+    if (send(fd, nlh, nlh->nlmsg_len, 0) < 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    uint8_t reply[4096];
+    ssize_t n = recv(fd, reply, sizeof(reply), 0);
+    close(fd);
+
+    if (n < (ssize_t)NLMSG_LENGTH(sizeof(struct nlmsgerr)))
+    {
+        errno = EIO;
+        return -1;
+    }
+
+    struct nlmsghdr *ack = (struct nlmsghdr *)reply;
+    if (ack->nlmsg_type == NLMSG_ERROR)
+    {
+        int error = ((struct nlmsgerr *)NLMSG_DATA(ack))->error;
+        if (error)
+        {
+            errno = -error;
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int cord_bench_veth_delete(const char *ifname)
+{
+    struct
+    {
+        struct nlmsghdr nlh;
+        struct ifinfomsg ifi;
+        uint8_t attrs[64];
+    } req;
+    memset(&req, 0, sizeof(req));
+
+    req.nlh.nlmsg_len = NLMSG_LENGTH(sizeof(struct ifinfomsg));
+    req.nlh.nlmsg_type = RTM_DELLINK;
+    req.ifi.ifi_family = AF_UNSPEC;
+    cord_bench_nl_put(&req.nlh, IFLA_IFNAME, ifname, strlen(ifname) + 1);
+
+    return cord_bench_nl_request(&req.nlh);
+}
+
+// Both ends are created down: veth refuses to open one end before the pair is linked
+static int cord_bench_veth_create(const char *ifname, const char *peer_ifname)
+{
+    struct
+    {
+        struct nlmsghdr nlh;
+        struct ifinfomsg ifi;
+        uint8_t attrs[256];
+    } req;
+    memset(&req, 0, sizeof(req));
+
+    req.nlh.nlmsg_len = NLMSG_LENGTH(sizeof(struct ifinfomsg));
+    req.nlh.nlmsg_type = RTM_NEWLINK;
+    req.nlh.nlmsg_flags = NLM_F_CREATE | NLM_F_EXCL;
+    req.ifi.ifi_family = AF_UNSPEC;
+
+    cord_bench_nl_put(&req.nlh, IFLA_IFNAME, ifname, strlen(ifname) + 1);
+    struct rtattr *linkinfo = cord_bench_nl_put(&req.nlh, IFLA_LINKINFO, NULL, 0);
+    cord_bench_nl_put(&req.nlh, IFLA_INFO_KIND, "veth", strlen("veth"));
+    struct rtattr *data = cord_bench_nl_put(&req.nlh, IFLA_INFO_DATA, NULL, 0);
+    struct rtattr *peer = cord_bench_nl_put(&req.nlh, VETH_INFO_PEER, NULL, 0);
+
+    // The peer attribute carries its own ifinfomsg ahead of its attributes
+    struct ifinfomsg *peer_ifi = (struct ifinfomsg *)((uint8_t *)&req.nlh + req.nlh.nlmsg_len);
+    peer_ifi->ifi_family = AF_UNSPEC;
+    req.nlh.nlmsg_len += NLMSG_ALIGN(sizeof(struct ifinfomsg));
+
+    cord_bench_nl_put(&req.nlh, IFLA_IFNAME, peer_ifname, strlen(peer_ifname) + 1);
+    cord_bench_nl_nest_end(&req.nlh, peer);
+    cord_bench_nl_nest_end(&req.nlh, data);
+    cord_bench_nl_nest_end(&req.nlh, linkinfo);
+
+    return cord_bench_nl_request(&req.nlh);
+}
+
+static int cord_bench_link_up(const char *ifname)
+{
+    int fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return -1;
+
+    struct ifreq ifr;
+    memset(&ifr, 0, sizeof(ifr));
+    strncpy(ifr.ifr_name, ifname, IFNAMSIZ - 1);
+
+    int ret = ioctl(fd, SIOCGIFFLAGS, &ifr);
+    if (ret == 0)
+    {
+        ifr.ifr_flags |= IFF_UP;
+        ret = ioctl(fd, SIOCSIFFLAGS, &ifr);
+    }
+
+    close(fd);
+    return ret;
+}
+
+// No router solicitations / MLD reports on the pair while measuring
+static void cord_bench_disable_ipv6(const char *ifname)
+{
+    char path[128];
+    snprintf(path, sizeof(path), "/proc/sys/net/ipv6/conf/%s/disable_ipv6", ifname);
+
+    FILE *f = fopen(path, "w");
+    if (f)
+    {
+        fputs("1", f);
+        fclose(f);
+    }
+}
+
+static void cord_bench_veth_cleanup(void)
+{
+    if (bench.veth)
+    {
+        cord_bench_veth_delete(CORD_BENCH_IF_TX);
+        bench.veth = false;
+    }
+}
+
+static void cord_bench_signal(int sig)
+{
+    (void)sig;
+    exit(EXIT_FAILURE);     // Runs the atexit() cleanup
+}
+
+static bool cord_bench_veth_setup(void)
+{
+    // Left over from an interrupted run
+    cord_bench_veth_delete(CORD_BENCH_IF_TX);
+
+    if (cord_bench_veth_create(CORD_BENCH_IF_TX, CORD_BENCH_IF_RX) < 0)
+    {
+        CORD_LOG("Cannot create the veth pair %s/%s (%s): only l4_udp runs, retry as root\n",
+                 CORD_BENCH_IF_TX, CORD_BENCH_IF_RX, strerror(errno));
+        return false;
+    }
+
+    bench.veth = true;
+    atexit(cord_bench_veth_cleanup);
+    signal(SIGINT, cord_bench_signal);
+    signal(SIGTERM, cord_bench_signal);
+
+    cord_bench_disable_ipv6(CORD_BENCH_IF_TX);
+    cord_bench_disable_ipv6(CORD_BENCH_IF_RX);
+
+    if (cord_bench_link_up(CORD_BENCH_IF_TX) < 0 || cord_bench_link_up(CORD_BENCH_IF_RX) < 0)
+    {
+        CORD_ERROR("[cord_flow_loopback_bench] SIOCSIFFLAGS");
+        return false;
+    }
+
+    // Both ends need carrier before the first frame goes out
+    struct timespec period = { .tv_sec = 0, .tv_nsec = 100000000L };
+    nanosleep(&period, NULL);
+
+    return true;
+}
+
+//
+// Frames
+//
+
+// Locally administered MACs: the receiving stack drops the frames as PACKET_OTHERHOST right
+// after the taps instead of routing them
+static const uint8_t cord_bench_src_mac[ETH_ALEN] = { 0x02, 0x00, 0x00, 0xC0, 0x4D, 0x01 };
+static const uint8_t cord_bench_dst_mac[ETH_ALEN] = { 0x02, 0x00, 0x00, 0xC0, 0x4D, 0x02 };
+
+// Ethernet / IPv4 / UDP between the benchmark MACs; the payload starts with the magic and a
+// sequence number
+static void cord_bench_build_frame(uint8_t *frame, uint16_t frame_size)
+{
+    memset(frame, 0, frame_size);
+
+    cord_eth_hdr_t *eth = (cord_eth_hdr_t *)frame;
+    memcpy(eth->h_dest.addr, cord_bench_dst_mac, ETH_ALEN);
+    memcpy(eth->h_source.addr, cord_bench_src_mac, ETH_ALEN);
+    eth->h_proto = cord_htons(CORD_ETH_P_IP);
+
+    cord_ipv4_hdr_t *ip = (cord_ipv4_hdr_t *)(eth + 1);
+    ip->version = 4;
+    ip->ihl = 5;
+    ip->tot_len = cord_htons((uint16_t)(frame_size - sizeof(cord_eth_hdr_t)));
+    ip->ttl = 64;
+    ip->protocol = IPPROTO_UDP;
+    ip->saddr.addr = cord_htonl(0xC6120001);   // 198.18.0.1 (RFC 2544 benchmarking range)
+    ip->daddr.addr = cord_htonl(0xC6120002);
+    ip->check = cord_htons(cord_calculate_ipv4_checksum(ip));
+
+    cord_udp_hdr_t *udp = (cord_udp_hdr_t *)(ip + 1);
+    udp->source = cord_htons(CORD_BENCH_UDP_PORT);
+    udp->dest = cord_htons(CORD_BENCH_UDP_PORT);
+    udp->len = cord_htons((uint16_t)(frame_size - sizeof(cord_eth_hdr_t) - sizeof(cord_ipv4_hdr_t)));
+
+    uint32_t magic = CORD_BENCH_MAGIC;
+    memcpy(frame + CORD_BENCH_HDR_LEN, &magic, sizeof(magic));
+}
+
+// Where the data of each backend starts in the frame: the L3 flow point takes the IP
+// packet, the L4 one the UDP payload
+static size_t cord_bench_data_offset(cord_bench_backend_t backend)
+{
+    switch (backend)
+    {
+        case CORD_BENCH_L3_RAW: return sizeof(cord_eth_hdr_t);
+        case CORD_BENCH_L4_UDP: return CORD_BENCH_HDR_LEN;
+        default:                return 0;
+    }
+}
+
+static inline bool cord_bench_is_ours(const uint8_t *data, size_t len, size_t payload_offset)
+{
+    uint32_t magic;
+    if (len < payload_offset + sizeof(magic))
+        return false;
+
+    memcpy(&magic, data + payload_offset, sizeof(magic));
+    return magic == CORD_BENCH_MAGIC;
+}
+
+//
+// Flow points
+//
+
+static bool cord_bench_open(cord_bench_run_t *r)
+{
+    switch (r->backend)
+    {
+        case CORD_BENCH_L2_RAW:
+            r->tx_fp = CORD_CREATE_L2_RAW_SOCKET_FLOW_POINT(0, CORD_BENCH_IF_TX);
+            r->rx_fp = CORD_CREATE_L2_RAW_SOCKET_FLOW_POINT(1, CORD_BENCH_IF_RX);
+            break;
+
+        case CORD_BENCH_TPACKETV3:
+            r->rx_ring = cord_tpacketv3_ring_alloc(CORD_BENCH_TPV3_BLOCK_SIZE, CORD_BENCH_TPV3_FRAME_SIZE, CORD_BENCH_TPV3_BLOCK_NUM);
+            if (!r->rx_ring)
+                return false;
+            r->tx_fp = CORD_CREATE_L2_RAW_SOCKET_FLOW_POINT(0, CORD_BENCH_IF_TX);
+            r->rx_fp = CORD_CREATE_L2_TPACKETV3_FLOW_POINT(1, CORD_BENCH_IF_RX, &r->rx_ring);
+            break;
+
+        case CORD_BENCH_L3_RAW:
+            // Same next-hop MAC as the L2 frames: PACKET_OTHERHOST on the peer, never forwarded
+            r->tx_fp = CORD_CREATE_L3_RAW_SOCKET_FLOW_POINT(0, CORD_BENCH_IF_TX);
+            r->rx_fp = CORD_CREATE_L3_RAW_SOCKET_FLOW_POINT(1, CORD_BENCH_IF_RX);
+            CordL3RawSocketFlowPoint_set_dst_mac((CordL3RawSocketFlowPoint *)r->tx_fp, cord_bench_dst_mac);
+            break;
+
+        case CORD_BENCH_L4_UDP:
+            r->tx_fp = CORD_CREATE_L4_UDP_FLOW_POINT(0, 0, htonl(INADDR_LOOPBACK), 0, CORD_BENCH_UDP_PORT);
+            r->rx_fp = CORD_CREATE_L4_UDP_FLOW_POINT(1, htonl(INADDR_LOOPBACK), htonl(INADDR_LOOPBACK), CORD_BENCH_UDP_PORT, 0);
+            break;
+
+        case CORD_BENCH_XDP:
+#ifdef ENABLE_XDP_DATAPLANE
+            r->xsk = cord_xdp_socket_alloc(CORD_BENCH_IF_RX, 0, CORD_BENCH_XDP_NUM_FRAMES, CORD_BENCH_XDP_FRAME_SIZE,
+                                           CORD_BENCH_XDP_RING_SIZE, CORD_BENCH_XDP_RING_SIZE,
+                                           CORD_BENCH_XDP_RING_SIZE, CORD_BENCH_XDP_RING_SIZE);
+            if (!r->xsk)
+                return false;
+            cord_xdp_socket_init(&r->xsk);
+            if (!r->xsk->xsk)
+            {
+                cord_xdp_socket_free(&r->xsk);
+                return false;
+            }
+            r->tx_fp = CORD_CREATE_L2_RAW_SOCKET_FLOW_POINT(0, CORD_BENCH_IF_TX);
+            r->rx_fp = CORD_CREATE_XDP_FLOW_POINT(1, &r->xsk);
+            CordXdpFlowPoint_fill_vcall((CordXdpFlowPoint *)r->rx_fp);
+            r->rx_fd = xsk_socket__fd(r->xsk->xsk);
+            return true;
+#else
+            return false;
+#endif
+
+        default:
+            return false;
+    }
+
+    r->rx_fd = r->rx_fp->io_handle;
+    return true;
+}
+
+// The virtual dtor; the TPACKETv3 one frees the RX ring as well
+static void cord_bench_close(cord_bench_run_t *r)
+{
+    CordFlowPoint_dtor(r->tx_fp);
+    CordFlowPoint_dtor(r->rx_fp);
+#ifdef ENABLE_XDP_DATAPLANE
+    if (r->xsk)
+        cord_xdp_socket_free(&r->xsk);
+#endif
+}
+
+//
+// Sender / receiver threads
+//
+
+static void *cord_bench_sender(void *arg)
+{
+    cord_bench_run_t *r = (cord_bench_run_t *)arg;
+
+    if (bench.cpu >= 0)
+        cord_bench_pin_cpu(bench.cpu + 1);
+
+    uint8_t frame[CORD_BENCH_MAX_FRAME];
+    cord_bench_build_frame(frame, r->frame_size);
+
+    size_t offset = cord_bench_data_offset(r->backend);
+    uint8_t *data = frame + offset;
+    size_t len = r->frame_size - offset;
+    uint8_t *seq_field = frame + CORD_BENCH_HDR_LEN + sizeof(uint32_t);
+
+    struct pollfd pfd = { .fd = r->tx_fp->io_handle, .events = POLLOUT };
+    uint64_t seq = 0;
+
+    while (!atomic_load_explicit(&r->stop, memory_order_relaxed))
+    {
+        ssize_t txed = 0;
+        memcpy(seq_field, &seq, sizeof(seq));
+
+        CORD_FLOW_POINT_TX(r->tx_fp, 0, data, len, &txed);
+        if (txed > 0)
+        {
+            r->sent++;
+            seq++;
+        }
+        else
+        {
+            // Socket send buffer full: wait for room instead of spinning on errors
+            r->tx_busy++;
+            poll(&pfd, 1, CORD_BENCH_POLL_MS);
+        }
+    }
+
+    return NULL;
+}
+
+// Socket backends: one packet per rx(); SIOCINQ tells whether another one is queued
+// without taking the EAGAIN path of rx()
+static void cord_bench_receive_socket(cord_bench_run_t *r, uint8_t *buf)
+{
+    size_t payload_offset = CORD_BENCH_HDR_LEN - cord_bench_data_offset(r->backend);
+
+    for (uint16_t b = 0; b < r->burst; b++)
+    {
+        int queued = 0;
+        if (b > 0 && (ioctl(r->rx_fd, SIOCINQ, &queued) < 0 || queued <= 0))
+            break;
+
+        ssize_t rxed = 0;
+        if (CORD_FLOW_POINT_RX(r->rx_fp, 0, buf, CORD_BENCH_MAX_FRAME, &rxed) != CORD_OK || rxed <= 0)
+            break;
+
+        if (cord_bench_is_ours(buf, (size_t)rxed, payload_offset))
+            r->received++;
+    }
+}
+
+// TPACKETv3: every ready block, released back to the kernel once counted
+static void cord_bench_receive_tpacketv3(cord_bench_run_t *r)
+{
+    struct cord_tpacketv3_ring *ring = r->rx_ring;
+
+    for (;;)
+    {
+        ssize_t rxed = 0;
+        CORD_FLOW_POINT_RX(r->rx_fp, 0, &r->rx_ring, 0, &rxed);
+        if (rxed <= 0)
+            break;
+
+        struct tpacket_block_desc *pbd = (struct tpacket_block_desc *)ring->iov_ring[ring->block_idx].iov_base;
+        struct tpacket3_hdr *hdr = (struct tpacket3_hdr *)((uint8_t *)pbd + pbd->hdr.bh1.offset_to_first_pkt);
+        for (ssize_t i = 0; i < rxed; i++)
+        {
+            if (cord_bench_is_ours((uint8_t *)hdr + hdr->tp_mac, hdr->tp_snaplen, CORD_BENCH_HDR_LEN))
+                r->received++;
+            hdr = (struct tpacket3_hdr *)((uint8_t *)hdr + hdr->tp_next_offset);
+        }
+
+        __atomic_store_n(&pbd->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+        ring->block_idx = (ring->block_idx + 1) % ring->req.tp_block_nr;
+    }
+}
+
+#ifdef ENABLE_XDP_DATAPLANE
+static void cord_bench_receive_xdp(cord_bench_run_t *r)
+{
+    struct cord_xdp_pkt_desc pkts[CORD_BENCH_MAX_BURST];
+    uint64_t frames[CORD_BENCH_MAX_BURST];
+    ssize_t rxed = 0;
+
+    CORD_FLOW_POINT_RX(r->rx_fp, 0, pkts, r->burst, &rxed);
+
+    for (ssize_t i = 0; i < rxed; i++)
+    {
+        if (cord_bench_is_ours(pkts[i].data, pkts[i].len, CORD_BENCH_HDR_LEN))
+            r->received++;
+        frames[i] = pkts[i].addr;
+    }
+
+    if (rxed > 0)
+        cord_xdp_free_frames_rx(r->xsk, frames, (uint32_t)rxed);
+}
+#endif
+
+static void *cord_bench_receiver(void *arg)
+{
+    cord_bench_run_t *r = (cord_bench_run_t *)arg;
+
+    if (bench.cpu >= 0)
+        cord_bench_pin_cpu(bench.cpu);
+
+    uint8_t buf[CORD_BENCH_MAX_FRAME];
+    struct pollfd pfd = { .fd = r->rx_fd, .events = POLLIN };
+
+    for (;;)
+    {
+        int ready = poll(&pfd, 1, CORD_BENCH_POLL_MS);
+        if (ready <= 0)
+        {
+            if (atomic_load_explicit(&r->done, memory_order_relaxed))
+                break;
+            continue;
+        }
+
+        switch (r->backend)
+        {
+            case CORD_BENCH_TPACKETV3:
+                cord_bench_receive_tpacketv3(r);
+                break;
+#ifdef ENABLE_XDP_DATAPLANE
+            case CORD_BENCH_XDP:
+                cord_bench_receive_xdp(r);
+                break;
+#endif
+            default:
+                cord_bench_receive_socket(r, buf);
+                break;
+        }
+    }
+
+    return NULL;
+}
+
+//
+// Runner
+//
+
+static bool cord_bench_match(const char *name)
+{
+    return !bench.filter || strstr(name, bench.filter);
+}
+
+static void cord_bench_header(void)
+{
+    CORD_LOG("%-30s %10s %10s %9s %10s %8s\n", "Benchmark", "TX Mpps", "RX Mpps", "RX Gbps", "CPU ns/pkt", "Drop %");
+}
+
+static void cord_bench_run(cord_bench_backend_t backend, uint16_t frame_size, uint16_t burst)
+{
+    char name[64];
+    if (backend == CORD_BENCH_TPACKETV3)
+        snprintf(name, sizeof(name), "%s/%uB/block", cord_bench_backend_names[backend], frame_size);
+    else
+        snprintf(name, sizeof(name), "%s/%uB/burst-%u", cord_bench_backend_names[backend], frame_size, burst);
+
+    if (!cord_bench_match(name))
+        return;
+
+    if (bench.list)
+    {
+        CORD_LOG("%s\n", name);
+        return;
+    }
+
+    cord_bench_run_t r;
+    memset(&r, 0, sizeof(r));
+    r.backend = backend;
+    r.frame_size = frame_size;
+    r.burst = burst;
+    atomic_init(&r.stop, false);
+    atomic_init(&r.done, false);
+
+    if (!cord_bench_open(&r))
+    {
+        CORD_LOG("%-30s %10s\n", name, "n/a");
+        return;
+    }
+
+    pthread_t rx_thread, tx_thread;
+    if (pthread_create(&rx_thread, NULL, cord_bench_receiver, &r) != 0)
+    {
+        CORD_ERROR("[cord_flow_loopback_bench] pthread_create");
+        cord_bench_close(&r);
+        return;
+    }
+
+    uint64_t cpu_start = cord_bench_cpu_ns();
+    uint64_t start = cord_bench_now_ns();
+
+    if (pthread_create(&tx_thread, NULL, cord_bench_sender, &r) != 0)
+    {
+        CORD_ERROR("[cord_flow_loopback_bench] pthread_create");
+        atomic_store(&r.done, true);
+        pthread_join(rx_thread, NULL);
+        cord_bench_close(&r);
+        return;
+    }
+
+    struct timespec period = { .tv_sec = (time_t)(bench.target_ns / 1000000000ULL),
+                               .tv_nsec = (long)(bench.target_ns % 1000000000ULL) };
+    nanosleep(&period, NULL);
+
+    atomic_store(&r.stop, true);
+    pthread_join(tx_thread, NULL);
+    uint64_t elapsed = cord_bench_now_ns() - start;
+
+    struct timespec drain = { .tv_sec = 0, .tv_nsec = CORD_BENCH_DRAIN_MS * 1000000L };
+    nanosleep(&drain, NULL);
+    atomic_store(&r.done, true);
+    pthread_join(rx_thread, NULL);
+    uint64_t cpu = cord_bench_cpu_ns() - cpu_start;
+
+    cord_bench_close(&r);
+
+    // Frames the sender saw twice or the receiver picked up from a previous run do not count
+    uint64_t received = (r.received < r.sent) ? r.received : r.sent;
+    double drop = r.sent ? 100.0 * (double)(r.sent - received) / (double)r.sent : 0.0;
+
+    char cpu_per_pkt[16];
+    if (received)
+        snprintf(cpu_per_pkt, sizeof(cpu_per_pkt), "%.1f", (double)cpu / (double)received);
+    else
+        snprintf(cpu_per_pkt, sizeof(cpu_per_pkt), "-");
+
+    CORD_LOG("%-30s %10.3f %10.3f %9.3f %10s %8.2f\n", name,
+             (double)r.sent * 1e3 / (double)elapsed,
+             (double)received * 1e3 / (double)elapsed,
+             (double)received * frame_size * 8.0 / (double)elapsed,
+             cpu_per_pkt, drop);
+}
+
+static void cord_bench_backend(cord_bench_backend_t backend)
+{
+    for (uint32_t s = 0; s < sizeof(cord_bench_frame_sizes) / sizeof(cord_bench_frame_sizes[0]); s++)
+    {
+        if (backend == CORD_BENCH_TPACKETV3)
+        {
+            cord_bench_run(backend, cord_bench_frame_sizes[s], 0);
+            continue;
+        }
+
+        for (uint32_t b = 0; b < sizeof(cord_bench_bursts) / sizeof(cord_bench_bursts[0]); b++)
+            cord_bench_run(backend, cord_bench_frame_sizes[s], cord_bench_bursts[b]);
+    }
+}
+
+//
+// Main
+//
+
+static void usage(const char *prog)
+{
+    CORD_LOG("Usage: %s [-f filter] [-t ms] [-c cpu] [-l]\n", prog);
+    CORD_LOG("  -f  Run only the benchmarks whose name contains filter (e.g. l2_raw, 64B, burst-32)\n");
+    CORD_LOG("  -t  Sending time per benchmark in milliseconds (default %u)\n", CORD_BENCH_DEFAULT_MS);
+    CORD_LOG("  -c  Pin the receiver to the CPU and the sender to the next one\n");
+    CORD_LOG("  -l  List the benchmarks\n");
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t target_ms = CORD_BENCH_DEFAULT_MS;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "f:t:c:lh")) != -1)
+    {
+        switch (opt)
+        {
+            case 'f': bench.filter = optarg; break;
+            case 't': target_ms = (uint32_t)strtoul(optarg, NULL, 10); break;
+            case 'c': bench.cpu = atoi(optarg); break;
+            case 'l': bench.list = true; break;
+            default:
+                usage(argv[0]);
+                return (opt == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    bench.target_ns = (uint64_t)(target_ms ? target_ms : CORD_BENCH_DEFAULT_MS) * 1000000ULL;
+
+    bool veth = false;
+    if (!bench.list)
+    {
+        cord_bench_warn_unoptimized();
+        veth = cord_bench_veth_setup();
+        cord_bench_header();
+    }
+
+    for (uint32_t backend = 0; backend < CORD_BENCH_BACKEND_COUNT; backend++)
+    {
+#ifndef ENABLE_XDP_DATAPLANE
+        if (backend == CORD_BENCH_XDP)
+            continue;
+#endif
+        if (!bench.list && !veth && backend != CORD_BENCH_L4_UDP)
+            continue;
+
+        cord_bench_backend(backend);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,121 @@
+//
+// cord_xdp_steer - default CORD-FLOW XDP program
+//
+// Redirects the flows listed in cord_steer_map to the AF_XDP socket of the receive
+// queue (xsks_map, filled by the XDP flow points) and passes everything else to the
+// kernel stack, so only the traffic the application asked for leaves the kernel.
+//
+// Key: (IP protocol, L4 destination port); port 0 matches protocols without ports.
+//
+
+#include <linux/bpf.h>
+#include <linux/if_ether.h>
+#include <linux/ip.h>
+#include <linux/ipv6.h>
+#include <linux/in.h>
+#include <linux/udp.h>
+#include <linux/tcp.h>
+#include <bpf/bpf_helpers.h>
+#include <bpf/bpf_endian.h>
+
+#define CORD_XDP_MAX_QUEUES     64
+#define CORD_XDP_STEER_ENTRIES  1024
+
+struct cord_xdp_steer_key
+{
+    __u8 ip_proto;
+    __u8 pad;
+    __be16 dst_port;
+};
+
+struct
+{
+    __uint(type, BPF_MAP_TYPE_XSKMAP);
+    __uint(max_entries, CORD_XDP_MAX_QUEUES);
+    __type(key, __u32);
+    __type(value, __u32);
+} xsks_map SEC(".maps");
+
+struct
+{
+    __uint(type, BPF_MAP_TYPE_HASH);
+    __uint(max_entries, CORD_XDP_STEER_ENTRIES);
+    __type(key, struct cord_xdp_steer_key);
+    __type(value, __u8);
+} cord_steer_map SEC(".maps");
+
+static __always_inline int cord_parse_l4_port(void *l4, void *data_end, __u8 ip_proto, __be16 *dst_port)
+{
+    if (ip_proto == IPPROTO_UDP)
+    {
+        struct udphdr *udp = l4;
+        if ((void *)(udp + 1) > data_end)
+            return -1;
+        *dst_port = udp->dest;
+    }
+    else if (ip_proto == IPPROTO_TCP)
+    {
+        struct tcphdr *tcp = l4;
+        if ((void *)(tcp + 1) > data_end)
+            return -1;
+        *dst_port = tcp->dest;
+    }
+    else
+    {
+        *dst_port = 0;
+    }
+
+    return 0;
+}
+
+SEC("xdp")
+int cord_xdp_steer(struct xdp_md *ctx)
+{
+    void *data = (void *)(long)ctx->data;
+    void *data_end = (void *)(long)ctx->data_end;
+    struct cord_xdp_steer_key key = {};
+    struct ethhdr *eth = data;
+    void *l4;
+
+    if ((void *)(eth + 1) > data_end)
+        return XDP_PASS;
+
+    if (eth->h_proto == bpf_htons(ETH_P_IP))
+    {
+        struct iphdr *ip = (void *)(eth + 1);
+        if ((void *)(ip + 1) > data_end || ip->ihl < 5)
+            return XDP_PASS;
+
+        // Non-first fragments carry no L4 header
+        if (ip->frag_off & bpf_htons(0x1FFF))
+            return XDP_PASS;
+
+        key.ip_proto = ip->protocol;
+        l4 = (void *)ip + ip->ihl * 4;
+    }
+    else if (eth->h_proto == bpf_htons(ETH_P_IPV6))
+    {
+        struct ipv6hdr *ip6 = (void *)(eth + 1);
+        if ((void *)(ip6 + 1) > data_end)
+            return XDP_PASS;
+
+        // Extension headers are left to the kernel
+        key.ip_proto = ip6->nexthdr;
+        l4 = (void *)(ip6 + 1);
+    }
+    else
+    {
+        return XDP_PASS;
+    }
+
+    if (cord_parse_l4_port(l4, data_end, key.ip_proto, &key.dst_port) < 0)
+        return XDP_PASS;
+
+    if (!bpf_map_lookup_elem(&cord_steer_map, &key))
+        return XDP_PASS;
+
+    // No socket on this queue: fall back to the kernel
+    return bpf_redirect_map(&xsks_map, ctx->rx_queue_index, XDP_PASS);
+}
+
+char _license[] SEC("license") = "Dual MIT/GPL";
@@ -4,6 +4,8 @@
 #include <match/cord_match.h>
 #include <protocol_headers/cord_protocol_headers.h>
 #include <memory/cord_memory.h>
+#include <action/cord_checksum.h>
+#include <action/cord_crc.h>
 #include <cord_retval.h>
 
 //
@@ -60,6 +62,24 @@ bool cord_compare_ipv4_last_fragment(const cord_ipv4_hdr_t *ip);
 bool cord_compare_ipv4_last_fragment_ntohs(const cord_ipv4_hdr_t *ip);
 bool cord_compare_if_ipv4_checksum_valid(const cord_ipv4_hdr_t *ip_hdr);
 
+// L4 checksum validation
+// len: bytes available from the IP header on; a length field that underflows or runs past it fails the check
+bool cord_compare_if_tcp_checksum_valid_ipv4(const cord_ipv4_hdr_t *ip_hdr, uint32_t len);
+bool cord_compare_if_udp_checksum_valid_ipv4(const cord_ipv4_hdr_t *ip_hdr, uint32_t len);
+bool cord_compare_if_icmp_checksum_valid_ipv4(const cord_ipv4_hdr_t *ip_hdr, uint32_t len);
+bool cord_compare_if_tcp_checksum_valid_ipv6(const cord_ipv6_hdr_t *ip6_hdr, uint32_t len);
+bool cord_compare_if_udp_checksum_valid_ipv6(const cord_ipv6_hdr_t *ip6_hdr, uint32_t len);
+bool cord_compare_if_icmpv6_checksum_valid(const cord_ipv6_hdr_t *ip6_hdr, uint32_t len);
+bool cord_compare_if_sctp_checksum_valid_ipv4(const cord_ipv4_hdr_t *ip_hdr, uint32_t len);
+bool cord_compare_if_sctp_checksum_valid_ipv6(const cord_ipv6_hdr_t *ip6_hdr, uint32_t len);
+
+#ifdef ENABLE_DPDK_DATAPLANE
+// Offload-aware validation (NIC verdict from ol_flags, software fallback)
+bool cord_compare_if_ipv4_checksum_valid_offload(const struct rte_mbuf *mbuf, const cord_ipv4_hdr_t *ip_hdr);
+bool cord_compare_if_l4_checksum_valid_offload_ipv4(const struct rte_mbuf *mbuf, const cord_ipv4_hdr_t *ip_hdr);
+bool cord_compare_if_l4_checksum_valid_offload_ipv6(const struct rte_mbuf *mbuf, const cord_ipv6_hdr_t *ip6_hdr);
+#endif // ENABLE_DPDK_DATAPLANE
+
 // L3 IPv6 Match Functions
 bool cord_compare_ipv6_version(const cord_ipv6_hdr_t *ip6);
 bool cord_compare_ipv6_traffic_class(const cord_ipv6_hdr_t *ip6, uint8_t tc);
@@ -277,6 +297,46 @@ void cord_set_field_icmp_id_htons(cord_icmp_hdr_t *icmp, uint16_t id);
 void cord_set_field_icmp_sequence(cord_icmp_hdr_t *icmp, uint16_t sequence);
 void cord_set_field_icmp_sequence_htons(cord_icmp_hdr_t *icmp, uint16_t sequence);
 
+//
+// Set with incremental checksum update (RFC 1624)
+//
+// Patch the IPv4 header checksum and the TCP/UDP checksum from the old and new
+// field values; the payload is never read. Address setters also fix the L4
+// pseudo-header checksum (skipped for non-first fragments and zero UDP checksums).
+//
+
+// IPv4 Field Setters (checksum-aware)
+void cord_set_field_ipv4_tos_csum(cord_ipv4_hdr_t *ip, uint8_t tos);
+void cord_set_field_ipv4_dscp_csum(cord_ipv4_hdr_t *ip, uint8_t dscp);
+void cord_set_field_ipv4_ecn_csum(cord_ipv4_hdr_t *ip, uint8_t ecn);
+void cord_set_field_ipv4_id_csum(cord_ipv4_hdr_t *ip, uint16_t id);
+void cord_set_field_ipv4_id_csum_htons(cord_ipv4_hdr_t *ip, uint16_t id);
+void cord_set_field_ipv4_ttl_csum(cord_ipv4_hdr_t *ip, uint8_t ttl);
+void cord_set_field_ipv4_src_addr_csum(cord_ipv4_hdr_t *ip, uint32_t addr);
+void cord_set_field_ipv4_src_addr_csum_htonl(cord_ipv4_hdr_t *ip, uint32_t addr);
+void cord_set_field_ipv4_dst_addr_csum(cord_ipv4_hdr_t *ip, uint32_t addr);
+void cord_set_field_ipv4_dst_addr_csum_htonl(cord_ipv4_hdr_t *ip, uint32_t addr);
+
+// TCP Field Setters (checksum-aware)
+void cord_set_field_tcp_src_port_csum(cord_tcp_hdr_t *tcp, uint16_t port);
+void cord_set_field_tcp_src_port_csum_htons(cord_tcp_hdr_t *tcp, uint16_t port);
+void cord_set_field_tcp_dst_port_csum(cord_tcp_hdr_t *tcp, uint16_t port);
+void cord_set_field_tcp_dst_port_csum_htons(cord_tcp_hdr_t *tcp, uint16_t port);
+void cord_set_field_tcp_seq_num_csum(cord_tcp_hdr_t *tcp, uint32_t seq);
+void cord_set_field_tcp_seq_num_csum_htonl(cord_tcp_hdr_t *tcp, uint32_t seq);
+void cord_set_field_tcp_ack_num_csum(cord_tcp_hdr_t *tcp, uint32_t ack);
+void cord_set_field_tcp_ack_num_csum_htonl(cord_tcp_hdr_t *tcp, uint32_t ack);
+
+// UDP Field Setters (checksum-aware)
+void cord_set_field_udp_src_port_csum(cord_udp_hdr_t *udp, uint16_t port);
+void cord_set_field_udp_src_port_csum_htons(cord_udp_hdr_t *udp, uint16_t port);
+void cord_set_field_udp_dst_port_csum(cord_udp_hdr_t *udp, uint16_t port);
+void cord_set_field_udp_dst_port_csum_htons(cord_udp_hdr_t *udp, uint16_t port);
+
+// ICMP Field Setters (checksum-aware)
+void cord_set_field_icmp_id_csum(cord_icmp_hdr_t *icmp, uint16_t id);
+void cord_set_field_icmp_id_csum_htons(cord_icmp_hdr_t *icmp, uint16_t id);
+
 //
 // Calculate
 //
@@ -299,6 +359,34 @@ uint16_t cord_calculate_udp_checksum_ipv4(const cord_ipv4_hdr_t *ip_hdr);
 // ICMP checksum calculation for IPv4
 uint16_t cord_calculate_icmp_checksum_ipv4(const cord_ipv4_hdr_t *ip_hdr);
 
+// TCP checksum calculation for IPv6 (no extension headers)
+uint16_t cord_calculate_tcp_checksum_ipv6(const cord_ipv6_hdr_t *ip6_hdr);
+
+// UDP checksum calculation for IPv6 (no extension headers)
+uint16_t cord_calculate_udp_checksum_ipv6(const cord_ipv6_hdr_t *ip6_hdr);
+
+// ICMPv6 checksum calculation (no extension headers)
+uint16_t cord_calculate_icmpv6_checksum(const cord_ipv6_hdr_t *ip6_hdr);
+
+// SCTP CRC32C checksum (RFC 4960). Unlike the other cord_calculate_* functions the value is
+// returned in wire order (CRC least significant byte first): store it with
+// cord_set_field_sctp_checksum() (not _htonl) and compare it with the raw header field.
+// Returns 0 if the length is shorter than the SCTP common header.
+uint32_t cord_calculate_sctp_checksum(const cord_sctp_hdr_t *sctp_hdr, size_t sctp_len);
+uint32_t cord_calculate_sctp_checksum_ipv4(const cord_ipv4_hdr_t *ip_hdr);
+uint32_t cord_calculate_sctp_checksum_ipv6(const cord_ipv6_hdr_t *ip6_hdr);
+
+#ifdef ENABLE_DPDK_DATAPLANE
+#include <rte_ip.h>
+#include <rte_ethdev.h>
+
+// Offload-aware checksum preparation: checksums whose RTE_ETH_TX_OFFLOAD_* bit is set
+// in tx_offloads are left to the NIC (ol_flags, l2_len/l3_len, pseudo-header seed),
+// the others are computed in software
+void cord_checksum_offload_ipv4(struct rte_mbuf *mbuf, cord_ipv4_hdr_t *ip_hdr, uint16_t l2_len, uint64_t tx_offloads);
+void cord_checksum_offload_ipv6(struct rte_mbuf *mbuf, cord_ipv6_hdr_t *ip6_hdr, uint16_t l2_len, uint64_t tx_offloads);
+#endif // ENABLE_DPDK_DATAPLANE
+
 //
 // Log
 //
@@ -439,6 +527,20 @@ cord_retval_t cord_pop_cvlan(cord_raw_pkt_desc_t *pkt);
 cord_retval_t cord_push_svlan(cord_raw_pkt_desc_t *pkt, uint16_t vlan_id, uint8_t pcp, uint8_t dei);
 cord_retval_t cord_pop_svlan(cord_raw_pkt_desc_t *pkt);
 
+//
+// In-place VLAN rewrite (outer tag VID/PCP, no header move)
+//
+cord_retval_t cord_rewrite_vlan(cord_raw_pkt_desc_t *pkt, uint16_t vlan_id, uint8_t pcp);
+
+//
+// Burst VLAN operations (return the number of packets modified)
+//
+uint32_t cord_push_vlan_burst(cord_raw_pkt_desc_t **pkts, uint32_t count, uint16_t vlan_id, uint8_t pcp, uint8_t dei, uint16_t ethertype);
+uint32_t cord_pop_vlan_burst(cord_raw_pkt_desc_t **pkts, uint32_t count);
+uint32_t cord_rewrite_vlan_burst(cord_raw_pkt_desc_t **pkts, uint32_t count, uint16_t vlan_id, uint8_t pcp);
+// VLAN translation: rewrite the outer tag in place, push one on untagged packets
+uint32_t cord_set_vlan_burst(cord_raw_pkt_desc_t **pkts, uint32_t count, uint16_t vlan_id, uint8_t pcp, uint8_t dei, uint16_t ethertype);
+
 #endif // Default dataplane
 
 #ifdef ENABLE_DPDK_DATAPLANE
@@ -461,6 +563,20 @@ cord_retval_t cord_pop_cvlan(struct rte_mbuf *mbuf);
 cord_retval_t cord_push_svlan(struct rte_mbuf *mbuf, uint16_t vlan_id, uint8_t pcp, uint8_t dei);
 cord_retval_t cord_pop_svlan(struct rte_mbuf *mbuf);
 
+//
+// In-place VLAN rewrite (outer tag VID/PCP, no header move)
+//
+cord_retval_t cord_rewrite_vlan(struct rte_mbuf *mbuf, uint16_t vlan_id, uint8_t pcp);
+
+//
+// Burst VLAN operations (return the number of packets modified)
+//
+uint32_t cord_push_vlan_burst(struct rte_mbuf **mbufs, uint32_t count, uint16_t vlan_id, uint8_t pcp, uint8_t dei, uint16_t ethertype);
+uint32_t cord_pop_vlan_burst(struct rte_mbuf **mbufs, uint32_t count);
+uint32_t cord_rewrite_vlan_burst(struct rte_mbuf **mbufs, uint32_t count, uint16_t vlan_id, uint8_t pcp);
+// VLAN translation: rewrite the outer tag in place, push one on untagged packets
+uint32_t cord_set_vlan_burst(struct rte_mbuf **mbufs, uint32_t count, uint16_t vlan_id, uint8_t pcp, uint8_t dei, uint16_t ethertype);
+
 #endif // ENABLE_DPDK_DATAPLANE
 
 #ifdef ENABLE_XDP_DATAPLANE
@@ -483,6 +599,20 @@ cord_retval_t cord_pop_cvlan(struct cord_xdp_pkt_desc *pkt);
 cord_retval_t cord_push_svlan(struct cord_xdp_pkt_desc *pkt, uint16_t vlan_id, uint8_t pcp, uint8_t dei);
 cord_retval_t cord_pop_svlan(struct cord_xdp_pkt_desc *pkt);
 
+//
+// In-place VLAN rewrite (outer tag VID/PCP, no header move)
+//
+cord_retval_t cord_rewrite_vlan(struct cord_xdp_pkt_desc *pkt, uint16_t vlan_id, uint8_t pcp);
+
+//
+// Burst VLAN operations (return the number of packets modified)
+//
+uint32_t cord_push_vlan_burst(struct cord_xdp_pkt_desc **pkts, uint32_t count, uint16_t vlan_id, uint8_t pcp, uint8_t dei, uint16_t ethertype);
+uint32_t cord_pop_vlan_burst(struct cord_xdp_pkt_desc **pkts, uint32_t count);
+uint32_t cord_rewrite_vlan_burst(struct cord_xdp_pkt_desc **pkts, uint32_t count, uint16_t vlan_id, uint8_t pcp);
+// VLAN translation: rewrite the outer tag in place, push one on untagged packets
+uint32_t cord_set_vlan_burst(struct cord_xdp_pkt_desc **pkts, uint32_t count, uint16_t vlan_id, uint8_t pcp, uint8_t dei, uint16_t ethertype);
+
 #endif // ENABLE_XDP_DATAPLANE
 
 #endif // CORD_ACTION_H
\ No newline at end of file
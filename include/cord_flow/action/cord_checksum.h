@@ -0,0 +1,87 @@
+#ifndef CORD_CHECKSUM_H
+#define CORD_CHECKSUM_H
+
+#include <cord_type.h>
+#include <protocol_headers/cord_protocol_headers.h>
+
+//
+// CORD Checksum - Internet checksum primitives
+//
+// References:
+// - RFC 1071: Computing the Internet Checksum
+// - RFC 1624: Computation of the Internet Checksum via Incremental Update
+//
+// The one's complement sum is byte-order independent: values and checksums
+// are passed exactly as stored in the packet (network byte order).
+//
+
+//
+// Buffer checksum kernels
+//
+// cord_csum_partial() accumulates the buffer 64 bits at a time (AVX2 selected at
+// runtime on x86-64, NEON on ARM) and returns the partial sum folded to 16 bits,
+// so that results can be chained and pseudo-header sums added without overflow.
+//
+
+uint32_t cord_csum_partial(const void *buf, size_t len, uint32_t sum);
+
+// Complete checksum of a buffer, ready to be stored (network byte order)
+uint16_t cord_csum(const void *buf, size_t len);
+
+// Pseudo-header partial sums (addresses in network byte order, length in host byte order)
+uint32_t cord_csum_pseudo_ipv4(uint32_t saddr, uint32_t daddr, uint8_t proto, uint16_t len);
+uint32_t cord_csum_pseudo_ipv6(const cord_ipv6_addr_t *saddr, const cord_ipv6_addr_t *daddr,
+                               uint8_t next_hdr, uint32_t len);
+
+//
+// Incremental update primitives
+//
+
+// Fold a 32-bit partial sum into 16 bits
+static inline uint16_t cord_csum_fold(uint32_t sum)
+{
+    sum = (sum & 0xFFFF) + (sum >> 16);
+    sum = (sum & 0xFFFF) + (sum >> 16);
+    return (uint16_t)sum;
+}
+
+// RFC 1624 eqn. 3: HC' = ~(~HC + ~m + m') for a 16-bit field change
+static inline uint16_t cord_csum_replace16(uint16_t check, uint16_t old_val, uint16_t new_val)
+{
+    uint32_t sum = (uint16_t)~check + (uint16_t)~old_val + (uint32_t)new_val;
+    return (uint16_t)~cord_csum_fold(sum);
+}
+
+// RFC 1624 eqn. 3 for a 32-bit field change (e.g. an IPv4 address)
+static inline uint16_t cord_csum_replace32(uint16_t check, uint32_t old_val, uint32_t new_val)
+{
+    uint32_t sum = (uint16_t)~check;
+    sum += (uint16_t)~(old_val >> 16) + (uint16_t)~(old_val & 0xFFFF);
+    sum += (new_val >> 16) + (new_val & 0xFFFF);
+    return (uint16_t)~cord_csum_fold(sum);
+}
+
+// UDP over IPv4: a zero checksum means "none", a computed zero is sent as 0xFFFF (RFC 768)
+static inline uint16_t cord_csum_replace16_udp(uint16_t check, uint16_t old_val, uint16_t new_val)
+{
+    if (check == 0)
+    {
+        return 0;
+    }
+
+    check = cord_csum_replace16(check, old_val, new_val);
+    return check ? check : 0xFFFF;
+}
+
+static inline uint16_t cord_csum_replace32_udp(uint16_t check, uint32_t old_val, uint32_t new_val)
+{
+    if (check == 0)
+    {
+        return 0;
+    }
+
+    check = cord_csum_replace32(check, old_val, new_val);
+    return check ? check : 0xFFFF;
+}
+
+#endif // CORD_CHECKSUM_H
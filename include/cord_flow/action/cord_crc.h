@@ -0,0 +1,43 @@
+#ifndef CORD_CRC_H
+#define CORD_CRC_H
+
+#include <cord_type.h>
+
+//
+// CORD CRC - CRC32 (IEEE 802.3) and CRC32C (Castagnoli)
+//
+// References:
+// - IEEE 802.3 Clause 3.2.9: Frame Check Sequence
+// - RFC 3309 / RFC 4960 Appendix B: SCTP CRC32C checksum
+// - V. Gopal et al., "Fast CRC Computation for Generic Polynomials Using
+//   PCLMULQDQ Instruction", Intel, 2009
+//
+// Implementations, selected at load time:
+// - CRC32:  PCLMULQDQ folding (x86-64), ARMv8 CRC32 instructions, slicing-by-8
+// - CRC32C: SSE4.2 CRC32 instruction (x86-64), ARMv8 CRC32C instructions, slicing-by-8
+//
+// Both use the reflected polynomial with ~0 initial value and final XOR.
+// The _update variants take and return the running (un-inverted) register,
+// so a buffer can be processed in pieces: start from CORD_CRC_INIT and
+// invert the final value.
+//
+
+#define CORD_CRC_INIT               0xFFFFFFFF
+#define CORD_CRC32_POLY             0xEDB88320  // 0x04C11DB7 reflected
+#define CORD_CRC32C_POLY            0x82F63B78  // 0x1EDC6F41 reflected
+
+uint32_t cord_crc32_update(uint32_t crc, const void *buf, size_t len);
+uint32_t cord_crc32c_update(uint32_t crc, const void *buf, size_t len);
+
+// Complete CRC of a buffer
+static inline uint32_t cord_crc32(const void *buf, size_t len)
+{
+    return ~cord_crc32_update(CORD_CRC_INIT, buf, len);
+}
+
+static inline uint32_t cord_crc32c(const void *buf, size_t len)
+{
+    return ~cord_crc32c_update(CORD_CRC_INIT, buf, len);
+}
+
+#endif // CORD_CRC_H
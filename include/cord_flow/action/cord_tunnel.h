@@ -0,0 +1,116 @@
+#ifndef CORD_TUNNEL_H
+#define CORD_TUNNEL_H
+
+#include <cord_type.h>
+#include <cord_retval.h>
+#include <protocol_headers/cord_protocol_headers.h>
+#include <memory/cord_memory.h>
+
+//
+// CORD Tunnel - Encapsulation / Decapsulation Actions
+//
+// References:
+// - RFC 7348: VXLAN
+// - RFC 8926: GENEVE
+// - RFC 2784 / RFC 2890: GRE and GRE key/sequence extensions
+// - 3GPP TS 29.281: GTP-U
+// - RFC 3032: MPLS label stack encoding
+//
+// Encapsulation copies a per-tunnel outer header template in one shot into the
+// packet headroom (prepend model, as cord_raw_pkt_prepend()), then patches the
+// length fields. The outer IPv4 checksum is precomputed with a zero total length
+// and fixed up incrementally (RFC 1624); outer UDP checksums are zero (RFC 7348,
+// RFC 6935 for IPv6).
+//
+// Payload carried by each tunnel type:
+// - VXLAN, GENEVE (TEB), GRE (TEB): the inner Ethernet frame
+// - GRE (IPv4/IPv6), GTP-U, MPLS:   the inner IP packet, inner Ethernet header and VLAN
+//                                    tags removed; encap rejects (CORD_ERR_INVALID_PARAM)
+//                                    frames of another EtherType (GRE: the template protocol)
+//
+// Decapsulation strips everything up to the inner payload; for L3 payloads the
+// outer Ethernet addresses are kept (outer VLAN tags are dropped) and the EtherType
+// is set to the inner protocol.
+//
+
+#define CORD_TUNNEL_MAX_HDR_LEN     128
+#define CORD_TUNNEL_MAX_MPLS_LABELS 8
+
+#define CORD_VXLAN_PORT             4789
+#define CORD_GENEVE_PORT            6081
+#define CORD_GTPU_PORT              2152
+#define CORD_ETH_P_TEB              0x6558  // Transparent Ethernet Bridging
+
+typedef enum
+{
+    CORD_TUNNEL_VXLAN = 0,
+    CORD_TUNNEL_GENEVE,
+    CORD_TUNNEL_GRE,
+    CORD_TUNNEL_GTPU,
+    CORD_TUNNEL_MPLS
+} cord_tunnel_type_t;
+
+// Outer endpoint description (addresses in network byte order, ports in host byte order)
+typedef struct
+{
+    cord_mac_addr_t eth_src;
+    cord_mac_addr_t eth_dst;
+    bool ipv6;                            // Outer IPv6 instead of IPv4
+    uint32_t ipv4_src;
+    uint32_t ipv4_dst;
+    cord_ipv6_addr_t ipv6_src;
+    cord_ipv6_addr_t ipv6_dst;
+    uint8_t ttl;                          // TTL / hop limit (0 = 64)
+    uint8_t tos;                          // TOS / traffic class
+    uint16_t udp_src_port;                // UDP tunnels (0 = 49152)
+    uint16_t udp_dst_port;                // UDP tunnels (0 = IANA port of the tunnel type)
+} cord_tunnel_endpoint_t;
+
+// Precomputed outer headers of one tunnel
+typedef struct
+{
+    uint8_t hdr[CORD_TUNNEL_MAX_HDR_LEN] __attribute__((aligned(CORD_CACHE_LINE_SIZE)));
+    cord_tunnel_type_t type;
+    uint16_t hdr_len;                     // Bytes prepended by encap
+    uint16_t l3_offset;                   // Outer IP header (0 for MPLS)
+    uint16_t l4_offset;                   // Outer UDP header (0 if none)
+    uint16_t tun_offset;                  // Tunnel header (GTP-U length fixup)
+    uint16_t ip_check;                    // Outer IPv4 checksum for tot_len == 0
+    bool ipv6;                            // Outer IPv6
+    bool inner_l2;                        // Payload is the full inner Ethernet frame
+} cord_tunnel_tmpl_t;
+
+// Template builders
+cord_retval_t cord_tunnel_tmpl_vxlan(cord_tunnel_tmpl_t *tmpl, const cord_tunnel_endpoint_t *ep, uint32_t vni);
+cord_retval_t cord_tunnel_tmpl_geneve(cord_tunnel_tmpl_t *tmpl, const cord_tunnel_endpoint_t *ep, uint32_t vni);
+cord_retval_t cord_tunnel_tmpl_gre(cord_tunnel_tmpl_t *tmpl, const cord_tunnel_endpoint_t *ep, uint16_t protocol, bool use_key, uint32_t key);
+cord_retval_t cord_tunnel_tmpl_gtpu(cord_tunnel_tmpl_t *tmpl, const cord_tunnel_endpoint_t *ep, uint32_t teid);
+cord_retval_t cord_tunnel_tmpl_mpls(cord_tunnel_tmpl_t *tmpl, const cord_tunnel_endpoint_t *ep,
+                                    const uint32_t *labels, uint8_t num_labels, uint8_t ttl);
+
+// Decap only strips UDP tunnels sent to udp_dst_port (host byte order, 0 = IANA port of the type);
+// GRE and MPLS ignore it
+
+// Default dataplane (L2 raw socket)
+#if !defined(ENABLE_DPDK_DATAPLANE) && !defined(ENABLE_XDP_DATAPLANE)
+cord_retval_t cord_tunnel_encap(cord_raw_pkt_desc_t *pkt, const cord_tunnel_tmpl_t *tmpl);
+cord_retval_t cord_tunnel_decap(cord_raw_pkt_desc_t *pkt, cord_tunnel_type_t type, uint16_t udp_dst_port);
+uint32_t cord_tunnel_encap_burst(cord_raw_pkt_desc_t **pkts, uint32_t count, const cord_tunnel_tmpl_t *tmpl);
+uint32_t cord_tunnel_decap_burst(cord_raw_pkt_desc_t **pkts, uint32_t count, cord_tunnel_type_t type, uint16_t udp_dst_port);
+#endif // Default dataplane
+
+#ifdef ENABLE_DPDK_DATAPLANE
+cord_retval_t cord_tunnel_encap(struct rte_mbuf *mbuf, const cord_tunnel_tmpl_t *tmpl);
+cord_retval_t cord_tunnel_decap(struct rte_mbuf *mbuf, cord_tunnel_type_t type, uint16_t udp_dst_port);
+uint32_t cord_tunnel_encap_burst(struct rte_mbuf **mbufs, uint32_t count, const cord_tunnel_tmpl_t *tmpl);
+uint32_t cord_tunnel_decap_burst(struct rte_mbuf **mbufs, uint32_t count, cord_tunnel_type_t type, uint16_t udp_dst_port);
+#endif // ENABLE_DPDK_DATAPLANE
+
+#ifdef ENABLE_XDP_DATAPLANE
+cord_retval_t cord_tunnel_encap(struct cord_xdp_pkt_desc *pkt, const cord_tunnel_tmpl_t *tmpl);
+cord_retval_t cord_tunnel_decap(struct cord_xdp_pkt_desc *pkt, cord_tunnel_type_t type, uint16_t udp_dst_port);
+uint32_t cord_tunnel_encap_burst(struct cord_xdp_pkt_desc **pkts, uint32_t count, const cord_tunnel_tmpl_t *tmpl);
+uint32_t cord_tunnel_decap_burst(struct cord_xdp_pkt_desc **pkts, uint32_t count, cord_tunnel_type_t type, uint16_t udp_dst_port);
+#endif // ENABLE_XDP_DATAPLANE
+
+#endif // CORD_TUNNEL_H
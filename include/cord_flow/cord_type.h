@@ -131,7 +131,8 @@ typedef enum
 {
     CUSTOM_FILTER,  // Custom
     CBPF_FILTER,    // Classic  BPF (LSF)
-    EBPF_FILTER     // Extended BPF (LSF)
+    EBPF_FILTER,    // Extended BPF (LSF)
+    XDP_FILTER      // XDP program (libxdp), cord_xdp_prog_cfg_t
 } cord_filter_type_t ; 
 
 #endif // CORD_TYPE_H
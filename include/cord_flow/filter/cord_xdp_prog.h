@@ -0,0 +1,77 @@
+#ifndef CORD_XDP_PROG_H
+#define CORD_XDP_PROG_H
+
+#ifdef ENABLE_XDP_DATAPLANE
+
+#include <cord_type.h>
+#include <cord_retval.h>
+#include <memory/cord_memory.h>
+
+#include <xdp/libxdp.h>
+
+//
+// CORD XDP program - load / attach an XDP program with libxdp and steer to AF_XDP sockets
+//
+// - SEC("xdp") programs are attached to the interface through the libxdp dispatcher
+//   (native mode first, generic/SKB mode as a fallback)
+// - If the object has an XSKMAP (xsks_map_name), the sockets of the flow point are
+//   inserted at their queue index, so the program can bpf_redirect_map() to them
+// - The default program (bpf/cord_xdp_steer.bpf.c) redirects only the flows listed in
+//   its steering map and passes everything else to the kernel stack
+//
+
+#ifndef CORD_XDP_DEFAULT_PROG_PATH
+#define CORD_XDP_DEFAULT_PROG_PATH      "/usr/local/share/cord_flow/bpf/cord_xdp_steer.bpf.o"
+#endif
+
+#define CORD_XDP_DEFAULT_PROG_NAME      "cord_xdp_steer"
+#define CORD_XDP_DEFAULT_XSKS_MAP       "xsks_map"
+#define CORD_XDP_DEFAULT_STEER_MAP      "cord_steer_map"
+#define CORD_XDP_XSK_DEFAULT_PROG_NAME  "xsk_def_prog"  // libxdp's program for xsk_socket__create()
+
+// Passed as the filter argument of attach_xBPF() together with XDP_FILTER
+typedef struct
+{
+    const char *obj_path;                 // BPF object file (NULL = CORD_XDP_DEFAULT_PROG_PATH)
+    const char *prog_name;                // Program in the object (NULL = CORD_XDP_DEFAULT_PROG_NAME when obj_path is NULL, else the first one)
+    const char *xsks_map_name;            // XSKMAP to populate (NULL = CORD_XDP_DEFAULT_XSKS_MAP, absent = plain interface program)
+    enum xdp_attach_mode mode;            // XDP_MODE_UNSPEC = native, falling back to SKB
+} cord_xdp_prog_cfg_t;
+
+// Steering map key of the default program (must match bpf/cord_xdp_steer.bpf.c)
+typedef struct
+{
+    uint8_t ip_proto;                     // IPPROTO_UDP, IPPROTO_TCP, ...
+    uint8_t pad;
+    uint16_t dst_port;                    // Network byte order, 0 for protocols without ports
+} cord_xdp_steer_key_t;
+
+typedef struct
+{
+    struct xdp_program *prog;
+    int ifindex;
+    enum xdp_attach_mode mode;            // Mode actually attached in
+    int xsks_map_fd;                      // -1 if the program has no XSKMAP
+} cord_xdp_prog_t;
+
+// Opens and attaches the program on ifindex; returns NULL on failure
+cord_xdp_prog_t *cord_xdp_prog_attach(int ifindex, const cord_xdp_prog_cfg_t *cfg);
+
+// Detaches the program from the interface and frees it
+void cord_xdp_prog_detach(cord_xdp_prog_t *xdp_prog);
+
+// Inserts the socket into the XSKMAP at its queue index
+cord_retval_t cord_xdp_prog_register_socket(cord_xdp_prog_t *xdp_prog, struct cord_xdp_socket_info *xsk_info);
+
+// Detaches the default XSK redirect program libxdp loads with a socket, if it is on the
+// interface; any other program, ours or not, stays attached. Sockets created with
+// inhibit_prog_load set never load it.
+void cord_xdp_prog_remove_xsk_default(int ifindex);
+
+// Default program: steer (ip_proto, dst_port) to the sockets (dst_port in host byte order)
+cord_retval_t cord_xdp_prog_steer_add(cord_xdp_prog_t *xdp_prog, uint8_t ip_proto, uint16_t dst_port);
+cord_retval_t cord_xdp_prog_steer_del(cord_xdp_prog_t *xdp_prog, uint8_t ip_proto, uint16_t dst_port);
+
+#endif // ENABLE_XDP_DATAPLANE
+
+#endif // CORD_XDP_PROG_H
@@ -7,26 +7,94 @@
 
 #include <rte_ethdev.h>
 #include <rte_mempool.h>
+#include <rte_flow.h>
 
 #define CORD_CREATE_DPDK_FLOW_POINT CORD_CREATE_DPDK_FLOW_POINT_ON_HEAP
 #define CORD_DESTROY_DPDK_FLOW_POINT CORD_DESTROY_DPDK_FLOW_POINT_ON_HEAP
 
 #define CORD_CREATE_DPDK_FLOW_POINT_ON_HEAP(id, port_id, queue_count, queue_size, mbuf_pool) \
-    (CordFlowPoint *) NEW_ON_HEAP(CordDpdkFlowPoint, id, port_id, queue_count, queue_size, mbuf_pool)
+    (CordFlowPoint *) NEW_ON_HEAP(CordDpdkFlowPoint, id, port_id, queue_count, queue_size, mbuf_pool, NULL)
 
 #define CORD_CREATE_DPDK_FLOW_POINT_ON_STACK(id, port_id, queue_count, queue_size, mbuf_pool) \
-    (CordFlowPoint *) &NEW_ON_STACK(CordDpdkFlowPoint, id, port_id, queue_count, queue_size, mbuf_pool)
+    (CordFlowPoint *) &NEW_ON_STACK(CordDpdkFlowPoint, id, port_id, queue_count, queue_size, mbuf_pool, NULL)
+
+#define CORD_CREATE_DPDK_FLOW_POINT_CONF_ON_HEAP(id, port_id, queue_count, queue_size, mbuf_pool, port_cfg) \
+    (CordFlowPoint *) NEW_ON_HEAP(CordDpdkFlowPoint, id, port_id, queue_count, queue_size, mbuf_pool, port_cfg)
+
+#define CORD_CREATE_DPDK_FLOW_POINT_CONF_ON_STACK(id, port_id, queue_count, queue_size, mbuf_pool, port_cfg) \
+    (CordFlowPoint *) &NEW_ON_STACK(CordDpdkFlowPoint, id, port_id, queue_count, queue_size, mbuf_pool, port_cfg)
 
 #define CORD_DESTROY_DPDK_FLOW_POINT_ON_HEAP(name) \
     do {                                           \
         DESTROY_ON_HEAP(CordDpdkFlowPoint, name);  \
     } while(0)
 
-#define CORD_DESTROY_DPDK_FLOW_POINT_ON_STACK(name) \
-    do {                                            \
-        DESTROY_ON_STACK(CordDpdkFlowPoint, name);  \
+#define CORD_DESTROY_DPDK_FLOW_POINT_ON_STACK(name)                \
+    do {                                                           \
+        CORD_FLOW_POINT_DESTROY_ON_STACK(CordDpdkFlowPoint, name); \
     } while(0)
 
+//
+// Port configuration
+//
+// - RSS over rss_hf (masked by what the device supports); rss_symmetric uses a
+//   0x6d5a-repeated Toeplitz key, so both directions of a flow hash to the same queue
+// - rx_offloads / tx_offloads take RTE_ETH_RX_OFFLOAD_* / RTE_ETH_TX_OFFLOAD_* flags
+//   (checksum, VLAN strip / insert, TSO, ...); unsupported ones are dropped with a log
+// - A NULL configuration keeps the plain port setup, plus symmetric IP/TCP/UDP RSS
+//   when queue_count > 1
+//
+
+#define CORD_DPDK_RSS_HF_DEFAULT    (RTE_ETH_RSS_IP | RTE_ETH_RSS_TCP | RTE_ETH_RSS_UDP)
+#define CORD_DPDK_RSS_KEY_MAX_LEN   64
+
+typedef struct
+{
+    uint64_t rss_hf;                      // RTE_ETH_RSS_* hash fields (0 = no RSS)
+    bool rss_symmetric;                   // Symmetric Toeplitz key
+    const uint8_t *rss_key;               // Custom key (overrides rss_symmetric), NULL = device default
+    uint8_t rss_key_len;
+    uint64_t rx_offloads;                 // RTE_ETH_RX_OFFLOAD_* flags
+    uint64_t tx_offloads;                 // RTE_ETH_TX_OFFLOAD_* flags (MBUF_FAST_FREE is added when supported)
+    bool promiscuous;
+} cord_dpdk_port_conf_t;
+
+// rte_flow match for CordDpdkFlowPoint_flow_to_queue(); zero fields are wildcards
+typedef struct
+{
+    uint8_t ip_version;                   // 4 or 6
+    uint8_t ip_proto;                     // IPPROTO_UDP / IPPROTO_TCP (0 = any)
+    uint8_t src_ip[16];                   // Network byte order (first 4 bytes for IPv4)
+    uint8_t dst_ip[16];
+    uint8_t src_prefix;                   // Prefix lengths (0 = any address)
+    uint8_t dst_prefix;
+    uint16_t src_port;                    // Host byte order (0 = any port)
+    uint16_t dst_port;
+} cord_dpdk_flow_match_t;
+
+//
+// TX buffering (rte_eth_tx_buffer style)
+//
+// - Unbuffered (default): tx() sends the burst at once, retrying the unsent tail up to
+//   tx_max_retries times before freeing it and counting it as dropped
+// - Buffered (CordDpdkFlowPoint_set_tx_buffer): tx() queues the mbufs per TX queue and
+//   sends them when tx_threshold packets are waiting or the oldest has waited
+//   tx_timeout; idle loops call CordDpdkFlowPoint_tx_flush_expired() to honour the timeout
+// - tx() always takes ownership of the mbufs it is given
+//
+
+#define CORD_DPDK_TX_BUFFER_MAX         512
+#define CORD_DPDK_TX_TIMEOUT_US         100
+#define CORD_DPDK_TX_MAX_RETRIES        8
+
+typedef struct
+{
+    struct rte_mbuf *pkts[CORD_DPDK_TX_BUFFER_MAX];
+    uint16_t count;                       // Buffered packets
+    uint64_t deadline_tsc;                // Flush time of the oldest buffered packet
+    uint64_t tx_flushes;                  // Owner lcore only; packets / drops go to the flow point queue stats
+} __rte_cache_aligned cord_dpdk_tx_queue_t;
+
 typedef struct CordDpdkFlowPoint
 {
     CordFlowPoint base;
@@ -34,7 +102,14 @@ typedef struct CordDpdkFlowPoint
     uint16_t queue_count;
     uint16_t queue_size;
     struct rte_mempool **mbuf_pool;
-    struct rte_eth_stats stats;
+    struct rte_eth_stats stats;           // Device counters, refreshed by CordDpdkFlowPoint_update_hw_stats()
+    uint64_t rss_hf;                      // Hash fields actually enabled
+    uint64_t rx_offloads;                 // Offloads actually enabled
+    uint64_t tx_offloads;
+    cord_dpdk_tx_queue_t *tx_queues;      // One per queue
+    uint16_t tx_threshold;                // 0 = unbuffered
+    uint16_t tx_max_retries;
+    uint64_t tx_timeout_tsc;
     void *params;
 } CordDpdkFlowPoint;
 
@@ -43,7 +118,28 @@ void CordDpdkFlowPoint_ctor(CordDpdkFlowPoint * const self,
                             uint16_t port_id,
                             uint16_t queue_count,
                             uint16_t queue_size,
-                            struct rte_mempool **mbuf_pool);
+                            struct rte_mempool **mbuf_pool,
+                            const cord_dpdk_port_conf_t *port_cfg);
+
+// Pins the matching flows to queue_id with an rte_flow rule; returns NULL if the device refuses it
+struct rte_flow *CordDpdkFlowPoint_flow_to_queue(CordDpdkFlowPoint * const self,
+                                                 const cord_dpdk_flow_match_t *match,
+                                                 uint16_t queue_id);
+
+cord_retval_t CordDpdkFlowPoint_flow_destroy(CordDpdkFlowPoint * const self, struct rte_flow *flow);
+
+// threshold 0 = unbuffered; timeout_us / max_retries 0 = defaults
+cord_retval_t CordDpdkFlowPoint_set_tx_buffer(CordDpdkFlowPoint * const self, uint16_t threshold, uint32_t timeout_us, uint16_t max_retries);
+
+// Send everything buffered on the queue; returns the number of packets sent
+uint16_t CordDpdkFlowPoint_tx_flush(CordDpdkFlowPoint * const self, uint16_t queue_id);
+
+// Flush the queue only if its oldest packet has waited longer than the timeout
+uint16_t CordDpdkFlowPoint_tx_flush_expired(CordDpdkFlowPoint * const self, uint16_t queue_id);
+
+// Device counters (rte_eth_stats_get) into self->stats; the software counters are in base.queue_stats
+cord_retval_t CordDpdkFlowPoint_update_hw_stats(CordDpdkFlowPoint * const self);
+void CordDpdkFlowPoint_print_hw_stats(CordDpdkFlowPoint * const self);
 
 void CordDpdkFlowPoint_dtor(CordDpdkFlowPoint * const self);
 
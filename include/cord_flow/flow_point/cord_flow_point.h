@@ -7,6 +7,8 @@
 
 #include <cord_type.h>
 #include <cord_retval.h>
+#include <memory/cord_memory.h>
+#include <telemetry/cord_cycles.h>
 
 #define MAX_AUX_HANDLE_COUNT 5
 
@@ -24,13 +26,34 @@
         DESTROY_ON_HEAP(CordFlowPoint, name); \
     } while(0)
 
-#define CORD_DESTROY_FLOW_POINT_ON_STACK(name) \
-    do {                                       \
-        DESTROY_ON_STACK(CordFlowPoint, name); \
+// The object itself is not freed, but every flow point owns a heap statistics block
+#define CORD_FLOW_POINT_DESTROY_ON_STACK(Type, name)          \
+({                                                            \
+    if (name)                                                 \
+    {                                                         \
+        CordFlowPoint_release((CordFlowPoint *)(name));       \
+    }                                                         \
+    DESTROY_ON_STACK(Type, name);                             \
+})
+
+#define CORD_DESTROY_FLOW_POINT_ON_STACK(name)                 \
+    do {                                                       \
+        CORD_FLOW_POINT_DESTROY_ON_STACK(CordFlowPoint, name); \
     } while(0)
 
 typedef struct CordFlowPoint CordFlowPoint;
 
+//
+// rx() / tx() buffers
+//
+// What buffer holds depends on the flow point: socket flow points take one packet's bytes
+// (len in bytes, *rxed / *txed in bytes), the DPDK one an array of struct rte_mbuf pointers
+// and the AF_XDP one an array of struct cord_xdp_pkt_desc (the XDP burst actions take pointers
+// into it). Flow points exchanging cord_raw_pkt_desc_t packets (pcap, traffic generator, ring)
+// all take an array of cord_raw_pkt_desc_t pointers, the same form cord_pipeline_t and the
+// burst actions use: len is the array size and *rxed / *txed the number of packets.
+//
+
 typedef struct
 {
     cord_retval_t (*rx)(CordFlowPoint * const self, uint16_t queue_id, void *buffer, size_t len, ssize_t *rxed);
@@ -53,23 +76,157 @@ typedef struct
     uint32_t nb_filtered_packets;
 } CordFlowPointStats;
 
+//
+// Per-queue statistics
+//
+// One cache line aligned block per queue, written only by the core serving that
+// queue (plain increments, no atomics); readers aggregate them into a snapshot.
+// Queues from CORD_FLOW_POINT_MAX_QUEUES up share one overflow block, updated with
+// relaxed atomic adds, so they are counted in the totals without aliasing a lower queue.
+// Batch histograms bucket each rx/tx call by burst size: 0, 1, 2-3, 4-7, ... 64+.
+//
+
+#define CORD_FLOW_POINT_MAX_QUEUES          64
+#define CORD_FLOW_POINT_STATS_BLOCKS        (CORD_FLOW_POINT_MAX_QUEUES + 1)   // + overflow block
+#define CORD_FLOW_POINT_BATCH_BUCKETS       8
+
+typedef struct
+{
+    uint64_t rx_packets;
+    uint64_t rx_bytes;
+    uint64_t tx_packets;
+    uint64_t tx_bytes;
+    uint64_t rx_dropped;
+    uint64_t tx_dropped;
+    uint64_t rx_errors;
+    uint64_t tx_errors;
+    uint64_t ring_full;                   // TX ring / socket buffer full (retry needed)
+    uint64_t rx_batch_hist[CORD_FLOW_POINT_BATCH_BUCKETS];
+    uint64_t tx_batch_hist[CORD_FLOW_POINT_BATCH_BUCKETS];
+} __attribute__((aligned(CORD_CACHE_LINE_SIZE))) CordFlowPointQueueStats;
+
 struct CordFlowPoint
 {
     const CordFlowPointVtbl *vptr;
     uint8_t id;
     int io_handle;
     int aux_handles[MAX_AUX_HANDLE_COUNT];
+    CordFlowPointQueueStats *queue_stats;   // CORD_FLOW_POINT_STATS_BLOCKS blocks
+    bool queue_stats_shared;                // Borrowed from a parent flow point (not freed)
 };
 
 #define CORD_FLOW_POINT_RX_VCALL(self, queue_id, buffer, len, rxed)   (*(self->vptr->rx))((self), (queue_id), (buffer), (len), (rxed))
 #define CORD_FLOW_POINT_TX_VCALL(self, queue_id, buffer, len, txed)   (*(self->vptr->tx))((self), (queue_id), (buffer), (len), (txed))
 #define CORD_FLOW_POINT_ATTACH_FILTER_VCALL(self, filter, params)     (*(self->vptr->attach_xBPF))((self), (filter), (params))
 
+#ifdef CORD_FLOW_CYCLES
+// Timed calls: empty polls are not recorded, they would only measure the poll loop
+#define CORD_FLOW_POINT_RX_TIMED(self, queue_id, buffer, len, rxed)                           \
+    ({                                                                                        \
+        uint64_t _cyc_start = cord_cycles_now();                                              \
+        cord_retval_t _cyc_ret = CORD_FLOW_POINT_RX_VCALL(self, queue_id, buffer, len, rxed); \
+        if (*(rxed) > 0)                                                                      \
+            cord_cycles_record(CORD_CYCLES_STAGE_RX, cord_cycles_now() - _cyc_start);         \
+        _cyc_ret;                                                                             \
+    })
+
+#define CORD_FLOW_POINT_TX_TIMED(self, queue_id, buffer, len, txed)                           \
+    ({                                                                                        \
+        uint64_t _cyc_start = cord_cycles_now();                                              \
+        cord_retval_t _cyc_ret = CORD_FLOW_POINT_TX_VCALL(self, queue_id, buffer, len, txed); \
+        cord_cycles_record(CORD_CYCLES_STAGE_TX, cord_cycles_now() - _cyc_start);             \
+        _cyc_ret;                                                                             \
+    })
+
+#define CORD_FLOW_POINT_RX CORD_FLOW_POINT_RX_TIMED
+#define CORD_FLOW_POINT_TX CORD_FLOW_POINT_TX_TIMED
+#else
 #define CORD_FLOW_POINT_RX CORD_FLOW_POINT_RX_VCALL
 #define CORD_FLOW_POINT_TX CORD_FLOW_POINT_TX_VCALL
+#endif
 #define CORD_FLOW_POINT_ATTACH_FILTER CORD_FLOW_POINT_ATTACH_FILTER_VCALL
 
 void CordFlowPoint_ctor(CordFlowPoint * const self, uint8_t id);
 void CordFlowPoint_dtor(CordFlowPoint * const self);
 
+// Releases the base resources (statistics); called by the derived dtors before free(self)
+void CordFlowPoint_release(CordFlowPoint * const self);
+
+// Make self count into parent's queue blocks (e.g. the queues of a multi-queue flow point)
+void CordFlowPoint_share_stats(CordFlowPoint * const self, CordFlowPoint * const parent);
+
+// Aggregate snapshot over all queues
+void CordFlowPoint_get_queue_stats_total(const CordFlowPoint * const self, CordFlowPointQueueStats *total);
+void CordFlowPoint_get_stats(const CordFlowPoint * const self, CordFlowPointStats *stats);
+void CordFlowPoint_print_stats(const CordFlowPoint * const self);
+
+//
+// Hot path counters
+//
+
+static inline CordFlowPointQueueStats *CordFlowPoint_queue_stats(CordFlowPoint * const self, uint16_t queue_id)
+{
+    return &self->queue_stats[(queue_id < CORD_FLOW_POINT_MAX_QUEUES) ? queue_id : CORD_FLOW_POINT_MAX_QUEUES];
+}
+
+static inline uint32_t CordFlowPoint_batch_bucket(uint64_t burst)
+{
+    if (burst == 0)
+        return 0;
+
+    uint32_t bucket = 64 - __builtin_clzll(burst);
+    return (bucket < CORD_FLOW_POINT_BATCH_BUCKETS) ? bucket : CORD_FLOW_POINT_BATCH_BUCKETS - 1;
+}
+
+// Queues past CORD_FLOW_POINT_MAX_QUEUES share the overflow block from several cores:
+// only there the increments are atomic, the per-queue blocks keep plain ones
+static inline void CordFlowPoint_stat_add(uint64_t *counter, uint64_t value, uint16_t queue_id)
+{
+    if (cord_likely(queue_id < CORD_FLOW_POINT_MAX_QUEUES))
+        *counter += value;
+    else
+        __atomic_fetch_add(counter, value, __ATOMIC_RELAXED);
+}
+
+static inline void CordFlowPoint_count_rx(CordFlowPoint * const self, uint16_t queue_id, uint64_t packets, uint64_t bytes)
+{
+    CordFlowPointQueueStats *qs = CordFlowPoint_queue_stats(self, queue_id);
+    CordFlowPoint_stat_add(&qs->rx_packets, packets, queue_id);
+    CordFlowPoint_stat_add(&qs->rx_bytes, bytes, queue_id);
+    CordFlowPoint_stat_add(&qs->rx_batch_hist[CordFlowPoint_batch_bucket(packets)], 1, queue_id);
+}
+
+static inline void CordFlowPoint_count_tx(CordFlowPoint * const self, uint16_t queue_id, uint64_t packets, uint64_t bytes)
+{
+    CordFlowPointQueueStats *qs = CordFlowPoint_queue_stats(self, queue_id);
+    CordFlowPoint_stat_add(&qs->tx_packets, packets, queue_id);
+    CordFlowPoint_stat_add(&qs->tx_bytes, bytes, queue_id);
+    CordFlowPoint_stat_add(&qs->tx_batch_hist[CordFlowPoint_batch_bucket(packets)], 1, queue_id);
+}
+
+static inline void CordFlowPoint_count_rx_dropped(CordFlowPoint * const self, uint16_t queue_id, uint64_t packets)
+{
+    CordFlowPoint_stat_add(&CordFlowPoint_queue_stats(self, queue_id)->rx_dropped, packets, queue_id);
+}
+
+static inline void CordFlowPoint_count_tx_dropped(CordFlowPoint * const self, uint16_t queue_id, uint64_t packets)
+{
+    CordFlowPoint_stat_add(&CordFlowPoint_queue_stats(self, queue_id)->tx_dropped, packets, queue_id);
+}
+
+static inline void CordFlowPoint_count_rx_error(CordFlowPoint * const self, uint16_t queue_id)
+{
+    CordFlowPoint_stat_add(&CordFlowPoint_queue_stats(self, queue_id)->rx_errors, 1, queue_id);
+}
+
+static inline void CordFlowPoint_count_tx_error(CordFlowPoint * const self, uint16_t queue_id)
+{
+    CordFlowPoint_stat_add(&CordFlowPoint_queue_stats(self, queue_id)->tx_errors, 1, queue_id);
+}
+
+static inline void CordFlowPoint_count_ring_full(CordFlowPoint * const self, uint16_t queue_id)
+{
+    CordFlowPoint_stat_add(&CordFlowPoint_queue_stats(self, queue_id)->ring_full, 1, queue_id);
+}
+
 #endif // CORD_FLOW_POINT_H
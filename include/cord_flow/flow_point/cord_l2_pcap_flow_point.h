@@ -0,0 +1,105 @@
+#ifndef CORD_L2_PCAP_FLOW_POINT_H
+#define CORD_L2_PCAP_FLOW_POINT_H
+
+#include <flow_point/cord_flow_point.h>
+
+#define CORD_CREATE_L2_PCAP_FLOW_POINT CORD_CREATE_L2_PCAP_FLOW_POINT_ON_HEAP
+#define CORD_DESTROY_L2_PCAP_FLOW_POINT CORD_DESTROY_L2_PCAP_FLOW_POINT_ON_HEAP
+
+#define CORD_CREATE_L2_PCAP_FLOW_POINT_ON_HEAP(id, rx_path, tx_path) \
+    (CordFlowPoint *) NEW_ON_HEAP(CordL2PcapFlowPoint, id, rx_path, tx_path)
+
+#define CORD_CREATE_L2_PCAP_FLOW_POINT_ON_STACK(id, rx_path, tx_path) \
+    (CordFlowPoint *) &NEW_ON_STACK(CordL2PcapFlowPoint, id, rx_path, tx_path)
+
+#define CORD_DESTROY_L2_PCAP_FLOW_POINT_ON_HEAP(name) \
+    do {                                              \
+        DESTROY_ON_HEAP(CordL2PcapFlowPoint, name);   \
+    } while(0)
+
+#define CORD_DESTROY_L2_PCAP_FLOW_POINT_ON_STACK(name)               \
+    do {                                                             \
+        CORD_FLOW_POINT_DESTROY_ON_STACK(CordL2PcapFlowPoint, name); \
+    } while(0)
+
+//
+// File-backed flow point: pcap / pcapng replay (rx) and pcap capture (tx)
+//
+// rx() fills an array of cord_raw_pkt_desc_t pointers (len = array size, *rxed = packets).
+// The descriptors belong to the flow point (one per packet of the file, valid until the
+// packet comes round again in the next loop) and point straight into a private mapping
+// of the file; the record header in front of each packet serves as headroom (16 bytes for
+// pcap, 28 for a pcapng EPB). They are not pool packets: never cord_pkt_free() them.
+// In-place rewrites stay private to the process and every replay loop starts from the
+// file content again. Only Ethernet (LINKTYPE_ETHERNET) packets are replayed.
+//
+// tx() takes the same pointer array and appends the packets to a nanosecond pcap file,
+// time stamped with CLOCK_REALTIME; the caller keeps the packets.
+//
+// Either path may be NULL (replay only / capture only).
+//
+
+#define CORD_PCAP_MAX_IFACES            64          // pcapng interfaces per section
+#define CORD_PCAP_SNAPLEN               65535       // Longest packet a descriptor holds (data_len)
+#define CORD_PCAP_TX_BUFFER_SIZE        (1u << 20)
+
+typedef enum
+{
+    CORD_PCAP_REPLAY_MAX_SPEED = 0,     // Up to len packets per rx() call
+    CORD_PCAP_REPLAY_TIMED,             // Recorded inter-packet gaps, divided by rate (2.0 = twice as fast)
+    CORD_PCAP_REPLAY_PPS                // Constant rate packets per second
+} cord_pcap_replay_mode_t;
+
+typedef struct
+{
+    cord_raw_pkt_desc_t desc;           // Handed out by rx(), reset on every hand-out
+    uint64_t ts_ns;                     // Capture time stamp
+    uint64_t offset;                    // Packet data within the mapping
+    uint32_t len;                       // Captured length
+    uint32_t headroom;                  // Record header bytes in front of the data
+} cord_pcap_pkt_index_t;
+
+typedef struct CordL2PcapFlowPoint
+{
+    CordFlowPoint base;
+    const char *rx_path;
+    const char *tx_path;
+
+    // Replay
+    uint8_t *map;
+    size_t map_size;
+    cord_pcap_pkt_index_t *pkts;        // Built at open, one entry per replayed packet
+    uint64_t num_pkts;
+    uint64_t skipped_pkts;              // Not Ethernet or longer than CORD_PCAP_SNAPLEN
+    uint64_t next_pkt;
+    cord_pcap_replay_mode_t mode;
+    double rate;
+    uint32_t loops;                     // 0 = endless
+    uint32_t loops_done;
+    uint64_t start_ns;                  // Pacing origin (TIMED: of the current loop)
+    uint64_t paced_pkts;                // Released since start_ns (PPS)
+
+    // Capture
+    FILE *tx_file;
+    void *params;
+} CordL2PcapFlowPoint;
+
+void CordL2PcapFlowPoint_ctor(CordL2PcapFlowPoint * const self,
+                              uint8_t id,
+                              const char *rx_path,
+                              const char *tx_path);
+
+void CordL2PcapFlowPoint_dtor(CordL2PcapFlowPoint * const self);
+
+// Restarts the replay; rate is ignored at MAX_SPEED, loops 0 = endless (default: 1 loop at max speed)
+cord_retval_t CordL2PcapFlowPoint_set_replay(CordL2PcapFlowPoint * const self, cord_pcap_replay_mode_t mode, double rate, uint32_t loops);
+
+// True once the last loop has been handed out
+static inline bool CordL2PcapFlowPoint_replay_done(const CordL2PcapFlowPoint * const self)
+{
+    return (self->loops != 0) && (self->loops_done >= self->loops);
+}
+
+cord_retval_t CordL2PcapFlowPoint_flush(CordL2PcapFlowPoint * const self);
+
+#endif // CORD_L2_PCAP_FLOW_POINT_H
@@ -19,11 +19,17 @@
         DESTROY_ON_HEAP(CordL2Tpacketv3FlowPoint, name);   \
     } while(0)
 
-#define CORD_DESTROY_L2_TPACKETV3_FLOW_POINT_ON_STACK(name) \
-    do {                                                    \
-        DESTROY_ON_STACK(CordL2Tpacketv3FlowPoint, name);   \
+#define CORD_DESTROY_L2_TPACKETV3_FLOW_POINT_ON_STACK(name)               \
+    do {                                                                  \
+        CORD_FLOW_POINT_DESTROY_ON_STACK(CordL2Tpacketv3FlowPoint, name); \
     } while(0)
 
+// TX: the packets of an RX block are sent with sendmmsg() in batches of
+// CORD_TPACKETV3_TX_BATCH, retried up to tx_max_retries times on backpressure
+// (EAGAIN / ENOBUFS) and counted as dropped after that
+#define CORD_TPACKETV3_TX_BATCH         64
+#define CORD_TPACKETV3_TX_MAX_RETRIES   8
+
 typedef struct CordL2Tpacketv3FlowPoint
 {
     CordFlowPoint base;
@@ -31,6 +37,7 @@ typedef struct CordL2Tpacketv3FlowPoint
     const char *anchor_iface_name;
     struct sockaddr_ll anchor_bind_addr;
     struct cord_tpacketv3_ring **rx_ring;
+    uint16_t tx_max_retries;
     void *params;
 } CordL2Tpacketv3FlowPoint;
 
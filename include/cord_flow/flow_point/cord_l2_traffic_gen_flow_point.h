@@ -0,0 +1,141 @@
+#ifndef CORD_L2_TRAFFIC_GEN_FLOW_POINT_H
+#define CORD_L2_TRAFFIC_GEN_FLOW_POINT_H
+
+#include <flow_point/cord_flow_point.h>
+#include <memory/cord_pkt_pool.h>
+
+#define CORD_CREATE_L2_TRAFFIC_GEN_FLOW_POINT CORD_CREATE_L2_TRAFFIC_GEN_FLOW_POINT_ON_HEAP
+#define CORD_DESTROY_L2_TRAFFIC_GEN_FLOW_POINT CORD_DESTROY_L2_TRAFFIC_GEN_FLOW_POINT_ON_HEAP
+
+#define CORD_CREATE_L2_TRAFFIC_GEN_FLOW_POINT_ON_HEAP(id, cfg) \
+    (CordFlowPoint *) NEW_ON_HEAP(CordL2TrafficGenFlowPoint, id, cfg)
+
+#define CORD_CREATE_L2_TRAFFIC_GEN_FLOW_POINT_ON_STACK(id, cfg) \
+    (CordFlowPoint *) &NEW_ON_STACK(CordL2TrafficGenFlowPoint, id, cfg)
+
+#define CORD_DESTROY_L2_TRAFFIC_GEN_FLOW_POINT_ON_HEAP(name)  \
+    do {                                                      \
+        DESTROY_ON_HEAP(CordL2TrafficGenFlowPoint, name);     \
+    } while(0)
+
+#define CORD_DESTROY_L2_TRAFFIC_GEN_FLOW_POINT_ON_STACK(name)              \
+    do {                                                                   \
+        CORD_FLOW_POINT_DESTROY_ON_STACK(CordL2TrafficGenFlowPoint, name); \
+    } while(0)
+
+//
+// Synthetic traffic source for load testing
+//
+// At construction the flow point allocates every buffer of a private cord_pkt_pool_t and
+// builds one frame per buffer from the template: Ethernet [/ up to two VLAN tags] / IPv4 /
+// UDP or TCP, with the frame size drawn from the size mix and valid checksums. The generator
+// keeps one reference on each buffer for its whole life.
+//
+// rx() fills an array of cord_raw_pkt_desc_t pointers (len = array size, *rxed = packets),
+// taking the buffers round-robin. Each handed out packet carries an extra reference that
+// the consumer drops with cord_pkt_free() / cord_pkt_free_bulk() once done with it; a
+// buffer still referenced when its turn comes ends the burst (counted as ring_full). Before
+// a buffer is handed out again only its headers are restored from the template and the
+// varied fields rewritten, with incremental checksum updates; the payload is written once.
+//
+// tx() is a counting sink: it takes the same pointer array and frees the packets, which
+// must come from a cord_pkt_pool_t.
+//
+
+#define CORD_TRAFFIC_GEN_MAX_SIZES          8
+#define CORD_TRAFFIC_GEN_NUM_BUFS           4096        // Default number of prebuilt packets
+#define CORD_TRAFFIC_GEN_SEED               0x9E3779B97F4A7C15ULL
+
+typedef enum
+{
+    CORD_TRAFFIC_GEN_FIELD_FIXED = 0,       // Template value
+    CORD_TRAFFIC_GEN_FIELD_INCREMENT,       // base, base + step, ... wrapping after count values
+    CORD_TRAFFIC_GEN_FIELD_RANDOM           // Uniform over base ... base + count - 1
+} cord_traffic_gen_field_mode_t;
+
+typedef struct
+{
+    cord_traffic_gen_field_mode_t mode;
+    uint32_t base;                          // Host byte order
+    uint32_t step;                          // INCREMENT (0 = 1)
+    uint32_t count;                         // Distinct values (0 = the whole field range)
+} cord_traffic_gen_field_t;
+
+typedef struct
+{
+    uint16_t size;                          // Frame size without FCS
+    uint16_t weight;                        // Relative share of the packets
+} cord_traffic_gen_size_t;
+
+typedef struct
+{
+    const uint8_t *template_pkt;            // Headers (and the start of the payload), copied
+    uint16_t template_len;
+
+    cord_traffic_gen_size_t sizes[CORD_TRAFFIC_GEN_MAX_SIZES];
+    uint8_t num_sizes;                      // 0 = template_len only
+
+    cord_traffic_gen_field_t ipv4_src;      // All RANDOM = random 5-tuples
+    cord_traffic_gen_field_t ipv4_dst;
+    cord_traffic_gen_field_t src_port;
+    cord_traffic_gen_field_t dst_port;
+
+    uint32_t num_bufs;                      // Prebuilt packets, rounded up to a power of two (0 = default)
+    uint64_t pps;                           // Rate limit (0 = as fast as rx() is called)
+    uint64_t max_pkts;                      // Stop after this many packets (0 = endless)
+    uint64_t seed;                          // RANDOM fields and the size order (0 = default)
+} cord_traffic_gen_cfg_t;
+
+typedef struct CordL2TrafficGenFlowPoint
+{
+    CordFlowPoint base;
+    cord_traffic_gen_cfg_t cfg;
+
+    // Prebuilt packets
+    cord_pkt_pool_t *pool;
+    cord_raw_pkt_desc_t **slots;            // Every buffer of the pool, in hand-out order
+    uint8_t *slot_size;                     // Size mix entry of each slot
+    uint32_t slot_mask;
+    uint32_t next_slot;
+
+    // Pristine headers, one per size mix entry
+    uint8_t *hdrs;
+    uint16_t hdr_len;
+    uint16_t l3_offset;
+    uint16_t l4_offset;
+    uint8_t l4_proto;
+    uint16_t frame_len[CORD_TRAFFIC_GEN_MAX_SIZES];
+
+    // Template field values (network byte order)
+    uint32_t tmpl_saddr;
+    uint32_t tmpl_daddr;
+    uint16_t tmpl_sport;
+    uint16_t tmpl_dport;
+
+    // Variation state
+    uint32_t field_idx[4];                  // INCREMENT position of ipv4_src, ipv4_dst, src_port, dst_port
+    uint64_t rng;
+
+    // Pacing
+    uint64_t start_ns;
+    uint64_t generated_pkts;
+
+    void *params;
+} CordL2TrafficGenFlowPoint;
+
+void CordL2TrafficGenFlowPoint_ctor(CordL2TrafficGenFlowPoint * const self,
+                                    uint8_t id,
+                                    const cord_traffic_gen_cfg_t *cfg);
+
+void CordL2TrafficGenFlowPoint_dtor(CordL2TrafficGenFlowPoint * const self);
+
+// Restarts the rate limit and max_pkts accounting (field sequences continue)
+void CordL2TrafficGenFlowPoint_restart(CordL2TrafficGenFlowPoint * const self);
+
+// True once max_pkts packets have been generated
+static inline bool CordL2TrafficGenFlowPoint_done(const CordL2TrafficGenFlowPoint * const self)
+{
+    return (self->cfg.max_pkts != 0) && (self->generated_pkts >= self->cfg.max_pkts);
+}
+
+#endif // CORD_L2_TRAFFIC_GEN_FLOW_POINT_H
@@ -17,17 +17,26 @@
         DESTROY_ON_HEAP(CordL3RawSocketFlowPoint, name);    \
     } while(0)
 
-#define CORD_DESTROY_L3_RAW_SOCKET_FLOW_POINT_ON_STACK(name) \
-    do {                                                     \
-        DESTROY_ON_STACK(CordL3RawSocketFlowPoint, name);    \
+#define CORD_DESTROY_L3_RAW_SOCKET_FLOW_POINT_ON_STACK(name)              \
+    do {                                                                  \
+        CORD_FLOW_POINT_DESTROY_ON_STACK(CordL3RawSocketFlowPoint, name); \
     } while(0)
 
+//
+// IP packets over an AF_PACKET SOCK_DGRAM socket: rx() returns the packet from the IP
+// header on, tx() takes one and the kernel builds the Ethernet header. The destination
+// MAC (the next hop) must be set with CordL3RawSocketFlowPoint_set_dst_mac() before the
+// first tx(); until then tx() fails with CORD_ERR_INVALID_PARAM.
+//
+
 typedef struct CordL3RawSocketFlowPoint
 {
     CordFlowPoint base;
     int ifindex;
     const char *anchor_iface_name;
     struct sockaddr_ll anchor_bind_addr;
+    struct sockaddr_ll dst_addr;            // Next hop, sll_halen = 0 until set
+    uint8_t rx_pkttype;                     // sll_pkttype of the last received packet
     int fanout_id;
     void *ring;
     void *params;
@@ -39,11 +48,14 @@ void CordL3RawSocketFlowPoint_ctor(CordL3RawSocketFlowPoint * const self,
 
 void CordL3RawSocketFlowPoint_dtor(CordL3RawSocketFlowPoint * const self);
 
+// Destination MAC of the frames tx() sends
+void CordL3RawSocketFlowPoint_set_dst_mac(CordL3RawSocketFlowPoint * const self, const uint8_t dst_mac[ETH_ALEN]);
+
 #define CORD_L3_RAW_SOCKET_FLOW_POINT_ENSURE_INBOUD(self) (CordL3RawSocketFlowPoint_ensure_packet_inboud(self))
 
 static inline cord_retval_t CordL3RawSocketFlowPoint_ensure_packet_inboud(CordFlowPoint const * const self)
 {
-    if (((CordL3RawSocketFlowPoint *)self)->anchor_bind_addr.sll_pkttype == PACKET_OUTGOING)
+    if (((CordL3RawSocketFlowPoint *)self)->rx_pkttype == PACKET_OUTGOING)
         return CORD_ERR;
     else
         return CORD_OK;
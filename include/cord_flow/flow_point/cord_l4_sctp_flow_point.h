@@ -17,9 +17,9 @@
         DESTROY_ON_HEAP(CordL4SctpFlowPoint, name);   \
     } while(0)
 
-#define CORD_DESTROY_L4_SCTP_FLOW_POINT_ON_STACK(name) \
-    do {                                               \
-        DESTROY_ON_STACK(CordL4SctpFlowPoint, name);   \
+#define CORD_DESTROY_L4_SCTP_FLOW_POINT_ON_STACK(name)               \
+    do {                                                             \
+        CORD_FLOW_POINT_DESTROY_ON_STACK(CordL4SctpFlowPoint, name); \
     } while(0)
 
 #define CLIENT_CONN_AUX_HANDLE_INDEX 0 // Single connection supported
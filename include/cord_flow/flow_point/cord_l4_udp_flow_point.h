@@ -17,9 +17,9 @@
         DESTROY_ON_HEAP(CordL4UdpFlowPoint, name);   \
     } while(0)
 
-#define CORD_DESTROY_L4_UDP_FLOW_POINT_ON_STACK(name) \
-    do {                                              \
-        DESTROY_ON_STACK(CordL4UdpFlowPoint, name);   \
+#define CORD_DESTROY_L4_UDP_FLOW_POINT_ON_STACK(name)               \
+    do {                                                            \
+        CORD_FLOW_POINT_DESTROY_ON_STACK(CordL4UdpFlowPoint, name); \
     } while(0)
 
 typedef struct CordL4UdpFlowPoint
@@ -0,0 +1,58 @@
+#ifndef CORD_RING_FLOW_POINT_H
+#define CORD_RING_FLOW_POINT_H
+
+#include <flow_point/cord_flow_point.h>
+#include <memory/cord_ring.h>
+
+#define CORD_CREATE_RING_FLOW_POINT CORD_CREATE_RING_FLOW_POINT_ON_HEAP
+#define CORD_DESTROY_RING_FLOW_POINT CORD_DESTROY_RING_FLOW_POINT_ON_HEAP
+
+#define CORD_CREATE_RING_FLOW_POINT_ON_HEAP(id, count, mode) \
+    (CordFlowPoint *) NEW_ON_HEAP(CordRingFlowPoint, id, count, mode)
+
+#define CORD_CREATE_RING_FLOW_POINT_ON_STACK(id, count, mode) \
+    (CordFlowPoint *) &NEW_ON_STACK(CordRingFlowPoint, id, count, mode)
+
+#define CORD_DESTROY_RING_FLOW_POINT_ON_HEAP(name) \
+    do {                                           \
+        DESTROY_ON_HEAP(CordRingFlowPoint, name);  \
+    } while(0)
+
+#define CORD_DESTROY_RING_FLOW_POINT_ON_STACK(name)                \
+    do {                                                           \
+        CORD_FLOW_POINT_DESTROY_ON_STACK(CordRingFlowPoint, name); \
+    } while(0)
+
+//
+// In-process flow point over a cord_ring_t, connecting pipeline stages on different threads
+//
+// tx() enqueues an array of descriptor pointers (len = array size, *txed = packets enqueued)
+// and rx() dequeues into one (*rxed = packets dequeued); ownership travels with the pointer,
+// the packets are never copied. A partial tx() counts ring_full and returns CORD_ERR_AGAIN,
+// the packets past *txed stay with the caller (retry or free them).
+//
+// There is no file descriptor to wait on (io_handle is -1): the receiving stage polls rx().
+// The ring mode follows the topology, e.g. CORD_RING_SPSC for one rx core feeding one worker,
+// CORD_RING_MPSC for several rx cores feeding one worker.
+//
+// The counters follow the per-queue rule of CordFlowPoint (plain increments by one thread):
+// every thread calling rx() or tx() must pass a queue_id of its own, the consumer included,
+// e.g. rx() on queue 0 and producer i on queue i + 1. A shared queue_id races on the counters
+// and puts the producer and consumer sides on one cache line.
+//
+
+typedef struct CordRingFlowPoint
+{
+    CordFlowPoint base;
+    cord_ring_t *ring;
+    void *params;
+} CordRingFlowPoint;
+
+void CordRingFlowPoint_ctor(CordRingFlowPoint * const self,
+                            uint8_t id,
+                            uint32_t count,
+                            cord_ring_mode_t mode);
+
+void CordRingFlowPoint_dtor(CordRingFlowPoint * const self);
+
+#endif // CORD_RING_FLOW_POINT_H
@@ -5,6 +5,7 @@
 
 #include <flow_point/cord_flow_point.h>
 #include <memory/cord_memory.h>
+#include <filter/cord_xdp_prog.h>
 
 #include <xdp/xsk.h>
 #include <linux/if_xdp.h>
@@ -24,17 +25,43 @@
         DESTROY_ON_HEAP(CordXdpFlowPoint, name);  \
     } while(0)
 
-#define CORD_DESTROY_XDP_FLOW_POINT_ON_STACK(name) \
-    do {                                           \
-        DESTROY_ON_STACK(CordXdpFlowPoint, name);  \
+#define CORD_DESTROY_XDP_FLOW_POINT_ON_STACK(name)                \
+    do {                                                          \
+        CORD_FLOW_POINT_DESTROY_ON_STACK(CordXdpFlowPoint, name); \
     } while(0)
 
+//
+// TX buffering - same model as the DPDK flow point
+//
+// Unbuffered by default (bounded retries, then the frames are recycled and counted as
+// dropped); CordXdpFlowPoint_set_tx_buffer() makes tx() queue descriptors until
+// threshold are waiting or the oldest has waited timeout_us. tx() always takes
+// ownership of the descriptors it is given.
+//
+
+#define CORD_XDP_TX_BUFFER_MAX          512
+#define CORD_XDP_TX_TIMEOUT_US          100
+#define CORD_XDP_TX_MAX_RETRIES         8
+
+typedef struct
+{
+    struct cord_xdp_pkt_desc *pkts;       // CORD_XDP_TX_BUFFER_MAX slots, allocated when buffering is enabled
+    uint16_t count;
+    uint16_t threshold;                   // 0 = unbuffered
+    uint16_t max_retries;
+    uint64_t timeout_ns;
+    uint64_t deadline_ns;                 // Flush time of the oldest buffered descriptor
+    uint64_t tx_flushes;                  // Packets / drops go to the flow point queue stats
+} cord_xdp_tx_queue_t;
+
 typedef struct CordXdpFlowPoint
 {
     CordFlowPoint base;
     cord_retval_t (*fill)(struct CordXdpFlowPoint * const self);
     cord_retval_t (*drain_completion)(struct CordXdpFlowPoint * const self);
     struct cord_xdp_socket_info **xsk_info;
+    cord_xdp_prog_t *xdp_prog;            // Program attached with attach_xBPF(XDP_FILTER), NULL if none (see inhibit_prog_load)
+    cord_xdp_tx_queue_t tx_queue;
     void *params;
 } CordXdpFlowPoint;
 
@@ -44,6 +71,11 @@ void CordXdpFlowPoint_ctor(CordXdpFlowPoint * const self,
 
 void CordXdpFlowPoint_dtor(CordXdpFlowPoint * const self);
 
+// threshold 0 = unbuffered; timeout_us / max_retries 0 = defaults
+cord_retval_t CordXdpFlowPoint_set_tx_buffer(CordXdpFlowPoint * const self, uint16_t threshold, uint32_t timeout_us, uint16_t max_retries);
+uint32_t CordXdpFlowPoint_tx_flush(CordXdpFlowPoint * const self);
+uint32_t CordXdpFlowPoint_tx_flush_expired(CordXdpFlowPoint * const self);
+
 #define CORDXDPFLOWPOINT_FILL_VCALL(self)   (*(self->fill))((self))
 #define CORDXDPFLOWPOINT_DRAIN_COMPLETION_VCALL(self)   (*(self->drain_completion))((self))
 
@@ -0,0 +1,104 @@
+#ifndef CORD_XDP_MQ_FLOW_POINT_H
+#define CORD_XDP_MQ_FLOW_POINT_H
+
+#ifdef ENABLE_XDP_DATAPLANE
+
+#include <flow_point/cord_flow_point.h>
+#include <flow_point/cord_xdp_flow_point.h>
+#include <memory/cord_memory.h>
+
+//
+// Multi-queue AF_XDP flow point: one XSK per NIC queue [0, queue_count)
+//
+// - Each queue is served by its own CordXdpFlowPoint; rx/tx dispatch on queue_id,
+//   so every worker owns one queue and no state is shared on the data path
+// - shared_umem: one UMEM on the NIC's NUMA node, each queue socket with its own
+//   fill / completion rings and a disjoint slice of num_frames frames;
+//   otherwise one UMEM per queue
+// - The XSKMAP redirect program is the libxdp default one, loaded with the first
+//   socket; every queue socket is inserted into its XSKMAP at its queue index
+// - attach_xBPF(XDP_FILTER) replaces it with a program of our own (cord_xdp_prog_t),
+//   loaded once for the interface, with every queue socket in its XSKMAP; programs
+//   other users attached to the interface are left alone
+// - The queue flow points count into the statistics of the multi-queue one (one block
+//   per queue), so CordFlowPoint_get_stats() on it covers the whole interface
+//
+
+#define CORD_XDP_MQ_MAX_QUEUES 64
+
+#define CORD_CREATE_XDP_MQ_FLOW_POINT CORD_CREATE_XDP_MQ_FLOW_POINT_ON_HEAP
+#define CORD_DESTROY_XDP_MQ_FLOW_POINT CORD_DESTROY_XDP_MQ_FLOW_POINT_ON_HEAP
+
+#define CORD_CREATE_XDP_MQ_FLOW_POINT_ON_HEAP(id, ifname, queue_count, num_frames, shared_umem) \
+    (CordFlowPoint *) NEW_ON_HEAP(CordXdpMqFlowPoint, id, ifname, queue_count, num_frames, shared_umem)
+
+#define CORD_CREATE_XDP_MQ_FLOW_POINT_ON_STACK(id, ifname, queue_count, num_frames, shared_umem) \
+    (CordFlowPoint *) &NEW_ON_STACK(CordXdpMqFlowPoint, id, ifname, queue_count, num_frames, shared_umem)
+
+#define CORD_DESTROY_XDP_MQ_FLOW_POINT_ON_HEAP(name) \
+    do {                                             \
+        DESTROY_ON_HEAP(CordXdpMqFlowPoint, name);   \
+    } while(0)
+
+#define CORD_DESTROY_XDP_MQ_FLOW_POINT_ON_STACK(name)               \
+    do {                                                            \
+        CORD_FLOW_POINT_DESTROY_ON_STACK(CordXdpMqFlowPoint, name); \
+    } while(0)
+
+typedef struct CordXdpMqFlowPoint
+{
+    CordFlowPoint base;
+    cord_retval_t (*fill)(struct CordXdpMqFlowPoint * const self, uint16_t queue_id);
+    cord_retval_t (*drain_completion)(struct CordXdpMqFlowPoint * const self, uint16_t queue_id);
+    CordXdpFlowPoint *queues[CORD_XDP_MQ_MAX_QUEUES];
+    struct cord_xdp_socket_info **xsk_info;      // Per-queue sockets (heap array, the queue flow points point into it)
+    cord_xdp_prog_t *xdp_prog;            // Program attached with attach_xBPF(XDP_FILTER), NULL if none
+    const char *ifname;
+    uint16_t queue_count;
+    uint32_t num_frames;                  // UMEM frames per queue (0 = 4096)
+    bool shared_umem;
+    int socket_id;                        // NUMA node of the NIC (UMEM placement)
+    void *params;
+} CordXdpMqFlowPoint;
+
+void CordXdpMqFlowPoint_ctor(CordXdpMqFlowPoint * const self,
+                             uint8_t id,
+                             const char *ifname,
+                             uint16_t queue_count,
+                             uint32_t num_frames,
+                             bool shared_umem);
+
+void CordXdpMqFlowPoint_dtor(CordXdpMqFlowPoint * const self);
+
+// Applies the TX buffering settings to every queue
+cord_retval_t CordXdpMqFlowPoint_set_tx_buffer(CordXdpMqFlowPoint * const self, uint16_t threshold, uint32_t timeout_us, uint16_t max_retries);
+
+// Per-queue XDP flow point, e.g. to hand to the worker that owns the queue
+static inline CordXdpFlowPoint *CordXdpMqFlowPoint_queue(CordXdpMqFlowPoint * const self, uint16_t queue_id)
+{
+    return (queue_id < self->queue_count) ? self->queues[queue_id] : NULL;
+}
+
+static inline uint32_t CordXdpMqFlowPoint_tx_flush(CordXdpMqFlowPoint * const self, uint16_t queue_id)
+{
+    return (queue_id < self->queue_count) ? CordXdpFlowPoint_tx_flush(self->queues[queue_id]) : 0;
+}
+
+static inline uint32_t CordXdpMqFlowPoint_tx_flush_expired(CordXdpMqFlowPoint * const self, uint16_t queue_id)
+{
+    return (queue_id < self->queue_count) ? CordXdpFlowPoint_tx_flush_expired(self->queues[queue_id]) : 0;
+}
+
+static inline cord_retval_t CordXdpMqFlowPoint_fill_vcall(CordXdpMqFlowPoint * const self, uint16_t queue_id)
+{
+    return (*(self->fill))(self, queue_id);
+}
+
+static inline cord_retval_t CordXdpMqFlowPoint_drain_completion_vcall(CordXdpMqFlowPoint * const self, uint16_t queue_id)
+{
+    return (*(self->drain_completion))(self, queue_id);
+}
+
+#endif // ENABLE_XDP_DATAPLANE
+
+#endif // CORD_XDP_MQ_FLOW_POINT_H
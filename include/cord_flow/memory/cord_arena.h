@@ -0,0 +1,61 @@
+#ifndef CORD_ARENA_H
+#define CORD_ARENA_H
+
+#include <cord_type.h>
+#include <memory/cord_memory.h>
+#include <stdatomic.h>
+
+//
+// CORD Arena - Huge page arena allocator
+//
+// Carves many long-lived objects (LPM tables, CAMs, rings, packet pools) out of a
+// few 2MB / 1GB pages instead of one rounded mapping per object, so they share
+// TLB entries. Memory is bound to a NUMA node (mbind) before it is faulted in.
+//
+// - Bump allocation within chunks of chunk_size bytes, first fit across chunks
+// - Requests larger than chunk_size get a dedicated chunk
+// - No per-object free: everything is released by cord_arena_destroy()
+// - Each chunk records its mapping (base, size, backing page size), so ownership
+//   of any pointer can be checked with cord_arena_owns()
+//
+
+#define CORD_ARENA_MIN_ALIGN    CORD_CACHE_LINE_SIZE
+
+// One mapping owned by the arena
+typedef struct cord_arena_chunk
+{
+    struct cord_arena_chunk *next;
+    uint8_t *base;                        // Start of the mapping
+    size_t size;                          // Mapping size (multiple of the requested page size)
+    size_t used;                          // Bump offset
+    size_t backing_page_size;             // Page size actually obtained (1GB, 2MB or 4KB)
+} cord_arena_chunk_t;
+
+typedef struct
+{
+    cord_arena_chunk_t *chunks;           // Newest first
+    size_t chunk_size;                    // Default mapping size
+    size_t page_size;                     // Requested huge page size
+    int numa_node;                        // NUMA node or CORD_NUMA_NODE_ANY
+    atomic_flag lock;                     // Serialises allocations
+
+    // Statistics
+    size_t mapped_bytes;
+    size_t used_bytes;
+    uint32_t num_chunks;
+    uint32_t num_allocs;
+} cord_arena_t;
+
+// chunk_size 0 = one page; page_size CORD_HUGE_PAGE_2MB or CORD_HUGE_PAGE_1GB
+cord_arena_t *cord_arena_create(size_t chunk_size, size_t page_size, int numa_node);
+void cord_arena_destroy(cord_arena_t *arena);
+
+// Zeroed memory aligned to max(align, cache line); align must be a power of two
+void *cord_arena_alloc(cord_arena_t *arena, size_t size, size_t align);
+
+bool cord_arena_owns(const cord_arena_t *arena, const void *ptr);
+
+// Statistics
+void cord_arena_print_stats(const cord_arena_t *arena);
+
+#endif // CORD_ARENA_H
@@ -30,8 +30,41 @@ void cord_pktmbuf_mpool_free(struct rte_mempool **mbuf_pool);
 #define CORD_ALIGN_TO_PAGE(x) \
     (((x) + CORD_PAGE_SIZE - 1) / CORD_PAGE_SIZE * CORD_PAGE_SIZE)
 
-// Huge page allocation functions (with fallback to calloc/free)
+// NUMA placement
+#define CORD_NUMA_NODE_ANY       (-1)
+#define CORD_NUMA_MAX_NODES      64
+
+// Sets a preferred-node policy (mbind) on a not yet faulted range; CORD_NUMA_NODE_ANY is a no-op
+int cord_numa_bind(void *addr, size_t len, int numa_node);
+
+// Preferred node for the calling thread's own (and in-kernel, e.g. socket ring) allocations;
+// CORD_NUMA_NODE_ANY sets the default local policy. To switch temporarily, save the thread's
+// policy first and restore it afterwards (keeps a numactl / application policy intact).
+int cord_numa_set_preferred(int numa_node);
+
+// Calling thread's memory policy (mode with flags, node mask)
+typedef struct
+{
+    int mode;
+    unsigned long nodemask[CORD_NUMA_MAX_NODES / (8 * sizeof(unsigned long))];
+} cord_numa_policy_t;
+
+int cord_numa_policy_save(cord_numa_policy_t *policy);
+int cord_numa_policy_restore(const cord_numa_policy_t *policy);
+
+// NUMA node of the CPU the caller runs on (0 if unknown) and number of nodes (highest online + 1)
+int cord_numa_node_self(void);
+int cord_numa_num_nodes(void);
+
+// Huge page mappings: size must be a multiple of page_size (2MB or 1GB).
+// Falls back 1GB -> 2MB -> regular pages (with transparent huge pages); the page size
+// actually obtained is returned in backing_page_size. Memory is zeroed and prefaulted.
+void *cord_map_hugepage(size_t size, size_t page_size, int numa_node, size_t *backing_page_size);
+void cord_unmap_hugepage(void *ptr, size_t size);
+
+// Huge page allocation functions (2MB rounded, with fallback to regular pages)
 void *cord_alloc_hugepage(size_t size);
+void *cord_alloc_hugepage_node(size_t size, int numa_node);
 void cord_free_hugepage(void *ptr, size_t size);
 
 // Cache-aligned buffer macro
@@ -92,9 +125,16 @@ static inline void cord_raw_pkt_reset(cord_raw_pkt_desc_t *pkt)
     pkt->data_len = 0;
 }
 
+// Bytes available in front of the packet data
+static inline uint16_t cord_raw_pkt_headroom(const cord_raw_pkt_desc_t *pkt)
+{
+    return (uint16_t)(pkt->data - pkt->buf_addr);
+}
+
 struct cord_tpacketv3_ring
 {
     int fd;
+    int socket_id;
     struct iovec *iov_ring;
     uint8_t *map;
     size_t map_size;
@@ -103,19 +143,60 @@ struct cord_tpacketv3_ring
 };
 
 struct cord_tpacketv3_ring* cord_tpacketv3_ring_alloc(uint32_t block_size, uint32_t frame_size, uint32_t block_num);
+struct cord_tpacketv3_ring* cord_tpacketv3_ring_alloc_socket(uint32_t block_size, uint32_t frame_size, uint32_t block_num,
+                                                             int socket_id);
 void cord_tpacketv3_ring_init(struct cord_tpacketv3_ring **ring);
 void cord_tpacketv3_ring_free(struct cord_tpacketv3_ring **ring);
 
 #ifdef ENABLE_XDP_DATAPLANE
 
 #include <xdp/xsk.h>
+#include <stdatomic.h>
+
+//
+// UMEM frame ring - bounded lock-free MPMC ring of free frame addresses
+//
+// Producers and consumers each reserve a range of slots with a CAS on their head,
+// copy, then publish it by moving their tail in reservation order: the multi-producer /
+// multi-consumer protocol of cord_ring_t (memory/cord_ring.h), on 64-bit frame addresses.
+// Several XSKs on different cores can thus hand frames of one shared UMEM back and
+// forth (zero-copy forwarding, completion routing) without a lock; bulk calls keep
+// the atomic traffic to one CAS per batch instead of one per frame.
+//
+
+#define CORD_XDP_FRAME_BATCH        64
+
+struct cord_xdp_frame_ring
+{
+    _Atomic uint32_t prod_head __attribute__((aligned(CORD_CACHE_LINE_SIZE)));
+    _Atomic uint32_t prod_tail;
+    _Atomic uint32_t cons_head __attribute__((aligned(CORD_CACHE_LINE_SIZE)));
+    _Atomic uint32_t cons_tail;
+    uint32_t capacity __attribute__((aligned(CORD_CACHE_LINE_SIZE)));
+    uint32_t mask;
+    uint64_t frames[];
+};
+
+struct cord_xdp_frame_ring *cord_xdp_frame_ring_create(uint32_t capacity);
+void cord_xdp_frame_ring_destroy(struct cord_xdp_frame_ring *ring);
+
+// Burst operations: move up to n frames, return the number moved
+uint32_t cord_xdp_frame_ring_enqueue_burst(struct cord_xdp_frame_ring *ring, const uint64_t *frames, uint32_t n);
+uint32_t cord_xdp_frame_ring_dequeue_burst(struct cord_xdp_frame_ring *ring, uint64_t *frames, uint32_t n);
+
+// Frames currently in the ring (a snapshot under concurrent use)
+static inline uint32_t cord_xdp_frame_ring_count(const struct cord_xdp_frame_ring *ring)
+{
+    return atomic_load_explicit(&ring->prod_tail, memory_order_acquire) -
+           atomic_load_explicit(&ring->cons_tail, memory_order_acquire);
+}
 
 struct cord_xdp_pkt_desc
 {
     void *data;
     uint64_t addr;
     uint32_t len;
-    struct cord_xdp_socket_info *src_socket;
+    struct cord_xdp_socket_info *src_socket;  // RX socket owning the frame (NULL: not a UMEM frame)
 };
 
 struct cord_xdp_socket_info
@@ -128,22 +209,33 @@ struct cord_xdp_socket_info
     struct xsk_socket *xsk;
     void *umem_area;
     size_t umem_size;
-    uint64_t *umem_frames_rx;
-    uint64_t *umem_frames_tx;
+    struct cord_xdp_frame_ring *umem_frames_rx;  // Free RX frames (fill ring supply)
+    struct cord_xdp_frame_ring *umem_frames_tx;  // Free TX frames (copy path)
+    uint64_t umem_offset;
     uint32_t num_frames;
     uint32_t frame_size;
-    uint32_t free_frames_rx;
-    uint32_t free_frames_tx;
     int ifindex;
     const char *ifname;
+    int socket_id;
     uint16_t queue_id;
     uint16_t rx_ring_size;
     uint16_t tx_ring_size;
     uint16_t fill_ring_size;
     uint16_t comp_ring_size;
+    bool inhibit_prog_load;                      // Set before init when a program of our own will be attached
     struct cord_xdp_socket_info *umem_owner;
+    struct cord_xdp_socket_info **frame_owner;   // Socket owning each UMEM frame (one table per UMEM)
 };
 
+// Bytes available in front of the packet data within its UMEM frame
+static inline size_t cord_xdp_pkt_headroom(const struct cord_xdp_pkt_desc *pkt)
+{
+    const struct cord_xdp_socket_info *xsk_info = pkt->src_socket;
+    uint64_t frame_base = pkt->addr - (pkt->addr % xsk_info->frame_size);
+    uint64_t data_offset = (uint64_t)((const uint8_t *)pkt->data - (const uint8_t *)xsk_info->umem_area);
+    return (size_t)(data_offset - frame_base);
+}
+
 struct cord_xdp_socket_info* cord_xdp_socket_alloc(const char *ifname,
                                                     uint16_t queue_id,
                                                     uint32_t num_frames,
@@ -153,15 +245,58 @@ struct cord_xdp_socket_info* cord_xdp_socket_alloc(const char *ifname,
                                                     uint16_t fill_ring_size,
                                                     uint16_t comp_ring_size);
 
+struct cord_xdp_socket_info* cord_xdp_socket_alloc_socket(const char *ifname,
+                                                           uint16_t queue_id,
+                                                           uint32_t num_frames,
+                                                           uint32_t frame_size,
+                                                           uint16_t rx_ring_size,
+                                                           uint16_t tx_ring_size,
+                                                           uint16_t fill_ring_size,
+                                                           uint16_t comp_ring_size,
+                                                           int socket_id);
+
 void cord_xdp_socket_init(struct cord_xdp_socket_info **xsk_info);
+// Shares the UMEM of shared_umem_socket (own fill/completion rings); the sharer uses the
+// num_frames frames starting at its umem_offset, which must not overlap the owner's slice
 void cord_xdp_socket_init_shared(struct cord_xdp_socket_info **xsk_info, struct cord_xdp_socket_info **shared_umem_socket);
 void cord_xdp_socket_free(struct cord_xdp_socket_info **xsk_info);
 
+// Single frame alloc / free (alloc returns UINT64_MAX when empty)
 uint64_t cord_xdp_alloc_frame_rx(struct cord_xdp_socket_info *xsk_info);
 void cord_xdp_free_frame_rx(struct cord_xdp_socket_info *xsk_info, uint64_t frame);
 uint64_t cord_xdp_alloc_frame_tx(struct cord_xdp_socket_info *xsk_info);
 void cord_xdp_free_frame_tx(struct cord_xdp_socket_info *xsk_info, uint64_t frame);
 
+// Bulk alloc returns the number of frames obtained (up to n); bulk free never drops frames
+uint32_t cord_xdp_alloc_frames_rx(struct cord_xdp_socket_info *xsk_info, uint64_t *frames, uint32_t n);
+void cord_xdp_free_frames_rx(struct cord_xdp_socket_info *xsk_info, const uint64_t *frames, uint32_t n);
+uint32_t cord_xdp_alloc_frames_tx(struct cord_xdp_socket_info *xsk_info, uint64_t *frames, uint32_t n);
+void cord_xdp_free_frames_tx(struct cord_xdp_socket_info *xsk_info, const uint64_t *frames, uint32_t n);
+
+static inline uint32_t cord_xdp_free_frames_rx_count(const struct cord_xdp_socket_info *xsk_info)
+{
+    return cord_xdp_frame_ring_count(xsk_info->umem_frames_rx);
+}
+
+static inline uint32_t cord_xdp_free_frames_tx_count(const struct cord_xdp_socket_info *xsk_info)
+{
+    return cord_xdp_frame_ring_count(xsk_info->umem_frames_tx);
+}
+
+// True if both sockets work on the same UMEM (zero-copy forwarding possible); a NULL
+// socket (packet outside any UMEM) never shares one
+static inline bool cord_xdp_same_umem(const struct cord_xdp_socket_info *a, const struct cord_xdp_socket_info *b)
+{
+    return a && b && a->umem == b->umem;
+}
+
+// Return a frame reaped from a completion ring to the socket and free list it belongs to:
+// zero-copy forwarded RX frames go back to their RX socket (and from there to its fill ring)
+void cord_xdp_complete_frame(struct cord_xdp_socket_info *xsk_info, uint64_t addr);
+
+// Bulk variant: consecutive frames with the same owner and free list are returned in one call
+void cord_xdp_complete_frames(struct cord_xdp_socket_info *xsk_info, const uint64_t *addrs, uint32_t n);
+
 #endif // ENABLE_XDP_DATAPLANE
 
 #endif // CORD_MEMORY_H
@@ -0,0 +1,110 @@
+#ifndef CORD_PKT_POOL_H
+#define CORD_PKT_POOL_H
+
+#include <cord_type.h>
+#include <memory/cord_memory.h>
+#include <memory/cord_arena.h>
+#include <stdatomic.h>
+
+//
+// CORD Packet Pool - Fixed-size packet buffers for the raw socket dataplane
+// Modelled after DPDK's rte_mempool / rte_mbuf
+//
+// - One hugepage-backed region (cord_alloc_hugepage or a cord_arena_t), elements cache-line aligned
+// - Element = cord_pkt_buf_t header (descriptor, refcount) + CORD_RAW_HEADROOM + data
+// - Shared free stack behind a spinlock, refilled/flushed in bulk from
+//   per-thread caches, so the common alloc/free path takes no lock
+// - Reference counted: a descriptor can be shared between flow points,
+//   conntrack and TX queues; the last cord_pkt_free() returns it to the pool
+//
+// The descriptor pointer handed out is the cord_raw_pkt_desc_t embedded at the
+// start of each element, so it works with all cord_raw_pkt_* helpers.
+//
+
+#define CORD_PKT_POOL_MAX_THREADS       64      // Live threads with a private cache (others use the shared stack), slots freed on thread exit
+#define CORD_PKT_POOL_CACHE_SIZE        256     // Default per-thread cache size
+#define CORD_PKT_POOL_CACHE_MAX         512     // Maximum per-thread cache size
+
+typedef struct cord_pkt_pool cord_pkt_pool_t;
+
+// Per-element header (one cache line, precedes the packet buffer)
+typedef struct
+{
+    cord_raw_pkt_desc_t desc;             // Must stay first: descriptors are cast back to the element
+    cord_pkt_pool_t *pool;                // Owning pool
+    atomic_uint refcnt;                   // Outstanding references (0 = free)
+    uint32_t index;                       // Element index in the arena
+} __attribute__((aligned(CORD_CACHE_LINE_SIZE))) cord_pkt_buf_t;
+
+// Per-thread cache
+typedef struct
+{
+    void **objs;                          // Cached free elements (2 * cache_size slots)
+    uint32_t len;                         // Elements currently cached
+    uint64_t alloc_count;                 // Statistics (owner thread only)
+    uint64_t free_count;
+    uint64_t alloc_fail_count;
+} __attribute__((aligned(CORD_CACHE_LINE_SIZE))) cord_pkt_pool_cache_t;
+
+// Packet pool structure
+struct cord_pkt_pool
+{
+    // Arena
+    uint8_t *arena;                       // Hugepage-backed element storage
+    size_t arena_size;                    // Allocation size of the arena
+    uint32_t elt_size;                    // Element stride (header + buffer, cache aligned)
+    uint32_t buf_size;                    // Packet buffer size (headroom included)
+    uint32_t num_bufs;                    // Number of elements
+    bool from_arena;                      // Elements carved from a cord_arena_t (not unmapped on destroy)
+
+    // Shared free stack
+    void **stack;                         // Free elements
+    uint32_t stack_len;                   // Elements on the stack
+    atomic_flag lock;                     // Protects the stack
+
+    // Per-thread caches
+    uint32_t cache_size;                  // Refill / flush quantum (0 = caches disabled)
+    cord_pkt_pool_cache_t caches[CORD_PKT_POOL_MAX_THREADS];
+};
+
+// Packet pool API
+cord_pkt_pool_t *cord_pkt_pool_create(uint32_t num_bufs, uint32_t buf_size, uint32_t cache_size);
+cord_pkt_pool_t *cord_pkt_pool_create_arena(cord_arena_t *arena, uint32_t num_bufs, uint32_t buf_size, uint32_t cache_size);
+void cord_pkt_pool_destroy(cord_pkt_pool_t *pool);
+
+// Returns a reset descriptor with a reference count of 1, or NULL if the pool is empty
+cord_raw_pkt_desc_t *cord_pkt_alloc(cord_pkt_pool_t *pool);
+
+// All-or-nothing: returns 0 on success, -1 (nothing allocated) otherwise
+int cord_pkt_alloc_bulk(cord_pkt_pool_t *pool, cord_raw_pkt_desc_t **pkts, uint32_t count);
+
+// Drop one reference; the buffer returns to its pool when the last one is dropped
+void cord_pkt_free(cord_raw_pkt_desc_t *pkt);
+void cord_pkt_free_bulk(cord_raw_pkt_desc_t **pkts, uint32_t count);
+
+static inline cord_pkt_buf_t *cord_pkt_buf(const cord_raw_pkt_desc_t *pkt)
+{
+    return (cord_pkt_buf_t *)pkt;
+}
+
+// Take an extra reference (e.g. before handing the packet to another owner)
+static inline void cord_pkt_refcnt_inc(cord_raw_pkt_desc_t *pkt)
+{
+    atomic_fetch_add_explicit(&cord_pkt_buf(pkt)->refcnt, 1, memory_order_relaxed);
+}
+
+static inline uint32_t cord_pkt_refcnt_read(const cord_raw_pkt_desc_t *pkt)
+{
+    return atomic_load_explicit(&cord_pkt_buf(pkt)->refcnt, memory_order_relaxed);
+}
+
+// Return the calling thread's cached buffers to the shared stack (call before a worker thread exits)
+void cord_pkt_pool_cache_flush(cord_pkt_pool_t *pool);
+
+// Free elements (approximate while other threads are running)
+uint32_t cord_pkt_pool_avail_count(cord_pkt_pool_t *pool);
+
+// Statistics
+void cord_pkt_pool_print_stats(cord_pkt_pool_t *pool);
+
+#endif // CORD_PKT_POOL_H
@@ -0,0 +1,159 @@
+#ifndef CORD_RING_H
+#define CORD_RING_H
+
+#include <cord_type.h>
+#include <memory/cord_memory.h>
+#include <memory/cord_arena.h>
+#include <stdatomic.h>
+#include <sched.h>
+
+//
+// CORD Ring - Lock-free pointer ring for handing packet descriptors between threads
+// Modelled after DPDK's rte_ring
+//
+// - Fixed power-of-two number of void * slots, all usable
+// - Producer and consumer indexes on separate cache lines (no false sharing)
+// - Single-producer / single-consumer sides publish with a plain store and keep a
+//   private copy of the opposite index, so they read the other side's cache line
+//   only when the cached view runs out
+// - Multi-producer / multi-consumer sides reserve slots with a CAS on the head and
+//   publish in reservation order by waiting for the tail to catch up
+//
+// The mode is fixed at creation; every thread on a "single" side must be the same one.
+//
+
+#define CORD_RING_SPINS                 1024    // Pause iterations before yielding to a preempted peer
+
+typedef enum
+{
+    CORD_RING_SPSC = 0,                   // One producer thread, one consumer thread
+    CORD_RING_MPSC,                       // Any number of producers, one consumer thread
+    CORD_RING_SPMC,                       // One producer thread, any number of consumers
+    CORD_RING_MPMC                        // Any number of producers and consumers
+} cord_ring_mode_t;
+
+typedef struct
+{
+    // Producer side
+    _Atomic uint32_t prod_head __attribute__((aligned(CORD_CACHE_LINE_SIZE)));
+    _Atomic uint32_t prod_tail;
+    uint32_t prod_cons_tail;              // Single producer: last consumer tail seen
+    bool prod_single;
+
+    // Consumer side
+    _Atomic uint32_t cons_head __attribute__((aligned(CORD_CACHE_LINE_SIZE)));
+    _Atomic uint32_t cons_tail;
+    uint32_t cons_prod_tail;              // Single consumer: last producer tail seen
+    bool cons_single;
+
+    // Read-only after creation
+    uint32_t capacity __attribute__((aligned(CORD_CACHE_LINE_SIZE)));
+    uint32_t mask;
+    cord_ring_mode_t mode;
+    bool from_arena;                      // Carved from a cord_arena_t (not freed on destroy)
+
+    void *objs[] __attribute__((aligned(CORD_CACHE_LINE_SIZE)));
+} cord_ring_t;
+
+//
+// Multi-producer / multi-consumer head/tail protocol, also used by the XDP UMEM frame ring
+//
+
+// count is the requested number, the result the one granted by the current view of the ring:
+// a failed CAS retries with count, not with a value clamped to a stale head / tail
+static inline uint32_t cord_ring_grant(uint32_t count, uint32_t avail, bool all)
+{
+    if (count <= avail)
+        return count;
+
+    return all ? 0 : avail;
+}
+
+// Reserve up to count slots by moving head with a CAS. base is the capacity on the producer
+// side (free slots) and 0 on the consumer side (entries). Returns the number reserved, the
+// range starts at *old_head.
+static inline uint32_t cord_ring_move_head(_Atomic uint32_t *head, _Atomic uint32_t *opposite_tail,
+                                           uint32_t base, uint32_t count, bool all, uint32_t *old_head)
+{
+    uint32_t n;
+
+    // Acquire on the head load and on the CAS refresh keeps the opposite tail load after
+    // it: a tail older than the head would over-grant
+    uint32_t h = atomic_load_explicit(head, memory_order_acquire);
+
+    do
+    {
+        n = cord_ring_grant(count, base + atomic_load_explicit(opposite_tail, memory_order_acquire) - h, all);
+        if (n == 0)
+        {
+            return 0;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(head, &h, h + n,
+                                                    memory_order_acquire, memory_order_acquire));
+
+    *old_head = h;
+    return n;
+}
+
+// Publish [head, next) once every earlier reservation is published; yield if its owner got preempted
+static inline void cord_ring_publish_tail(_Atomic uint32_t *tail, uint32_t head, uint32_t next)
+{
+    uint32_t spins = 0;
+
+    while (atomic_load_explicit(tail, memory_order_relaxed) != head)
+    {
+        if (++spins < CORD_RING_SPINS)
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#elif defined(__aarch64__)
+            __asm__ __volatile__("yield");
+#endif
+        }
+        else
+        {
+            sched_yield();
+            spins = 0;
+        }
+    }
+
+    atomic_store_explicit(tail, next, memory_order_release);
+}
+
+// Ring API (count is rounded up to a power of two)
+cord_ring_t *cord_ring_create(uint32_t count, cord_ring_mode_t mode);
+cord_ring_t *cord_ring_create_arena(cord_arena_t *arena, uint32_t count, cord_ring_mode_t mode);
+void cord_ring_destroy(cord_ring_t *ring);
+
+// Burst: move up to n objects, return the number moved
+uint32_t cord_ring_enqueue_burst(cord_ring_t *ring, void * const *objs, uint32_t n);
+uint32_t cord_ring_dequeue_burst(cord_ring_t *ring, void **objs, uint32_t n);
+
+// Bulk: all-or-nothing, return n or 0
+uint32_t cord_ring_enqueue_bulk(cord_ring_t *ring, void * const *objs, uint32_t n);
+uint32_t cord_ring_dequeue_bulk(cord_ring_t *ring, void **objs, uint32_t n);
+
+// Objects currently in the ring (a snapshot under concurrent use)
+static inline uint32_t cord_ring_count(const cord_ring_t *ring)
+{
+    uint32_t cons_tail = atomic_load_explicit(&ring->cons_tail, memory_order_acquire);
+    uint32_t count = atomic_load_explicit(&ring->prod_tail, memory_order_acquire) - cons_tail;
+    return (count > ring->capacity) ? ring->capacity : count;
+}
+
+static inline uint32_t cord_ring_free_count(const cord_ring_t *ring)
+{
+    return ring->capacity - cord_ring_count(ring);
+}
+
+static inline bool cord_ring_empty(const cord_ring_t *ring)
+{
+    return cord_ring_count(ring) == 0;
+}
+
+static inline bool cord_ring_full(const cord_ring_t *ring)
+{
+    return cord_ring_count(ring) == ring->capacity;
+}
+
+#endif // CORD_RING_H
@@ -0,0 +1,210 @@
+#ifndef CORD_PIPELINE_H
+#define CORD_PIPELINE_H
+
+#include <cord_type.h>
+#include <cord_retval.h>
+#include <protocol_headers/cord_protocol_headers.h>
+#include <memory/cord_memory.h>
+#include <table/cord_cam.h>
+#include <table/cord_lpm.h>
+#include <table/cord_acl.h>
+
+//
+// CORD Pipeline - Multi-stage Match-Action Pipeline
+// OpenFlow-like model: chained stages, each a table lookup followed by an action list
+//
+// Stage types:
+// - L2 CAM:    exact match on (destination MAC, VLAN ID)   -> port ID
+// - IPv4 LPM:  longest prefix match on destination address -> next hop ID
+// - IPv4 ACL:  5-tuple classification                      -> rule action
+// - Custom:    user lookup callback                        -> user entry ID
+//
+// The lookup result selects an action list: per-entry lists first, then the stage
+// hit list; a miss runs the stage miss list. A burst is executed stage by stage,
+// so every table sees a single batched (and prefetched) lookup per burst.
+//
+// Verdicts are left in the per-packet metadata (out_port / drop), TX stays with the caller.
+//
+
+#define CORD_PIPELINE_MAX_STAGES        16
+#define CORD_PIPELINE_MAX_ACTIONS       8
+#define CORD_PIPELINE_BURST_SIZE        64
+#define CORD_PIPELINE_MISS              0xFFFFFFFF
+#define CORD_PIPELINE_PORT_NONE         0xFFFFFFFF
+#define CORD_PIPELINE_PORT_FROM_TABLE   0xFFFFFFFE  // OUTPUT to the stage lookup result
+#define CORD_PIPELINE_STAGE_END         0xFF
+
+// Dataplane-native packet descriptor
+#if defined(ENABLE_DPDK_DATAPLANE)
+typedef struct rte_mbuf cord_pipeline_pkt_t;
+
+static inline uint8_t *cord_pipeline_pkt_data(cord_pipeline_pkt_t *pkt)
+{
+    return rte_pktmbuf_mtod(pkt, uint8_t *);
+}
+
+static inline uint32_t cord_pipeline_pkt_len(const cord_pipeline_pkt_t *pkt)
+{
+    return rte_pktmbuf_data_len(pkt);
+}
+#elif defined(ENABLE_XDP_DATAPLANE)
+typedef struct cord_xdp_pkt_desc cord_pipeline_pkt_t;
+
+static inline uint8_t *cord_pipeline_pkt_data(cord_pipeline_pkt_t *pkt)
+{
+    return (uint8_t *)pkt->data;
+}
+
+static inline uint32_t cord_pipeline_pkt_len(const cord_pipeline_pkt_t *pkt)
+{
+    return pkt->len;
+}
+#else
+typedef cord_raw_pkt_desc_t cord_pipeline_pkt_t;
+
+static inline uint8_t *cord_pipeline_pkt_data(cord_pipeline_pkt_t *pkt)
+{
+    return pkt->data;
+}
+
+static inline uint32_t cord_pipeline_pkt_len(const cord_pipeline_pkt_t *pkt)
+{
+    return pkt->data_len;
+}
+#endif
+
+// Per-packet metadata (parsed once, carried across stages)
+typedef struct
+{
+    cord_eth_hdr_t *eth;                  // Ethernet header
+    cord_vlan_hdr_t *vlan;                // Outer 802.1Q/802.1ad tag (NULL if untagged)
+    cord_ipv4_hdr_t *ipv4;                // Validated IPv4 header (NULL if not IPv4 or malformed)
+    uint16_t vlan_id;                     // Outer VLAN ID (0 if untagged)
+    uint16_t l4_offset;                   // L4 header offset from the frame start (0 if no IPv4)
+    uint16_t l4_len;                      // L4 bytes covered by the IPv4 total length
+    uint8_t next_stage;                   // Stage to execute next (CORD_PIPELINE_STAGE_END = done)
+    uint8_t drop;                         // Packet must be dropped
+    uint32_t out_port;                    // Output port (CORD_PIPELINE_PORT_NONE = unset)
+    uint32_t table_result;                // Result of the last stage lookup
+    uint32_t metadata;                    // User metadata (set by actions)
+} cord_pipeline_md_t;
+
+//
+// Actions
+//
+
+typedef enum
+{
+    CORD_PIPELINE_ACTION_OUTPUT = 0,      // Set out_port (or the lookup result)
+    CORD_PIPELINE_ACTION_DROP,            // Drop the packet, stop the pipeline
+    CORD_PIPELINE_ACTION_GOTO_STAGE,      // Continue at a later stage
+    CORD_PIPELINE_ACTION_SET_ETH_SRC,     // Rewrite source MAC
+    CORD_PIPELINE_ACTION_SET_ETH_DST,     // Rewrite destination MAC
+    CORD_PIPELINE_ACTION_DEC_IPV4_TTL,    // Decrement TTL (drops on expiry)
+    CORD_PIPELINE_ACTION_SET_IPV4_DSCP,   // Rewrite DSCP
+    CORD_PIPELINE_ACTION_PUSH_VLAN,       // Push an 802.1Q/802.1ad tag
+    CORD_PIPELINE_ACTION_POP_VLAN,        // Pop the outer tag
+    CORD_PIPELINE_ACTION_SET_METADATA,    // Set user metadata
+    CORD_PIPELINE_ACTION_CUSTOM           // User callback
+} cord_pipeline_action_type_t;
+
+typedef void (*cord_pipeline_custom_action_fn)(cord_pipeline_pkt_t *pkt, cord_pipeline_md_t *md, void *ctx);
+
+typedef struct
+{
+    cord_pipeline_action_type_t type;
+    union
+    {
+        uint32_t port;                    // OUTPUT
+        uint8_t stage;                    // GOTO_STAGE
+        cord_mac_addr_t mac;              // SET_ETH_SRC / SET_ETH_DST
+        uint8_t dscp;                     // SET_IPV4_DSCP
+        uint32_t metadata;                // SET_METADATA
+        struct
+        {
+            uint16_t vlan_id;
+            uint8_t pcp;
+            uint8_t dei;
+            uint16_t ethertype;
+        } vlan;                           // PUSH_VLAN
+        struct
+        {
+            cord_pipeline_custom_action_fn fn;
+            void *ctx;
+        } custom;                         // CUSTOM
+    };
+} cord_pipeline_action_t;
+
+typedef struct
+{
+    cord_pipeline_action_t actions[CORD_PIPELINE_MAX_ACTIONS];
+    uint8_t count;
+} cord_pipeline_action_list_t;
+
+//
+// Stages
+//
+
+typedef enum
+{
+    CORD_PIPELINE_STAGE_L2_CAM = 0,
+    CORD_PIPELINE_STAGE_IPV4_LPM,
+    CORD_PIPELINE_STAGE_IPV4_ACL,
+    CORD_PIPELINE_STAGE_CUSTOM
+} cord_pipeline_stage_type_t;
+
+// Custom lookup: returns an entry ID or CORD_PIPELINE_MISS
+typedef uint32_t (*cord_pipeline_custom_lookup_fn)(void *table, cord_pipeline_pkt_t *pkt, cord_pipeline_md_t *md);
+
+typedef struct
+{
+    cord_pipeline_stage_type_t type;
+    void *table;                                  // cord_l2_cam_t / cord_ipv4_lpm_t / cord_acl_t / user table
+    cord_pipeline_custom_lookup_fn lookup;        // Custom stages only
+    cord_pipeline_action_list_t *entry_actions;   // Per-entry action lists (indexed by lookup result)
+    uint32_t num_entry_actions;
+    cord_pipeline_action_list_t hit_actions;      // Default for entries without their own list
+    cord_pipeline_action_list_t miss_actions;
+    uint8_t next_stage;                           // Default successor (CORD_PIPELINE_STAGE_END = last)
+
+    // Statistics
+    uint64_t hit_count;
+    uint64_t miss_count;
+} cord_pipeline_stage_t;
+
+// Pipeline structure
+typedef struct
+{
+    cord_pipeline_stage_t stages[CORD_PIPELINE_MAX_STAGES];
+    uint8_t num_stages;
+
+    // Statistics
+    uint64_t packet_count;                        // Packets run through the pipeline
+    uint64_t drop_count;                          // Packets dropped by actions
+} cord_pipeline_t;
+
+// Pipeline API
+cord_pipeline_t *cord_pipeline_create(void);
+void cord_pipeline_destroy(cord_pipeline_t *pipeline);
+
+// Returns the stage index or -1; stages are chained in declaration order by default
+int cord_pipeline_add_stage(cord_pipeline_t *pipeline, cord_pipeline_stage_type_t type,
+                            void *table, cord_pipeline_custom_lookup_fn lookup);
+
+int cord_pipeline_set_entry_actions(cord_pipeline_t *pipeline, uint8_t stage, uint32_t entry_id,
+                                    const cord_pipeline_action_t *actions, uint8_t count);
+int cord_pipeline_set_hit_actions(cord_pipeline_t *pipeline, uint8_t stage,
+                                  const cord_pipeline_action_t *actions, uint8_t count);
+int cord_pipeline_set_miss_actions(cord_pipeline_t *pipeline, uint8_t stage,
+                                   const cord_pipeline_action_t *actions, uint8_t count);
+// next_stage: a later stage that has already been added, or CORD_PIPELINE_STAGE_END
+int cord_pipeline_set_next_stage(cord_pipeline_t *pipeline, uint8_t stage, uint8_t next_stage);
+
+// Execute a burst; verdicts are returned in md[i].out_port / md[i].drop
+void cord_pipeline_run(cord_pipeline_t *pipeline, cord_pipeline_pkt_t **pkts,
+                       cord_pipeline_md_t *md, uint32_t count);
+
+// Statistics
+void cord_pipeline_print_stats(const cord_pipeline_t *pipeline);
+
+#endif // CORD_PIPELINE_H
@@ -0,0 +1,134 @@
+#ifndef CORD_ACL_H
+#define CORD_ACL_H
+
+#include <cord_type.h>
+#include <protocol_headers/cord_protocol_headers.h>
+
+//
+// CORD ACL - Multi-field Packet Classification
+// Based on the Lucent bit-vector (BV) scheme
+//
+// References:
+// - T.V. Lakshman, D. Stiliadis, "High-Speed Policy-based Packet Forwarding
+//   Using Efficient Multi-dimensional Range Matching", SIGCOMM 1998
+//
+
+//
+// IPv4 5-tuple ACL - Bit-Vector Algorithm
+//
+//
+// Algorithm: Per-field elementary intervals with rule bitmaps
+// - Each field (src/dst IPv4, src/dst port, protocol) is cut into the
+//   elementary intervals formed by all rule boundaries
+// - Every interval owns a bitmap with one bit per rule (bit set = rule covers it)
+// - Classification: 1 interval search per field, AND the 5 bitmaps,
+//   the first set bit is the highest priority matching rule
+//
+// Performance: 2 binary searches + 3 direct lookups + (num_rules / 64) word ANDs,
+//              the AND loop uses AVX-512 / AVX2 when the build target has them
+// Memory: ~(2 * num_rules) intervals * (max_rules / 8) bytes per field
+//
+// Rules are prioritised by insertion order (rule 0 wins over rule 1).
+// The table must be (re)built with cord_acl_build() after adding rules.
+//
+
+#define CORD_ACL_MAX_RULES          4096
+#define CORD_ACL_NO_MATCH           0xFFFFFFFF
+#define CORD_ACL_WORD_BITS          64
+#define CORD_ACL_WORD_ALIGN         8          // Bitmap stride alignment in words (one 512-bit vector)
+
+// ACL classification fields
+typedef enum
+{
+    CORD_ACL_FIELD_SRC_IPV4 = 0,
+    CORD_ACL_FIELD_DST_IPV4,
+    CORD_ACL_FIELD_SRC_PORT,
+    CORD_ACL_FIELD_DST_PORT,
+    CORD_ACL_FIELD_PROTO,
+    CORD_ACL_FIELD_COUNT
+} cord_acl_field_id_t;
+
+// ACL rule (all values in host byte order)
+typedef struct
+{
+    uint32_t src_ip;                      // Source IPv4 prefix
+    uint32_t dst_ip;                      // Destination IPv4 prefix
+    uint8_t src_depth;                    // Source prefix length (0 = any)
+    uint8_t dst_depth;                    // Destination prefix length (0 = any)
+    uint8_t proto;                        // IP protocol
+    uint8_t proto_any;                    // Ignore the protocol field
+    uint16_t src_port_min;                // Source port range (inclusive)
+    uint16_t src_port_max;
+    uint16_t dst_port_min;                // Destination port range (inclusive)
+    uint16_t dst_port_max;
+    uint32_t action;                      // User data returned on match
+} cord_acl_rule_t;
+
+// ACL lookup key (all values in host byte order)
+typedef struct
+{
+    uint32_t src_ip;
+    uint32_t dst_ip;
+    uint16_t src_port;
+    uint16_t dst_port;
+    uint8_t proto;
+} cord_acl_key_t;
+
+// Per-field elementary interval index
+typedef struct
+{
+    uint32_t *bounds;                     // Sorted interval start points (bounds[0] == 0)
+    uint32_t num_intervals;               // Number of elementary intervals
+    uint16_t *direct;                     // Value -> interval (port/protocol fields only)
+    uint64_t *bitmaps;                    // num_intervals * word_stride rule bitmaps
+    size_t bitmaps_size;                  // Allocation size of bitmaps
+} cord_acl_field_t;
+
+// ACL table structure
+typedef struct
+{
+    // Rules
+    cord_acl_rule_t *rules;               // Rules in priority order
+    uint32_t num_rules;                   // Number of installed rules
+    uint32_t max_rules;                   // Maximum rules capacity
+
+    // Compiled fields
+    cord_acl_field_t fields[CORD_ACL_FIELD_COUNT];
+    uint32_t num_words;                   // Bitmap words in use (ceil(num_rules / 64))
+    uint32_t word_stride;                 // Bitmap words per interval (aligned)
+    bool built;                           // Compiled fields match the rule set
+
+    // Statistics
+    uint64_t lookup_count;                // Total classifications performed
+    uint64_t match_count;                 // Classifications that hit a rule
+} cord_acl_t;
+
+// ACL API
+cord_acl_t *cord_acl_create(uint32_t max_rules);
+void cord_acl_destroy(cord_acl_t *acl);
+
+int cord_acl_add(cord_acl_t *acl, const cord_acl_rule_t *rule);
+int cord_acl_build(cord_acl_t *acl);
+void cord_acl_clear(cord_acl_t *acl);
+
+// Returns the matching rule index or CORD_ACL_NO_MATCH
+uint32_t cord_acl_classify(const cord_acl_t *acl, const cord_acl_key_t *key);
+
+// Burst classification: resolves all intervals first, then ANDs the bitmaps
+void cord_acl_classify_batch(const cord_acl_t *acl, const cord_acl_key_t *keys,
+                             uint32_t *rule_ids, uint32_t count);
+
+// Rule index -> user action (CORD_ACL_NO_MATCH passes through)
+static inline uint32_t cord_acl_rule_action(const cord_acl_t *acl, uint32_t rule_id)
+{
+    return (rule_id == CORD_ACL_NO_MATCH) ? CORD_ACL_NO_MATCH : acl->rules[rule_id].action;
+}
+
+// Convenience functions for packet processing
+// l3_len: bytes available from ip on; the ports stay 0 unless IHL >= 5 and they fit in l3_len
+void cord_acl_key_from_ipv4(const cord_ipv4_hdr_t *ip, uint32_t l3_len, cord_acl_key_t *key);
+
+// Statistics
+void cord_acl_print_stats(const cord_acl_t *acl);
+
+#endif // CORD_ACL_H
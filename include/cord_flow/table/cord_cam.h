@@ -3,12 +3,14 @@
 
 #include <cord_type.h>
 #include <protocol_headers/cord_protocol_headers.h>
+#include <memory/cord_memory.h>
 
 //
 // CORD CAM - Content Addressable Memory (Exact Match Tables)
 //
 // Layer 2 CAM for Ethernet switching: (MAC address, VLAN ID) → Port ID
-// Uses hash table with chaining for collision resolution
+// Uses hash table with chaining for collision resolution; buckets and the
+// max_entries entry pool share one huge page mapping on the table's NUMA node
 //
 
 //
@@ -16,6 +18,7 @@
 //
 
 #define CORD_L2_CAM_INVALID_PORT 0xFFFFFFFF
+#define CORD_L2_CAM_BATCH_SIZE   32
 
 // L2 CAM entry structure
 typedef struct cord_l2_cam_entry
@@ -38,14 +41,20 @@ typedef struct cord_l2_cam
     uint64_t lookup_count;                // Total lookups performed
     uint64_t hit_count;                   // Successful lookups
     uint64_t miss_count;                  // Failed lookups
+    cord_l2_cam_entry_t *entry_pool;      // Preallocated entries (max_entries)
+    cord_l2_cam_entry_t *free_entries;    // Free entry list
+    void *mem;                            // Mapping holding buckets and entries
+    size_t mem_size;
+    int socket_id;                        // NUMA node of the table
 } cord_l2_cam_t;
 
 //
 // L2 CAM API
 //
 
-// Create and destroy
+// Create and destroy (cord_l2_cam_create() places the table on the caller's NUMA node)
 cord_l2_cam_t *cord_l2_cam_create(uint32_t num_buckets, uint32_t max_entries);
+cord_l2_cam_t *cord_l2_cam_create_socket(uint32_t num_buckets, uint32_t max_entries, int socket_id);
 void cord_l2_cam_destroy(cord_l2_cam_t *cam);
 
 // Basic operations
@@ -53,6 +62,10 @@ int cord_l2_cam_add(cord_l2_cam_t *cam, const cord_mac_addr_t *mac, uint32_t por
 int cord_l2_cam_delete(cord_l2_cam_t *cam, const cord_mac_addr_t *mac, uint16_t vlan_id);
 uint32_t cord_l2_cam_lookup(cord_l2_cam_t *cam, const cord_mac_addr_t *mac, uint16_t vlan_id);
 
+// Batch lookup: hashes, then prefetches buckets and chain heads before matching
+void cord_l2_cam_lookup_batch(cord_l2_cam_t *cam, const cord_mac_addr_t * const *macs,
+                              const uint16_t *vlan_ids, uint32_t *port_ids, uint32_t count);
+
 // Convenience functions for packet processing
 int cord_l2_cam_add_from_eth(cord_l2_cam_t *cam, const cord_eth_hdr_t *eth, uint32_t port_id,
                              uint16_t vlan_id, bool use_src);
@@ -64,6 +77,28 @@ uint32_t cord_l2_cam_lookup_from_vlan(cord_l2_cam_t *cam, const cord_eth_hdr_t *
 // Management
 void cord_l2_cam_clear(cord_l2_cam_t *cam);
 
+//
+// Per-NUMA-node replicas: updates go to every replica, each worker looks up in the
+// replica of its own node (see the LPM replicas in <table/cord_lpm.h>). An update that
+// fails on one replica is rolled back on the replicas already updated.
+//
+
+typedef struct
+{
+    cord_l2_cam_t *replicas[CORD_NUMA_MAX_NODES];
+    int num_nodes;
+} cord_l2_cam_replicated_t;
+
+cord_l2_cam_replicated_t *cord_l2_cam_replicated_create(uint32_t num_buckets, uint32_t max_entries);
+void cord_l2_cam_replicated_destroy(cord_l2_cam_replicated_t *rcam);
+int cord_l2_cam_replicated_add(cord_l2_cam_replicated_t *rcam, const cord_mac_addr_t *mac, uint32_t port_id, uint16_t vlan_id);
+int cord_l2_cam_replicated_delete(cord_l2_cam_replicated_t *rcam, const cord_mac_addr_t *mac, uint16_t vlan_id);
+
+static inline cord_l2_cam_t *cord_l2_cam_replica(const cord_l2_cam_replicated_t *rcam, int socket_id)
+{
+    return rcam->replicas[(socket_id >= 0 && socket_id < rcam->num_nodes) ? socket_id : 0];
+}
+
 // Statistics and debugging
 void cord_l2_cam_print_stats(const cord_l2_cam_t *cam);
 void cord_l2_cam_print_entries(const cord_l2_cam_t *cam);
@@ -3,6 +3,7 @@
 
 #include <cord_type.h>
 #include <protocol_headers/cord_protocol_headers.h>
+#include <memory/cord_memory.h>
 
 //
 // CORD LPM - Longest Prefix Match Implementation
@@ -22,7 +23,7 @@
 // - TBL8:  Multiple groups of 2^8 entries for depth > 24
 //
 // Performance: 1-2 memory accesses (1 for depth <= 24, 2 for depth > 24)
-// Memory: ~128MB base + ~2KB per TBL8 group
+// Memory: 128MB TBL24 + 512KB TBL8 pool, mapped together on one NUMA node
 //
 
 #define CORD_IPV4_LPM_TBL24_SIZE        (1 << 24)  // 16,777,216 entries
@@ -30,6 +31,7 @@
 #define CORD_IPV4_LPM_TBL8_MAX_GROUPS   256        // Default: 256 groups (configurable)
 #define CORD_IPV4_LPM_MAX_DEPTH         32
 #define CORD_IPV4_LPM_INVALID_NEXT_HOP  0xFFFFFFFF
+#define CORD_IPV4_LPM_TBL8_POOL_SIZE    (CORD_IPV4_LPM_TBL8_MAX_GROUPS * CORD_IPV4_LPM_TBL8_SIZE * sizeof(cord_ipv4_lpm_entry_t))
 
 // IPv4 LPM entry structure (8 bytes - cache line friendly)
 typedef struct
@@ -48,6 +50,7 @@ typedef struct
     // Tables
     cord_ipv4_lpm_entry_t *tbl24;                                  // Primary table (16M entries)
     cord_ipv4_lpm_entry_t **tbl8_groups;                           // Secondary tables (on-demand)
+    cord_ipv4_lpm_entry_t *tbl8_pool;                              // Backing store of all TBL8 groups
 
     // TBL8 management
     uint16_t tbl8_free_list[CORD_IPV4_LPM_TBL8_MAX_GROUPS];        // Free group indices
@@ -58,10 +61,12 @@ typedef struct
     uint64_t lookup_count;                                         // Total lookups performed
     uint32_t routes_count;                                         // Number of installed routes
     uint32_t max_routes;                                           // Maximum routes capacity
+    int socket_id;                                                 // NUMA node of the tables
 } cord_ipv4_lpm_t;
 
-// IPv4 LPM API
+// IPv4 LPM API (cord_ipv4_lpm_create() places the tables on the caller's NUMA node)
 cord_ipv4_lpm_t *cord_ipv4_lpm_create(uint32_t max_routes);
+cord_ipv4_lpm_t *cord_ipv4_lpm_create_socket(uint32_t max_routes, int socket_id);
 void cord_ipv4_lpm_destroy(cord_ipv4_lpm_t *lpm);
 
 int cord_ipv4_lpm_add(cord_ipv4_lpm_t *lpm, uint32_t ip, uint8_t depth, uint32_t next_hop);
@@ -147,10 +152,12 @@ typedef struct
     uint32_t routes_count;
     uint32_t max_routes;
     uint32_t max_depth_reached;                                    // Deepest trie level used
+    int socket_id;                                                 // NUMA node of TBL24
 } cord_ipv6_lpm_t;
 
-// IPv6 LPM API
+// IPv6 LPM API (cord_ipv6_lpm_create() places TBL24 on the caller's NUMA node)
 cord_ipv6_lpm_t *cord_ipv6_lpm_create(uint32_t max_routes);
+cord_ipv6_lpm_t *cord_ipv6_lpm_create_socket(uint32_t max_routes, int socket_id);
 void cord_ipv6_lpm_destroy(cord_ipv6_lpm_t *lpm);
 
 int cord_ipv6_lpm_add(cord_ipv6_lpm_t *lpm, const cord_ipv6_addr_t *ip, uint8_t depth, uint32_t next_hop);
@@ -162,6 +169,50 @@ uint32_t cord_ipv6_lpm_lookup(const cord_ipv6_lpm_t *lpm, const cord_ipv6_addr_t
 void cord_ipv6_lpm_lookup_batch(const cord_ipv6_lpm_t *lpm, const cord_ipv6_addr_t *ips,
                                  uint32_t *next_hops, uint32_t count);
 
+//
+// Per-NUMA-Node Replicas
+//
+// Read-mostly tables replicated once per NUMA node: updates are applied to every
+// replica, and each worker looks up in the replica of its own node (resolve it once
+// with cord_numa_node_self() after pinning). Replicas are identical, so an update
+// normally fails on the first replica and leaves all of them unchanged. The tables
+// keep no rule list to roll back to: if a later replica fails (e.g. out of TBL8
+// groups after a diverging history), -1 is returned with the earlier replicas already
+// updated, and the caller must repeat the update or rebuild the replicas.
+//
+
+typedef struct
+{
+    cord_ipv4_lpm_t *replicas[CORD_NUMA_MAX_NODES];
+    int num_nodes;
+} cord_ipv4_lpm_replicated_t;
+
+typedef struct
+{
+    cord_ipv6_lpm_t *replicas[CORD_NUMA_MAX_NODES];
+    int num_nodes;
+} cord_ipv6_lpm_replicated_t;
+
+cord_ipv4_lpm_replicated_t *cord_ipv4_lpm_replicated_create(uint32_t max_routes);
+void cord_ipv4_lpm_replicated_destroy(cord_ipv4_lpm_replicated_t *rlpm);
+int cord_ipv4_lpm_replicated_add(cord_ipv4_lpm_replicated_t *rlpm, uint32_t ip, uint8_t depth, uint32_t next_hop);
+int cord_ipv4_lpm_replicated_delete(cord_ipv4_lpm_replicated_t *rlpm, uint32_t ip, uint8_t depth);
+
+static inline cord_ipv4_lpm_t *cord_ipv4_lpm_replica(const cord_ipv4_lpm_replicated_t *rlpm, int socket_id)
+{
+    return rlpm->replicas[(socket_id >= 0 && socket_id < rlpm->num_nodes) ? socket_id : 0];
+}
+
+cord_ipv6_lpm_replicated_t *cord_ipv6_lpm_replicated_create(uint32_t max_routes);
+void cord_ipv6_lpm_replicated_destroy(cord_ipv6_lpm_replicated_t *rlpm);
+int cord_ipv6_lpm_replicated_add(cord_ipv6_lpm_replicated_t *rlpm, const cord_ipv6_addr_t *ip, uint8_t depth, uint32_t next_hop);
+int cord_ipv6_lpm_replicated_delete(cord_ipv6_lpm_replicated_t *rlpm, const cord_ipv6_addr_t *ip, uint8_t depth);
+
+static inline cord_ipv6_lpm_t *cord_ipv6_lpm_replica(const cord_ipv6_lpm_replicated_t *rlpm, int socket_id)
+{
+    return rlpm->replicas[(socket_id >= 0 && socket_id < rlpm->num_nodes) ? socket_id : 0];
+}
+
 //
 // Helper Functions
 //
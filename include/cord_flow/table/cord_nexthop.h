@@ -0,0 +1,109 @@
+#ifndef CORD_NEXTHOP_H
+#define CORD_NEXTHOP_H
+
+#include <cord_type.h>
+#include <cord_retval.h>
+#include <protocol_headers/cord_protocol_headers.h>
+#include <memory/cord_memory.h>
+#include <flow_point/cord_flow_point.h>
+#include <table/cord_lpm.h>
+
+//
+// CORD Next Hop - IPv4 Forwarding Adjacency Table
+//
+// Each next hop stores the complete outgoing L2 header (Ethernet, optionally
+// 802.1Q tagged) and its egress flow point. Forwarding a packet is:
+// - one fixed-size copy of the prebuilt 14/18-byte header in front of the IPv4 header
+// - TTL decrement with an incremental (RFC 1624) header checksum update
+//
+// Next hop IDs are the values installed as LPM next hops, so an LPM lookup
+// result indexes the table directly.
+//
+
+#define CORD_NEXTHOP_L2_HDR_MAX     32      // Room for Ethernet + 802.1Q (18 bytes), padded
+#define CORD_NEXTHOP_PREFETCH       4       // Packets to prefetch ahead in burst operations
+
+// Next hop (adjacency) entry
+typedef struct
+{
+    uint8_t l2_hdr[CORD_NEXTHOP_L2_HDR_MAX] __attribute__((aligned(CORD_NEXTHOP_L2_HDR_MAX)));
+    uint8_t l2_len;                       // 14 (untagged) or 18 (802.1Q)
+    bool valid;                           // Entry is installed
+    CordFlowPoint *egress;                // Egress flow point
+    uint64_t tx_count;                    // Packets forwarded through this next hop
+} cord_nexthop_t;
+
+// Next hop table structure
+typedef struct
+{
+    cord_nexthop_t *entries;              // Indexed by next hop ID
+    uint32_t max_entries;                 // Table capacity
+    uint32_t num_entries;                 // Installed entries
+
+    // Statistics
+    uint64_t forward_count;               // Packets rewritten for forwarding
+    uint64_t ttl_expired_count;           // Packets dropped on TTL expiry
+    uint64_t invalid_count;               // Packets dropped (no route / no next hop / not IPv4)
+} cord_nexthop_table_t;
+
+// Next hop table API
+cord_nexthop_table_t *cord_nexthop_table_create(uint32_t max_entries);
+void cord_nexthop_table_destroy(cord_nexthop_table_t *table);
+
+// vlan_id == 0 installs an untagged header; MAC addresses as on the wire
+int cord_nexthop_set(cord_nexthop_table_t *table, uint32_t nh_id,
+                     const cord_mac_addr_t *src_mac, const cord_mac_addr_t *dst_mac,
+                     uint16_t vlan_id, uint8_t pcp, CordFlowPoint *egress);
+int cord_nexthop_delete(cord_nexthop_table_t *table, uint32_t nh_id);
+
+static inline const cord_nexthop_t *cord_nexthop_get(const cord_nexthop_table_t *table, uint32_t nh_id)
+{
+    if (nh_id >= table->max_entries || !table->entries[nh_id].valid)
+    {
+        return NULL;
+    }
+
+    return &table->entries[nh_id];
+}
+
+//
+// Forwarding
+//
+// cord_nexthop_forward() rewrites one packet (Ethernet [+ one VLAN tag] + IPv4) for
+// the given next hop. Returns CORD_OK, CORD_ERR_NOT_FOUND (no such next hop),
+// CORD_ERR_INVALID (not IPv4 / TTL expired) or CORD_ERR_NO_MEMORY (no headroom to grow).
+//
+// The burst variants fill egress[i] with the next hop flow point, or NULL for packets
+// to be dropped, and return the number of packets forwarded.
+// cord_nexthop_route_burst() also performs the LPM lookup on the destination address.
+//
+
+// Default dataplane (L2 raw socket)
+#if !defined(ENABLE_DPDK_DATAPLANE) && !defined(ENABLE_XDP_DATAPLANE)
+cord_retval_t cord_nexthop_forward(cord_nexthop_table_t *table, uint32_t nh_id, cord_raw_pkt_desc_t *pkt);
+uint32_t cord_nexthop_forward_burst(cord_nexthop_table_t *table, const uint32_t *nh_ids,
+                                    cord_raw_pkt_desc_t **pkts, CordFlowPoint **egress, uint32_t count);
+uint32_t cord_nexthop_route_burst(cord_nexthop_table_t *table, const cord_ipv4_lpm_t *lpm,
+                                  cord_raw_pkt_desc_t **pkts, CordFlowPoint **egress, uint32_t count);
+#endif // Default dataplane
+
+#ifdef ENABLE_DPDK_DATAPLANE
+cord_retval_t cord_nexthop_forward(cord_nexthop_table_t *table, uint32_t nh_id, struct rte_mbuf *mbuf);
+uint32_t cord_nexthop_forward_burst(cord_nexthop_table_t *table, const uint32_t *nh_ids,
+                                    struct rte_mbuf **mbufs, CordFlowPoint **egress, uint32_t count);
+uint32_t cord_nexthop_route_burst(cord_nexthop_table_t *table, const cord_ipv4_lpm_t *lpm,
+                                  struct rte_mbuf **mbufs, CordFlowPoint **egress, uint32_t count);
+#endif // ENABLE_DPDK_DATAPLANE
+
+#ifdef ENABLE_XDP_DATAPLANE
+cord_retval_t cord_nexthop_forward(cord_nexthop_table_t *table, uint32_t nh_id, struct cord_xdp_pkt_desc *pkt);
+uint32_t cord_nexthop_forward_burst(cord_nexthop_table_t *table, const uint32_t *nh_ids,
+                                    struct cord_xdp_pkt_desc **pkts, CordFlowPoint **egress, uint32_t count);
+uint32_t cord_nexthop_route_burst(cord_nexthop_table_t *table, const cord_ipv4_lpm_t *lpm,
+                                  struct cord_xdp_pkt_desc **pkts, CordFlowPoint **egress, uint32_t count);
+#endif // ENABLE_XDP_DATAPLANE
+
+// Statistics
+void cord_nexthop_print_stats(const cord_nexthop_table_t *table);
+
+#endif // CORD_NEXTHOP_H
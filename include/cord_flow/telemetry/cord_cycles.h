@@ -0,0 +1,152 @@
+#ifndef CORD_CYCLES_H
+#define CORD_CYCLES_H
+
+#include <cord_type.h>
+#include <memory/cord_memory.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+//
+// CORD Cycles - Per-stage cycle accounting of the packet path
+//
+// Built with CORD_FLOW_CYCLES (cmake -DENABLE_CORD_FLOW_CYCLES=ON), every instrumented
+// stage records the TSC cycles one burst spent in it:
+//
+// - rx / tx:        CORD_FLOW_POINT_RX() (non-empty bursts only) / CORD_FLOW_POINT_TX()
+// - parse:          pipeline header parsing (the match step)
+// - table lookups:  L2 CAM, IPv4 / IPv6 LPM and ACL batch lookups, custom pipeline lookups
+// - nexthop:        next hop rewrites (cord_nexthop_forward_burst)
+// - actions:        pipeline action lists
+//
+// Each thread records into its own cache-aligned block of HDR-style histograms
+// (log-linear: 8 sub-buckets per power of two, i.e. ~12.5% resolution), without atomics.
+// Readers merge the blocks: cord_cycles_get(), cord_cycles_print_stats() and the
+// telemetry segment (cord_telemetry_register_cycles()).
+//
+// Without CORD_FLOW_CYCLES the CORD_CYCLES_* macros expand to nothing.
+//
+
+#define CORD_CYCLES_MAX_THREADS         64      // Threads that record (others are not counted)
+#define CORD_CYCLES_SUB_BITS            3
+#define CORD_CYCLES_SUB_BUCKETS         (1u << CORD_CYCLES_SUB_BITS)
+#define CORD_CYCLES_MAX_EXP             40      // Bursts above 2^41 cycles land in the last bucket
+#define CORD_CYCLES_BUCKETS             ((CORD_CYCLES_MAX_EXP - 1) * CORD_CYCLES_SUB_BUCKETS)
+
+typedef enum
+{
+    CORD_CYCLES_STAGE_RX = 0,
+    CORD_CYCLES_STAGE_PARSE,
+    CORD_CYCLES_STAGE_L2_CAM,
+    CORD_CYCLES_STAGE_IPV4_LPM,
+    CORD_CYCLES_STAGE_IPV6_LPM,
+    CORD_CYCLES_STAGE_ACL,
+    CORD_CYCLES_STAGE_CUSTOM_LOOKUP,
+    CORD_CYCLES_STAGE_ACTIONS,
+    CORD_CYCLES_STAGE_NEXTHOP,
+    CORD_CYCLES_STAGE_TX,
+    CORD_CYCLES_STAGE_COUNT
+} cord_cycles_stage_t;
+
+typedef struct
+{
+    uint64_t count;                       // Recorded bursts
+    uint64_t total;                       // Sum of the cycles
+    uint64_t max;
+    uint64_t buckets[CORD_CYCLES_BUCKETS];
+} cord_cycles_hist_t;
+
+typedef struct
+{
+    cord_cycles_hist_t stages[CORD_CYCLES_STAGE_COUNT];
+} __attribute__((aligned(CORD_CACHE_LINE_SIZE))) cord_cycles_thread_t;
+
+extern _Thread_local cord_cycles_thread_t *cord_cycles_self;
+
+// Claims a block for the calling thread; once all CORD_CYCLES_MAX_THREADS are taken the
+// thread records into a discarded block
+cord_cycles_thread_t *cord_cycles_thread_register(void);
+
+static inline uint64_t cord_cycles_now(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t cnt;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(cnt));
+    return cnt;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static inline uint32_t cord_cycles_bucket(uint64_t cycles)
+{
+    if (cycles < CORD_CYCLES_SUB_BUCKETS)
+        return (uint32_t)cycles;
+
+    uint32_t exp = 63 - __builtin_clzll(cycles);
+    if (exp > CORD_CYCLES_MAX_EXP)
+        return CORD_CYCLES_BUCKETS - 1;
+
+    uint32_t sub = (uint32_t)(cycles >> (exp - CORD_CYCLES_SUB_BITS)) & (CORD_CYCLES_SUB_BUCKETS - 1);
+    return (exp - CORD_CYCLES_SUB_BITS + 1) * CORD_CYCLES_SUB_BUCKETS + sub;
+}
+
+// Smallest value that falls into the bucket
+static inline uint64_t cord_cycles_bucket_floor(uint32_t bucket)
+{
+    if (bucket < CORD_CYCLES_SUB_BUCKETS)
+        return bucket;
+
+    uint32_t exp = bucket / CORD_CYCLES_SUB_BUCKETS + CORD_CYCLES_SUB_BITS - 1;
+    uint64_t sub = bucket % CORD_CYCLES_SUB_BUCKETS;
+    return (CORD_CYCLES_SUB_BUCKETS + sub) << (exp - CORD_CYCLES_SUB_BITS);
+}
+
+static inline void cord_cycles_record(cord_cycles_stage_t stage, uint64_t cycles)
+{
+    cord_cycles_thread_t *self = cord_cycles_self;
+    if (cord_unlikely(!self))
+        self = cord_cycles_thread_register();
+
+    cord_cycles_hist_t *hist = &self->stages[stage];
+    hist->count++;
+    hist->total += cycles;
+    if (cycles > hist->max)
+        hist->max = cycles;
+    hist->buckets[cord_cycles_bucket(cycles)]++;
+}
+
+#ifdef CORD_FLOW_CYCLES
+#define CORD_CYCLES_START(var)          uint64_t var = cord_cycles_now()
+#define CORD_CYCLES_STOP(var, stage)    cord_cycles_record((stage), cord_cycles_now() - (var))
+#else
+#define CORD_CYCLES_START(var)          do { } while (0)
+#define CORD_CYCLES_STOP(var, stage)    do { } while (0)
+#endif
+
+//
+// Readers (merge all threads; safe while the workers run, results may trail by a burst)
+//
+
+void cord_cycles_get(cord_cycles_stage_t stage, cord_cycles_hist_t *hist);
+
+// Value below which the given fraction (0.0 - 1.0) of the bursts fall (bucket floor)
+uint64_t cord_cycles_percentile(const cord_cycles_hist_t *hist, double fraction);
+
+const char *cord_cycles_stage_name(cord_cycles_stage_t stage);
+
+// TSC ticks per second, measured against CLOCK_MONOTONIC on first use
+uint64_t cord_cycles_hz(void);
+
+// Zeroes every thread's histograms (may lose a few concurrent records)
+void cord_cycles_reset(void);
+
+void cord_cycles_print_stats(void);
+
+#endif // CORD_CYCLES_H
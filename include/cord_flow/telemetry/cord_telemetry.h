@@ -0,0 +1,185 @@
+#ifndef CORD_TELEMETRY_H
+#define CORD_TELEMETRY_H
+
+#include <cord_type.h>
+#include <memory/cord_memory.h>
+#include <memory/cord_arena.h>
+#include <memory/cord_pkt_pool.h>
+#include <flow_point/cord_flow_point.h>
+#include <table/cord_cam.h>
+#include <table/cord_lpm.h>
+#include <table/cord_acl.h>
+#include <table/cord_nexthop.h>
+#include <pipeline/cord_pipeline.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+//
+// CORD Telemetry - Shared memory export of the library counters
+//
+// A POSIX shared memory segment (/dev/shm/<name>) holds a snapshot of every registered
+// source: flow points, tables, pipelines, packet pools, arenas, the conntrack and the
+// per-stage cycle histograms.
+//
+// - Publisher: a background thread (or explicit cord_telemetry_publish() calls) reads
+//   the counters the workers already keep and copies them into the segment; the workers
+//   are never signalled, locked or asked for anything
+// - The whole segment is protected by a seqlock: the publisher makes the sequence odd,
+//   writes, and makes it even again; readers copy and retry if the sequence moved
+// - Readers (cord_flow_telemetry, or any process) map the segment read-only
+// - Each counter has a name, an optional Prometheus label (e.g. size="4-7") and a kind;
+//   CORD_TELEMETRY_COUNTER values only grow, so readers can turn them into rates
+//
+
+#define CORD_TELEMETRY_MAGIC            0x43544c4d  // "CTLM"
+#define CORD_TELEMETRY_VERSION          1
+#define CORD_TELEMETRY_DEFAULT_NAME     "/cord_flow_telemetry"
+#define CORD_TELEMETRY_DEFAULT_INTERVAL_MS 1000
+
+#define CORD_TELEMETRY_MAX_SOURCES      64
+#define CORD_TELEMETRY_MAX_COUNTERS     48
+#define CORD_TELEMETRY_NAME_LEN         32
+#define CORD_TELEMETRY_LABEL_LEN        24
+#define CORD_TELEMETRY_READ_RETRIES     1000
+
+typedef enum
+{
+    CORD_TELEMETRY_SOURCE_FLOW_POINT = 0,
+    CORD_TELEMETRY_SOURCE_L2_CAM,
+    CORD_TELEMETRY_SOURCE_IPV4_LPM,
+    CORD_TELEMETRY_SOURCE_IPV6_LPM,
+    CORD_TELEMETRY_SOURCE_ACL,
+    CORD_TELEMETRY_SOURCE_NEXTHOP,
+    CORD_TELEMETRY_SOURCE_PIPELINE,
+    CORD_TELEMETRY_SOURCE_PKT_POOL,
+    CORD_TELEMETRY_SOURCE_ARENA,
+    CORD_TELEMETRY_SOURCE_CONNTRACK,
+    CORD_TELEMETRY_SOURCE_CUSTOM,
+    CORD_TELEMETRY_SOURCE_CYCLES,
+    CORD_TELEMETRY_SOURCE_TYPE_COUNT
+} cord_telemetry_source_type_t;
+
+typedef enum
+{
+    CORD_TELEMETRY_COUNTER = 0,           // Monotonic
+    CORD_TELEMETRY_GAUGE                  // Current level
+} cord_telemetry_kind_t;
+
+typedef struct
+{
+    char name[CORD_TELEMETRY_NAME_LEN];   // e.g. "rx_packets"
+    char label[CORD_TELEMETRY_LABEL_LEN]; // Prometheus label pair or "" (e.g. stage="2")
+    uint32_t kind;                        // cord_telemetry_kind_t
+} cord_telemetry_counter_desc_t;
+
+//
+// Shared memory layout (shared with the readers, bump CORD_TELEMETRY_VERSION on change)
+//
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t segment_size;                // sizeof(cord_telemetry_segment_t)
+    uint32_t interval_ms;                 // Publisher period (0 = manual publishing)
+    _Atomic uint64_t seq;                 // Seqlock sequence, odd while the publisher writes
+    uint64_t timestamp_ns;                // CLOCK_MONOTONIC time of the snapshot
+    uint64_t snapshot_count;
+    uint32_t num_sources;                 // Used slots (unregistered slots have num_counters 0)
+    uint32_t pid;                         // Publishing process
+} __attribute__((aligned(CORD_CACHE_LINE_SIZE))) cord_telemetry_header_t;
+
+typedef struct
+{
+    char name[CORD_TELEMETRY_NAME_LEN];   // Instance name, e.g. "eth0" or "fib"
+    uint32_t type;                        // cord_telemetry_source_type_t
+    uint32_t num_counters;
+    cord_telemetry_counter_desc_t counters[CORD_TELEMETRY_MAX_COUNTERS];
+    uint64_t values[CORD_TELEMETRY_MAX_COUNTERS];
+} cord_telemetry_source_t;
+
+typedef struct
+{
+    cord_telemetry_header_t header;
+    cord_telemetry_source_t sources[CORD_TELEMETRY_MAX_SOURCES];
+} cord_telemetry_segment_t;
+
+//
+// Publisher
+//
+
+// Fills values[] (num_counters of the registration) from obj; runs on the publisher thread
+typedef void (*cord_telemetry_collect_fn)(const void *obj, uint64_t *values);
+
+typedef struct
+{
+    const void *obj;
+    cord_telemetry_collect_fn collect;
+} cord_telemetry_binding_t;
+
+typedef struct
+{
+    cord_telemetry_segment_t *segment;    // Shared mapping
+    char shm_name[64];
+    cord_telemetry_binding_t bindings[CORD_TELEMETRY_MAX_SOURCES];
+    uint64_t staging[CORD_TELEMETRY_MAX_SOURCES][CORD_TELEMETRY_MAX_COUNTERS]; // Collected before the write section
+    atomic_flag lock;                     // Serialises registration and publishing
+    uint32_t interval_ms;
+    pthread_t thread;
+    atomic_bool running;
+} cord_telemetry_t;
+
+// Creates (or takes over) the segment; shm_name NULL = CORD_TELEMETRY_DEFAULT_NAME
+cord_telemetry_t *cord_telemetry_create(const char *shm_name, uint32_t interval_ms);
+
+// Stops the publisher and removes the segment
+void cord_telemetry_destroy(cord_telemetry_t *telemetry);
+
+// Background publishing every interval_ms; returns 0 on success, -1 on failure
+int cord_telemetry_start(cord_telemetry_t *telemetry);
+void cord_telemetry_stop(cord_telemetry_t *telemetry);
+
+// One snapshot of all sources into the segment
+void cord_telemetry_publish(cord_telemetry_t *telemetry);
+
+// Registration: returns 0 on success, -1 on failure (no free slot, bad parameters)
+int cord_telemetry_register(cord_telemetry_t *telemetry, const char *name, cord_telemetry_source_type_t type,
+                            const cord_telemetry_counter_desc_t *counters, uint32_t num_counters,
+                            cord_telemetry_collect_fn collect, const void *obj);
+int cord_telemetry_unregister(cord_telemetry_t *telemetry, const void *obj);
+
+// Registration of the library objects
+struct cord_connection_tracker_t;
+int cord_telemetry_register_flow_point(cord_telemetry_t *telemetry, const char *name, const CordFlowPoint *fp);
+int cord_telemetry_register_l2_cam(cord_telemetry_t *telemetry, const char *name, const cord_l2_cam_t *cam);
+int cord_telemetry_register_ipv4_lpm(cord_telemetry_t *telemetry, const char *name, const cord_ipv4_lpm_t *lpm);
+int cord_telemetry_register_ipv6_lpm(cord_telemetry_t *telemetry, const char *name, const cord_ipv6_lpm_t *lpm);
+int cord_telemetry_register_acl(cord_telemetry_t *telemetry, const char *name, const cord_acl_t *acl);
+int cord_telemetry_register_nexthop(cord_telemetry_t *telemetry, const char *name, const cord_nexthop_table_t *table);
+int cord_telemetry_register_pipeline(cord_telemetry_t *telemetry, const char *name, const cord_pipeline_t *pipeline);
+int cord_telemetry_register_pkt_pool(cord_telemetry_t *telemetry, const char *name, const cord_pkt_pool_t *pool);
+int cord_telemetry_register_arena(cord_telemetry_t *telemetry, const char *name, const cord_arena_t *arena);
+int cord_telemetry_register_conntrack(cord_telemetry_t *telemetry, const char *name, const struct cord_connection_tracker_t *tracker);
+
+// Per-stage cycle histograms (cord_cycles.h); all zero unless built with CORD_FLOW_CYCLES
+int cord_telemetry_register_cycles(cord_telemetry_t *telemetry, const char *name);
+int cord_telemetry_unregister_cycles(cord_telemetry_t *telemetry);
+
+//
+// Reader
+//
+
+// Maps the segment read-only; returns NULL if it does not exist or has another layout version
+const cord_telemetry_segment_t *cord_telemetry_attach(const char *shm_name);
+void cord_telemetry_detach(const cord_telemetry_segment_t *segment);
+
+// Consistent copy of the segment; returns 0 on success, -1 if the publisher kept writing
+int cord_telemetry_read(const cord_telemetry_segment_t *segment, cord_telemetry_segment_t *snapshot);
+
+const char *cord_telemetry_source_type_name(uint32_t type);
+
+// Prometheus text exposition format, written atomically (temporary file + rename)
+// so it can be picked up by the node_exporter textfile collector; returns 0 / -1
+int cord_telemetry_write_prometheus(const cord_telemetry_segment_t *snapshot, const char *path);
+
+#endif // CORD_TELEMETRY_H
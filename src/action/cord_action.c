@@ -1,5 +1,13 @@
 #include <action/cord_action.h>
 #include <stdint.h>
+#include <stddef.h>
+#include <endian.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 //
 // Compare
@@ -254,26 +262,260 @@ bool cord_compare_ipv4_last_fragment_ntohs(const cord_ipv4_hdr_t *ip)
 // IPv4 checksum validation
 bool cord_compare_if_ipv4_checksum_valid(const cord_ipv4_hdr_t *ip_hdr)
 {
-    uint32_t sum = 0;
-    const uint8_t *ptr = (const uint8_t *) ip_hdr;
-    uint8_t ihl = ip_hdr->ihl * 4; // Header length in bytes
+    // Sum all 16-bit words including the checksum field: a valid header folds to 0xFFFF
+    return cord_csum_fold(cord_csum_partial(ip_hdr, ip_hdr->ihl * 4, 0)) == 0xFFFF;
+}
+
+// L4 checksum validation (IPv4)
+//
+// len is the number of bytes available from the IP header on. The checksummed length
+// comes from the headers and is rejected when it underflows or runs past len.
+static inline bool cord_ipv4_l4_len_checked(const cord_ipv4_hdr_t *ip_hdr, uint32_t len,
+                                            uint32_t min_l4_len, uint16_t *l4_len)
+{
+    uint32_t ihl_bytes = ip_hdr->ihl * 4u;
+    uint32_t tot_len = cord_ntohs(ip_hdr->tot_len);
+
+    if (ip_hdr->ihl < 5 || tot_len > len || tot_len < ihl_bytes + min_l4_len)
+    {
+        return false;
+    }
+
+    *l4_len = (uint16_t)(tot_len - ihl_bytes);
+    return true;
+}
+
+bool cord_compare_if_tcp_checksum_valid_ipv4(const cord_ipv4_hdr_t *ip_hdr, uint32_t len)
+{
+    uint16_t tcp_len;
+
+    if (ip_hdr->protocol != CORD_IPPROTO_TCP ||
+        !cord_ipv4_l4_len_checked(ip_hdr, len, sizeof(cord_tcp_hdr_t), &tcp_len))
+    {
+        return false;
+    }
+
+    uint32_t sum = cord_csum_pseudo_ipv4(ip_hdr->saddr.addr, ip_hdr->daddr.addr, CORD_IPPROTO_TCP, tcp_len);
+    sum = cord_csum_partial((const uint8_t *) ip_hdr + ip_hdr->ihl * 4, tcp_len, sum);
+    return cord_csum_fold(sum) == 0xFFFF;
+}
+
+bool cord_compare_if_udp_checksum_valid_ipv4(const cord_ipv4_hdr_t *ip_hdr, uint32_t len)
+{
+    uint16_t ip_payload_len;
+
+    if (ip_hdr->protocol != CORD_IPPROTO_UDP ||
+        !cord_ipv4_l4_len_checked(ip_hdr, len, sizeof(cord_udp_hdr_t), &ip_payload_len))
+    {
+        return false;
+    }
+
+    const cord_udp_hdr_t *udp_hdr = (const cord_udp_hdr_t *) ((const uint8_t *) ip_hdr + ip_hdr->ihl * 4);
+    if (udp_hdr->check == 0)
+    {
+        return true; // Checksum not used
+    }
+
+    uint16_t udp_len = cord_ntohs(udp_hdr->len);
+    if (udp_len < sizeof(cord_udp_hdr_t) || udp_len > ip_payload_len)
+    {
+        return false;
+    }
+
+    uint32_t sum = cord_csum_pseudo_ipv4(ip_hdr->saddr.addr, ip_hdr->daddr.addr, CORD_IPPROTO_UDP, udp_len);
+    sum = cord_csum_partial(udp_hdr, udp_len, sum);
+    return cord_csum_fold(sum) == 0xFFFF;
+}
+
+bool cord_compare_if_icmp_checksum_valid_ipv4(const cord_ipv4_hdr_t *ip_hdr, uint32_t len)
+{
+    uint16_t icmp_len;
+
+    if (ip_hdr->protocol != CORD_IPPROTO_ICMP ||
+        !cord_ipv4_l4_len_checked(ip_hdr, len, sizeof(cord_icmp_hdr_t), &icmp_len))
+    {
+        return false;
+    }
+
+    return cord_csum_fold(cord_csum_partial((const uint8_t *) ip_hdr + ip_hdr->ihl * 4, icmp_len, 0)) == 0xFFFF;
+}
+
+// L4 checksum validation (IPv6, no extension headers)
+static inline bool cord_ipv6_l4_len_checked(const cord_ipv6_hdr_t *ip6_hdr, uint32_t len,
+                                            uint32_t min_l4_len, uint16_t *l4_len)
+{
+    uint32_t payload_len = cord_ntohs(ip6_hdr->payload_len);
+
+    if (len < sizeof(cord_ipv6_hdr_t) || payload_len > len - sizeof(cord_ipv6_hdr_t) || payload_len < min_l4_len)
+    {
+        return false;
+    }
+
+    *l4_len = (uint16_t)payload_len;
+    return true;
+}
+
+bool cord_compare_if_tcp_checksum_valid_ipv6(const cord_ipv6_hdr_t *ip6_hdr, uint32_t len)
+{
+    uint16_t tcp_len;
+
+    if (ip6_hdr->nexthdr != CORD_IPPROTO_TCP ||
+        !cord_ipv6_l4_len_checked(ip6_hdr, len, sizeof(cord_tcp_hdr_t), &tcp_len))
+    {
+        return false;
+    }
+
+    uint32_t sum = cord_csum_pseudo_ipv6(&ip6_hdr->saddr, &ip6_hdr->daddr, CORD_IPPROTO_TCP, tcp_len);
+    sum = cord_csum_partial((const uint8_t *) ip6_hdr + sizeof(cord_ipv6_hdr_t), tcp_len, sum);
+    return cord_csum_fold(sum) == 0xFFFF;
+}
+
+bool cord_compare_if_udp_checksum_valid_ipv6(const cord_ipv6_hdr_t *ip6_hdr, uint32_t len)
+{
+    uint16_t ip_payload_len;
+
+    if (ip6_hdr->nexthdr != CORD_IPPROTO_UDP ||
+        !cord_ipv6_l4_len_checked(ip6_hdr, len, sizeof(cord_udp_hdr_t), &ip_payload_len))
+    {
+        return false;
+    }
+
+    const cord_udp_hdr_t *udp_hdr = (const cord_udp_hdr_t *) ((const uint8_t *) ip6_hdr + sizeof(cord_ipv6_hdr_t));
+    uint16_t udp_len = cord_ntohs(udp_hdr->len);
+    if (udp_len < sizeof(cord_udp_hdr_t) || udp_len > ip_payload_len)
+    {
+        return false;
+    }
+
+    uint32_t sum = cord_csum_pseudo_ipv6(&ip6_hdr->saddr, &ip6_hdr->daddr, CORD_IPPROTO_UDP, udp_len);
+    sum = cord_csum_partial(udp_hdr, udp_len, sum);
+    return udp_hdr->check != 0 && cord_csum_fold(sum) == 0xFFFF;
+}
+
+bool cord_compare_if_icmpv6_checksum_valid(const cord_ipv6_hdr_t *ip6_hdr, uint32_t len)
+{
+    uint16_t icmp6_len;
+
+    if (ip6_hdr->nexthdr != CORD_IPPROTO_ICMPV6 ||
+        !cord_ipv6_l4_len_checked(ip6_hdr, len, sizeof(cord_icmpv6_hdr_t), &icmp6_len))
+    {
+        return false;
+    }
+
+    uint32_t sum = cord_csum_pseudo_ipv6(&ip6_hdr->saddr, &ip6_hdr->daddr, CORD_IPPROTO_ICMPV6, icmp6_len);
+    sum = cord_csum_partial((const uint8_t *) ip6_hdr + sizeof(cord_ipv6_hdr_t), icmp6_len, sum);
+    return cord_csum_fold(sum) == 0xFFFF;
+}
+
+bool cord_compare_if_sctp_checksum_valid_ipv4(const cord_ipv4_hdr_t *ip_hdr, uint32_t len)
+{
+    uint16_t sctp_len;
+
+    if (ip_hdr->protocol != CORD_IPPROTO_SCTP ||
+        !cord_ipv4_l4_len_checked(ip_hdr, len, sizeof(cord_sctp_hdr_t), &sctp_len))
+    {
+        return false;
+    }
+
+    const cord_sctp_hdr_t *sctp_hdr = (const cord_sctp_hdr_t *) ((const uint8_t *) ip_hdr + ip_hdr->ihl * 4);
+    return sctp_hdr->checksum == cord_calculate_sctp_checksum_ipv4(ip_hdr);
+}
+
+bool cord_compare_if_sctp_checksum_valid_ipv6(const cord_ipv6_hdr_t *ip6_hdr, uint32_t len)
+{
+    uint16_t sctp_len;
+
+    if (ip6_hdr->nexthdr != CORD_IPPROTO_SCTP ||
+        !cord_ipv6_l4_len_checked(ip6_hdr, len, sizeof(cord_sctp_hdr_t), &sctp_len))
+    {
+        return false;
+    }
+
+    const cord_sctp_hdr_t *sctp_hdr = (const cord_sctp_hdr_t *) ((const uint8_t *) ip6_hdr + sizeof(cord_ipv6_hdr_t));
+    return sctp_hdr->checksum == cord_calculate_sctp_checksum_ipv6(ip6_hdr);
+}
+
+#ifdef ENABLE_DPDK_DATAPLANE
+// Offload-aware validation: trust the NIC verdict in ol_flags, verify in software otherwise
+bool cord_compare_if_ipv4_checksum_valid_offload(const struct rte_mbuf *mbuf, const cord_ipv4_hdr_t *ip_hdr)
+{
+    uint64_t flags = mbuf->ol_flags & RTE_MBUF_F_RX_IP_CKSUM_MASK;
+
+    if (flags == RTE_MBUF_F_RX_IP_CKSUM_GOOD)
+    {
+        return true;
+    }
+
+    if (flags == RTE_MBUF_F_RX_IP_CKSUM_BAD)
+    {
+        return false;
+    }
+
+    return cord_compare_if_ipv4_checksum_valid(ip_hdr);
+}
+
+bool cord_compare_if_l4_checksum_valid_offload_ipv4(const struct rte_mbuf *mbuf, const cord_ipv4_hdr_t *ip_hdr)
+{
+    uint64_t flags = mbuf->ol_flags & RTE_MBUF_F_RX_L4_CKSUM_MASK;
+
+    if (flags == RTE_MBUF_F_RX_L4_CKSUM_GOOD)
+    {
+        return true;
+    }
+
+    if (flags == RTE_MBUF_F_RX_L4_CKSUM_BAD)
+    {
+        return false;
+    }
+
+    uint32_t len = rte_pktmbuf_data_len(mbuf) - (uint32_t)((const uint8_t *) ip_hdr - rte_pktmbuf_mtod(mbuf, const uint8_t *));
+
+    switch (ip_hdr->protocol)
+    {
+        case CORD_IPPROTO_TCP:
+            return cord_compare_if_tcp_checksum_valid_ipv4(ip_hdr, len);
+        case CORD_IPPROTO_UDP:
+            return cord_compare_if_udp_checksum_valid_ipv4(ip_hdr, len);
+        case CORD_IPPROTO_ICMP:
+            return cord_compare_if_icmp_checksum_valid_ipv4(ip_hdr, len);
+        case CORD_IPPROTO_SCTP:
+            return cord_compare_if_sctp_checksum_valid_ipv4(ip_hdr, len);
+        default:
+            return true;
+    }
+}
+
+bool cord_compare_if_l4_checksum_valid_offload_ipv6(const struct rte_mbuf *mbuf, const cord_ipv6_hdr_t *ip6_hdr)
+{
+    uint64_t flags = mbuf->ol_flags & RTE_MBUF_F_RX_L4_CKSUM_MASK;
 
-    // Sum all 16-bit words including checksum field
-    for (uint8_t i = 0; i < ihl; i += 2)
+    if (flags == RTE_MBUF_F_RX_L4_CKSUM_GOOD)
     {
-        uint16_t word = (ptr[i] << 8) | ptr[i + 1];
-        sum += word;
+        return true;
     }
 
-    // Add carry bits and take one's complement
-    while (sum >> 16)
+    if (flags == RTE_MBUF_F_RX_L4_CKSUM_BAD)
     {
-        sum = (sum & 0xFFFF) + (sum >> 16);
+        return false;
     }
 
-    // For a valid checksum, the result should be 0
-    return (~sum) == 0;
+    uint32_t len = rte_pktmbuf_data_len(mbuf) - (uint32_t)((const uint8_t *) ip6_hdr - rte_pktmbuf_mtod(mbuf, const uint8_t *));
+
+    switch (ip6_hdr->nexthdr)
+    {
+        case CORD_IPPROTO_TCP:
+            return cord_compare_if_tcp_checksum_valid_ipv6(ip6_hdr, len);
+        case CORD_IPPROTO_UDP:
+            return cord_compare_if_udp_checksum_valid_ipv6(ip6_hdr, len);
+        case CORD_IPPROTO_ICMPV6:
+            return cord_compare_if_icmpv6_checksum_valid(ip6_hdr, len);
+        case CORD_IPPROTO_SCTP:
+            return cord_compare_if_sctp_checksum_valid_ipv6(ip6_hdr, len);
+        default:
+            return true;
+    }
 }
+#endif // ENABLE_DPDK_DATAPLANE
 
 // L3 IPv6 Compare Functions
 bool cord_compare_ipv6_version(const cord_ipv6_hdr_t *ip6)
@@ -1250,6 +1492,185 @@ void cord_set_field_icmp_sequence_htons(cord_icmp_hdr_t *icmp, uint16_t sequence
     icmp->un.echo.sequence = cord_htons(sequence);
 }
 
+//
+// Set with incremental checksum update (RFC 1624)
+//
+
+// Patch the TCP/UDP checksum covering the IPv4 pseudo-header after an address change
+static void ipv4_l4_csum_replace32(cord_ipv4_hdr_t *ip, uint32_t old_addr, uint32_t new_addr)
+{
+    // Non-first fragments carry no L4 header
+    if (ip->frag_off & cord_htons(0x1FFF))
+    {
+        return;
+    }
+
+    uint8_t *l4 = (uint8_t *)ip + (ip->ihl * 4);
+
+    if (ip->protocol == CORD_IPPROTO_TCP)
+    {
+        cord_tcp_hdr_t *tcp = (cord_tcp_hdr_t *)l4;
+        tcp->check = cord_csum_replace32(tcp->check, old_addr, new_addr);
+    }
+    else if (ip->protocol == CORD_IPPROTO_UDP)
+    {
+        cord_udp_hdr_t *udp = (cord_udp_hdr_t *)l4;
+        udp->check = cord_csum_replace32_udp(udp->check, old_addr, new_addr);
+    }
+}
+
+// Patch the header checksum after an 8-bit field change (offset of its 16-bit word)
+static inline void ipv4_csum_replace_word(cord_ipv4_hdr_t *ip, size_t offset, uint16_t old_word)
+{
+    uint16_t new_word;
+    memcpy(&new_word, (uint8_t *)ip + offset, sizeof(uint16_t));
+    ip->check = cord_csum_replace16(ip->check, old_word, new_word);
+}
+
+// IPv4 Field Setters (checksum-aware)
+void cord_set_field_ipv4_tos_csum(cord_ipv4_hdr_t *ip, uint8_t tos)
+{
+    uint16_t old_word;
+    memcpy(&old_word, ip, sizeof(uint16_t));
+    ip->tos = tos;
+    ipv4_csum_replace_word(ip, 0, old_word);
+}
+
+void cord_set_field_ipv4_dscp_csum(cord_ipv4_hdr_t *ip, uint8_t dscp)
+{
+    cord_set_field_ipv4_tos_csum(ip, (ip->tos & 0x03) | ((dscp & 0x3F) << 2));
+}
+
+void cord_set_field_ipv4_ecn_csum(cord_ipv4_hdr_t *ip, uint8_t ecn)
+{
+    cord_set_field_ipv4_tos_csum(ip, (ip->tos & 0xFC) | (ecn & 0x03));
+}
+
+void cord_set_field_ipv4_id_csum(cord_ipv4_hdr_t *ip, uint16_t id)
+{
+    ip->check = cord_csum_replace16(ip->check, ip->id, id);
+    ip->id = id;
+}
+
+void cord_set_field_ipv4_id_csum_htons(cord_ipv4_hdr_t *ip, uint16_t id)
+{
+    cord_set_field_ipv4_id_csum(ip, cord_htons(id));
+}
+
+void cord_set_field_ipv4_ttl_csum(cord_ipv4_hdr_t *ip, uint8_t ttl)
+{
+    uint16_t old_word;
+    memcpy(&old_word, (uint8_t *)ip + offsetof(cord_ipv4_hdr_t, ttl), sizeof(uint16_t)); // TTL + protocol
+    ip->ttl = ttl;
+    ipv4_csum_replace_word(ip, offsetof(cord_ipv4_hdr_t, ttl), old_word);
+}
+
+void cord_set_field_ipv4_src_addr_csum(cord_ipv4_hdr_t *ip, uint32_t addr)
+{
+    uint32_t old_addr = ip->saddr.addr;
+    ip->saddr.addr = addr;
+    ip->check = cord_csum_replace32(ip->check, old_addr, addr);
+    ipv4_l4_csum_replace32(ip, old_addr, addr);
+}
+
+void cord_set_field_ipv4_src_addr_csum_htonl(cord_ipv4_hdr_t *ip, uint32_t addr)
+{
+    cord_set_field_ipv4_src_addr_csum(ip, cord_htonl(addr));
+}
+
+void cord_set_field_ipv4_dst_addr_csum(cord_ipv4_hdr_t *ip, uint32_t addr)
+{
+    uint32_t old_addr = ip->daddr.addr;
+    ip->daddr.addr = addr;
+    ip->check = cord_csum_replace32(ip->check, old_addr, addr);
+    ipv4_l4_csum_replace32(ip, old_addr, addr);
+}
+
+void cord_set_field_ipv4_dst_addr_csum_htonl(cord_ipv4_hdr_t *ip, uint32_t addr)
+{
+    cord_set_field_ipv4_dst_addr_csum(ip, cord_htonl(addr));
+}
+
+// TCP Field Setters (checksum-aware)
+void cord_set_field_tcp_src_port_csum(cord_tcp_hdr_t *tcp, uint16_t port)
+{
+    tcp->check = cord_csum_replace16(tcp->check, tcp->source, port);
+    tcp->source = port;
+}
+
+void cord_set_field_tcp_src_port_csum_htons(cord_tcp_hdr_t *tcp, uint16_t port)
+{
+    cord_set_field_tcp_src_port_csum(tcp, cord_htons(port));
+}
+
+void cord_set_field_tcp_dst_port_csum(cord_tcp_hdr_t *tcp, uint16_t port)
+{
+    tcp->check = cord_csum_replace16(tcp->check, tcp->dest, port);
+    tcp->dest = port;
+}
+
+void cord_set_field_tcp_dst_port_csum_htons(cord_tcp_hdr_t *tcp, uint16_t port)
+{
+    cord_set_field_tcp_dst_port_csum(tcp, cord_htons(port));
+}
+
+void cord_set_field_tcp_seq_num_csum(cord_tcp_hdr_t *tcp, uint32_t seq)
+{
+    tcp->check = cord_csum_replace32(tcp->check, tcp->seq, seq);
+    tcp->seq = seq;
+}
+
+void cord_set_field_tcp_seq_num_csum_htonl(cord_tcp_hdr_t *tcp, uint32_t seq)
+{
+    cord_set_field_tcp_seq_num_csum(tcp, cord_htonl(seq));
+}
+
+void cord_set_field_tcp_ack_num_csum(cord_tcp_hdr_t *tcp, uint32_t ack)
+{
+    tcp->check = cord_csum_replace32(tcp->check, tcp->ack_seq, ack);
+    tcp->ack_seq = ack;
+}
+
+void cord_set_field_tcp_ack_num_csum_htonl(cord_tcp_hdr_t *tcp, uint32_t ack)
+{
+    cord_set_field_tcp_ack_num_csum(tcp, cord_htonl(ack));
+}
+
+// UDP Field Setters (checksum-aware)
+void cord_set_field_udp_src_port_csum(cord_udp_hdr_t *udp, uint16_t port)
+{
+    udp->check = cord_csum_replace16_udp(udp->check, udp->source, port);
+    udp->source = port;
+}
+
+void cord_set_field_udp_src_port_csum_htons(cord_udp_hdr_t *udp, uint16_t port)
+{
+    cord_set_field_udp_src_port_csum(udp, cord_htons(port));
+}
+
+void cord_set_field_udp_dst_port_csum(cord_udp_hdr_t *udp, uint16_t port)
+{
+    udp->check = cord_csum_replace16_udp(udp->check, udp->dest, port);
+    udp->dest = port;
+}
+
+void cord_set_field_udp_dst_port_csum_htons(cord_udp_hdr_t *udp, uint16_t port)
+{
+    cord_set_field_udp_dst_port_csum(udp, cord_htons(port));
+}
+
+// ICMP Field Setters (checksum-aware)
+void cord_set_field_icmp_id_csum(cord_icmp_hdr_t *icmp, uint16_t id)
+{
+    icmp->checksum = cord_csum_replace16(icmp->checksum, icmp->un.echo.id, id);
+    icmp->un.echo.id = id;
+}
+
+void cord_set_field_icmp_id_csum_htons(cord_icmp_hdr_t *icmp, uint16_t id)
+{
+    cord_set_field_icmp_id_csum(icmp, cord_htons(id));
+}
+
 //
 // Calculate
 //
@@ -1257,47 +1678,8 @@ void cord_set_field_icmp_sequence_htons(cord_icmp_hdr_t *icmp, uint16_t sequence
 // Ethernet frame CRC32 calculation
 uint32_t cord_calculate_ethernet_crc32(const void *buffer, size_t frame_len)
 {
-    // Standard Ethernet CRC32 polynomial: 0x04C11DB7
-    static const uint32_t crc_table[256] = {
-        0x00000000, 0x77073096, 0xEE0E612C, 0x990951BA, 0x076DC419, 0x706AF48F, 0xE963A535, 0x9E6495A3, 0x0EDB8832,
-        0x79DCB8A4, 0xE0D5E91E, 0x97D2D988, 0x09B64C2B, 0x7EB17CBD, 0xE7B82D07, 0x90BF1D91, 0x1DB71064, 0x6AB020F2,
-        0xF3B97148, 0x84BE41DE, 0x1ADAD47D, 0x6DDDE4EB, 0xF4D4B551, 0x83D385C7, 0x136C9856, 0x646BA8C0, 0xFD62F97A,
-        0x8A65C9EC, 0x14015C4F, 0x63066CD9, 0xFA0F3D63, 0x8D080DF5, 0x3B6E20C8, 0x4C69105E, 0xD56041E4, 0xA2677172,
-        0x3C03E4D1, 0x4B04D447, 0xD20D85FD, 0xA50AB56B, 0x35B5A8FA, 0x42B2986C, 0xDBBBC9D6, 0xACBCF940, 0x32D86CE3,
-        0x45DF5C75, 0xDCD60DCF, 0xABD13D59, 0x26D930AC, 0x51DE003A, 0xC8D75180, 0xBFD06116, 0x21B4F4B5, 0x56B3C423,
-        0xCFBA9599, 0xB8BDA50F, 0x2802B89E, 0x5F058808, 0xC60CD9B2, 0xB10BE924, 0x2F6F7C87, 0x58684C11, 0xC1611DAB,
-        0xB6662D3D, 0x76DC4190, 0x01DB7106, 0x98D220BC, 0xEFD5102A, 0x71B18589, 0x06B6B51F, 0x9FBFE4A5, 0xE8B8D433,
-        0x7807C9A2, 0x0F00F934, 0x9609A88E, 0xE10E9818, 0x7F6A0DBB, 0x086D3D2D, 0x91646C97, 0xE6635C01, 0x6B6B51F4,
-        0x1C6C6162, 0x856530D8, 0xF262004E, 0x6C0695ED, 0x1B01A57B, 0x8208F4C1, 0xF50FC457, 0x65B0D9C6, 0x12B7E950,
-        0x8BBEB8EA, 0xFCB9887C, 0x62DD1DDF, 0x15DA2D49, 0x8CD37CF3, 0xFBD44C65, 0x4DB26158, 0x3AB551CE, 0xA3BC0074,
-        0xD4BB30E2, 0x4ADFA541, 0x3DD895D7, 0xA4D1C46D, 0xD3D6F4FB, 0x4369E96A, 0x346ED9FC, 0xAD678846, 0xDA60B8D0,
-        0x44042D73, 0x33031DE5, 0xAA0A4C5F, 0xDD0D7CC9, 0x5005713C, 0x270241AA, 0xBE0B1010, 0xC90C2086, 0x5768B525,
-        0x206F85B3, 0xB966D409, 0xCE61E49F, 0x5EDEF90E, 0x29D9C998, 0xB0D09822, 0xC7D7A8B4, 0x59B33D17, 0x2EB40D81,
-        0xB7BD5C3B, 0xC0BA6CAD, 0xEDB88320, 0x9ABFB3B6, 0x03B6E20C, 0x74B1D29A, 0xEAD54739, 0x9DD277AF, 0x04DB2615,
-        0x73DC1683, 0xE3630B12, 0x94643B84, 0x0D6D6A3E, 0x7A6A5AA8, 0xE40ECF0B, 0x9309FF9D, 0x0A00AE27, 0x7D079EB1,
-        0xF00F9344, 0x8708A3D2, 0x1E01F268, 0x6906C2FE, 0xF762575D, 0x806567CB, 0x196C3671, 0x6E6B06E7, 0xFED41B76,
-        0x89D32BE0, 0x10DA7A5A, 0x67DD4ACC, 0xF9B9DF6F, 0x8EBEEFF9, 0x17B7BE43, 0x60B08ED5, 0xD6D6A3E8, 0xA1D1937E,
-        0x38D8C2C4, 0x4FDFF252, 0xD1BB67F1, 0xA6BC5767, 0x3FB506DD, 0x48B2364B, 0xD80D2BDA, 0xAF0A1B4C, 0x36034AF6,
-        0x41047A60, 0xDF60EFC3, 0xA867DF55, 0x316E8EEF, 0x4669BE79, 0xCB61B38C, 0xBC66831A, 0x256FD2A0, 0x5268E236,
-        0xCC0C7795, 0xBB0B4703, 0x220216B9, 0x5505262F, 0xC5BA3BBE, 0xB2BD0B28, 0x2BB45A92, 0x5CB36A04, 0xC2D7FFA7,
-        0xB5D0CF31, 0x2CD99E8B, 0x5BDEAE1D, 0x9B64C2B0, 0xEC63F226, 0x756AA39C, 0x026D930A, 0x9C0906A9, 0xEB0E363F,
-        0x72076785, 0x05005713, 0x95BF4A82, 0xE2B87A14, 0x7BB12BAE, 0x0CB61B38, 0x92D28E9B, 0xE5D5BE0D, 0x7CDCEFB7,
-        0x0BDBDF21, 0x86D3D2D4, 0xF1D4E242, 0x68DDB3F8, 0x1FDA836E, 0x81BE16CD, 0xF6B9265B, 0x6FB077E1, 0x18B74777,
-        0x88085AE6, 0xFF0F6A70, 0x66063BCA, 0x11010B5C, 0x8F659EFF, 0xF862AE69, 0x616BFFD3, 0x166CCF45, 0xA00AE278,
-        0xD70DD2EE, 0x4E048354, 0x3903B3C2, 0xA7672661, 0xD06016F7, 0x4969474D, 0x3E6E77DB, 0xAED16A4A, 0xD9D65ADC,
-        0x40DF0B66, 0x37D83BF0, 0xA9BCAE53, 0xDEBB9EC5, 0x47B2CF7F, 0x30B5FFE9, 0xBDBDF21C, 0xCABAC28A, 0x53B39330,
-        0x24B4A3A6, 0xBAD03605, 0xCDD70693, 0x54DE5729, 0x23D967BF, 0xB3667A2E, 0xC4614AB8, 0x5D681B02, 0x2A6F2B94,
-        0xB40BBE37, 0xC30C8EA1, 0x5A05DF1B, 0x2D02EF8D};
-
-    uint32_t crc = 0xFFFFFFFF;
-    const uint8_t *data = (const uint8_t *) buffer;
-
-    for (size_t i = 0; i < frame_len; i++)
-    {
-        crc = crc_table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
-    }
-
-    return ~crc;
+    // Standard Ethernet CRC32 polynomial: 0x04C11DB7 (hardware accelerated when available)
+    return cord_crc32(buffer, frame_len);
 }
 
 // IPv4 payload length calculation
@@ -1311,32 +1693,11 @@ uint16_t cord_calculate_ipv4_payload_length_ntohs(const cord_ipv4_hdr_t *ip_hdr)
 // IPv4 checksum calculation
 uint16_t cord_calculate_ipv4_checksum(const cord_ipv4_hdr_t *ip_hdr)
 {
-    uint32_t sum = 0;
-    const uint8_t *ptr = (const uint8_t *) ip_hdr;
-    uint8_t ihl = ip_hdr->ihl * 4; // Header length in bytes
-
-    // Save original checksum and zero it for calculation
-    uint16_t orig_check = ip_hdr->check;
-
-    // Sum all 16-bit words in the header (skip checksum field)
-    for (uint8_t i = 0; i < ihl; i += 2)
-    {
-        if (i == 10)
-            continue; // Skip checksum field at offset 10-11
-        uint16_t word = (ptr[i] << 8) | ptr[i + 1];
-        sum += word;
-    }
-
-    // Restore original checksum
-    *((uint16_t *) &ip_hdr->check) = orig_check;
-
-    // Add carry bits and take one's complement
-    while (sum >> 16)
-    {
-        sum = (sum & 0xFFFF) + (sum >> 16);
-    }
+    // Sum the whole header, then take the stored checksum back out
+    uint32_t sum = cord_csum_partial(ip_hdr, ip_hdr->ihl * 4, 0);
+    sum += (uint16_t)~ip_hdr->check;
 
-    return ~sum;
+    return cord_ntohs((uint16_t)~cord_csum_fold(sum));
 }
 
 // TCP checksum calculation for IPv4
@@ -1351,47 +1712,14 @@ uint16_t cord_calculate_tcp_checksum_ipv4(const cord_ipv4_hdr_t *ip_hdr)
     // Calculate IP header length and find TCP header
     uint8_t ip_hdr_len = ip_hdr->ihl * 4;
     const cord_tcp_hdr_t *tcp_hdr = (const cord_tcp_hdr_t *) ((const uint8_t *) ip_hdr + ip_hdr_len);
-
-    uint32_t sum = 0;
     uint16_t tcp_len = cord_calculate_ipv4_payload_length_ntohs(ip_hdr);
 
-    // Pseudo header: src addr + dst addr + zero + protocol + length
-    // Source address (network byte order, split into 16-bit words)
-    sum += cord_ntohs((ip_hdr->saddr.addr >> 16) & 0xFFFF);
-    sum += cord_ntohs(ip_hdr->saddr.addr & 0xFFFF);
-    // Destination address (network byte order, split into 16-bit words)
-    sum += cord_ntohs((ip_hdr->daddr.addr >> 16) & 0xFFFF);
-    sum += cord_ntohs(ip_hdr->daddr.addr & 0xFFFF);
-    // Zero byte + protocol (6 for TCP) - in network byte order
-    sum += CORD_IPPROTO_TCP;
-    // TCP length
-    sum += tcp_len;
-
-    // TCP header and data
-    const uint8_t *ptr = (const uint8_t *) tcp_hdr;
-
-    // Sum all 16-bit words, skipping checksum field at offset 16-17
-    for (uint16_t i = 0; i < tcp_len / 2; i++)
-    {
-        if (i == 8)
-            continue; // Skip checksum field (offset 16-17 = word 8)
-        uint16_t word = (ptr[i * 2] << 8) | ptr[i * 2 + 1];
-        sum += word;
-    }
-
-    // Handle odd byte
-    if (tcp_len & 1)
-    {
-        sum += ptr[tcp_len - 1] << 8;
-    }
-
-    // Add carry bits and take one's complement
-    while (sum >> 16)
-    {
-        sum = (sum & 0xFFFF) + (sum >> 16);
-    }
+    // Pseudo header + TCP header and data, without the checksum field
+    uint32_t sum = cord_csum_pseudo_ipv4(ip_hdr->saddr.addr, ip_hdr->daddr.addr, CORD_IPPROTO_TCP, tcp_len);
+    sum = cord_csum_partial(tcp_hdr, tcp_len, sum);
+    sum += (uint16_t)~tcp_hdr->check;
 
-    return ~sum;
+    return cord_ntohs((uint16_t)~cord_csum_fold(sum));
 }
 
 // UDP checksum calculation for IPv4
@@ -1406,47 +1734,14 @@ uint16_t cord_calculate_udp_checksum_ipv4(const cord_ipv4_hdr_t *ip_hdr)
     // Calculate IP header length and find UDP header
     uint8_t ip_hdr_len = ip_hdr->ihl * 4;
     const cord_udp_hdr_t *udp_hdr = (const cord_udp_hdr_t *) ((const uint8_t *) ip_hdr + ip_hdr_len);
-
-    uint32_t sum = 0;
     uint16_t udp_len = cord_ntohs(udp_hdr->len);
 
-    // Pseudo header: src addr + dst addr + zero + protocol + length
-    // Source address (network byte order, split into 16-bit words)
-    sum += cord_ntohs((ip_hdr->saddr.addr >> 16) & 0xFFFF);
-    sum += cord_ntohs(ip_hdr->saddr.addr & 0xFFFF);
-    // Destination address (network byte order, split into 16-bit words)
-    sum += cord_ntohs((ip_hdr->daddr.addr >> 16) & 0xFFFF);
-    sum += cord_ntohs(ip_hdr->daddr.addr & 0xFFFF);
-    // Zero byte + protocol (17 for UDP) - in network byte order
-    sum += CORD_IPPROTO_UDP;
-    // UDP length - already converted to host byte order above
-    sum += udp_len;
-
-    // UDP header and data
-    const uint8_t *ptr = (const uint8_t *) udp_hdr;
-
-    // Sum all 16-bit words, skipping checksum field at offset 6-7
-    for (uint16_t i = 0; i < udp_len / 2; i++)
-    {
-        if (i == 3)
-            continue; // Skip checksum field (offset 6-7 = word 3)
-        uint16_t word = (ptr[i * 2] << 8) | ptr[i * 2 + 1];
-        sum += word;
-    }
-
-    // Handle odd byte
-    if (udp_len & 1)
-    {
-        sum += ptr[udp_len - 1] << 8;
-    }
-
-    // Add carry bits and take one's complement
-    while (sum >> 16)
-    {
-        sum = (sum & 0xFFFF) + (sum >> 16);
-    }
+    // Pseudo header + UDP header and data, without the checksum field
+    uint32_t sum = cord_csum_pseudo_ipv4(ip_hdr->saddr.addr, ip_hdr->daddr.addr, CORD_IPPROTO_UDP, udp_len);
+    sum = cord_csum_partial(udp_hdr, udp_len, sum);
+    sum += (uint16_t)~udp_hdr->check;
 
-    return ~sum;
+    return cord_ntohs((uint16_t)~cord_csum_fold(sum));
 }
 
 // ICMP checksum calculation for IPv4
@@ -1461,39 +1756,225 @@ uint16_t cord_calculate_icmp_checksum_ipv4(const cord_ipv4_hdr_t *ip_hdr)
     // Calculate IP header length and find ICMP header
     uint8_t ip_hdr_len = ip_hdr->ihl * 4;
     const cord_icmp_hdr_t *icmp_hdr = (const cord_icmp_hdr_t *) ((const uint8_t *) ip_hdr + ip_hdr_len);
+    uint16_t icmp_len = cord_ntohs(ip_hdr->tot_len) - ip_hdr_len;
 
-    // Calculate ICMP data length
-    uint16_t total_len = cord_ntohs(ip_hdr->tot_len);
-    uint16_t icmp_len = total_len - ip_hdr_len;
+    // ICMP header and data (no pseudo header), without the checksum field
+    uint32_t sum = cord_csum_partial(icmp_hdr, icmp_len, 0);
+    sum += (uint16_t)~icmp_hdr->checksum;
 
-    uint32_t sum = 0;
-    const uint8_t *ptr = (const uint8_t *) icmp_hdr;
+    return cord_ntohs((uint16_t)~cord_csum_fold(sum));
+}
 
-    // Sum all 16-bit words, skipping checksum field at offset 2-3
-    for (uint16_t i = 0; i < icmp_len / 2; i++)
+// TCP checksum calculation for IPv6 (no extension headers)
+uint16_t cord_calculate_tcp_checksum_ipv6(const cord_ipv6_hdr_t *ip6_hdr)
+{
+    if (ip6_hdr->nexthdr != CORD_IPPROTO_TCP)
     {
-        if (i == 1)
-            continue; // Skip checksum field (offset 2-3 = word 1)
-        uint16_t word = (ptr[i * 2] << 8) | ptr[i * 2 + 1];
-        sum += word;
+        return 0; // Invalid protocol
     }
 
-    // Handle odd byte
-    if (icmp_len & 1)
-    {
-        sum += ptr[icmp_len - 1] << 8;
-    }
+    const cord_tcp_hdr_t *tcp_hdr = (const cord_tcp_hdr_t *) ((const uint8_t *) ip6_hdr + sizeof(cord_ipv6_hdr_t));
+    uint16_t tcp_len = cord_ntohs(ip6_hdr->payload_len);
 
-    // Add carry bits and take one's complement
-    while (sum >> 16)
-    {
-        sum = (sum & 0xFFFF) + (sum >> 16);
-    }
+    uint32_t sum = cord_csum_pseudo_ipv6(&ip6_hdr->saddr, &ip6_hdr->daddr, CORD_IPPROTO_TCP, tcp_len);
+    sum = cord_csum_partial(tcp_hdr, tcp_len, sum);
+    sum += (uint16_t)~tcp_hdr->check;
 
-    return ~sum;
+    return cord_ntohs((uint16_t)~cord_csum_fold(sum));
 }
 
-//
+// UDP checksum calculation for IPv6 (no extension headers)
+uint16_t cord_calculate_udp_checksum_ipv6(const cord_ipv6_hdr_t *ip6_hdr)
+{
+    if (ip6_hdr->nexthdr != CORD_IPPROTO_UDP)
+    {
+        return 0; // Invalid protocol
+    }
+
+    const cord_udp_hdr_t *udp_hdr = (const cord_udp_hdr_t *) ((const uint8_t *) ip6_hdr + sizeof(cord_ipv6_hdr_t));
+    uint16_t udp_len = cord_ntohs(udp_hdr->len);
+
+    uint32_t sum = cord_csum_pseudo_ipv6(&ip6_hdr->saddr, &ip6_hdr->daddr, CORD_IPPROTO_UDP, udp_len);
+    sum = cord_csum_partial(udp_hdr, udp_len, sum);
+    sum += (uint16_t)~udp_hdr->check;
+
+    // The UDP checksum is mandatory over IPv6: a computed zero is sent as 0xFFFF
+    uint16_t check = (uint16_t)~cord_csum_fold(sum);
+    return check ? cord_ntohs(check) : 0xFFFF;
+}
+
+// ICMPv6 checksum calculation (no extension headers)
+uint16_t cord_calculate_icmpv6_checksum(const cord_ipv6_hdr_t *ip6_hdr)
+{
+    if (ip6_hdr->nexthdr != CORD_IPPROTO_ICMPV6)
+    {
+        return 0; // Invalid protocol
+    }
+
+    const cord_icmpv6_hdr_t *icmp6_hdr = (const cord_icmpv6_hdr_t *) ((const uint8_t *) ip6_hdr + sizeof(cord_ipv6_hdr_t));
+    uint16_t icmp6_len = cord_ntohs(ip6_hdr->payload_len);
+
+    uint32_t sum = cord_csum_pseudo_ipv6(&ip6_hdr->saddr, &ip6_hdr->daddr, CORD_IPPROTO_ICMPV6, icmp6_len);
+    sum = cord_csum_partial(icmp6_hdr, icmp6_len, sum);
+    sum += (uint16_t)~icmp6_hdr->checksum;
+
+    return cord_ntohs((uint16_t)~cord_csum_fold(sum));
+}
+
+// SCTP CRC32C checksum over the common header and chunks, checksum field taken as zero
+uint32_t cord_calculate_sctp_checksum(const cord_sctp_hdr_t *sctp_hdr, size_t sctp_len)
+{
+    static const uint32_t zero = 0;
+    const uint8_t *data = (const uint8_t *) sctp_hdr;
+    size_t csum_offset = offsetof(cord_sctp_hdr_t, checksum);
+
+    if (sctp_len < sizeof(cord_sctp_hdr_t))
+    {
+        return 0; // Truncated header
+    }
+
+    uint32_t crc = cord_crc32c_update(CORD_CRC_INIT, data, csum_offset);
+    crc = cord_crc32c_update(crc, &zero, sizeof(zero));
+    crc = cord_crc32c_update(crc, data + sizeof(cord_sctp_hdr_t), sctp_len - sizeof(cord_sctp_hdr_t));
+
+    // The CRC is transmitted least significant byte first
+    return htole32(~crc);
+}
+
+uint32_t cord_calculate_sctp_checksum_ipv4(const cord_ipv4_hdr_t *ip_hdr)
+{
+    if (ip_hdr->protocol != CORD_IPPROTO_SCTP)
+    {
+        return 0; // Invalid protocol
+    }
+
+    // tot_len comes from the packet: a short one must not wrap the SCTP length
+    if (cord_ntohs(ip_hdr->tot_len) < ip_hdr->ihl * 4 + sizeof(cord_sctp_hdr_t))
+    {
+        return 0; // Truncated packet
+    }
+
+    const cord_sctp_hdr_t *sctp_hdr = (const cord_sctp_hdr_t *) ((const uint8_t *) ip_hdr + ip_hdr->ihl * 4);
+    return cord_calculate_sctp_checksum(sctp_hdr, cord_calculate_ipv4_payload_length_ntohs(ip_hdr));
+}
+
+uint32_t cord_calculate_sctp_checksum_ipv6(const cord_ipv6_hdr_t *ip6_hdr)
+{
+    if (ip6_hdr->nexthdr != CORD_IPPROTO_SCTP)
+    {
+        return 0; // Invalid protocol
+    }
+
+    if (cord_ntohs(ip6_hdr->payload_len) < sizeof(cord_sctp_hdr_t))
+    {
+        return 0; // Truncated packet
+    }
+
+    const cord_sctp_hdr_t *sctp_hdr = (const cord_sctp_hdr_t *) ((const uint8_t *) ip6_hdr + sizeof(cord_ipv6_hdr_t));
+    return cord_calculate_sctp_checksum(sctp_hdr, cord_ntohs(ip6_hdr->payload_len));
+}
+
+#ifdef ENABLE_DPDK_DATAPLANE
+
+//
+// Checksum offload (DPDK)
+//
+
+void cord_checksum_offload_ipv4(struct rte_mbuf *mbuf, cord_ipv4_hdr_t *ip_hdr, uint16_t l2_len, uint64_t tx_offloads)
+{
+    uint8_t ip_hdr_len = ip_hdr->ihl * 4;
+
+    mbuf->l2_len = l2_len;
+    mbuf->l3_len = ip_hdr_len;
+    mbuf->ol_flags |= RTE_MBUF_F_TX_IPV4;
+
+    if (tx_offloads & RTE_ETH_TX_OFFLOAD_IPV4_CKSUM)
+    {
+        ip_hdr->check = 0;
+        mbuf->ol_flags |= RTE_MBUF_F_TX_IP_CKSUM;
+    }
+    else
+    {
+        ip_hdr->check = cord_htons(cord_calculate_ipv4_checksum(ip_hdr));
+    }
+
+    // Non-first fragments carry no L4 header
+    if (ip_hdr->frag_off & cord_htons(0x1FFF))
+    {
+        return;
+    }
+
+    uint8_t *l4 = (uint8_t *) ip_hdr + ip_hdr_len;
+
+    if (ip_hdr->protocol == CORD_IPPROTO_TCP)
+    {
+        cord_tcp_hdr_t *tcp_hdr = (cord_tcp_hdr_t *) l4;
+        if (tx_offloads & RTE_ETH_TX_OFFLOAD_TCP_CKSUM)
+        {
+            // The NIC expects the pseudo-header sum in the checksum field
+            mbuf->ol_flags |= RTE_MBUF_F_TX_TCP_CKSUM;
+            tcp_hdr->check = rte_ipv4_phdr_cksum((const struct rte_ipv4_hdr *) ip_hdr, mbuf->ol_flags);
+        }
+        else
+        {
+            tcp_hdr->check = cord_htons(cord_calculate_tcp_checksum_ipv4(ip_hdr));
+        }
+    }
+    else if (ip_hdr->protocol == CORD_IPPROTO_UDP)
+    {
+        cord_udp_hdr_t *udp_hdr = (cord_udp_hdr_t *) l4;
+        if (tx_offloads & RTE_ETH_TX_OFFLOAD_UDP_CKSUM)
+        {
+            mbuf->ol_flags |= RTE_MBUF_F_TX_UDP_CKSUM;
+            udp_hdr->check = rte_ipv4_phdr_cksum((const struct rte_ipv4_hdr *) ip_hdr, mbuf->ol_flags);
+        }
+        else
+        {
+            uint16_t check = cord_htons(cord_calculate_udp_checksum_ipv4(ip_hdr));
+            udp_hdr->check = check ? check : 0xFFFF;
+        }
+    }
+}
+
+void cord_checksum_offload_ipv6(struct rte_mbuf *mbuf, cord_ipv6_hdr_t *ip6_hdr, uint16_t l2_len, uint64_t tx_offloads)
+{
+    mbuf->l2_len = l2_len;
+    mbuf->l3_len = sizeof(cord_ipv6_hdr_t);
+    mbuf->ol_flags |= RTE_MBUF_F_TX_IPV6;
+
+    uint8_t *l4 = (uint8_t *) ip6_hdr + sizeof(cord_ipv6_hdr_t);
+
+    if (ip6_hdr->nexthdr == CORD_IPPROTO_TCP)
+    {
+        cord_tcp_hdr_t *tcp_hdr = (cord_tcp_hdr_t *) l4;
+        if (tx_offloads & RTE_ETH_TX_OFFLOAD_TCP_CKSUM)
+        {
+            mbuf->ol_flags |= RTE_MBUF_F_TX_TCP_CKSUM;
+            tcp_hdr->check = rte_ipv6_phdr_cksum((const struct rte_ipv6_hdr *) ip6_hdr, mbuf->ol_flags);
+        }
+        else
+        {
+            tcp_hdr->check = cord_htons(cord_calculate_tcp_checksum_ipv6(ip6_hdr));
+        }
+    }
+    else if (ip6_hdr->nexthdr == CORD_IPPROTO_UDP)
+    {
+        cord_udp_hdr_t *udp_hdr = (cord_udp_hdr_t *) l4;
+        if (tx_offloads & RTE_ETH_TX_OFFLOAD_UDP_CKSUM)
+        {
+            mbuf->ol_flags |= RTE_MBUF_F_TX_UDP_CKSUM;
+            udp_hdr->check = rte_ipv6_phdr_cksum((const struct rte_ipv6_hdr *) ip6_hdr, mbuf->ol_flags);
+        }
+        else
+        {
+            udp_hdr->check = cord_htons(cord_calculate_udp_checksum_ipv6(ip6_hdr));
+        }
+    }
+}
+
+#endif // ENABLE_DPDK_DATAPLANE
+
+//
 // Log
 //
 
@@ -2087,16 +2568,71 @@ void cord_log_field_icmp_sequence_ntohs(const cord_icmp_hdr_t *icmp, const char
 // Push/Pop
 //
 
+#define CORD_ETH_ADDRS_LEN      12  // Destination + source MAC
+#define CORD_VLAN_PREFETCH      4   // Packets to prefetch ahead in burst operations
+
+// Push: the header has already been prepended, the old Ethernet header starts at data + 4.
+// Moves dst/src down by 4 bytes and writes TPID + TCI; the original EtherType already
+// sits where the tag's inner EtherType belongs.
+static inline void cord_vlan_hdr_shift_push(uint8_t *data, uint16_t tpid, uint16_t tci)
+{
+#if defined(__SSE2__)
+    // Single 16-byte move: dst/src + TPID + TCI
+    __m128i hdr = _mm_loadu_si128((const __m128i *)(data + sizeof(cord_vlan_hdr_t)));
+    hdr = _mm_insert_epi16(hdr, tpid, 6);
+    hdr = _mm_insert_epi16(hdr, tci, 7);
+    _mm_storeu_si128((__m128i *)data, hdr);
+#elif defined(__ARM_NEON)
+    uint16x8_t hdr = vreinterpretq_u16_u8(vld1q_u8(data + sizeof(cord_vlan_hdr_t)));
+    hdr = vsetq_lane_u16(tpid, hdr, 6);
+    hdr = vsetq_lane_u16(tci, hdr, 7);
+    vst1q_u8(data, vreinterpretq_u8_u16(hdr));
+#else
+    memmove(data, data + sizeof(cord_vlan_hdr_t), CORD_ETH_ADDRS_LEN);
+    memcpy(data + CORD_ETH_ADDRS_LEN, &tpid, sizeof(tpid));
+    memcpy(data + CORD_ETH_ADDRS_LEN + sizeof(tpid), &tci, sizeof(tci));
+#endif
+}
+
+// Pop: moves dst/src up by 4 bytes over the tag, so that they precede the inner EtherType.
+// The caller then advances the packet start by 4 bytes.
+static inline void cord_vlan_hdr_shift_pop(uint8_t *data)
+{
+#if defined(__SSE2__)
+    // Single 16-byte move: bytes 0..11 land at 4..15, bytes 0..3 are discarded
+    __m128i hdr = _mm_loadu_si128((const __m128i *)data);
+    _mm_storeu_si128((__m128i *)data, _mm_slli_si128(hdr, sizeof(cord_vlan_hdr_t)));
+#elif defined(__ARM_NEON)
+    uint8x16_t hdr = vld1q_u8(data);
+    vst1q_u8(data, vextq_u8(vdupq_n_u8(0), hdr, 16 - sizeof(cord_vlan_hdr_t)));
+#else
+    memmove(data + sizeof(cord_vlan_hdr_t), data, CORD_ETH_ADDRS_LEN);
+#endif
+}
+
+static inline bool cord_vlan_is_tagged(const uint8_t *data)
+{
+    uint16_t eth_proto = cord_ntohs(((const cord_eth_hdr_t *)data)->h_proto);
+    return eth_proto == CORD_ETH_P_8021Q || eth_proto == CORD_ETH_P_8021AD;
+}
+
+// In-place TCI rewrite of the outer tag: VID and PCP are replaced, DEI is kept
+static inline void cord_vlan_rewrite_tci(uint8_t *data, uint16_t vlan_id, uint8_t pcp)
+{
+    cord_vlan_hdr_t *vlan = (cord_vlan_hdr_t *)(data + sizeof(cord_eth_hdr_t));
+    uint16_t tci = cord_ntohs(vlan->tci);
+    vlan->tci = cord_htons((tci & 0x1000) | ((pcp & 0x7) << 13) | (vlan_id & 0x0FFF));
+}
+
 // Default dataplane (L2 raw socket)
 #if !defined(ENABLE_DPDK_DATAPLANE) && !defined(ENABLE_XDP_DATAPLANE)
 
 cord_retval_t cord_push_vlan(cord_raw_pkt_desc_t *pkt, uint16_t vlan_id, uint8_t pcp, uint8_t dei, uint16_t ethertype)
 {
-    // Get pointer to current Ethernet header
-    cord_eth_hdr_t *old_eth = (cord_eth_hdr_t *)pkt->data;
-
-    // Save original EtherType
-    uint16_t original_ethertype = old_eth->h_proto;
+    if (pkt->data_len < sizeof(cord_eth_hdr_t) + 2)
+    {
+        return CORD_ERR_INVALID_PARAM;
+    }
 
     // Prepend 4 bytes for VLAN tag
     void *vlan_space = cord_raw_pkt_prepend(pkt, sizeof(cord_vlan_hdr_t));
@@ -2105,20 +2641,9 @@ cord_retval_t cord_push_vlan(cord_raw_pkt_desc_t *pkt, uint16_t vlan_id, uint8_t
         return CORD_ERR_NO_MEMORY;
     }
 
-    // Now pkt->data points 4 bytes before the old position
-    // Move Ethernet dst/src (12 bytes) to new position
-    cord_eth_hdr_t *new_eth = (cord_eth_hdr_t *)pkt->data;
-    memmove(new_eth, old_eth, 12); // Copy dst + src
-
-    // VLAN header is at position 12
-    cord_vlan_hdr_t *vlan = (cord_vlan_hdr_t *)(pkt->data + 12);
-
-    // Construct VLAN header
-    vlan->tci = cord_htons((pcp << 13) | (dei << 12) | (vlan_id & 0x0FFF));
-    vlan->h_proto = original_ethertype;
-
-    // Update Ethernet header with VLAN EtherType (0x8100 or 0x88A8 for QinQ)
-    new_eth->h_proto = cord_htons(ethertype);
+    // Move Ethernet dst/src to the new start, TPID at 12, TCI at 14 (inner EtherType at 16)
+    cord_vlan_hdr_shift_push(pkt->data, cord_htons(ethertype),
+                             cord_htons((pcp << 13) | (dei << 12) | (vlan_id & 0x0FFF)));
 
     return CORD_OK;
 }
@@ -2126,39 +2651,107 @@ cord_retval_t cord_push_vlan(cord_raw_pkt_desc_t *pkt, uint16_t vlan_id, uint8_t
 cord_retval_t cord_pop_vlan(cord_raw_pkt_desc_t *pkt)
 {
     // Check if packet has VLAN tag
-    cord_eth_hdr_t *eth = (cord_eth_hdr_t *)pkt->data;
-    uint16_t eth_proto = cord_ntohs(eth->h_proto);
+    if (pkt->data_len < sizeof(cord_eth_hdr_t) + sizeof(cord_vlan_hdr_t) || !cord_vlan_is_tagged(pkt->data))
+    {
+        return CORD_ERR_NOT_FOUND;
+    }
+
+    // Move Ethernet dst/src over the tag, then drop the first 4 bytes
+    cord_vlan_hdr_shift_pop(pkt->data);
+    cord_raw_pkt_adj(pkt, sizeof(cord_vlan_hdr_t));
+
+    return CORD_OK;
+}
 
-    if (eth_proto != CORD_ETH_P_8021Q && eth_proto != CORD_ETH_P_8021AD)
+cord_retval_t cord_rewrite_vlan(cord_raw_pkt_desc_t *pkt, uint16_t vlan_id, uint8_t pcp)
+{
+    if (pkt->data_len < sizeof(cord_eth_hdr_t) + sizeof(cord_vlan_hdr_t) || !cord_vlan_is_tagged(pkt->data))
     {
         return CORD_ERR_NOT_FOUND;
     }
 
-    // VLAN header is at position 12 (after Ethernet dst/src)
-    cord_vlan_hdr_t *vlan = (cord_vlan_hdr_t *)(pkt->data + 12);
+    cord_vlan_rewrite_tci(pkt->data, vlan_id, pcp);
 
-    // Save inner EtherType
-    uint16_t inner_ethertype = vlan->h_proto;
+    return CORD_OK;
+}
 
-    // Save Ethernet dst/src
-    uint8_t eth_addrs[12];
-    memcpy(eth_addrs, pkt->data, 12);
+//
+// Burst VLAN operations
+//
 
-    // Remove VLAN tag by adjusting pointer forward
-    void *new_start = cord_raw_pkt_adj(pkt, sizeof(cord_vlan_hdr_t));
-    if (!new_start)
+uint32_t cord_push_vlan_burst(cord_raw_pkt_desc_t **pkts, uint32_t count, uint16_t vlan_id, uint8_t pcp, uint8_t dei, uint16_t ethertype)
+{
+    uint32_t done = 0;
+
+    for (uint32_t i = 0; i < count; i++)
     {
-        return CORD_ERR_INVALID_PARAM;
+        if (i + CORD_VLAN_PREFETCH < count)
+        {
+            __builtin_prefetch(pkts[i + CORD_VLAN_PREFETCH]->data - sizeof(cord_vlan_hdr_t), 1);
+        }
+
+        done += (cord_push_vlan(pkts[i], vlan_id, pcp, dei, ethertype) == CORD_OK);
     }
 
-    // Restore Ethernet dst/src at new position
-    memcpy(pkt->data, eth_addrs, 12);
+    return done;
+}
 
-    // Update Ethernet header with inner EtherType
-    eth = (cord_eth_hdr_t *)pkt->data;
-    eth->h_proto = inner_ethertype;
+uint32_t cord_pop_vlan_burst(cord_raw_pkt_desc_t **pkts, uint32_t count)
+{
+    uint32_t done = 0;
 
-    return CORD_OK;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (i + CORD_VLAN_PREFETCH < count)
+        {
+            __builtin_prefetch(pkts[i + CORD_VLAN_PREFETCH]->data, 1);
+        }
+
+        done += (cord_pop_vlan(pkts[i]) == CORD_OK);
+    }
+
+    return done;
+}
+
+uint32_t cord_rewrite_vlan_burst(cord_raw_pkt_desc_t **pkts, uint32_t count, uint16_t vlan_id, uint8_t pcp)
+{
+    uint32_t done = 0;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (i + CORD_VLAN_PREFETCH < count)
+        {
+            __builtin_prefetch(pkts[i + CORD_VLAN_PREFETCH]->data, 1);
+        }
+
+        done += (cord_rewrite_vlan(pkts[i], vlan_id, pcp) == CORD_OK);
+    }
+
+    return done;
+}
+
+uint32_t cord_set_vlan_burst(cord_raw_pkt_desc_t **pkts, uint32_t count, uint16_t vlan_id, uint8_t pcp, uint8_t dei, uint16_t ethertype)
+{
+    uint32_t done = 0;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (i + CORD_VLAN_PREFETCH < count)
+        {
+            __builtin_prefetch(pkts[i + CORD_VLAN_PREFETCH]->data, 1);
+        }
+
+        // Translate in place when tagged, push otherwise
+        if (cord_rewrite_vlan(pkts[i], vlan_id, pcp) == CORD_OK)
+        {
+            done++;
+            continue;
+        }
+
+        done += (cord_push_vlan(pkts[i], vlan_id, pcp, dei, ethertype) == CORD_OK);
+    }
+
+    return done;
 }
 
 //
@@ -2209,71 +2802,132 @@ cord_retval_t cord_pop_svlan(cord_raw_pkt_desc_t *pkt)
 
 cord_retval_t cord_push_vlan(struct rte_mbuf *mbuf, uint16_t vlan_id, uint8_t pcp, uint8_t dei, uint16_t ethertype)
 {
-    // Get pointer to current Ethernet header
-    cord_eth_hdr_t *old_eth = rte_pktmbuf_mtod(mbuf, cord_eth_hdr_t *);
-
-    // Save original EtherType
-    uint16_t original_ethertype = old_eth->h_proto;
+    if (rte_pktmbuf_data_len(mbuf) < sizeof(cord_eth_hdr_t) + 2)
+    {
+        return CORD_ERR_INVALID_PARAM;
+    }
 
     // Use DPDK's rte_pktmbuf_prepend to move data pointer
-    char *new_data = (char *)rte_pktmbuf_prepend(mbuf, sizeof(cord_vlan_hdr_t));
+    uint8_t *new_data = (uint8_t *)rte_pktmbuf_prepend(mbuf, sizeof(cord_vlan_hdr_t));
     if (!new_data)
     {
         return CORD_ERR_NO_MEMORY;
     }
 
-    // Move Ethernet dst/src (12 bytes) to new position
-    cord_eth_hdr_t *new_eth = (cord_eth_hdr_t *)new_data;
-    memmove(new_eth, old_eth, 12); // Copy dst + src
+    // Move Ethernet dst/src to the new start, TPID at 12, TCI at 14 (inner EtherType at 16)
+    cord_vlan_hdr_shift_push(new_data, cord_htons(ethertype),
+                             cord_htons((pcp << 13) | (dei << 12) | (vlan_id & 0x0FFF)));
 
-    // VLAN header is at position 12
-    cord_vlan_hdr_t *vlan = (cord_vlan_hdr_t *)(new_data + 12);
+    return CORD_OK;
+}
 
-    // Construct VLAN header
-    vlan->tci = cord_htons((pcp << 13) | (dei << 12) | (vlan_id & 0x0FFF));
-    vlan->h_proto = original_ethertype;
+cord_retval_t cord_pop_vlan(struct rte_mbuf *mbuf)
+{
+    uint8_t *data = rte_pktmbuf_mtod(mbuf, uint8_t *);
+
+    if (rte_pktmbuf_data_len(mbuf) < sizeof(cord_eth_hdr_t) + sizeof(cord_vlan_hdr_t) || !cord_vlan_is_tagged(data))
+    {
+        return CORD_ERR_NOT_FOUND;
+    }
 
-    // Update Ethernet header with VLAN EtherType
-    new_eth->h_proto = cord_htons(ethertype);
+    // Move Ethernet dst/src over the tag, then drop the first 4 bytes
+    cord_vlan_hdr_shift_pop(data);
+    rte_pktmbuf_adj(mbuf, sizeof(cord_vlan_hdr_t));
 
     return CORD_OK;
 }
 
-cord_retval_t cord_pop_vlan(struct rte_mbuf *mbuf)
+cord_retval_t cord_rewrite_vlan(struct rte_mbuf *mbuf, uint16_t vlan_id, uint8_t pcp)
 {
-    // Get packet data
-    cord_eth_hdr_t *eth = rte_pktmbuf_mtod(mbuf, cord_eth_hdr_t *);
-    uint16_t eth_proto = cord_ntohs(eth->h_proto);
+    uint8_t *data = rte_pktmbuf_mtod(mbuf, uint8_t *);
 
-    if (eth_proto != CORD_ETH_P_8021Q && eth_proto != CORD_ETH_P_8021AD)
+    if (rte_pktmbuf_data_len(mbuf) < sizeof(cord_eth_hdr_t) + sizeof(cord_vlan_hdr_t) || !cord_vlan_is_tagged(data))
     {
         return CORD_ERR_NOT_FOUND;
     }
 
-    // VLAN header is at position 12 (after Ethernet dst/src)
-    cord_vlan_hdr_t *vlan = (cord_vlan_hdr_t *)((uint8_t *)eth + 12);
+    cord_vlan_rewrite_tci(data, vlan_id, pcp);
 
-    // Save inner EtherType
-    uint16_t inner_ethertype = vlan->h_proto;
+    return CORD_OK;
+}
 
-    // Save Ethernet dst/src
-    uint8_t eth_addrs[12];
-    memcpy(eth_addrs, eth, 12);
+//
+// Burst VLAN operations
+//
+
+uint32_t cord_push_vlan_burst(struct rte_mbuf **mbufs, uint32_t count, uint16_t vlan_id, uint8_t pcp, uint8_t dei, uint16_t ethertype)
+{
+    uint32_t done = 0;
 
-    // Use DPDK's rte_pktmbuf_adj to move pointer forward
-    if (rte_pktmbuf_adj(mbuf, sizeof(cord_vlan_hdr_t)) == NULL)
+    for (uint32_t i = 0; i < count; i++)
     {
-        return CORD_ERR_INVALID_PARAM;
+        if (i + CORD_VLAN_PREFETCH < count)
+        {
+            rte_prefetch0(rte_pktmbuf_mtod(mbufs[i + CORD_VLAN_PREFETCH], uint8_t *) - sizeof(cord_vlan_hdr_t));
+        }
+
+        done += (cord_push_vlan(mbufs[i], vlan_id, pcp, dei, ethertype) == CORD_OK);
     }
 
-    // Restore Ethernet dst/src at new position
-    eth = rte_pktmbuf_mtod(mbuf, cord_eth_hdr_t *);
-    memcpy(eth, eth_addrs, 12);
+    return done;
+}
 
-    // Update Ethernet header with inner EtherType
-    eth->h_proto = inner_ethertype;
+uint32_t cord_pop_vlan_burst(struct rte_mbuf **mbufs, uint32_t count)
+{
+    uint32_t done = 0;
 
-    return CORD_OK;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (i + CORD_VLAN_PREFETCH < count)
+        {
+            rte_prefetch0(rte_pktmbuf_mtod(mbufs[i + CORD_VLAN_PREFETCH], void *));
+        }
+
+        done += (cord_pop_vlan(mbufs[i]) == CORD_OK);
+    }
+
+    return done;
+}
+
+uint32_t cord_rewrite_vlan_burst(struct rte_mbuf **mbufs, uint32_t count, uint16_t vlan_id, uint8_t pcp)
+{
+    uint32_t done = 0;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (i + CORD_VLAN_PREFETCH < count)
+        {
+            rte_prefetch0(rte_pktmbuf_mtod(mbufs[i + CORD_VLAN_PREFETCH], void *));
+        }
+
+        done += (cord_rewrite_vlan(mbufs[i], vlan_id, pcp) == CORD_OK);
+    }
+
+    return done;
+}
+
+uint32_t cord_set_vlan_burst(struct rte_mbuf **mbufs, uint32_t count, uint16_t vlan_id, uint8_t pcp, uint8_t dei, uint16_t ethertype)
+{
+    uint32_t done = 0;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (i + CORD_VLAN_PREFETCH < count)
+        {
+            rte_prefetch0(rte_pktmbuf_mtod(mbufs[i + CORD_VLAN_PREFETCH], void *));
+        }
+
+        // Translate in place when tagged, push otherwise
+        if (cord_rewrite_vlan(mbufs[i], vlan_id, pcp) == CORD_OK)
+        {
+            done++;
+            continue;
+        }
+
+        done += (cord_push_vlan(mbufs[i], vlan_id, pcp, dei, ethertype) == CORD_OK);
+    }
+
+    return done;
 }
 
 //
@@ -2324,14 +2978,13 @@ cord_retval_t cord_pop_svlan(struct rte_mbuf *mbuf)
 
 cord_retval_t cord_push_vlan(struct cord_xdp_pkt_desc *pkt, uint16_t vlan_id, uint8_t pcp, uint8_t dei, uint16_t ethertype)
 {
-    // Get pointer to current Ethernet header
-    cord_eth_hdr_t *old_eth = (cord_eth_hdr_t *)pkt->data;
-
-    // Save original EtherType
-    uint16_t original_ethertype = old_eth->h_proto;
+    if (pkt->len < sizeof(cord_eth_hdr_t) + 2)
+    {
+        return CORD_ERR_INVALID_PARAM;
+    }
 
     // Check if space available in UMEM frame
-    if (pkt->data < (void *)((uint8_t *)pkt->data - sizeof(cord_vlan_hdr_t)))
+    if (cord_xdp_pkt_headroom(pkt) < sizeof(cord_vlan_hdr_t))
     {
         return CORD_ERR_NO_MEMORY;
     }
@@ -2340,19 +2993,9 @@ cord_retval_t cord_push_vlan(struct cord_xdp_pkt_desc *pkt, uint16_t vlan_id, ui
     pkt->data = (void *)((uint8_t *)pkt->data - sizeof(cord_vlan_hdr_t));
     pkt->len += sizeof(cord_vlan_hdr_t);
 
-    // Move Ethernet dst/src (12 bytes) to new position
-    cord_eth_hdr_t *new_eth = (cord_eth_hdr_t *)pkt->data;
-    memmove(new_eth, old_eth, 12); // Copy dst + src
-
-    // VLAN header is at position 12
-    cord_vlan_hdr_t *vlan = (cord_vlan_hdr_t *)((uint8_t *)pkt->data + 12);
-
-    // Construct VLAN header
-    vlan->tci = cord_htons((pcp << 13) | (dei << 12) | (vlan_id & 0x0FFF));
-    vlan->h_proto = original_ethertype;
-
-    // Update Ethernet header with VLAN EtherType
-    new_eth->h_proto = cord_htons(ethertype);
+    // Move Ethernet dst/src to the new start, TPID at 12, TCI at 14 (inner EtherType at 16)
+    cord_vlan_hdr_shift_push((uint8_t *)pkt->data, cord_htons(ethertype),
+                             cord_htons((pcp << 13) | (dei << 12) | (vlan_id & 0x0FFF)));
 
     return CORD_OK;
 }
@@ -2360,36 +3003,108 @@ cord_retval_t cord_push_vlan(struct cord_xdp_pkt_desc *pkt, uint16_t vlan_id, ui
 cord_retval_t cord_pop_vlan(struct cord_xdp_pkt_desc *pkt)
 {
     // Check if packet has VLAN tag
-    cord_eth_hdr_t *eth = (cord_eth_hdr_t *)pkt->data;
-    uint16_t eth_proto = cord_ntohs(eth->h_proto);
+    if (pkt->len < sizeof(cord_eth_hdr_t) + sizeof(cord_vlan_hdr_t) || !cord_vlan_is_tagged((const uint8_t *)pkt->data))
+    {
+        return CORD_ERR_NOT_FOUND;
+    }
+
+    // Move Ethernet dst/src over the tag, then advance the data pointer
+    cord_vlan_hdr_shift_pop((uint8_t *)pkt->data);
+    pkt->data = (void *)((uint8_t *)pkt->data + sizeof(cord_vlan_hdr_t));
+    pkt->len -= sizeof(cord_vlan_hdr_t);
 
-    if (eth_proto != CORD_ETH_P_8021Q && eth_proto != CORD_ETH_P_8021AD)
+    return CORD_OK;
+}
+
+cord_retval_t cord_rewrite_vlan(struct cord_xdp_pkt_desc *pkt, uint16_t vlan_id, uint8_t pcp)
+{
+    if (pkt->len < sizeof(cord_eth_hdr_t) + sizeof(cord_vlan_hdr_t) || !cord_vlan_is_tagged((const uint8_t *)pkt->data))
     {
         return CORD_ERR_NOT_FOUND;
     }
 
-    // VLAN header is at position 12 (after Ethernet dst/src)
-    cord_vlan_hdr_t *vlan = (cord_vlan_hdr_t *)((uint8_t *)eth + 12);
+    cord_vlan_rewrite_tci((uint8_t *)pkt->data, vlan_id, pcp);
 
-    // Save inner EtherType
-    uint16_t inner_ethertype = vlan->h_proto;
+    return CORD_OK;
+}
 
-    // Save Ethernet dst/src
-    uint8_t eth_addrs[12];
-    memcpy(eth_addrs, pkt->data, 12);
+//
+// Burst VLAN operations (arrays of descriptor pointers)
+//
 
-    // Adjust data pointer forward
-    pkt->data = (void *)((uint8_t *)pkt->data + sizeof(cord_vlan_hdr_t));
-    pkt->len -= sizeof(cord_vlan_hdr_t);
+uint32_t cord_push_vlan_burst(struct cord_xdp_pkt_desc **pkts, uint32_t count, uint16_t vlan_id, uint8_t pcp, uint8_t dei, uint16_t ethertype)
+{
+    uint32_t done = 0;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (i + CORD_VLAN_PREFETCH < count)
+        {
+            __builtin_prefetch((uint8_t *)pkts[i + CORD_VLAN_PREFETCH]->data - sizeof(cord_vlan_hdr_t), 1);
+        }
 
-    // Restore Ethernet dst/src at new position
-    memcpy(pkt->data, eth_addrs, 12);
+        done += (cord_push_vlan(pkts[i], vlan_id, pcp, dei, ethertype) == CORD_OK);
+    }
 
-    // Update Ethernet header with inner EtherType
-    eth = (cord_eth_hdr_t *)pkt->data;
-    eth->h_proto = inner_ethertype;
+    return done;
+}
 
-    return CORD_OK;
+uint32_t cord_pop_vlan_burst(struct cord_xdp_pkt_desc **pkts, uint32_t count)
+{
+    uint32_t done = 0;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (i + CORD_VLAN_PREFETCH < count)
+        {
+            __builtin_prefetch(pkts[i + CORD_VLAN_PREFETCH]->data, 1);
+        }
+
+        done += (cord_pop_vlan(pkts[i]) == CORD_OK);
+    }
+
+    return done;
+}
+
+uint32_t cord_rewrite_vlan_burst(struct cord_xdp_pkt_desc **pkts, uint32_t count, uint16_t vlan_id, uint8_t pcp)
+{
+    uint32_t done = 0;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (i + CORD_VLAN_PREFETCH < count)
+        {
+            __builtin_prefetch(pkts[i + CORD_VLAN_PREFETCH]->data, 1);
+        }
+
+        done += (cord_rewrite_vlan(pkts[i], vlan_id, pcp) == CORD_OK);
+    }
+
+    return done;
+}
+
+uint32_t cord_set_vlan_burst(struct cord_xdp_pkt_desc **pkts, uint32_t count, uint16_t vlan_id, uint8_t pcp, uint8_t dei, uint16_t ethertype)
+{
+    uint32_t done = 0;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (i + CORD_VLAN_PREFETCH < count)
+        {
+            __builtin_prefetch(pkts[i + CORD_VLAN_PREFETCH]->data, 1);
+        }
+
+        // Translate in place when tagged, push otherwise
+        if (cord_rewrite_vlan(pkts[i], vlan_id, pcp) == CORD_OK)
+        {
+            done++;
+            continue;
+        }
+
+        done += (cord_push_vlan(pkts[i], vlan_id, pcp, dei, ethertype) == CORD_OK);
+    }
+
+    return done;
 }
 
 //
@@ -0,0 +1,199 @@
+#include <action/cord_checksum.h>
+#include <string.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+//
+// Internet Checksum Kernels (RFC 1071)
+//
+// Words are loaded in native byte order and summed with end-around carry;
+// the one's complement sum is byte-order independent, so the folded result
+// can be stored as-is.
+//
+
+// Buffers shorter than this are not worth a vector setup
+#define CORD_CSUM_VECTOR_MIN_LEN 64
+
+static inline uint64_t csum_add64(uint64_t sum, uint64_t value)
+{
+    sum += value;
+    return sum + (sum < value); // End-around carry
+}
+
+static inline uint32_t csum_fold64(uint64_t sum)
+{
+    sum = (sum & 0xFFFFFFFF) + (sum >> 32);
+    sum = (sum & 0xFFFFFFFF) + (sum >> 32);
+    return cord_csum_fold((uint32_t)sum);
+}
+
+static uint64_t csum_partial_scalar(const uint8_t *ptr, size_t len, uint64_t sum)
+{
+    uint64_t w0, w1, w2, w3;
+
+    while (len >= 32)
+    {
+        memcpy(&w0, ptr, 8);
+        memcpy(&w1, ptr + 8, 8);
+        memcpy(&w2, ptr + 16, 8);
+        memcpy(&w3, ptr + 24, 8);
+        sum = csum_add64(sum, w0);
+        sum = csum_add64(sum, w1);
+        sum = csum_add64(sum, w2);
+        sum = csum_add64(sum, w3);
+        ptr += 32;
+        len -= 32;
+    }
+
+    while (len >= 8)
+    {
+        memcpy(&w0, ptr, 8);
+        sum = csum_add64(sum, w0);
+        ptr += 8;
+        len -= 8;
+    }
+
+    if (len >= 4)
+    {
+        uint32_t w;
+        memcpy(&w, ptr, 4);
+        sum = csum_add64(sum, w);
+        ptr += 4;
+        len -= 4;
+    }
+
+    if (len >= 2)
+    {
+        uint16_t w;
+        memcpy(&w, ptr, 2);
+        sum = csum_add64(sum, w);
+        ptr += 2;
+        len -= 2;
+    }
+
+    // Odd trailing byte is the high-order byte of a zero-padded word
+    if (len)
+    {
+#if __BYTE_ORDER == __LITTLE_ENDIAN
+        sum = csum_add64(sum, *ptr);
+#else
+        sum = csum_add64(sum, (uint64_t)*ptr << 8);
+#endif
+    }
+
+    return sum;
+}
+
+#if defined(__x86_64__)
+// 32-bit words zero-extended into 64-bit lanes: no carries to track in the loop
+__attribute__((target("avx2")))
+static uint64_t csum_partial_avx2(const uint8_t *ptr, size_t len, uint64_t sum)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc0 = zero;
+    __m256i acc1 = zero;
+
+    while (len >= 64)
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i *)ptr);
+        __m256i b = _mm256_loadu_si256((const __m256i *)(ptr + 32));
+        acc0 = _mm256_add_epi64(acc0, _mm256_unpacklo_epi32(a, zero));
+        acc1 = _mm256_add_epi64(acc1, _mm256_unpackhi_epi32(a, zero));
+        acc0 = _mm256_add_epi64(acc0, _mm256_unpacklo_epi32(b, zero));
+        acc1 = _mm256_add_epi64(acc1, _mm256_unpackhi_epi32(b, zero));
+        ptr += 64;
+        len -= 64;
+    }
+
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i *)lanes, _mm256_add_epi64(acc0, acc1));
+    for (int i = 0; i < 4; i++)
+    {
+        sum = csum_add64(sum, lanes[i]);
+    }
+
+    return csum_partial_scalar(ptr, len, sum);
+}
+#elif defined(__ARM_NEON)
+static uint64_t csum_partial_neon(const uint8_t *ptr, size_t len, uint64_t sum)
+{
+    uint64x2_t acc = vdupq_n_u64(0);
+
+    while (len >= 16)
+    {
+        // Pairwise add 32-bit words into 64-bit accumulators
+        acc = vpadalq_u32(acc, vreinterpretq_u32_u8(vld1q_u8(ptr)));
+        ptr += 16;
+        len -= 16;
+    }
+
+    sum = csum_add64(sum, vgetq_lane_u64(acc, 0));
+    sum = csum_add64(sum, vgetq_lane_u64(acc, 1));
+
+    return csum_partial_scalar(ptr, len, sum);
+}
+#endif
+
+static uint64_t (*csum_partial_vector)(const uint8_t *ptr, size_t len, uint64_t sum) = csum_partial_scalar;
+
+// Runtime CPU dispatch, resolved once at load time
+__attribute__((constructor))
+static void cord_checksum_dispatch_init(void)
+{
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        csum_partial_vector = csum_partial_avx2;
+    }
+#elif defined(__ARM_NEON)
+    csum_partial_vector = csum_partial_neon;
+#endif
+}
+
+//
+// Buffer API
+//
+
+uint32_t cord_csum_partial(const void *buf, size_t len, uint32_t sum)
+{
+    const uint8_t *ptr = (const uint8_t *)buf;
+
+    if (len < CORD_CSUM_VECTOR_MIN_LEN)
+    {
+        return csum_fold64(csum_partial_scalar(ptr, len, sum));
+    }
+
+    return csum_fold64(csum_partial_vector(ptr, len, sum));
+}
+
+uint16_t cord_csum(const void *buf, size_t len)
+{
+    return (uint16_t)~cord_csum_partial(buf, len, 0);
+}
+
+//
+// Pseudo-headers
+//
+
+uint32_t cord_csum_pseudo_ipv4(uint32_t saddr, uint32_t daddr, uint8_t proto, uint16_t len)
+{
+    uint64_t sum = (uint64_t)saddr + daddr;
+    sum += cord_htons((uint16_t)proto);
+    sum += cord_htons(len);
+    return csum_fold64(sum);
+}
+
+uint32_t cord_csum_pseudo_ipv6(const cord_ipv6_addr_t *saddr, const cord_ipv6_addr_t *daddr,
+                               uint8_t next_hdr, uint32_t len)
+{
+    uint64_t sum = csum_partial_scalar(saddr->addr, sizeof(saddr->addr), 0);
+    sum = csum_partial_scalar(daddr->addr, sizeof(daddr->addr), sum);
+    sum = csum_add64(sum, cord_htonl(len));
+    sum = csum_add64(sum, cord_htonl((uint32_t)next_hdr));
+    return csum_fold64(sum);
+}
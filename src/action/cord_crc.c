@@ -0,0 +1,295 @@
+#include <action/cord_crc.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_acle.h>
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+
+//
+// Slicing-by-8 (portable)
+//
+// table[0] is the classic byte-wise table, table[k][n] advances table[k-1][n]
+// by one more zero byte, so 8 input bytes are folded with 8 independent lookups.
+//
+
+static uint32_t crc32_table[8][256];
+static uint32_t crc32c_table[8][256];
+
+static void crc_table_init(uint32_t table[8][256], uint32_t poly)
+{
+    for (uint32_t n = 0; n < 256; n++)
+    {
+        uint32_t crc = n;
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ ((crc & 1) ? poly : 0);
+        }
+        table[0][n] = crc;
+    }
+
+    for (uint32_t n = 0; n < 256; n++)
+    {
+        for (int k = 1; k < 8; k++)
+        {
+            table[k][n] = (table[k - 1][n] >> 8) ^ table[0][table[k - 1][n] & 0xFF];
+        }
+    }
+}
+
+static inline uint32_t crc_load32_le(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint32_t crc_slice8(const uint32_t table[8][256], uint32_t crc, const uint8_t *ptr, size_t len)
+{
+    while (len >= 8)
+    {
+        uint32_t lo = crc ^ crc_load32_le(ptr);
+        uint32_t hi = crc_load32_le(ptr + 4);
+
+        crc = table[7][lo & 0xFF] ^ table[6][(lo >> 8) & 0xFF] ^
+              table[5][(lo >> 16) & 0xFF] ^ table[4][lo >> 24] ^
+              table[3][hi & 0xFF] ^ table[2][(hi >> 8) & 0xFF] ^
+              table[1][(hi >> 16) & 0xFF] ^ table[0][hi >> 24];
+
+        ptr += 8;
+        len -= 8;
+    }
+
+    while (len--)
+    {
+        crc = table[0][(crc ^ *ptr++) & 0xFF] ^ (crc >> 8);
+    }
+
+    return crc;
+}
+
+static uint32_t crc32_slice8(uint32_t crc, const uint8_t *ptr, size_t len)
+{
+    return crc_slice8(crc32_table, crc, ptr, len);
+}
+
+static uint32_t crc32c_slice8(uint32_t crc, const uint8_t *ptr, size_t len)
+{
+    return crc_slice8(crc32c_table, crc, ptr, len);
+}
+
+#if defined(__x86_64__)
+//
+// CRC32 - PCLMULQDQ folding (x86-64)
+//
+// Four 128-bit lanes are folded 64 bytes at a time, reduced to one lane,
+// folded 16 bytes at a time, then Barrett-reduced to 32 bits.
+// Constants are x^(k) mod P(x) in the bit-reflected domain (Intel paper, CRC32).
+//
+
+#define CORD_CRC32_PCLMUL_MIN_LEN 64
+
+__attribute__((target("pclmul,sse4.1")))
+static uint32_t crc32_pclmul(uint32_t crc, const uint8_t *ptr, size_t len)
+{
+    if (len < CORD_CRC32_PCLMUL_MIN_LEN)
+    {
+        return crc32_slice8(crc, ptr, len);
+    }
+
+    const __m128i k1k2 = _mm_set_epi64x(0x01C6E41596, 0x0154442BD4);
+    const __m128i k3k4 = _mm_set_epi64x(0x00CCAA009E, 0x01751997D0);
+    const __m128i k5k0 = _mm_set_epi64x(0x0000000000, 0x0163CD6124);
+    const __m128i poly = _mm_set_epi64x(0x01F7011641, 0x01DB710641);
+    const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+
+    __m128i x1 = _mm_loadu_si128((const __m128i *)(ptr + 0x00));
+    __m128i x2 = _mm_loadu_si128((const __m128i *)(ptr + 0x10));
+    __m128i x3 = _mm_loadu_si128((const __m128i *)(ptr + 0x20));
+    __m128i x4 = _mm_loadu_si128((const __m128i *)(ptr + 0x30));
+    __m128i x5, x6, x7, x8;
+
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+    ptr += 64;
+    len -= 64;
+
+    // Parallel fold, 64 bytes per iteration
+    while (len >= 64)
+    {
+        x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+
+        x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i *)(ptr + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i *)(ptr + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i *)(ptr + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i *)(ptr + 0x30)));
+
+        ptr += 64;
+        len -= 64;
+    }
+
+    // Fold the four lanes into one
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    // Single fold, 16 bytes per iteration
+    while (len >= 16)
+    {
+        x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128((const __m128i *)ptr)), x5);
+        ptr += 16;
+        len -= 16;
+    }
+
+    // 128 -> 64 bits
+    x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask32);
+    x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction to 32 bits
+    x2 = _mm_and_si128(x1, mask32);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+    x2 = _mm_and_si128(x2, mask32);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    crc = (uint32_t)_mm_extract_epi32(x1, 1);
+
+    return crc32_slice8(crc, ptr, len);
+}
+
+//
+// CRC32C - SSE4.2 CRC32 instruction (x86-64)
+//
+
+__attribute__((target("sse4.2")))
+static uint32_t crc32c_sse42(uint32_t crc, const uint8_t *ptr, size_t len)
+{
+    uint64_t crc64 = crc;
+
+    while (len >= 8)
+    {
+        uint64_t word;
+        memcpy(&word, ptr, 8);
+        crc64 = _mm_crc32_u64(crc64, word);
+        ptr += 8;
+        len -= 8;
+    }
+
+    crc = (uint32_t)crc64;
+    while (len--)
+    {
+        crc = _mm_crc32_u8(crc, *ptr++);
+    }
+
+    return crc;
+}
+#elif defined(__aarch64__)
+//
+// CRC32 / CRC32C - ARMv8 CRC32 instructions (AArch64)
+//
+
+__attribute__((target("+crc")))
+static uint32_t crc32_armv8(uint32_t crc, const uint8_t *ptr, size_t len)
+{
+    while (len >= 8)
+    {
+        uint64_t word;
+        memcpy(&word, ptr, 8);
+        crc = __crc32d(crc, word);
+        ptr += 8;
+        len -= 8;
+    }
+
+    while (len--)
+    {
+        crc = __crc32b(crc, *ptr++);
+    }
+
+    return crc;
+}
+
+__attribute__((target("+crc")))
+static uint32_t crc32c_armv8(uint32_t crc, const uint8_t *ptr, size_t len)
+{
+    while (len >= 8)
+    {
+        uint64_t word;
+        memcpy(&word, ptr, 8);
+        crc = __crc32cd(crc, word);
+        ptr += 8;
+        len -= 8;
+    }
+
+    while (len--)
+    {
+        crc = __crc32cb(crc, *ptr++);
+    }
+
+    return crc;
+}
+#endif
+
+static uint32_t (*crc32_impl)(uint32_t crc, const uint8_t *ptr, size_t len) = crc32_slice8;
+static uint32_t (*crc32c_impl)(uint32_t crc, const uint8_t *ptr, size_t len) = crc32c_slice8;
+
+// Tables and runtime CPU dispatch, resolved once at load time
+__attribute__((constructor))
+static void cord_crc_dispatch_init(void)
+{
+    crc_table_init(crc32_table, CORD_CRC32_POLY);
+    crc_table_init(crc32c_table, CORD_CRC32C_POLY);
+
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1"))
+    {
+        crc32_impl = crc32_pclmul;
+    }
+    if (__builtin_cpu_supports("sse4.2"))
+    {
+        crc32c_impl = crc32c_sse42;
+    }
+#elif defined(__aarch64__)
+    if (getauxval(AT_HWCAP) & HWCAP_CRC32)
+    {
+        crc32_impl = crc32_armv8;
+        crc32c_impl = crc32c_armv8;
+    }
+#endif
+}
+
+//
+// Buffer API
+//
+
+uint32_t cord_crc32_update(uint32_t crc, const void *buf, size_t len)
+{
+    return crc32_impl(crc, (const uint8_t *)buf, len);
+}
+
+uint32_t cord_crc32c_update(uint32_t crc, const void *buf, size_t len)
+{
+    return crc32c_impl(crc, (const uint8_t *)buf, len);
+}
@@ -0,0 +1,786 @@
+#include <action/cord_tunnel.h>
+#include <action/cord_checksum.h>
+#include <string.h>
+
+#define CORD_TUNNEL_PREFETCH        4       // Packets to prefetch ahead in burst operations
+#define CORD_TUNNEL_UDP_SRC_PORT    49152   // Default outer UDP source port
+#define CORD_TUNNEL_DEFAULT_TTL     64
+#define CORD_GTPU_MSG_GPDU          0xFF
+
+//
+// Template builders
+//
+
+// Outer Ethernet + IPv4/IPv6 header; returns the offset after the IP header
+static uint16_t cord_tunnel_tmpl_outer(cord_tunnel_tmpl_t *tmpl, const cord_tunnel_endpoint_t *ep, uint8_t ip_proto)
+{
+    memset(tmpl, 0, sizeof(*tmpl));
+
+    cord_eth_hdr_t *eth = (cord_eth_hdr_t *)tmpl->hdr;
+    eth->h_dest = ep->eth_dst;
+    eth->h_source = ep->eth_src;
+    eth->h_proto = cord_htons(ep->ipv6 ? CORD_ETH_P_IPV6 : CORD_ETH_P_IP);
+
+    uint8_t ttl = ep->ttl ? ep->ttl : CORD_TUNNEL_DEFAULT_TTL;
+    tmpl->l3_offset = sizeof(cord_eth_hdr_t);
+    tmpl->ipv6 = ep->ipv6;
+
+    if (ep->ipv6)
+    {
+        cord_ipv6_hdr_t *ip6 = (cord_ipv6_hdr_t *)(tmpl->hdr + tmpl->l3_offset);
+        uint32_t ver_tc_flow = cord_htonl((6u << 28) | ((uint32_t)ep->tos << 20));
+        memcpy(ip6, &ver_tc_flow, sizeof(ver_tc_flow));
+        ip6->payload_len = 0;                   // Patched on encap
+        ip6->nexthdr = ip_proto;
+        ip6->hop_limit = ttl;
+        ip6->saddr = ep->ipv6_src;
+        ip6->daddr = ep->ipv6_dst;
+        return tmpl->l3_offset + sizeof(cord_ipv6_hdr_t);
+    }
+
+    cord_ipv4_hdr_t *ip = (cord_ipv4_hdr_t *)(tmpl->hdr + tmpl->l3_offset);
+    ip->version = 4;
+    ip->ihl = 5;
+    ip->tos = ep->tos;
+    ip->tot_len = 0;                            // Patched on encap
+    ip->id = 0;
+    ip->frag_off = cord_htons(0x4000);          // DF: atomic datagram, ID not needed (RFC 6864)
+    ip->ttl = ttl;
+    ip->protocol = ip_proto;
+    ip->saddr.addr = ep->ipv4_src;
+    ip->daddr.addr = ep->ipv4_dst;
+    ip->check = 0;
+    ip->check = cord_csum(ip, sizeof(cord_ipv4_hdr_t));
+    tmpl->ip_check = ip->check;
+
+    return tmpl->l3_offset + sizeof(cord_ipv4_hdr_t);
+}
+
+static uint16_t cord_tunnel_tmpl_udp(cord_tunnel_tmpl_t *tmpl, const cord_tunnel_endpoint_t *ep, uint16_t offset, uint16_t default_port)
+{
+    cord_udp_hdr_t *udp = (cord_udp_hdr_t *)(tmpl->hdr + offset);
+    udp->source = cord_htons(ep->udp_src_port ? ep->udp_src_port : CORD_TUNNEL_UDP_SRC_PORT);
+    udp->dest = cord_htons(ep->udp_dst_port ? ep->udp_dst_port : default_port);
+    udp->len = 0;                               // Patched on encap
+    udp->check = 0;
+
+    tmpl->l4_offset = offset;
+    return offset + sizeof(cord_udp_hdr_t);
+}
+
+static inline void cord_tunnel_set_vni(uint8_t *vni, uint32_t value)
+{
+    vni[0] = (value >> 16) & 0xFF;
+    vni[1] = (value >> 8) & 0xFF;
+    vni[2] = value & 0xFF;
+}
+
+cord_retval_t cord_tunnel_tmpl_vxlan(cord_tunnel_tmpl_t *tmpl, const cord_tunnel_endpoint_t *ep, uint32_t vni)
+{
+    if (!tmpl || !ep || vni > 0xFFFFFF)
+    {
+        return CORD_ERR_INVALID_PARAM;
+    }
+
+    uint16_t offset = cord_tunnel_tmpl_outer(tmpl, ep, CORD_IPPROTO_UDP);
+    offset = cord_tunnel_tmpl_udp(tmpl, ep, offset, CORD_VXLAN_PORT);
+
+    cord_vxlan_hdr_t *vxlan = (cord_vxlan_hdr_t *)(tmpl->hdr + offset);
+    vxlan->flags = 0x08;                        // I flag: valid VNI
+    cord_tunnel_set_vni(vxlan->vni, vni);
+
+    tmpl->type = CORD_TUNNEL_VXLAN;
+    tmpl->tun_offset = offset;
+    tmpl->hdr_len = offset + sizeof(cord_vxlan_hdr_t);
+    tmpl->inner_l2 = true;
+
+    return CORD_OK;
+}
+
+cord_retval_t cord_tunnel_tmpl_geneve(cord_tunnel_tmpl_t *tmpl, const cord_tunnel_endpoint_t *ep, uint32_t vni)
+{
+    if (!tmpl || !ep || vni > 0xFFFFFF)
+    {
+        return CORD_ERR_INVALID_PARAM;
+    }
+
+    uint16_t offset = cord_tunnel_tmpl_outer(tmpl, ep, CORD_IPPROTO_UDP);
+    offset = cord_tunnel_tmpl_udp(tmpl, ep, offset, CORD_GENEVE_PORT);
+
+    cord_geneve_hdr_t *geneve = (cord_geneve_hdr_t *)(tmpl->hdr + offset);
+    geneve->ver_opt_len = 0;                    // Version 0, no options
+    geneve->flags = 0;
+    geneve->protocol = cord_htons(CORD_ETH_P_TEB);
+    cord_tunnel_set_vni(geneve->vni, vni);
+
+    tmpl->type = CORD_TUNNEL_GENEVE;
+    tmpl->tun_offset = offset;
+    tmpl->hdr_len = offset + sizeof(cord_geneve_hdr_t);
+    tmpl->inner_l2 = true;
+
+    return CORD_OK;
+}
+
+cord_retval_t cord_tunnel_tmpl_gre(cord_tunnel_tmpl_t *tmpl, const cord_tunnel_endpoint_t *ep, uint16_t protocol, bool use_key, uint32_t key)
+{
+    if (!tmpl || !ep)
+    {
+        return CORD_ERR_INVALID_PARAM;
+    }
+
+    if (protocol != CORD_ETH_P_IP && protocol != CORD_ETH_P_IPV6 && protocol != CORD_ETH_P_TEB)
+    {
+        return CORD_ERR_UNSUPPORTED;
+    }
+
+    uint16_t offset = cord_tunnel_tmpl_outer(tmpl, ep, CORD_IPPROTO_GRE);
+
+    cord_gre_hdr_t *gre = (cord_gre_hdr_t *)(tmpl->hdr + offset);
+    gre->flags_version = cord_htons(use_key ? 0x2000 : 0);
+    gre->protocol = cord_htons(protocol);
+
+    tmpl->type = CORD_TUNNEL_GRE;
+    tmpl->tun_offset = offset;
+    tmpl->hdr_len = offset + sizeof(cord_gre_hdr_t);
+
+    if (use_key)
+    {
+        uint32_t key_be = cord_htonl(key);
+        memcpy(tmpl->hdr + tmpl->hdr_len, &key_be, sizeof(key_be));
+        tmpl->hdr_len += sizeof(key_be);
+    }
+
+    tmpl->inner_l2 = (protocol == CORD_ETH_P_TEB);
+
+    return CORD_OK;
+}
+
+cord_retval_t cord_tunnel_tmpl_gtpu(cord_tunnel_tmpl_t *tmpl, const cord_tunnel_endpoint_t *ep, uint32_t teid)
+{
+    if (!tmpl || !ep)
+    {
+        return CORD_ERR_INVALID_PARAM;
+    }
+
+    uint16_t offset = cord_tunnel_tmpl_outer(tmpl, ep, CORD_IPPROTO_UDP);
+    offset = cord_tunnel_tmpl_udp(tmpl, ep, offset, CORD_GTPU_PORT);
+
+    cord_gtpu_hdr_t *gtpu = (cord_gtpu_hdr_t *)(tmpl->hdr + offset);
+    gtpu->version_pt_reserved_e_s_pn = 0x30;    // Version 1, PT = GTP, no optional fields
+    gtpu->message_type = CORD_GTPU_MSG_GPDU;
+    gtpu->length = 0;                           // Patched on encap
+    gtpu->teid = cord_htonl(teid);
+
+    tmpl->type = CORD_TUNNEL_GTPU;
+    tmpl->tun_offset = offset;
+    tmpl->hdr_len = offset + sizeof(cord_gtpu_hdr_t);
+    tmpl->inner_l2 = false;
+
+    return CORD_OK;
+}
+
+cord_retval_t cord_tunnel_tmpl_mpls(cord_tunnel_tmpl_t *tmpl, const cord_tunnel_endpoint_t *ep,
+                                    const uint32_t *labels, uint8_t num_labels, uint8_t ttl)
+{
+    if (!tmpl || !ep || !labels || num_labels == 0 || num_labels > CORD_TUNNEL_MAX_MPLS_LABELS)
+    {
+        return CORD_ERR_INVALID_PARAM;
+    }
+
+    memset(tmpl, 0, sizeof(*tmpl));
+
+    cord_eth_hdr_t *eth = (cord_eth_hdr_t *)tmpl->hdr;
+    eth->h_dest = ep->eth_dst;
+    eth->h_source = ep->eth_src;
+    eth->h_proto = cord_htons(CORD_ETH_P_MPLS_UC);
+
+    uint16_t offset = sizeof(cord_eth_hdr_t);
+    ttl = ttl ? ttl : CORD_TUNNEL_DEFAULT_TTL;
+
+    for (uint8_t i = 0; i < num_labels; i++)
+    {
+        if (labels[i] > 0xFFFFF)
+        {
+            return CORD_ERR_INVALID_PARAM;
+        }
+
+        // Label:20, EXP:3, S:1 (bottom of stack), TTL:8
+        uint32_t entry = (labels[i] << 12) | ((i == num_labels - 1) ? 0x100 : 0) | ttl;
+        uint32_t entry_be = cord_htonl(entry);
+        memcpy(tmpl->hdr + offset, &entry_be, sizeof(entry_be));
+        offset += sizeof(cord_mpls_hdr_t);
+    }
+
+    tmpl->type = CORD_TUNNEL_MPLS;
+    tmpl->hdr_len = offset;
+    tmpl->inner_l2 = false;
+
+    return CORD_OK;
+}
+
+//
+// Encap / decap on packet data
+//
+
+// Copy the template and patch the length fields; len covers the whole encapsulated packet
+static inline void cord_tunnel_write_hdr(uint8_t *data, uint32_t len, const cord_tunnel_tmpl_t *tmpl)
+{
+    memcpy(data, tmpl->hdr, tmpl->hdr_len);
+
+    if (tmpl->l3_offset)
+    {
+        if (tmpl->ipv6)
+        {
+            cord_ipv6_hdr_t *ip6 = (cord_ipv6_hdr_t *)(data + tmpl->l3_offset);
+            ip6->payload_len = cord_htons(len - tmpl->l3_offset - sizeof(cord_ipv6_hdr_t));
+        }
+        else
+        {
+            cord_ipv4_hdr_t *ip = (cord_ipv4_hdr_t *)(data + tmpl->l3_offset);
+            ip->tot_len = cord_htons(len - tmpl->l3_offset);
+            ip->check = cord_csum_replace16(tmpl->ip_check, 0, ip->tot_len);
+        }
+    }
+
+    if (tmpl->l4_offset)
+    {
+        cord_udp_hdr_t *udp = (cord_udp_hdr_t *)(data + tmpl->l4_offset);
+        udp->len = cord_htons(len - tmpl->l4_offset);
+    }
+
+    if (tmpl->type == CORD_TUNNEL_GTPU)
+    {
+        // GTP-U length excludes the mandatory 8-byte header
+        cord_gtpu_hdr_t *gtpu = (cord_gtpu_hdr_t *)(data + tmpl->tun_offset);
+        gtpu->length = cord_htons(len - tmpl->tun_offset - sizeof(cord_gtpu_hdr_t));
+    }
+}
+
+static inline uint16_t cord_tunnel_ip_ethertype(uint8_t first_byte)
+{
+    switch (first_byte >> 4)
+    {
+        case 4:
+            return CORD_ETH_P_IP;
+        case 6:
+            return CORD_ETH_P_IPV6;
+        default:
+            return 0;
+    }
+}
+
+static inline uint16_t cord_tunnel_default_port(cord_tunnel_type_t type)
+{
+    switch (type)
+    {
+        case CORD_TUNNEL_VXLAN:
+            return CORD_VXLAN_PORT;
+        case CORD_TUNNEL_GENEVE:
+            return CORD_GENEVE_PORT;
+        case CORD_TUNNEL_GTPU:
+            return CORD_GTPU_PORT;
+        default:
+            return 0;
+    }
+}
+
+// Locate the inner payload of a tunnel packet. Returns its offset (0 = not a tunnel of this type);
+// *inner_proto is the EtherType of an L3 payload, 0 for an Ethernet payload.
+// UDP tunnels must be addressed to udp_dst_port (0 = IANA port of the tunnel type).
+static uint32_t cord_tunnel_parse(const uint8_t *data, uint32_t len, cord_tunnel_type_t type, uint16_t udp_dst_port, uint16_t *inner_proto)
+{
+    uint32_t offset = sizeof(cord_eth_hdr_t);
+
+    if (len < offset)
+    {
+        return 0;
+    }
+
+    uint16_t eth_proto = cord_ntohs(((const cord_eth_hdr_t *)data)->h_proto);
+
+    // Outer VLAN tags
+    while ((eth_proto == CORD_ETH_P_8021Q || eth_proto == CORD_ETH_P_8021AD) && len >= offset + sizeof(cord_vlan_hdr_t))
+    {
+        eth_proto = cord_ntohs(((const cord_vlan_hdr_t *)(data + offset))->h_proto);
+        offset += sizeof(cord_vlan_hdr_t);
+    }
+
+    if (type == CORD_TUNNEL_MPLS)
+    {
+        if (eth_proto != CORD_ETH_P_MPLS_UC && eth_proto != CORD_ETH_P_MPLS_MC)
+        {
+            return 0;
+        }
+
+        uint32_t entry;
+        do
+        {
+            if (len < offset + sizeof(cord_mpls_hdr_t))
+            {
+                return 0;
+            }
+            memcpy(&entry, data + offset, sizeof(entry));
+            offset += sizeof(cord_mpls_hdr_t);
+        } while (!(cord_ntohl(entry) & 0x100));
+
+        if (len <= offset)
+        {
+            return 0;
+        }
+
+        *inner_proto = cord_tunnel_ip_ethertype(data[offset]);
+        return *inner_proto ? offset : 0;
+    }
+
+    uint8_t l4_proto;
+
+    if (eth_proto == CORD_ETH_P_IP)
+    {
+        if (len < offset + sizeof(cord_ipv4_hdr_t))
+        {
+            return 0;
+        }
+
+        const cord_ipv4_hdr_t *ip = (const cord_ipv4_hdr_t *)(data + offset);
+        if (ip->ihl < 5)
+        {
+            return 0;
+        }
+
+        if (ip->frag_off & cord_htons(0x3FFF))
+        {
+            return 0; // Fragmented outer packet
+        }
+
+        l4_proto = ip->protocol;
+        offset += ip->ihl * 4;
+    }
+    else if (eth_proto == CORD_ETH_P_IPV6)
+    {
+        if (len < offset + sizeof(cord_ipv6_hdr_t))
+        {
+            return 0;
+        }
+
+        l4_proto = ((const cord_ipv6_hdr_t *)(data + offset))->nexthdr;
+        offset += sizeof(cord_ipv6_hdr_t);
+    }
+    else
+    {
+        return 0;
+    }
+
+    if (type == CORD_TUNNEL_GRE)
+    {
+        if (l4_proto != CORD_IPPROTO_GRE || len < offset + sizeof(cord_gre_hdr_t))
+        {
+            return 0;
+        }
+
+        const cord_gre_hdr_t *gre = (const cord_gre_hdr_t *)(data + offset);
+        uint16_t flags = cord_ntohs(gre->flags_version);
+        uint16_t protocol = cord_ntohs(gre->protocol);
+
+        if (flags & 0x0007)
+        {
+            return 0; // Only GRE version 0
+        }
+
+        // Optional checksum, key and sequence number words
+        offset += sizeof(cord_gre_hdr_t);
+        offset += (flags & 0x8000) ? 4 : 0;
+        offset += (flags & 0x2000) ? 4 : 0;
+        offset += (flags & 0x1000) ? 4 : 0;
+
+        *inner_proto = (protocol == CORD_ETH_P_TEB) ? 0 : protocol;
+        return (offset < len) ? offset : 0;
+    }
+
+    if (l4_proto != CORD_IPPROTO_UDP || len < offset + sizeof(cord_udp_hdr_t) + 8)
+    {
+        return 0;
+    }
+
+    // Only UDP to the tunnel port is a tunnel of this type
+    if (!udp_dst_port)
+    {
+        udp_dst_port = cord_tunnel_default_port(type);
+    }
+
+    if (((const cord_udp_hdr_t *)(data + offset))->dest != cord_htons(udp_dst_port))
+    {
+        return 0;
+    }
+
+    offset += sizeof(cord_udp_hdr_t);
+
+    switch (type)
+    {
+        case CORD_TUNNEL_VXLAN:
+        {
+            const cord_vxlan_hdr_t *vxlan = (const cord_vxlan_hdr_t *)(data + offset);
+            if (!(vxlan->flags & 0x08))
+            {
+                return 0;
+            }
+
+            offset += sizeof(cord_vxlan_hdr_t);
+            *inner_proto = 0;
+            break;
+        }
+
+        case CORD_TUNNEL_GENEVE:
+        {
+            const cord_geneve_hdr_t *geneve = (const cord_geneve_hdr_t *)(data + offset);
+            if (geneve->ver_opt_len >> 6)
+            {
+                return 0; // Only version 0
+            }
+
+            uint16_t protocol = cord_ntohs(geneve->protocol);
+            offset += sizeof(cord_geneve_hdr_t) + (geneve->ver_opt_len & 0x3F) * 4;
+            *inner_proto = (protocol == CORD_ETH_P_TEB) ? 0 : protocol;
+            break;
+        }
+
+        case CORD_TUNNEL_GTPU:
+        {
+            const cord_gtpu_hdr_t *gtpu = (const cord_gtpu_hdr_t *)(data + offset);
+            uint8_t flags = gtpu->version_pt_reserved_e_s_pn;
+            if ((flags >> 5) != 1 || gtpu->message_type != CORD_GTPU_MSG_GPDU)
+            {
+                return 0;
+            }
+
+            offset += sizeof(cord_gtpu_hdr_t);
+
+            // E/S/PN: sequence number, N-PDU number and next extension type follow
+            if (flags & 0x07)
+            {
+                offset += 4;
+                if (len < offset)
+                {
+                    return 0;
+                }
+
+                uint8_t next_ext = (flags & 0x04) ? data[offset - 1] : 0;
+                while (next_ext)
+                {
+                    if (len <= offset || data[offset] == 0)
+                    {
+                        return 0;
+                    }
+
+                    offset += data[offset] * 4;
+                    if (len < offset)
+                    {
+                        return 0;
+                    }
+
+                    next_ext = data[offset - 1];
+                }
+            }
+
+            if (len <= offset)
+            {
+                return 0;
+            }
+
+            *inner_proto = cord_tunnel_ip_ethertype(data[offset]);
+            if (!*inner_proto)
+            {
+                return 0;
+            }
+            break;
+        }
+
+        default:
+            return 0;
+    }
+
+    return (offset < len) ? offset : 0;
+}
+
+// Returns the number of leading bytes to strip (0 = not a tunnel of this type).
+// For L3 payloads the outer Ethernet addresses are moved in front of the inner packet.
+static inline uint32_t cord_tunnel_decap_hdr(uint8_t *data, uint32_t len, cord_tunnel_type_t type, uint16_t udp_dst_port)
+{
+    uint16_t inner_proto = 0;
+    uint32_t offset = cord_tunnel_parse(data, len, type, udp_dst_port, &inner_proto);
+
+    if (offset == 0 || inner_proto == 0)
+    {
+        return offset;
+    }
+
+    uint32_t strip = offset - sizeof(cord_eth_hdr_t);
+    uint16_t h_proto = cord_htons(inner_proto);
+    memmove(data + strip, data, 2 * CORD_ETH_ALEN);
+    memcpy(data + strip + 2 * CORD_ETH_ALEN, &h_proto, sizeof(h_proto));
+
+    return strip;
+}
+
+// Bytes of inner Ethernet header (VLAN tags included) that encap removes; -1 if the inner
+// frame is too short or does not carry the protocol the template encapsulates.
+static inline int32_t cord_tunnel_encap_strip(const uint8_t *data, uint32_t len, const cord_tunnel_tmpl_t *tmpl)
+{
+    if (len < sizeof(cord_eth_hdr_t))
+    {
+        return -1;
+    }
+
+    if (tmpl->inner_l2)
+    {
+        return 0;
+    }
+
+    uint32_t offset = sizeof(cord_eth_hdr_t);
+    uint16_t eth_proto = cord_ntohs(((const cord_eth_hdr_t *)data)->h_proto);
+
+    while ((eth_proto == CORD_ETH_P_8021Q || eth_proto == CORD_ETH_P_8021AD) && len >= offset + sizeof(cord_vlan_hdr_t))
+    {
+        eth_proto = cord_ntohs(((const cord_vlan_hdr_t *)(data + offset))->h_proto);
+        offset += sizeof(cord_vlan_hdr_t);
+    }
+
+    if (offset >= len)
+    {
+        return -1;
+    }
+
+    if (tmpl->type == CORD_TUNNEL_GRE)
+    {
+        const cord_gre_hdr_t *gre = (const cord_gre_hdr_t *)(tmpl->hdr + tmpl->tun_offset);
+        if (eth_proto != cord_ntohs(gre->protocol))
+        {
+            return -1;
+        }
+    }
+    else if (eth_proto != CORD_ETH_P_IP && eth_proto != CORD_ETH_P_IPV6)
+    {
+        return -1;
+    }
+
+    return (int32_t)offset;
+}
+
+// Default dataplane (L2 raw socket)
+#if !defined(ENABLE_DPDK_DATAPLANE) && !defined(ENABLE_XDP_DATAPLANE)
+
+cord_retval_t cord_tunnel_encap(cord_raw_pkt_desc_t *pkt, const cord_tunnel_tmpl_t *tmpl)
+{
+    int32_t strip = cord_tunnel_encap_strip(pkt->data, pkt->data_len, tmpl);
+
+    if (strip < 0)
+    {
+        return CORD_ERR_INVALID_PARAM;
+    }
+
+    if (cord_raw_pkt_headroom(pkt) + strip < tmpl->hdr_len)
+    {
+        return CORD_ERR_NO_MEMORY;
+    }
+
+    cord_raw_pkt_adj(pkt, strip);
+    cord_raw_pkt_prepend(pkt, tmpl->hdr_len);
+    cord_tunnel_write_hdr(pkt->data, pkt->data_len, tmpl);
+
+    return CORD_OK;
+}
+
+cord_retval_t cord_tunnel_decap(cord_raw_pkt_desc_t *pkt, cord_tunnel_type_t type, uint16_t udp_dst_port)
+{
+    uint32_t strip = cord_tunnel_decap_hdr(pkt->data, pkt->data_len, type, udp_dst_port);
+    if (strip == 0)
+    {
+        return CORD_ERR_NOT_FOUND;
+    }
+
+    cord_raw_pkt_adj(pkt, strip);
+
+    return CORD_OK;
+}
+
+uint32_t cord_tunnel_encap_burst(cord_raw_pkt_desc_t **pkts, uint32_t count, const cord_tunnel_tmpl_t *tmpl)
+{
+    uint32_t done = 0;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (i + CORD_TUNNEL_PREFETCH < count)
+        {
+            __builtin_prefetch(pkts[i + CORD_TUNNEL_PREFETCH]->data - tmpl->hdr_len, 1);
+        }
+
+        done += (cord_tunnel_encap(pkts[i], tmpl) == CORD_OK);
+    }
+
+    return done;
+}
+
+uint32_t cord_tunnel_decap_burst(cord_raw_pkt_desc_t **pkts, uint32_t count, cord_tunnel_type_t type, uint16_t udp_dst_port)
+{
+    uint32_t done = 0;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (i + CORD_TUNNEL_PREFETCH < count)
+        {
+            __builtin_prefetch(pkts[i + CORD_TUNNEL_PREFETCH]->data, 1);
+        }
+
+        done += (cord_tunnel_decap(pkts[i], type, udp_dst_port) == CORD_OK);
+    }
+
+    return done;
+}
+
+#endif // Default dataplane
+
+#ifdef ENABLE_DPDK_DATAPLANE
+
+cord_retval_t cord_tunnel_encap(struct rte_mbuf *mbuf, const cord_tunnel_tmpl_t *tmpl)
+{
+    // Inner Ethernet header must be in the first segment
+    int32_t strip = cord_tunnel_encap_strip(rte_pktmbuf_mtod(mbuf, const uint8_t *), rte_pktmbuf_data_len(mbuf), tmpl);
+
+    if (strip < 0)
+    {
+        return CORD_ERR_INVALID_PARAM;
+    }
+
+    if (rte_pktmbuf_headroom(mbuf) + strip < tmpl->hdr_len)
+    {
+        return CORD_ERR_NO_MEMORY;
+    }
+
+    rte_pktmbuf_adj(mbuf, strip);
+    uint8_t *data = (uint8_t *)rte_pktmbuf_prepend(mbuf, tmpl->hdr_len);
+    cord_tunnel_write_hdr(data, rte_pktmbuf_pkt_len(mbuf), tmpl);
+
+    return CORD_OK;
+}
+
+cord_retval_t cord_tunnel_decap(struct rte_mbuf *mbuf, cord_tunnel_type_t type, uint16_t udp_dst_port)
+{
+    // Outer headers must be in the first segment
+    uint32_t strip = cord_tunnel_decap_hdr(rte_pktmbuf_mtod(mbuf, uint8_t *), rte_pktmbuf_data_len(mbuf), type, udp_dst_port);
+    if (strip == 0)
+    {
+        return CORD_ERR_NOT_FOUND;
+    }
+
+    rte_pktmbuf_adj(mbuf, strip);
+
+    return CORD_OK;
+}
+
+uint32_t cord_tunnel_encap_burst(struct rte_mbuf **mbufs, uint32_t count, const cord_tunnel_tmpl_t *tmpl)
+{
+    uint32_t done = 0;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (i + CORD_TUNNEL_PREFETCH < count)
+        {
+            rte_prefetch0(rte_pktmbuf_mtod(mbufs[i + CORD_TUNNEL_PREFETCH], uint8_t *) - tmpl->hdr_len);
+        }
+
+        done += (cord_tunnel_encap(mbufs[i], tmpl) == CORD_OK);
+    }
+
+    return done;
+}
+
+uint32_t cord_tunnel_decap_burst(struct rte_mbuf **mbufs, uint32_t count, cord_tunnel_type_t type, uint16_t udp_dst_port)
+{
+    uint32_t done = 0;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (i + CORD_TUNNEL_PREFETCH < count)
+        {
+            rte_prefetch0(rte_pktmbuf_mtod(mbufs[i + CORD_TUNNEL_PREFETCH], void *));
+        }
+
+        done += (cord_tunnel_decap(mbufs[i], type, udp_dst_port) == CORD_OK);
+    }
+
+    return done;
+}
+
+#endif // ENABLE_DPDK_DATAPLANE
+
+#ifdef ENABLE_XDP_DATAPLANE
+
+cord_retval_t cord_tunnel_encap(struct cord_xdp_pkt_desc *pkt, const cord_tunnel_tmpl_t *tmpl)
+{
+    int32_t strip = cord_tunnel_encap_strip((const uint8_t *)pkt->data, pkt->len, tmpl);
+
+    if (strip < 0)
+    {
+        return CORD_ERR_INVALID_PARAM;
+    }
+
+    if (cord_xdp_pkt_headroom(pkt) + strip < tmpl->hdr_len)
+    {
+        return CORD_ERR_NO_MEMORY;
+    }
+
+    pkt->data = (void *)((uint8_t *)pkt->data + strip - tmpl->hdr_len);
+    pkt->len = pkt->len - strip + tmpl->hdr_len;
+    cord_tunnel_write_hdr((uint8_t *)pkt->data, pkt->len, tmpl);
+
+    return CORD_OK;
+}
+
+cord_retval_t cord_tunnel_decap(struct cord_xdp_pkt_desc *pkt, cord_tunnel_type_t type, uint16_t udp_dst_port)
+{
+    uint32_t strip = cord_tunnel_decap_hdr((uint8_t *)pkt->data, pkt->len, type, udp_dst_port);
+    if (strip == 0)
+    {
+        return CORD_ERR_NOT_FOUND;
+    }
+
+    pkt->data = (void *)((uint8_t *)pkt->data + strip);
+    pkt->len -= strip;
+
+    return CORD_OK;
+}
+
+uint32_t cord_tunnel_encap_burst(struct cord_xdp_pkt_desc **pkts, uint32_t count, const cord_tunnel_tmpl_t *tmpl)
+{
+    uint32_t done = 0;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (i + CORD_TUNNEL_PREFETCH < count)
+        {
+            __builtin_prefetch((uint8_t *)pkts[i + CORD_TUNNEL_PREFETCH]->data - tmpl->hdr_len, 1);
+        }
+
+        done += (cord_tunnel_encap(pkts[i], tmpl) == CORD_OK);
+    }
+
+    return done;
+}
+
+uint32_t cord_tunnel_decap_burst(struct cord_xdp_pkt_desc **pkts, uint32_t count, cord_tunnel_type_t type, uint16_t udp_dst_port)
+{
+    uint32_t done = 0;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (i + CORD_TUNNEL_PREFETCH < count)
+        {
+            __builtin_prefetch(pkts[i + CORD_TUNNEL_PREFETCH]->data, 1);
+        }
+
+        done += (cord_tunnel_decap(pkts[i], type, udp_dst_port) == CORD_OK);
+    }
+
+    return done;
+}
+
+#endif // ENABLE_XDP_DATAPLANE
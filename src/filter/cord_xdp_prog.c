@@ -0,0 +1,197 @@
+#ifdef ENABLE_XDP_DATAPLANE
+
+#include <filter/cord_xdp_prog.h>
+#include <cord_error.h>
+#include <stdlib.h>
+#include <string.h>
+#include <arpa/inet.h>
+
+#include <bpf/bpf.h>
+#include <bpf/libbpf.h>
+
+//
+// Attach / Detach
+//
+
+cord_xdp_prog_t *cord_xdp_prog_attach(int ifindex, const cord_xdp_prog_cfg_t *cfg)
+{
+    const char *obj_path = (cfg && cfg->obj_path) ? cfg->obj_path : CORD_XDP_DEFAULT_PROG_PATH;
+    const char *prog_name = (cfg && cfg->prog_name) ? cfg->prog_name : NULL;
+    const char *xsks_map_name = (cfg && cfg->xsks_map_name) ? cfg->xsks_map_name : CORD_XDP_DEFAULT_XSKS_MAP;
+    enum xdp_attach_mode mode = cfg ? cfg->mode : XDP_MODE_UNSPEC;
+    int ret;
+
+    if (!prog_name && !(cfg && cfg->obj_path))
+        prog_name = CORD_XDP_DEFAULT_PROG_NAME;
+
+    cord_xdp_prog_t *xdp_prog = calloc(1, sizeof(cord_xdp_prog_t));
+    if (!xdp_prog)
+    {
+        CORD_ERROR("[cord_xdp_prog_attach] calloc");
+        return NULL;
+    }
+
+    DECLARE_LIBXDP_OPTS(xdp_program_opts, opts,
+                        .open_filename = obj_path,
+                        .prog_name = prog_name);
+
+    xdp_prog->prog = xdp_program__create(&opts);
+    if (libxdp_get_error(xdp_prog->prog))
+    {
+        CORD_LOG("[cord_xdp_prog_attach] Failed to open %s\n", obj_path);
+        free(xdp_prog);
+        return NULL;
+    }
+
+    // Native (driver) mode first, then generic XDP
+    if (mode == XDP_MODE_UNSPEC)
+    {
+        ret = xdp_program__attach(xdp_prog->prog, ifindex, XDP_MODE_NATIVE, 0);
+        mode = (ret == 0) ? XDP_MODE_NATIVE : XDP_MODE_SKB;
+        if (ret != 0)
+            ret = xdp_program__attach(xdp_prog->prog, ifindex, XDP_MODE_SKB, 0);
+    }
+    else
+    {
+        ret = xdp_program__attach(xdp_prog->prog, ifindex, mode, 0);
+    }
+
+    if (ret != 0)
+    {
+        CORD_LOG("[cord_xdp_prog_attach] Failed to attach %s on ifindex %d: %d\n", obj_path, ifindex, ret);
+        xdp_program__close(xdp_prog->prog);
+        free(xdp_prog);
+        return NULL;
+    }
+
+    xdp_prog->ifindex = ifindex;
+    xdp_prog->mode = mode;
+
+    // Programs without an XSKMAP are plain interface programs (drop / pass / TX)
+    xdp_prog->xsks_map_fd = bpf_object__find_map_fd_by_name(xdp_program__bpf_obj(xdp_prog->prog), xsks_map_name);
+    if (xdp_prog->xsks_map_fd < 0)
+        xdp_prog->xsks_map_fd = -1;
+
+    return xdp_prog;
+}
+
+void cord_xdp_prog_detach(cord_xdp_prog_t *xdp_prog)
+{
+    if (!xdp_prog)
+        return;
+
+    if (xdp_program__detach(xdp_prog->prog, xdp_prog->ifindex, xdp_prog->mode, 0) != 0)
+        CORD_LOG("[cord_xdp_prog_detach] Failed to detach the XDP program from ifindex %d\n", xdp_prog->ifindex);
+
+    xdp_program__close(xdp_prog->prog);
+    free(xdp_prog);
+}
+
+static bool cord_xdp_prog_is_xsk_default(const struct xdp_program *prog)
+{
+    const char *name = prog ? xdp_program__name(prog) : NULL;
+    return name && strcmp(name, CORD_XDP_XSK_DEFAULT_PROG_NAME) == 0;
+}
+
+void cord_xdp_prog_remove_xsk_default(int ifindex)
+{
+    struct xdp_multiprog *mp = xdp_multiprog__get_from_ifindex(ifindex);
+    if (libxdp_get_error(mp) || !mp)
+        return;
+
+    enum xdp_attach_mode mode = xdp_multiprog__attach_mode(mp);
+    struct xdp_program *prog = NULL;
+
+    // Programs of other users of the interface stay attached
+    if (xdp_multiprog__is_legacy(mp))
+    {
+        if (cord_xdp_prog_is_xsk_default(xdp_multiprog__main_prog(mp)))
+            prog = xdp_multiprog__main_prog(mp);
+    }
+    else
+    {
+        for (struct xdp_program *p = xdp_multiprog__next_prog(NULL, mp); p; p = xdp_multiprog__next_prog(p, mp))
+        {
+            if (cord_xdp_prog_is_xsk_default(p))
+            {
+                prog = p;
+                break;
+            }
+        }
+    }
+
+    if (prog && xdp_program__detach(prog, ifindex, mode, 0) != 0)
+        CORD_LOG("[cord_xdp_prog_remove_xsk_default] Failed to detach the XSK program from ifindex %d\n", ifindex);
+
+    xdp_multiprog__close(mp);
+}
+
+//
+// XSKMAP
+//
+
+cord_retval_t cord_xdp_prog_register_socket(cord_xdp_prog_t *xdp_prog, struct cord_xdp_socket_info *xsk_info)
+{
+    if (!xdp_prog || !xsk_info || !xsk_info->xsk)
+        return CORD_ERR_INVALID_PARAM;
+
+    if (xdp_prog->xsks_map_fd < 0)
+        return CORD_ERR_NOT_FOUND;
+
+    if (xsk_socket__update_xskmap(xsk_info->xsk, xdp_prog->xsks_map_fd) != 0)
+    {
+        CORD_LOG("[cord_xdp_prog_register_socket] Failed to insert queue %u into the XSKMAP\n", xsk_info->queue_id);
+        return CORD_ERR;
+    }
+
+    return CORD_OK;
+}
+
+//
+// Default program steering
+//
+
+static int cord_xdp_prog_steer_map_fd(cord_xdp_prog_t *xdp_prog)
+{
+    return bpf_object__find_map_fd_by_name(xdp_program__bpf_obj(xdp_prog->prog), CORD_XDP_DEFAULT_STEER_MAP);
+}
+
+cord_retval_t cord_xdp_prog_steer_add(cord_xdp_prog_t *xdp_prog, uint8_t ip_proto, uint16_t dst_port)
+{
+    if (!xdp_prog)
+        return CORD_ERR_INVALID_PARAM;
+
+    int map_fd = cord_xdp_prog_steer_map_fd(xdp_prog);
+    if (map_fd < 0)
+        return CORD_ERR_NOT_FOUND;
+
+    cord_xdp_steer_key_t key = { .ip_proto = ip_proto, .pad = 0, .dst_port = htons(dst_port) };
+    uint8_t value = 1;
+
+    if (bpf_map_update_elem(map_fd, &key, &value, BPF_ANY) != 0)
+    {
+        CORD_ERROR("[cord_xdp_prog_steer_add] bpf_map_update_elem");
+        return CORD_ERR;
+    }
+
+    return CORD_OK;
+}
+
+cord_retval_t cord_xdp_prog_steer_del(cord_xdp_prog_t *xdp_prog, uint8_t ip_proto, uint16_t dst_port)
+{
+    if (!xdp_prog)
+        return CORD_ERR_INVALID_PARAM;
+
+    int map_fd = cord_xdp_prog_steer_map_fd(xdp_prog);
+    if (map_fd < 0)
+        return CORD_ERR_NOT_FOUND;
+
+    cord_xdp_steer_key_t key = { .ip_proto = ip_proto, .pad = 0, .dst_port = htons(dst_port) };
+
+    if (bpf_map_delete_elem(map_fd, &key) != 0)
+        return CORD_ERR_NOT_FOUND;
+
+    return CORD_OK;
+}
+
+#endif // ENABLE_XDP_DATAPLANE
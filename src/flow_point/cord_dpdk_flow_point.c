@@ -5,6 +5,11 @@
 #include <cord_error.h>
 #include <rte_eal.h>
 #include <rte_errno.h>
+#include <rte_byteorder.h>
+#include <rte_cycles.h>
+#include <rte_malloc.h>
+#include <rte_pause.h>
+#include <netinet/in.h>
 #include <string.h>
 #include <stdbool.h>
 
@@ -14,37 +19,99 @@ static cord_retval_t CordDpdkFlowPoint_rx_(CordDpdkFlowPoint * const self, uint1
     CORD_LOG("[CordDpdkFlowPoint] rx()\n");
 #endif
     struct rte_mbuf** mbufs = (struct rte_mbuf**)buffer;
-    *rx_packets = rte_eth_rx_burst(self->port_id, queue_id, mbufs, len); // size_t len here is the burst length (packets, not bytes)
+    // size_t len here is the burst length (packets, not bytes); rte_eth_rx_burst() takes 16 bits
+    *rx_packets = rte_eth_rx_burst(self->port_id, queue_id, mbufs, (uint16_t)RTE_MIN(len, (size_t)UINT16_MAX));
 
     if (unlikely(*rx_packets < 0))
     {
         CORD_ERROR("[CordDpdkFlowPoint] rx : rte_eth_rx_burst()");
+        CordFlowPoint_count_rx_error(&self->base, queue_id);
         return CORD_ERR;
     }
 
+    uint64_t rx_bytes = 0;
+    for (ssize_t n = 0; n < *rx_packets; n++)
+        rx_bytes += mbufs[n]->pkt_len;
+
+    CordFlowPoint_count_rx(&self->base, queue_id, *rx_packets, rx_bytes);
+
     return CORD_OK;
 }
 
+// rte_eth_tx_burst with bounded retries of the unsent tail; what is left is freed and counted
+static uint16_t cord_dpdk_tx_burst_retry(CordDpdkFlowPoint * const self, uint16_t queue_id, struct rte_mbuf **mbufs, uint16_t count)
+{
+    // Sent mbufs belong to the driver, so the bytes are summed up front
+    uint64_t tx_bytes = 0;
+    for (uint16_t n = 0; n < count; n++)
+        tx_bytes += mbufs[n]->pkt_len;
+
+    uint16_t sent = rte_eth_tx_burst(self->port_id, queue_id, mbufs, count);
+
+    for (uint16_t retry = 0; sent < count && retry < self->tx_max_retries; retry++)
+    {
+        rte_pause();
+        sent += rte_eth_tx_burst(self->port_id, queue_id, mbufs + sent, count - sent);
+        CordFlowPoint_count_ring_full(&self->base, queue_id);
+    }
+
+    if (unlikely(sent < count))
+    {
+        for (uint16_t n = sent; n < count; n++)
+            tx_bytes -= mbufs[n]->pkt_len;
+
+        rte_pktmbuf_free_bulk(mbufs + sent, count - sent);
+        CordFlowPoint_count_tx_dropped(&self->base, queue_id, count - sent);
+    }
+
+    CordFlowPoint_count_tx(&self->base, queue_id, sent, tx_bytes);
+
+    return sent;
+}
+
 static cord_retval_t CordDpdkFlowPoint_tx_(CordDpdkFlowPoint * const self, uint16_t queue_id, void *buffer, size_t len, ssize_t *tx_packets)
 {
 #ifdef CORD_FLOW_POINT_LOG
     CORD_LOG("[CordDpdkFlowPoint] tx()\n");
 #endif
-    struct rte_mbuf** mbufs = (struct rte_mbuf**)buffer;
-    *tx_packets = rte_eth_tx_burst(self->port_id, queue_id, mbufs, len); // size_t len here is the burst length (packets, not bytes)
+    struct rte_mbuf** mbufs = (struct rte_mbuf**)buffer; // size_t len here is the burst length (packets, not bytes)
 
-    // Free any unsent packets
-    if (unlikely(*tx_packets < len))
+    if (unlikely(queue_id >= self->queue_count))
     {
-        for (uint16_t n = *tx_packets; n < len; n++)
-            rte_pktmbuf_free(mbufs[n]);
+        rte_pktmbuf_free_bulk(mbufs, len);
+        CordFlowPoint_count_tx_error(&self->base, queue_id);
+        *tx_packets = 0;
+        return CORD_ERR_INVALID_PARAM;
     }
 
-    if (unlikely(*tx_packets < 0))
+    if (self->tx_threshold == 0)
     {
-        CORD_ERROR("[CordDpdkFlowPoint] tx : rte_eth_tx_burst()");
-        return CORD_ERR;
+        // rte_eth_tx_burst() takes a 16-bit count
+        ssize_t sent = 0;
+        for (size_t n = 0; n < len; n += UINT16_MAX)
+            sent += cord_dpdk_tx_burst_retry(self, queue_id, mbufs + n, (uint16_t)RTE_MIN(len - n, (size_t)UINT16_MAX));
+
+        *tx_packets = sent;
+        return CORD_OK;
     }
+
+    // Buffered: the packets are accepted now and sent by a later flush
+    cord_dpdk_tx_queue_t *txq = &self->tx_queues[queue_id];
+
+    for (size_t n = 0; n < len; n++)
+    {
+        if (txq->count == 0)
+            txq->deadline_tsc = rte_rdtsc() + self->tx_timeout_tsc;
+
+        txq->pkts[txq->count++] = mbufs[n];
+
+        if (txq->count >= self->tx_threshold)
+            CordDpdkFlowPoint_tx_flush(self, queue_id);
+    }
+
+    CordDpdkFlowPoint_tx_flush_expired(self, queue_id);
+
+    *tx_packets = len;
     return CORD_OK;
 }
 
@@ -60,12 +127,20 @@ static cord_retval_t CordDpdkFlowPoint_attach_xBPF_(CordDpdkFlowPoint * const se
     return CORD_OK;
 }
 
+// 0x6d5a repeated: Toeplitz hash of (src, dst) equals that of (dst, src)
+static void cord_dpdk_symmetric_rss_key(uint8_t *key, uint8_t key_len)
+{
+    for (uint8_t i = 0; i < key_len; i++)
+        key[i] = (i & 1) ? 0x5a : 0x6d;
+}
+
 void CordDpdkFlowPoint_ctor(CordDpdkFlowPoint * const self,
     uint8_t id,
     uint16_t port_id,
     uint16_t queue_count,
     uint16_t queue_size,
-    struct rte_mempool **mbuf_pool)
+    struct rte_mempool **mbuf_pool,
+    const cord_dpdk_port_conf_t *port_cfg)
 {
 #ifdef CORD_FLOW_POINT_LOG
     CORD_LOG("[CordDpdkFlowPoint] ctor()\n");
@@ -85,9 +160,19 @@ void CordDpdkFlowPoint_ctor(CordDpdkFlowPoint * const self,
     self->queue_size = queue_size;
     self->mbuf_pool = mbuf_pool;
 
+    // NULL configuration: plain port, promiscuous, symmetric RSS across multiple queues
+    cord_dpdk_port_conf_t default_cfg = {
+        .rss_hf = (queue_count > 1) ? CORD_DPDK_RSS_HF_DEFAULT : 0,
+        .rss_symmetric = true,
+        .promiscuous = true,
+    };
+    const cord_dpdk_port_conf_t *cfg = port_cfg ? port_cfg : &default_cfg;
+
     struct rte_eth_conf port_conf;
 	struct rte_eth_dev_info dev_info;
+	struct rte_eth_rxconf rxconf;
 	struct rte_eth_txconf txconf;
+    uint8_t rss_key[CORD_DPDK_RSS_KEY_MAX_LEN];
     int retval;
 
 	if (!rte_eth_dev_is_valid_port(self->port_id))
@@ -99,8 +184,73 @@ void CordDpdkFlowPoint_ctor(CordDpdkFlowPoint * const self,
 	if (retval != 0)
 		CORD_ERROR("[CordDpdkFlowPoint] ctor(): rte_eth_dev_info_get()");
 
+    // RSS
+    uint64_t rss_hf = cfg->rss_hf & dev_info.flow_type_rss_offloads;
+    if (rss_hf != cfg->rss_hf)
+        CORD_LOG("[CordDpdkFlowPoint] ctor(): Port %u RSS hash fields 0x%" PRIx64 " not supported\n",
+                 self->port_id, cfg->rss_hf & ~rss_hf);
+
+    if (rss_hf && self->queue_count > 1)
+    {
+        port_conf.rxmode.mq_mode = RTE_ETH_MQ_RX_RSS;
+        port_conf.rx_adv_conf.rss_conf.rss_hf = rss_hf;
+
+        uint8_t key_len = dev_info.hash_key_size;
+        if (cfg->rss_key && cfg->rss_key_len == key_len)
+        {
+            port_conf.rx_adv_conf.rss_conf.rss_key = (uint8_t *)cfg->rss_key;
+            port_conf.rx_adv_conf.rss_conf.rss_key_len = key_len;
+        }
+        else if (cfg->rss_key)
+        {
+            CORD_LOG("[CordDpdkFlowPoint] ctor(): Port %u expects a %u byte RSS key, using the default one\n",
+                     self->port_id, key_len);
+        }
+        else if (cfg->rss_symmetric && key_len > 0 && key_len <= CORD_DPDK_RSS_KEY_MAX_LEN)
+        {
+            cord_dpdk_symmetric_rss_key(rss_key, key_len);
+            port_conf.rx_adv_conf.rss_conf.rss_key = rss_key;
+            port_conf.rx_adv_conf.rss_conf.rss_key_len = key_len;
+        }
+    }
+    else
+    {
+        rss_hf = 0;
+    }
+
+    // Offloads
+    uint64_t rx_offloads = cfg->rx_offloads & dev_info.rx_offload_capa;
+    uint64_t tx_offloads = cfg->tx_offloads & dev_info.tx_offload_capa;
+
+    if (rx_offloads != cfg->rx_offloads)
+        CORD_LOG("[CordDpdkFlowPoint] ctor(): Port %u RX offloads 0x%" PRIx64 " not supported\n",
+                 self->port_id, cfg->rx_offloads & ~rx_offloads);
+
+    if (tx_offloads != cfg->tx_offloads)
+        CORD_LOG("[CordDpdkFlowPoint] ctor(): Port %u TX offloads 0x%" PRIx64 " not supported\n",
+                 self->port_id, cfg->tx_offloads & ~tx_offloads);
+
 	if (dev_info.tx_offload_capa & RTE_ETH_TX_OFFLOAD_MBUF_FAST_FREE)
-		port_conf.txmode.offloads |= RTE_ETH_TX_OFFLOAD_MBUF_FAST_FREE;
+		tx_offloads |= RTE_ETH_TX_OFFLOAD_MBUF_FAST_FREE;
+
+    port_conf.rxmode.offloads = rx_offloads;
+    port_conf.txmode.offloads = tx_offloads;
+
+    self->rss_hf = rss_hf;
+    self->rx_offloads = rx_offloads;
+    self->tx_offloads = tx_offloads;
+
+    // Unbuffered TX with retries until set_tx_buffer() is called
+    self->tx_threshold = 0;
+    self->tx_max_retries = CORD_DPDK_TX_MAX_RETRIES;
+    self->tx_timeout_tsc = rte_get_tsc_hz() / 1000000 * CORD_DPDK_TX_TIMEOUT_US;
+    self->tx_queues = rte_zmalloc_socket("cord_dpdk_tx_queues", self->queue_count * sizeof(cord_dpdk_tx_queue_t),
+                                         RTE_CACHE_LINE_SIZE, rte_eth_dev_socket_id(self->port_id));
+    if (!self->tx_queues)
+    {
+        CORD_LOG("[CordDpdkFlowPoint] ctor(): rte_zmalloc_socket() failed for the TX queues\n");
+        CORD_EXIT(EXIT_FAILURE);
+    }
 
 	retval = rte_eth_dev_configure(self->port_id, self->queue_count, self->queue_count, &port_conf);
 	if (retval != 0)
@@ -110,12 +260,15 @@ void CordDpdkFlowPoint_ctor(CordDpdkFlowPoint * const self,
 	if (retval != 0)
         CORD_ERROR("[CordDpdkFlowPoint] ctor(): rte_eth_dev_adjust_nb_rx_tx_desc()");
 
+    rxconf = dev_info.default_rxconf;
+    rxconf.offloads = port_conf.rxmode.offloads;
+
     txconf = dev_info.default_txconf;
 	txconf.offloads = port_conf.txmode.offloads;
 
 	for (uint16_t q = 0; q < self->queue_count; q++) {
 		// RX queues setup
-        retval = rte_eth_rx_queue_setup(self->port_id, q, self->queue_size, rte_eth_dev_socket_id(self->port_id), NULL, *(self->mbuf_pool));
+        retval = rte_eth_rx_queue_setup(self->port_id, q, self->queue_size, rte_eth_dev_socket_id(self->port_id), &rxconf, *(self->mbuf_pool));
 		if (retval < 0)
             CORD_ERROR("[CordDpdkFlowPoint] ctor(): rte_eth_rx_queue_setup()");
         
@@ -138,9 +291,255 @@ void CordDpdkFlowPoint_ctor(CordDpdkFlowPoint * const self,
 			   " %02" PRIx8 " %02" PRIx8 " %02" PRIx8 "\n",
 			self->port_id, RTE_ETHER_ADDR_BYTES(&addr));
 
-	retval = rte_eth_promiscuous_enable(self->port_id);
-	if (retval != 0)
-        CORD_ERROR("[CordDpdkFlowPoint] ctor(): rte_eth_promiscuous_enable()");
+    if (cfg->promiscuous)
+    {
+        retval = rte_eth_promiscuous_enable(self->port_id);
+        if (retval != 0)
+            CORD_ERROR("[CordDpdkFlowPoint] ctor(): rte_eth_promiscuous_enable()");
+    }
+}
+
+//
+// Flow steering (rte_flow)
+//
+
+static void cord_dpdk_prefix_mask(uint8_t *mask, uint8_t len_bytes, uint8_t prefix)
+{
+    for (uint8_t i = 0; i < len_bytes; i++)
+    {
+        if (prefix >= 8)
+        {
+            mask[i] = 0xFF;
+            prefix -= 8;
+        }
+        else
+        {
+            mask[i] = (uint8_t)(0xFF << (8 - prefix));
+            prefix = 0;
+        }
+    }
+}
+
+struct rte_flow *CordDpdkFlowPoint_flow_to_queue(CordDpdkFlowPoint * const self,
+                                                 const cord_dpdk_flow_match_t *match,
+                                                 uint16_t queue_id)
+{
+    if (!match || queue_id >= self->queue_count || (match->ip_version != 4 && match->ip_version != 6))
+        return NULL;
+
+    struct rte_flow_attr attr = { .ingress = 1 };
+    struct rte_flow_item pattern[4];
+    struct rte_flow_action action[2];
+    struct rte_flow_action_queue queue = { .index = queue_id };
+    struct rte_flow_item_ipv4 ip4_spec, ip4_mask;
+    struct rte_flow_item_ipv6 ip6_spec, ip6_mask;
+    struct rte_flow_item_udp udp_spec, udp_mask;
+    struct rte_flow_item_tcp tcp_spec, tcp_mask;
+    struct rte_flow_error error;
+    uint8_t n = 0;
+
+    memset(pattern, 0, sizeof(pattern));
+    memset(action, 0, sizeof(action));
+
+    pattern[n++].type = RTE_FLOW_ITEM_TYPE_ETH;
+
+    // L3
+    if (match->ip_version == 4)
+    {
+        memset(&ip4_spec, 0, sizeof(ip4_spec));
+        memset(&ip4_mask, 0, sizeof(ip4_mask));
+
+        cord_dpdk_prefix_mask((uint8_t *)&ip4_mask.hdr.src_addr, 4, match->src_prefix > 32 ? 32 : match->src_prefix);
+        cord_dpdk_prefix_mask((uint8_t *)&ip4_mask.hdr.dst_addr, 4, match->dst_prefix > 32 ? 32 : match->dst_prefix);
+        memcpy(&ip4_spec.hdr.src_addr, match->src_ip, 4);
+        memcpy(&ip4_spec.hdr.dst_addr, match->dst_ip, 4);
+        ip4_spec.hdr.src_addr &= ip4_mask.hdr.src_addr;
+        ip4_spec.hdr.dst_addr &= ip4_mask.hdr.dst_addr;
+
+        if (match->ip_proto)
+        {
+            ip4_spec.hdr.next_proto_id = match->ip_proto;
+            ip4_mask.hdr.next_proto_id = 0xFF;
+        }
+
+        pattern[n].type = RTE_FLOW_ITEM_TYPE_IPV4;
+        pattern[n].spec = &ip4_spec;
+        pattern[n++].mask = &ip4_mask;
+    }
+    else
+    {
+        memset(&ip6_spec, 0, sizeof(ip6_spec));
+        memset(&ip6_mask, 0, sizeof(ip6_mask));
+
+        cord_dpdk_prefix_mask((uint8_t *)&ip6_mask.hdr.src_addr, 16, match->src_prefix > 128 ? 128 : match->src_prefix);
+        cord_dpdk_prefix_mask((uint8_t *)&ip6_mask.hdr.dst_addr, 16, match->dst_prefix > 128 ? 128 : match->dst_prefix);
+
+        uint8_t *src = (uint8_t *)&ip6_spec.hdr.src_addr;
+        uint8_t *dst = (uint8_t *)&ip6_spec.hdr.dst_addr;
+        const uint8_t *src_mask = (const uint8_t *)&ip6_mask.hdr.src_addr;
+        const uint8_t *dst_mask = (const uint8_t *)&ip6_mask.hdr.dst_addr;
+        for (uint8_t i = 0; i < 16; i++)
+        {
+            src[i] = match->src_ip[i] & src_mask[i];
+            dst[i] = match->dst_ip[i] & dst_mask[i];
+        }
+
+        if (match->ip_proto)
+        {
+            ip6_spec.hdr.proto = match->ip_proto;
+            ip6_mask.hdr.proto = 0xFF;
+        }
+
+        pattern[n].type = RTE_FLOW_ITEM_TYPE_IPV6;
+        pattern[n].spec = &ip6_spec;
+        pattern[n++].mask = &ip6_mask;
+    }
+
+    // L4
+    if (match->ip_proto == IPPROTO_UDP)
+    {
+        memset(&udp_spec, 0, sizeof(udp_spec));
+        memset(&udp_mask, 0, sizeof(udp_mask));
+        udp_spec.hdr.src_port = rte_cpu_to_be_16(match->src_port);
+        udp_spec.hdr.dst_port = rte_cpu_to_be_16(match->dst_port);
+        udp_mask.hdr.src_port = match->src_port ? 0xFFFF : 0;
+        udp_mask.hdr.dst_port = match->dst_port ? 0xFFFF : 0;
+
+        pattern[n].type = RTE_FLOW_ITEM_TYPE_UDP;
+        pattern[n].spec = &udp_spec;
+        pattern[n++].mask = &udp_mask;
+    }
+    else if (match->ip_proto == IPPROTO_TCP)
+    {
+        memset(&tcp_spec, 0, sizeof(tcp_spec));
+        memset(&tcp_mask, 0, sizeof(tcp_mask));
+        tcp_spec.hdr.src_port = rte_cpu_to_be_16(match->src_port);
+        tcp_spec.hdr.dst_port = rte_cpu_to_be_16(match->dst_port);
+        tcp_mask.hdr.src_port = match->src_port ? 0xFFFF : 0;
+        tcp_mask.hdr.dst_port = match->dst_port ? 0xFFFF : 0;
+
+        pattern[n].type = RTE_FLOW_ITEM_TYPE_TCP;
+        pattern[n].spec = &tcp_spec;
+        pattern[n++].mask = &tcp_mask;
+    }
+
+    pattern[n].type = RTE_FLOW_ITEM_TYPE_END;
+
+    action[0].type = RTE_FLOW_ACTION_TYPE_QUEUE;
+    action[0].conf = &queue;
+    action[1].type = RTE_FLOW_ACTION_TYPE_END;
+
+    if (rte_flow_validate(self->port_id, &attr, pattern, action, &error) != 0)
+    {
+        CORD_LOG("[CordDpdkFlowPoint] flow_to_queue(): Port %u rejected the rule: %s\n",
+                 self->port_id, error.message ? error.message : "(no message)");
+        return NULL;
+    }
+
+    struct rte_flow *flow = rte_flow_create(self->port_id, &attr, pattern, action, &error);
+    if (!flow)
+    {
+        CORD_LOG("[CordDpdkFlowPoint] flow_to_queue(): rte_flow_create() failed: %s\n",
+                 error.message ? error.message : "(no message)");
+    }
+
+    return flow;
+}
+
+cord_retval_t CordDpdkFlowPoint_flow_destroy(CordDpdkFlowPoint * const self, struct rte_flow *flow)
+{
+    struct rte_flow_error error;
+
+    if (!flow)
+        return CORD_ERR_INVALID_PARAM;
+
+    if (rte_flow_destroy(self->port_id, flow, &error) != 0)
+    {
+        CORD_LOG("[CordDpdkFlowPoint] flow_destroy(): %s\n", error.message ? error.message : "(no message)");
+        return CORD_ERR;
+    }
+
+    return CORD_OK;
+}
+
+//
+// TX buffering
+//
+
+cord_retval_t CordDpdkFlowPoint_set_tx_buffer(CordDpdkFlowPoint * const self, uint16_t threshold, uint32_t timeout_us, uint16_t max_retries)
+{
+    if (threshold > CORD_DPDK_TX_BUFFER_MAX)
+        return CORD_ERR_INVALID_PARAM;
+
+    // Send whatever the previous setting left behind
+    for (uint16_t q = 0; q < self->queue_count; q++)
+        CordDpdkFlowPoint_tx_flush(self, q);
+
+    self->tx_threshold = threshold;
+    self->tx_max_retries = (max_retries == 0) ? CORD_DPDK_TX_MAX_RETRIES : max_retries;
+    self->tx_timeout_tsc = rte_get_tsc_hz() / 1000000 * ((timeout_us == 0) ? CORD_DPDK_TX_TIMEOUT_US : timeout_us);
+
+    return CORD_OK;
+}
+
+uint16_t CordDpdkFlowPoint_tx_flush(CordDpdkFlowPoint * const self, uint16_t queue_id)
+{
+    if (queue_id >= self->queue_count)
+        return 0;
+
+    cord_dpdk_tx_queue_t *txq = &self->tx_queues[queue_id];
+    if (txq->count == 0)
+        return 0;
+
+    uint16_t sent = cord_dpdk_tx_burst_retry(self, queue_id, txq->pkts, txq->count);
+    txq->count = 0;
+    txq->tx_flushes++;
+
+    return sent;
+}
+
+uint16_t CordDpdkFlowPoint_tx_flush_expired(CordDpdkFlowPoint * const self, uint16_t queue_id)
+{
+    if (queue_id >= self->queue_count)
+        return 0;
+
+    cord_dpdk_tx_queue_t *txq = &self->tx_queues[queue_id];
+    if (txq->count == 0 || rte_rdtsc() < txq->deadline_tsc)
+        return 0;
+
+    return CordDpdkFlowPoint_tx_flush(self, queue_id);
+}
+
+//
+// Statistics
+//
+
+cord_retval_t CordDpdkFlowPoint_update_hw_stats(CordDpdkFlowPoint * const self)
+{
+    if (rte_eth_stats_get(self->port_id, &self->stats) != 0)
+    {
+        CORD_ERROR("[CordDpdkFlowPoint] rte_eth_stats_get()");
+        return CORD_ERR;
+    }
+
+    return CORD_OK;
+}
+
+void CordDpdkFlowPoint_print_hw_stats(CordDpdkFlowPoint * const self)
+{
+    if (CordDpdkFlowPoint_update_hw_stats(self) != CORD_OK)
+        return;
+
+    CORD_LOG("=== Port %u HW Statistics ===\n", self->port_id);
+    CORD_LOG("RX packets:       %lu\n", self->stats.ipackets);
+    CORD_LOG("RX bytes:         %lu\n", self->stats.ibytes);
+    CORD_LOG("TX packets:       %lu\n", self->stats.opackets);
+    CORD_LOG("TX bytes:         %lu\n", self->stats.obytes);
+    CORD_LOG("RX missed:        %lu\n", self->stats.imissed);
+    CORD_LOG("RX errors:        %lu\n", self->stats.ierrors);
+    CORD_LOG("TX errors:        %lu\n", self->stats.oerrors);
+    CORD_LOG("RX no mbuf:       %lu\n", self->stats.rx_nombuf);
+    CORD_LOG("=============================\n");
 }
 
 void CordDpdkFlowPoint_dtor(CordDpdkFlowPoint * const self)
@@ -150,6 +549,16 @@ void CordDpdkFlowPoint_dtor(CordDpdkFlowPoint * const self)
 #endif
 
     int retval;
+    struct rte_flow_error error;
+
+    // Send what is still buffered while the port is up
+    for (uint16_t q = 0; q < self->queue_count; q++)
+        CordDpdkFlowPoint_tx_flush(self, q);
+
+    rte_free(self->tx_queues);
+
+    // Remove the steering rules before the port goes down
+    rte_flow_flush(self->port_id, &error);
 
     // Disable promiscuous mode of the ethernet device
     retval = rte_eth_promiscuous_disable(self->port_id);
@@ -170,6 +579,7 @@ void CordDpdkFlowPoint_dtor(CordDpdkFlowPoint * const self)
     CORD_LOG("[CordDpdkFlowPoint] dtor(): DPDK Packet Mbuf and Mempool cleanup.\n");
     cord_pktmbuf_mpool_free(self->mbuf_pool);
 
+    CordFlowPoint_release(&self->base);
     free(self);
 }
 
@@ -4,6 +4,7 @@
 
 #include <flow_point/cord_flow_point.h>
 #include <cord_retval.h>
+#include <cord_error.h>
 
 static cord_retval_t CordFlowPoint_rx_(CordFlowPoint * const self, uint16_t queue_id, void *buffer, size_t len, ssize_t *rxed)
 {
@@ -55,6 +56,15 @@ void CordFlowPoint_ctor(CordFlowPoint * const self, uint8_t id)
 
     self->vptr = &vtbl;
     self->id = id;
+
+    self->queue_stats = aligned_alloc(CORD_CACHE_LINE_SIZE, CORD_FLOW_POINT_STATS_BLOCKS * sizeof(CordFlowPointQueueStats));
+    if (!self->queue_stats)
+    {
+        CORD_ERROR("[CordFlowPoint] aligned_alloc()");
+        CORD_EXIT(EXIT_FAILURE);
+    }
+    memset(self->queue_stats, 0, CORD_FLOW_POINT_STATS_BLOCKS * sizeof(CordFlowPointQueueStats));
+    self->queue_stats_shared = false;
 }
 
 void CordFlowPoint_dtor(CordFlowPoint * const self)
@@ -69,6 +79,109 @@ void CordFlowPoint_dtor(CordFlowPoint * const self)
     } else
     {
         // Fallback if no cleanup defined
+        CordFlowPoint_release(self);
         free(self);
     }
 }
+
+void CordFlowPoint_release(CordFlowPoint * const self)
+{
+    if (!self->queue_stats_shared)
+        free(self->queue_stats);
+
+    self->queue_stats = NULL;
+}
+
+void CordFlowPoint_share_stats(CordFlowPoint * const self, CordFlowPoint * const parent)
+{
+    if (!self->queue_stats_shared)
+        free(self->queue_stats);
+
+    self->queue_stats = parent->queue_stats;
+    self->queue_stats_shared = true;
+}
+
+//
+// Statistics snapshot
+//
+
+void CordFlowPoint_get_queue_stats_total(const CordFlowPoint * const self, CordFlowPointQueueStats *total)
+{
+    memset(total, 0, sizeof(CordFlowPointQueueStats));
+
+    for (uint32_t q = 0; q < CORD_FLOW_POINT_STATS_BLOCKS; q++)
+    {
+        // Written by the queue's core without atomics: read each counter once
+        const volatile CordFlowPointQueueStats *qs = &self->queue_stats[q];
+
+        total->rx_packets += qs->rx_packets;
+        total->rx_bytes += qs->rx_bytes;
+        total->tx_packets += qs->tx_packets;
+        total->tx_bytes += qs->tx_bytes;
+        total->rx_dropped += qs->rx_dropped;
+        total->tx_dropped += qs->tx_dropped;
+        total->rx_errors += qs->rx_errors;
+        total->tx_errors += qs->tx_errors;
+        total->ring_full += qs->ring_full;
+
+        for (uint32_t b = 0; b < CORD_FLOW_POINT_BATCH_BUCKETS; b++)
+        {
+            total->rx_batch_hist[b] += qs->rx_batch_hist[b];
+            total->tx_batch_hist[b] += qs->tx_batch_hist[b];
+        }
+    }
+}
+
+void CordFlowPoint_get_stats(const CordFlowPoint * const self, CordFlowPointStats *stats)
+{
+    CordFlowPointQueueStats total;
+    CordFlowPoint_get_queue_stats_total(self, &total);
+
+    memset(stats, 0, sizeof(CordFlowPointStats));
+    stats->nb_rx_packets = (uint32_t)total.rx_packets;
+    stats->nb_tx_packets = (uint32_t)total.tx_packets;
+    stats->nb_rxed = total.rx_bytes;
+    stats->nb_txed = total.tx_bytes;
+    stats->nb_lost_packets = (uint32_t)(total.rx_errors + total.tx_errors);
+    stats->nb_dropped_packets = (uint32_t)(total.rx_dropped + total.tx_dropped);
+}
+
+void CordFlowPoint_print_stats(const CordFlowPoint * const self)
+{
+    static const char *bucket_names[CORD_FLOW_POINT_BATCH_BUCKETS] = {
+        "0", "1", "2-3", "4-7", "8-15", "16-31", "32-63", "64+"
+    };
+
+    CordFlowPointQueueStats total;
+    CordFlowPoint_get_queue_stats_total(self, &total);
+
+    CORD_LOG("=== FlowPoint %u Statistics ===\n", self->id);
+    CORD_LOG("RX packets:       %lu\n", total.rx_packets);
+    CORD_LOG("RX bytes:         %lu\n", total.rx_bytes);
+    CORD_LOG("TX packets:       %lu\n", total.tx_packets);
+    CORD_LOG("TX bytes:         %lu\n", total.tx_bytes);
+    CORD_LOG("RX dropped:       %lu\n", total.rx_dropped);
+    CORD_LOG("TX dropped:       %lu\n", total.tx_dropped);
+    CORD_LOG("RX errors:        %lu\n", total.rx_errors);
+    CORD_LOG("TX errors:        %lu\n", total.tx_errors);
+    CORD_LOG("Ring full:        %lu\n", total.ring_full);
+
+    CORD_LOG("Batch sizes:      RX / TX calls\n");
+    for (uint32_t b = 0; b < CORD_FLOW_POINT_BATCH_BUCKETS; b++)
+    {
+        CORD_LOG("  %-6s          %lu / %lu\n", bucket_names[b], total.rx_batch_hist[b], total.tx_batch_hist[b]);
+    }
+
+    for (uint32_t q = 0; q < CORD_FLOW_POINT_STATS_BLOCKS; q++)
+    {
+        const CordFlowPointQueueStats *qs = &self->queue_stats[q];
+        if (qs->rx_packets || qs->tx_packets || qs->rx_dropped || qs->tx_dropped || qs->rx_errors || qs->tx_errors)
+        {
+            CORD_LOG("  Queue %2u%s       RX %lu  TX %lu  drop %lu/%lu  err %lu/%lu\n", q,
+                     (q == CORD_FLOW_POINT_MAX_QUEUES) ? "+:" : ": ",
+                     qs->rx_packets, qs->tx_packets, qs->rx_dropped, qs->tx_dropped, qs->rx_errors, qs->tx_errors);
+        }
+    }
+
+    CORD_LOG("===============================\n");
+}
@@ -60,5 +60,6 @@ void CordL2CustomFlowPoint_dtor(CordL2CustomFlowPoint * const self)
 #ifdef CORD_FLOW_POINT_LOG
     CORD_LOG("[CordL2CustomFlowPoint] dtor()\n");
 #endif
+    CordFlowPoint_release(&self->base);
     free(self);
 }
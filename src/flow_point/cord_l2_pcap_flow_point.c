@@ -0,0 +1,597 @@
+#include <flow_point/cord_l2_pcap_flow_point.h>
+#include <cord_error.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#define CORD_PCAP_MAGIC_US              0xA1B2C3D4
+#define CORD_PCAP_MAGIC_NS              0xA1B23C4D
+#define CORD_PCAP_HDR_LEN               24
+#define CORD_PCAP_REC_HDR_LEN           16
+#define CORD_PCAP_LINKTYPE_ETHERNET     1
+
+#define CORD_PCAPNG_SHB                 0x0A0D0D0A
+#define CORD_PCAPNG_IDB                 0x00000001
+#define CORD_PCAPNG_SPB                 0x00000003
+#define CORD_PCAPNG_EPB                 0x00000006
+#define CORD_PCAPNG_BYTE_ORDER_MAGIC    0x1A2B3C4D
+#define CORD_PCAPNG_OPT_END             0
+#define CORD_PCAPNG_OPT_IF_TSRESOL      9
+#define CORD_PCAPNG_EPB_HDR_LEN         28          // Block header + EPB fields in front of the data
+#define CORD_PCAPNG_SPB_HDR_LEN         12
+
+static inline uint64_t cord_pcap_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static inline uint32_t cord_pcap_rd32(const uint8_t *p, bool swap)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return swap ? __builtin_bswap32(v) : v;
+}
+
+static inline uint16_t cord_pcap_rd16(const uint8_t *p, bool swap)
+{
+    uint16_t v;
+    memcpy(&v, p, sizeof(v));
+    return swap ? __builtin_bswap16(v) : v;
+}
+
+//
+// Packet index
+//
+
+static void cord_pcap_index_add(CordL2PcapFlowPoint * const self, uint64_t *capacity,
+                                uint64_t ts_ns, uint64_t offset, uint32_t len, uint32_t headroom)
+{
+    if (len > CORD_PCAP_SNAPLEN)
+    {
+        self->skipped_pkts++;
+        return;
+    }
+
+    if (self->num_pkts == *capacity)
+    {
+        uint64_t new_capacity = *capacity ? *capacity * 2 : 1024;
+        cord_pcap_pkt_index_t *pkts = realloc(self->pkts, new_capacity * sizeof(cord_pcap_pkt_index_t));
+        if (!pkts)
+        {
+            CORD_ERROR("[CordL2PcapFlowPoint] realloc()");
+            CORD_EXIT(EXIT_FAILURE);
+        }
+        self->pkts = pkts;
+        *capacity = new_capacity;
+    }
+
+    cord_pcap_pkt_index_t *pkt = &self->pkts[self->num_pkts++];
+    memset(&pkt->desc, 0, sizeof(pkt->desc));
+    pkt->ts_ns = ts_ns;
+    pkt->offset = offset;
+    pkt->len = len;
+    pkt->headroom = headroom;
+}
+
+// Time stamp in units per second (pcapng if_tsresol) to nanoseconds
+static inline uint64_t cord_pcap_ts_ns(uint64_t ts, uint64_t units)
+{
+    uint64_t sec = ts / units;
+    uint64_t frac = ts % units;
+
+    if (units <= 1000000000ULL && 1000000000ULL % units == 0)
+        return sec * 1000000000ULL + frac * (1000000000ULL / units);
+
+    return sec * 1000000000ULL + (uint64_t)((double)frac * 1e9 / (double)units);
+}
+
+static int cord_pcap_index_pcap(CordL2PcapFlowPoint * const self, bool swap, bool nsec)
+{
+    const uint8_t *map = self->map;
+    uint64_t capacity = 0;
+
+    if (self->map_size < CORD_PCAP_HDR_LEN)
+        return -1;
+
+    // The upper bits of the link type field carry the FCS length
+    uint32_t linktype = cord_pcap_rd32(map + 20, swap) & 0x0FFFFFFF;
+    if (linktype != CORD_PCAP_LINKTYPE_ETHERNET)
+    {
+        CORD_LOG("[CordL2PcapFlowPoint] %s: link type %u, only Ethernet is supported\n", self->rx_path, linktype);
+        return -1;
+    }
+
+    uint64_t off = CORD_PCAP_HDR_LEN;
+    while (off + CORD_PCAP_REC_HDR_LEN <= self->map_size)
+    {
+        uint32_t ts_sec = cord_pcap_rd32(map + off, swap);
+        uint32_t ts_frac = cord_pcap_rd32(map + off + 4, swap);
+        uint32_t incl_len = cord_pcap_rd32(map + off + 8, swap);
+
+        // A truncated last record (capture still being written) ends the replay
+        if (off + CORD_PCAP_REC_HDR_LEN + incl_len > self->map_size)
+            break;
+
+        uint64_t ts_ns = (uint64_t)ts_sec * 1000000000ULL + (nsec ? ts_frac : (uint64_t)ts_frac * 1000ULL);
+        cord_pcap_index_add(self, &capacity, ts_ns, off + CORD_PCAP_REC_HDR_LEN, incl_len, CORD_PCAP_REC_HDR_LEN);
+
+        off += CORD_PCAP_REC_HDR_LEN + incl_len;
+    }
+
+    return 0;
+}
+
+static int cord_pcap_index_pcapng(CordL2PcapFlowPoint * const self)
+{
+    const uint8_t *map = self->map;
+    uint64_t capacity = 0;
+    bool swap = false;
+    bool in_section = false;
+
+    // Interfaces of the current section
+    uint32_t num_ifaces = 0;
+    uint16_t if_linktype[CORD_PCAP_MAX_IFACES];
+    uint32_t if_snaplen[CORD_PCAP_MAX_IFACES];
+    uint64_t if_units[CORD_PCAP_MAX_IFACES];
+    uint64_t last_ts_ns = 0;
+
+    uint64_t off = 0;
+    while (off + 12 <= self->map_size)
+    {
+        // The SHB type reads the same in both byte orders; its byte order magic sets the section's
+        uint32_t type = cord_pcap_rd32(map + off, swap);
+        if (type == CORD_PCAPNG_SHB)
+        {
+            uint32_t bom = cord_pcap_rd32(map + off + 8, false);
+            if (bom == CORD_PCAPNG_BYTE_ORDER_MAGIC)
+                swap = false;
+            else if (bom == __builtin_bswap32(CORD_PCAPNG_BYTE_ORDER_MAGIC))
+                swap = true;
+            else
+                return -1;
+
+            in_section = true;
+            num_ifaces = 0;
+        }
+        else if (!in_section)
+        {
+            return -1;
+        }
+
+        uint32_t block_len = cord_pcap_rd32(map + off + 4, swap);
+        if (block_len < 12 || (block_len & 3) || off + block_len > self->map_size)
+            break;
+
+        const uint8_t *body = map + off + 8;
+        uint32_t body_len = block_len - 12;
+
+        switch (type)
+        {
+            case CORD_PCAPNG_IDB:
+            {
+                if (body_len < 8)
+                    break;
+
+                uint32_t iface = num_ifaces++;
+                if (iface >= CORD_PCAP_MAX_IFACES)
+                    break;
+
+                if_linktype[iface] = cord_pcap_rd16(body, swap);
+                if_snaplen[iface] = cord_pcap_rd32(body + 4, swap);
+                if_units[iface] = 1000000ULL;
+
+                // Options: code, length, value padded to 32 bits
+                uint32_t opt = 8;
+                while (opt + 4 <= body_len)
+                {
+                    uint16_t code = cord_pcap_rd16(body + opt, swap);
+                    uint16_t len = cord_pcap_rd16(body + opt + 2, swap);
+                    if (code == CORD_PCAPNG_OPT_END || opt + 4 + len > body_len)
+                        break;
+
+                    if (code == CORD_PCAPNG_OPT_IF_TSRESOL && len >= 1)
+                    {
+                        uint8_t tsresol = body[opt + 4];
+                        uint64_t units = 1;
+                        if (tsresol & 0x80)
+                        {
+                            units = 1ULL << ((tsresol & 0x7F) < 63 ? (tsresol & 0x7F) : 63);
+                        }
+                        else
+                        {
+                            for (uint8_t i = 0; i < tsresol && i < 19; i++)
+                                units *= 10;
+                        }
+                        if_units[iface] = units;
+                    }
+
+                    opt += 4 + ((len + 3u) & ~3u);
+                }
+                break;
+            }
+
+            case CORD_PCAPNG_EPB:
+            {
+                if (body_len < 20)
+                    break;
+
+                uint32_t iface = cord_pcap_rd32(body, swap);
+                uint64_t ts = ((uint64_t)cord_pcap_rd32(body + 4, swap) << 32) | cord_pcap_rd32(body + 8, swap);
+                uint32_t cap_len = cord_pcap_rd32(body + 12, swap);
+
+                if (cap_len > body_len - 20 || iface >= num_ifaces || iface >= CORD_PCAP_MAX_IFACES ||
+                    if_linktype[iface] != CORD_PCAP_LINKTYPE_ETHERNET)
+                {
+                    self->skipped_pkts++;
+                    break;
+                }
+
+                last_ts_ns = cord_pcap_ts_ns(ts, if_units[iface]);
+                cord_pcap_index_add(self, &capacity, last_ts_ns, off + CORD_PCAPNG_EPB_HDR_LEN, cap_len, CORD_PCAPNG_EPB_HDR_LEN);
+                break;
+            }
+
+            case CORD_PCAPNG_SPB:
+            {
+                // Interface 0, no time stamp: replayed right after the previous packet
+                if (body_len < 4 || num_ifaces == 0 || if_linktype[0] != CORD_PCAP_LINKTYPE_ETHERNET)
+                {
+                    self->skipped_pkts++;
+                    break;
+                }
+
+                uint32_t cap_len = cord_pcap_rd32(body, swap);
+                if (cap_len > body_len - 4)
+                    cap_len = body_len - 4;
+                if (if_snaplen[0] && cap_len > if_snaplen[0])
+                    cap_len = if_snaplen[0];
+
+                cord_pcap_index_add(self, &capacity, last_ts_ns, off + CORD_PCAPNG_SPB_HDR_LEN, cap_len, CORD_PCAPNG_SPB_HDR_LEN);
+                break;
+            }
+
+            default:
+                break;
+        }
+
+        off += block_len;
+    }
+
+    return 0;
+}
+
+static void cord_pcap_open_rx(CordL2PcapFlowPoint * const self)
+{
+    self->base.io_handle = open(self->rx_path, O_RDONLY | O_CLOEXEC);
+    if (self->base.io_handle < 0)
+    {
+        CORD_ERROR("[CordL2PcapFlowPoint] open()");
+        CORD_EXIT(EXIT_FAILURE);
+    }
+
+    struct stat st;
+    if (fstat(self->base.io_handle, &st) < 0)
+    {
+        CORD_ERROR("[CordL2PcapFlowPoint] fstat()");
+        CORD_CLOSE(self->base.io_handle);
+        CORD_EXIT(EXIT_FAILURE);
+    }
+
+    if (st.st_size < 4)
+    {
+        CORD_LOG("[CordL2PcapFlowPoint] %s: empty file\n", self->rx_path);
+        CORD_CLOSE(self->base.io_handle);
+        CORD_EXIT(EXIT_FAILURE);
+    }
+
+    // Private and writable: in-place rewrites copy the page, the file is never modified.
+    // No MAP_POPULATE: on a writable private mapping it write-faults every page into an
+    // anonymous copy; read-ahead into the page cache is enough.
+    self->map_size = (size_t)st.st_size;
+    self->map = mmap(NULL, self->map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, self->base.io_handle, 0);
+    if (self->map == MAP_FAILED)
+    {
+        self->map = NULL;
+        CORD_ERROR("[CordL2PcapFlowPoint] mmap()");
+        CORD_CLOSE(self->base.io_handle);
+        CORD_EXIT(EXIT_FAILURE);
+    }
+
+    madvise(self->map, self->map_size, MADV_WILLNEED);
+
+    int ret;
+    uint32_t magic = cord_pcap_rd32(self->map, false);
+    switch (magic)
+    {
+        case CORD_PCAP_MAGIC_US:                    ret = cord_pcap_index_pcap(self, false, false); break;
+        case CORD_PCAP_MAGIC_NS:                    ret = cord_pcap_index_pcap(self, false, true);  break;
+        case __builtin_bswap32(CORD_PCAP_MAGIC_US): ret = cord_pcap_index_pcap(self, true, false);  break;
+        case __builtin_bswap32(CORD_PCAP_MAGIC_NS): ret = cord_pcap_index_pcap(self, true, true);   break;
+        case CORD_PCAPNG_SHB:                       ret = cord_pcap_index_pcapng(self);             break;
+        default:                                    ret = -1;                                       break;
+    }
+
+    if (ret < 0)
+    {
+        CORD_LOG("[CordL2PcapFlowPoint] %s: not a valid pcap / pcapng file\n", self->rx_path);
+        munmap(self->map, self->map_size);
+        self->map = NULL;
+        free(self->pkts);
+        self->pkts = NULL;
+        CORD_CLOSE(self->base.io_handle);
+        CORD_EXIT(EXIT_FAILURE);
+    }
+
+    if (self->skipped_pkts)
+        CORD_LOG("[CordL2PcapFlowPoint] %s: %lu packets skipped (not Ethernet or over %u bytes)\n",
+                 self->rx_path, self->skipped_pkts, CORD_PCAP_SNAPLEN);
+}
+
+static void cord_pcap_open_tx(CordL2PcapFlowPoint * const self)
+{
+    self->tx_file = fopen(self->tx_path, "wb");
+    if (!self->tx_file)
+    {
+        CORD_ERROR("[CordL2PcapFlowPoint] fopen()");
+        CORD_EXIT(EXIT_FAILURE);
+    }
+
+    setvbuf(self->tx_file, NULL, _IOFBF, CORD_PCAP_TX_BUFFER_SIZE);
+
+    // pcap 2.4 in native byte order, nanosecond time stamps
+    struct
+    {
+        uint32_t magic;
+        uint16_t version_major;
+        uint16_t version_minor;
+        int32_t thiszone;
+        uint32_t sigfigs;
+        uint32_t snaplen;
+        uint32_t linktype;
+    } hdr = { CORD_PCAP_MAGIC_NS, 2, 4, 0, 0, CORD_PCAP_SNAPLEN, CORD_PCAP_LINKTYPE_ETHERNET };
+    _Static_assert(sizeof(hdr) == CORD_PCAP_HDR_LEN, "pcap file header layout");
+
+    if (fwrite(&hdr, sizeof(hdr), 1, self->tx_file) != 1)
+    {
+        CORD_ERROR("[CordL2PcapFlowPoint] fwrite()");
+        CORD_EXIT(EXIT_FAILURE);
+    }
+}
+
+//
+// Replay
+//
+
+// Next loop; false once the last one is done
+static bool cord_pcap_rewind(CordL2PcapFlowPoint * const self)
+{
+    self->loops_done++;
+    if (CordL2PcapFlowPoint_replay_done(self))
+        return false;
+
+    // Drop the pages rewritten in place, the next loop reads the file content again
+    madvise(self->map, self->map_size, MADV_DONTNEED);
+
+    self->next_pkt = 0;
+    if (self->mode == CORD_PCAP_REPLAY_TIMED)
+        self->start_ns = cord_pcap_now_ns();
+
+    return true;
+}
+
+static cord_retval_t CordL2PcapFlowPoint_rx_(CordL2PcapFlowPoint * const self, uint16_t queue_id, void *buffer, size_t len, ssize_t *rx_packets)
+{
+#ifdef CORD_FLOW_POINT_LOG
+    CORD_LOG("[CordL2PcapFlowPoint] rx()\n");
+#endif
+
+    cord_raw_pkt_desc_t **pkt_descs = (cord_raw_pkt_desc_t **)buffer;
+    *rx_packets = 0;
+
+    if (!self->map)
+        return CORD_ERR;
+
+    if (self->num_pkts == 0 || CordL2PcapFlowPoint_replay_done(self))
+    {
+        CordFlowPoint_count_rx(&self->base, queue_id, 0, 0);
+        return CORD_OK;
+    }
+
+    if (self->next_pkt == self->num_pkts && !cord_pcap_rewind(self))
+    {
+        CordFlowPoint_count_rx(&self->base, queue_id, 0, 0);
+        return CORD_OK;
+    }
+
+    uint64_t limit = len;
+    uint64_t elapsed_ns = 0;
+
+    if (self->mode != CORD_PCAP_REPLAY_MAX_SPEED)
+    {
+        elapsed_ns = cord_pcap_now_ns() - self->start_ns;
+
+        if (self->mode == CORD_PCAP_REPLAY_PPS)
+        {
+            uint64_t due = (uint64_t)((double)elapsed_ns * self->rate / 1e9);
+            uint64_t budget = (due > self->paced_pkts) ? due - self->paced_pkts : 0;
+            if (budget < limit)
+                limit = budget;
+        }
+    }
+
+    uint64_t first_ts_ns = self->pkts[0].ts_ns;
+    uint64_t rx_bytes = 0;
+    uint64_t count = 0;
+
+    while (count < limit && self->next_pkt < self->num_pkts)
+    {
+        cord_pcap_pkt_index_t *pkt = &self->pkts[self->next_pkt];
+
+        if (self->mode == CORD_PCAP_REPLAY_TIMED && pkt->ts_ns > first_ts_ns &&
+            (double)(pkt->ts_ns - first_ts_ns) / self->rate > (double)elapsed_ns)
+            break;
+
+        // The previous loop's consumer may have moved data / data_len
+        pkt->desc.buf_addr = self->map + pkt->offset - pkt->headroom;
+        pkt->desc.data = self->map + pkt->offset;
+        pkt->desc.data_len = (uint16_t)pkt->len;
+        pkt_descs[count] = &pkt->desc;
+        rx_bytes += pkt->len;
+
+        count++;
+        self->next_pkt++;
+    }
+
+    self->paced_pkts += count;
+    *rx_packets = (ssize_t)count;
+    CordFlowPoint_count_rx(&self->base, queue_id, count, rx_bytes);
+
+    return CORD_OK;
+}
+
+//
+// Capture
+//
+
+static cord_retval_t CordL2PcapFlowPoint_tx_(CordL2PcapFlowPoint * const self, uint16_t queue_id, void *buffer, size_t len, ssize_t *tx_packets)
+{
+#ifdef CORD_FLOW_POINT_LOG
+    CORD_LOG("[CordL2PcapFlowPoint] tx()\n");
+#endif
+
+    cord_raw_pkt_desc_t * const *pkt_descs = (cord_raw_pkt_desc_t * const *)buffer;
+    *tx_packets = 0;
+
+    if (!self->tx_file)
+    {
+        CordFlowPoint_count_tx_dropped(&self->base, queue_id, len);
+        return CORD_ERR;
+    }
+
+    // One time stamp per burst
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+
+    uint64_t tx_bytes = 0;
+    size_t sent = 0;
+
+    for (; sent < len; sent++)
+    {
+        uint32_t rec[4] = { (uint32_t)ts.tv_sec, (uint32_t)ts.tv_nsec, pkt_descs[sent]->data_len, pkt_descs[sent]->data_len };
+
+        if (fwrite(rec, sizeof(rec), 1, self->tx_file) != 1 ||
+            fwrite(pkt_descs[sent]->data, pkt_descs[sent]->data_len, 1, self->tx_file) != 1)
+        {
+            CORD_ERROR("[CordL2PcapFlowPoint] tx : fwrite()");
+            CordFlowPoint_count_tx_error(&self->base, queue_id);
+            break;
+        }
+
+        tx_bytes += pkt_descs[sent]->data_len;
+    }
+
+    CordFlowPoint_count_tx_dropped(&self->base, queue_id, len - sent);
+    CordFlowPoint_count_tx(&self->base, queue_id, sent, tx_bytes);
+
+    *tx_packets = (ssize_t)sent;
+    return (sent == len) ? CORD_OK : CORD_ERR;
+}
+
+static cord_retval_t CordL2PcapFlowPoint_attach_xBPF_(CordL2PcapFlowPoint * const self, void *filter, void *params)
+{
+#ifdef CORD_FLOW_POINT_LOG
+    CORD_LOG("[CordL2PcapFlowPoint] attach_xBPF()\n");
+#endif
+    (void)self;
+    (void)filter;
+    (void)params;
+
+    return CORD_ERR_UNSUPPORTED;
+}
+
+cord_retval_t CordL2PcapFlowPoint_set_replay(CordL2PcapFlowPoint * const self, cord_pcap_replay_mode_t mode, double rate, uint32_t loops)
+{
+    if (mode > CORD_PCAP_REPLAY_PPS || (mode != CORD_PCAP_REPLAY_MAX_SPEED && !(rate > 0.0)))
+        return CORD_ERR_INVALID_PARAM;
+
+    // A restart replays the file content, not the rewrites of the previous run
+    if (self->map)
+        madvise(self->map, self->map_size, MADV_DONTNEED);
+
+    self->mode = mode;
+    self->rate = rate;
+    self->loops = loops;
+    self->loops_done = 0;
+    self->next_pkt = 0;
+    self->paced_pkts = 0;
+    self->start_ns = cord_pcap_now_ns();
+
+    return CORD_OK;
+}
+
+cord_retval_t CordL2PcapFlowPoint_flush(CordL2PcapFlowPoint * const self)
+{
+    if (!self->tx_file)
+        return CORD_ERR;
+
+    return (fflush(self->tx_file) == 0) ? CORD_OK : CORD_ERR;
+}
+
+void CordL2PcapFlowPoint_ctor(CordL2PcapFlowPoint * const self,
+                              uint8_t id,
+                              const char *rx_path,
+                              const char *tx_path)
+{
+#ifdef CORD_FLOW_POINT_LOG
+    CORD_LOG("[CordL2PcapFlowPoint] ctor()\n");
+#endif
+    static const CordFlowPointVtbl vtbl = {
+        .rx = (cord_retval_t (*)(CordFlowPoint * const self, uint16_t queue_id, void *buffer, size_t len, ssize_t *rx_packets))&CordL2PcapFlowPoint_rx_,
+        .tx = (cord_retval_t (*)(CordFlowPoint * const self, uint16_t queue_id, void *buffer, size_t len, ssize_t *tx_packets))&CordL2PcapFlowPoint_tx_,
+        .attach_xBPF = (cord_retval_t (*)(CordFlowPoint * const self, void *filter, void *params))&CordL2PcapFlowPoint_attach_xBPF_,
+        .cleanup = (void     (*)(CordFlowPoint * const self))&CordL2PcapFlowPoint_dtor,
+    };
+
+    CordFlowPoint_ctor(&self->base, id);
+    self->base.vptr = &vtbl;
+    self->base.io_handle = -1;
+    self->rx_path = rx_path;
+    self->tx_path = tx_path;
+
+    self->map = NULL;
+    self->map_size = 0;
+    self->pkts = NULL;
+    self->num_pkts = 0;
+    self->skipped_pkts = 0;
+    self->tx_file = NULL;
+    self->params = NULL;
+
+    CordL2PcapFlowPoint_set_replay(self, CORD_PCAP_REPLAY_MAX_SPEED, 0.0, 1);
+
+    if (rx_path)
+        cord_pcap_open_rx(self);
+
+    if (tx_path)
+        cord_pcap_open_tx(self);
+}
+
+void CordL2PcapFlowPoint_dtor(CordL2PcapFlowPoint * const self)
+{
+#ifdef CORD_FLOW_POINT_LOG
+    CORD_LOG("[CordL2PcapFlowPoint] dtor()\n");
+#endif
+    if (self->tx_file)
+        fclose(self->tx_file);
+
+    if (self->map)
+        munmap(self->map, self->map_size);
+
+    if (self->base.io_handle >= 0)
+        close(self->base.io_handle);
+
+    free(self->pkts);
+    CordFlowPoint_release(&self->base);
+    free(self);
+}
@@ -12,9 +12,14 @@ static cord_retval_t CordL2RawSocketFlowPoint_rx_(CordL2RawSocketFlowPoint * con
     if (*rx_bytes < 0)
     {
         CORD_ERROR("[CordL2RawSocketFlowPoint] rx : recvfrom()");
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            CordFlowPoint_count_rx(&self->base, queue_id, 0, 0);
+        else
+            CordFlowPoint_count_rx_error(&self->base, queue_id);
         return CORD_ERR;
     }
 
+    CordFlowPoint_count_rx(&self->base, queue_id, 1, *rx_bytes);
     return CORD_OK;
 }
 
@@ -28,9 +33,14 @@ static cord_retval_t CordL2RawSocketFlowPoint_tx_(CordL2RawSocketFlowPoint * con
     if (*tx_bytes < 0)
     {
         CORD_ERROR("[CordL2RawSocketFlowPoint] tx : sendto()");
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == ENOBUFS))
+            CordFlowPoint_count_ring_full(&self->base, queue_id);
+        else
+            CordFlowPoint_count_tx_error(&self->base, queue_id);
         return CORD_ERR;
     }
 
+    CordFlowPoint_count_tx(&self->base, queue_id, 1, *tx_bytes);
     return CORD_OK;
 }
 
@@ -147,5 +157,6 @@ void CordL2RawSocketFlowPoint_dtor(CordL2RawSocketFlowPoint * const self)
     CORD_LOG("[CordL2RawSocketFlowPoint] dtor()\n");
 #endif
     close(self->base.io_handle);
+    CordFlowPoint_release(&self->base);
     free(self);
 }
@@ -1,3 +1,4 @@
+#define _GNU_SOURCE
 #include <flow_point/cord_l2_tpacketv3_flow_point.h>
 #include <cord_error.h>
 #include <linux/filter.h>
@@ -8,31 +9,79 @@ static cord_retval_t CordL2Tpacketv3FlowPoint_rx_(CordL2Tpacketv3FlowPoint * con
     CORD_LOG("[CordL2Tpacketv3FlowPoint] rx()\n");
 #endif
 
-    (void)queue_id;
-    (void)self;
-
     struct cord_tpacketv3_ring *ring = *(struct cord_tpacketv3_ring **)buffer;
     struct tpacket_block_desc *pbd = (struct tpacket_block_desc *)ring->iov_ring[ring->block_idx].iov_base;
 
     if (!(pbd->hdr.bh1.block_status & TP_STATUS_USER))
     {
         *rx_packets = 0;
+        CordFlowPoint_count_rx(&self->base, queue_id, 0, 0);
         return CORD_OK;
     }
 
     *rx_packets = pbd->hdr.bh1.num_pkts;
 
+    uint64_t rx_bytes = 0;
+    struct tpacket3_hdr *hdr = (struct tpacket3_hdr *)((uint8_t *)pbd + pbd->hdr.bh1.offset_to_first_pkt);
+    for (uint32_t i = 0; i < pbd->hdr.bh1.num_pkts; i++)
+    {
+        rx_bytes += hdr->tp_snaplen;
+        hdr = (struct tpacket3_hdr *)((uint8_t *)hdr + hdr->tp_next_offset);
+    }
+
+    CordFlowPoint_count_rx(&self->base, queue_id, *rx_packets, rx_bytes);
+
     return CORD_OK;
 }
 
+// sendmmsg() with bounded retries on backpressure; a message the kernel refuses outright is dropped
+static uint32_t cord_tpacketv3_send_batch(CordL2Tpacketv3FlowPoint * const self, uint16_t queue_id, struct mmsghdr *msgs, uint32_t count)
+{
+    uint32_t done = 0;
+    uint32_t sent = 0;
+    uint64_t sent_bytes = 0;
+    uint16_t retries = 0;
+
+    while (done < count)
+    {
+        int ret = sendmmsg(self->base.io_handle, msgs + done, count - done, MSG_DONTWAIT);
+        if (ret > 0)
+        {
+            for (int i = 0; i < ret; i++)
+                sent_bytes += msgs[done + i].msg_len;
+
+            done += ret;
+            sent += ret;
+            continue;
+        }
+
+        if (ret < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != ENOBUFS && errno != EINTR)
+        {
+            // e.g. EMSGSIZE: skip the offending packet
+            done++;
+            CordFlowPoint_count_tx_error(&self->base, queue_id);
+            CordFlowPoint_count_tx_dropped(&self->base, queue_id, 1);
+            continue;
+        }
+
+        if (retries++ >= self->tx_max_retries)
+            break;
+
+        CordFlowPoint_count_ring_full(&self->base, queue_id);
+    }
+
+    CordFlowPoint_count_tx_dropped(&self->base, queue_id, count - done);
+    CordFlowPoint_count_tx(&self->base, queue_id, sent, sent_bytes);
+
+    return sent;
+}
+
 static cord_retval_t CordL2Tpacketv3FlowPoint_tx_(CordL2Tpacketv3FlowPoint * const self, uint16_t queue_id, void *buffer, size_t len, ssize_t *tx_packets)
 {
 #ifdef CORD_FLOW_POINT_LOG
     CORD_LOG("[CordL2Tpacketv3FlowPoint] tx()\n");
 #endif
 
-    (void)queue_id;
-
     struct cord_tpacketv3_ring *ring = *(struct cord_tpacketv3_ring **)buffer;
     struct tpacket_block_desc *pbd = (struct tpacket_block_desc *)ring->iov_ring[ring->block_idx].iov_base;
 
@@ -42,20 +91,31 @@ static cord_retval_t CordL2Tpacketv3FlowPoint_tx_(CordL2Tpacketv3FlowPoint * con
         return CORD_OK;
     }
 
+    struct mmsghdr msgs[CORD_TPACKETV3_TX_BATCH];
+    struct iovec iovs[CORD_TPACKETV3_TX_BATCH];
     ssize_t sent_count = 0;
     struct tpacket3_hdr *hdr = (struct tpacket3_hdr *)((uint8_t *)pbd + pbd->hdr.bh1.offset_to_first_pkt);
 
-    for (size_t i = 0; i < len; i++)
+    // The block goes back to the kernel below, so its packets are sent in batches right away
+    for (size_t i = 0; i < len; )
     {
-        uint8_t *pkt_data = (uint8_t *)hdr + hdr->tp_mac;
-        uint32_t pkt_len = hdr->tp_snaplen;
+        uint32_t n = 0;
 
-        ssize_t ret = sendto(self->base.io_handle, pkt_data, pkt_len, MSG_DONTWAIT,
-                             (struct sockaddr *)&self->anchor_bind_addr, sizeof(self->anchor_bind_addr));
-        if (ret > 0)
-            sent_count++;
+        for (; n < CORD_TPACKETV3_TX_BATCH && i < len; n++, i++)
+        {
+            iovs[n].iov_base = (uint8_t *)hdr + hdr->tp_mac;
+            iovs[n].iov_len = hdr->tp_snaplen;
 
-        hdr = (struct tpacket3_hdr *)((uint8_t *)hdr + hdr->tp_next_offset);
+            memset(&msgs[n], 0, sizeof(struct mmsghdr));
+            msgs[n].msg_hdr.msg_name = &self->anchor_bind_addr;
+            msgs[n].msg_hdr.msg_namelen = sizeof(self->anchor_bind_addr);
+            msgs[n].msg_hdr.msg_iov = &iovs[n];
+            msgs[n].msg_hdr.msg_iovlen = 1;
+
+            hdr = (struct tpacket3_hdr *)((uint8_t *)hdr + hdr->tp_next_offset);
+        }
+
+        sent_count += cord_tpacketv3_send_batch(self, queue_id, msgs, n);
     }
 
     pbd->hdr.bh1.block_status = TP_STATUS_KERNEL;
@@ -130,6 +190,7 @@ void CordL2Tpacketv3FlowPoint_ctor(CordL2Tpacketv3FlowPoint * const self,
     self->base.vptr = &vtbl_base;
     self->anchor_iface_name = anchor_iface_name;
     self->rx_ring = rx_ring;
+    self->tx_max_retries = CORD_TPACKETV3_TX_MAX_RETRIES;
 
     self->base.io_handle = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
     if (self->base.io_handle < 0)
@@ -189,7 +250,18 @@ void CordL2Tpacketv3FlowPoint_ctor(CordL2Tpacketv3FlowPoint * const self,
     }
     
     (*rx_ring)->fd = self->base.io_handle;
-    if (setsockopt(self->base.io_handle, SOL_PACKET, PACKET_RX_RING, &((*rx_ring)->req), sizeof((*rx_ring)->req)) < 0)
+
+    // The kernel allocates the ring blocks here, under the calling thread's memory policy;
+    // the thread's own policy is put back afterwards (left alone if it cannot be saved)
+    cord_numa_policy_t saved_policy;
+    bool numa_switch = ((*rx_ring)->socket_id != CORD_NUMA_NODE_ANY) &&
+                       (cord_numa_policy_save(&saved_policy) == 0) &&
+                       (cord_numa_set_preferred((*rx_ring)->socket_id) == 0);
+    int rx_ring_ret = setsockopt(self->base.io_handle, SOL_PACKET, PACKET_RX_RING, &((*rx_ring)->req), sizeof((*rx_ring)->req));
+    if (numa_switch)
+        cord_numa_policy_restore(&saved_policy);
+
+    if (rx_ring_ret < 0)
     {
         CORD_ERROR("[CordL2Tpacketv3FlowPoint] setsockopt(PACKET_RX_RING)");
         CORD_CLOSE(self->base.io_handle);
@@ -209,5 +281,6 @@ void CordL2Tpacketv3FlowPoint_dtor(CordL2Tpacketv3FlowPoint * const self)
 
     cord_tpacketv3_ring_free(self->rx_ring);
 
+    CordFlowPoint_release(&self->base);
     free(self);
 }
@@ -0,0 +1,496 @@
+#include <flow_point/cord_l2_traffic_gen_flow_point.h>
+#include <action/cord_checksum.h>
+#include <cord_error.h>
+#include <time.h>
+
+#define CORD_TRAFFIC_GEN_FIELD_SRC_IP       0
+#define CORD_TRAFFIC_GEN_FIELD_DST_IP       1
+#define CORD_TRAFFIC_GEN_FIELD_SRC_PORT     2
+#define CORD_TRAFFIC_GEN_FIELD_DST_PORT     3
+
+static inline uint64_t cord_traffic_gen_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// xorshift64*
+static inline uint64_t cord_traffic_gen_rand(CordL2TrafficGenFlowPoint * const self)
+{
+    uint64_t x = self->rng;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    self->rng = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+//
+// Field variation
+//
+
+static inline uint32_t cord_traffic_gen_next(CordL2TrafficGenFlowPoint * const self, uint32_t field, const cord_traffic_gen_field_t *f)
+{
+    if (f->mode == CORD_TRAFFIC_GEN_FIELD_INCREMENT)
+    {
+        uint32_t idx = self->field_idx[field];
+        uint32_t value = f->base + idx * (f->step ? f->step : 1);
+
+        idx++;
+        if (f->count && idx == f->count)
+            idx = 0;
+        self->field_idx[field] = idx;
+
+        return value;
+    }
+
+    // Multiply-shift instead of a modulo: uniform enough for load generation
+    uint32_t r = (uint32_t)(cord_traffic_gen_rand(self) >> 32);
+    return f->base + (f->count ? (uint32_t)(((uint64_t)r * f->count) >> 32) : r);
+}
+
+static inline void cord_traffic_gen_l4_replace32(CordL2TrafficGenFlowPoint * const self, uint8_t *l4, uint32_t old_val, uint32_t new_val)
+{
+    if (self->l4_proto == CORD_IPPROTO_UDP)
+    {
+        cord_udp_hdr_t *udp = (cord_udp_hdr_t *)l4;
+        udp->check = cord_csum_replace32_udp(udp->check, old_val, new_val);
+    }
+    else if (self->l4_proto == CORD_IPPROTO_TCP)
+    {
+        cord_tcp_hdr_t *tcp = (cord_tcp_hdr_t *)l4;
+        tcp->check = cord_csum_replace32(tcp->check, old_val, new_val);
+    }
+}
+
+static inline void cord_traffic_gen_l4_replace16(CordL2TrafficGenFlowPoint * const self, uint8_t *l4, uint16_t old_val, uint16_t new_val)
+{
+    if (self->l4_proto == CORD_IPPROTO_UDP)
+    {
+        cord_udp_hdr_t *udp = (cord_udp_hdr_t *)l4;
+        udp->check = cord_csum_replace16_udp(udp->check, old_val, new_val);
+    }
+    else
+    {
+        cord_tcp_hdr_t *tcp = (cord_tcp_hdr_t *)l4;
+        tcp->check = cord_csum_replace16(tcp->check, old_val, new_val);
+    }
+}
+
+// Rewrites the varied fields of a freshly restored header; the checksums follow incrementally
+static inline void cord_traffic_gen_vary(CordL2TrafficGenFlowPoint * const self, uint8_t *frame)
+{
+    cord_ipv4_hdr_t *ip = (cord_ipv4_hdr_t *)(frame + self->l3_offset);
+    uint8_t *l4 = frame + self->l4_offset;
+
+    if (self->cfg.ipv4_src.mode != CORD_TRAFFIC_GEN_FIELD_FIXED)
+    {
+        uint32_t saddr = cord_htonl(cord_traffic_gen_next(self, CORD_TRAFFIC_GEN_FIELD_SRC_IP, &self->cfg.ipv4_src));
+        ip->check = cord_csum_replace32(ip->check, self->tmpl_saddr, saddr);
+        cord_traffic_gen_l4_replace32(self, l4, self->tmpl_saddr, saddr);
+        ip->saddr.addr = saddr;
+    }
+
+    if (self->cfg.ipv4_dst.mode != CORD_TRAFFIC_GEN_FIELD_FIXED)
+    {
+        uint32_t daddr = cord_htonl(cord_traffic_gen_next(self, CORD_TRAFFIC_GEN_FIELD_DST_IP, &self->cfg.ipv4_dst));
+        ip->check = cord_csum_replace32(ip->check, self->tmpl_daddr, daddr);
+        cord_traffic_gen_l4_replace32(self, l4, self->tmpl_daddr, daddr);
+        ip->daddr.addr = daddr;
+    }
+
+    // Source and destination port sit at the same offsets in UDP and TCP
+    if (self->cfg.src_port.mode != CORD_TRAFFIC_GEN_FIELD_FIXED)
+    {
+        uint16_t sport = cord_htons((uint16_t)cord_traffic_gen_next(self, CORD_TRAFFIC_GEN_FIELD_SRC_PORT, &self->cfg.src_port));
+        cord_traffic_gen_l4_replace16(self, l4, self->tmpl_sport, sport);
+        ((cord_udp_hdr_t *)l4)->source = sport;
+    }
+
+    if (self->cfg.dst_port.mode != CORD_TRAFFIC_GEN_FIELD_FIXED)
+    {
+        uint16_t dport = cord_htons((uint16_t)cord_traffic_gen_next(self, CORD_TRAFFIC_GEN_FIELD_DST_PORT, &self->cfg.dst_port));
+        cord_traffic_gen_l4_replace16(self, l4, self->tmpl_dport, dport);
+        ((cord_udp_hdr_t *)l4)->dest = dport;
+    }
+}
+
+//
+// Template
+//
+
+static void cord_traffic_gen_parse_template(CordL2TrafficGenFlowPoint * const self)
+{
+    const cord_traffic_gen_cfg_t *cfg = &self->cfg;
+    const uint8_t *tmpl = cfg->template_pkt;
+    uint16_t len = cfg->template_len;
+
+    if (!tmpl || len < sizeof(cord_eth_hdr_t))
+    {
+        CORD_LOG("[CordL2TrafficGenFlowPoint] The template must hold at least an Ethernet header\n");
+        CORD_EXIT(EXIT_FAILURE);
+    }
+
+    // Skip up to two VLAN tags
+    uint16_t off = sizeof(cord_eth_hdr_t);
+    uint16_t proto = cord_ntohs(((const cord_eth_hdr_t *)tmpl)->h_proto);
+    for (int tags = 0; tags < 2 && (proto == CORD_ETH_P_8021Q || proto == CORD_ETH_P_8021AD); tags++)
+    {
+        if (off + sizeof(cord_vlan_hdr_t) > len)
+            break;
+
+        proto = cord_ntohs(((const cord_vlan_hdr_t *)(tmpl + off))->h_proto);
+        off += sizeof(cord_vlan_hdr_t);
+    }
+
+    self->hdr_len = off;
+    self->l3_offset = 0;
+    self->l4_offset = 0;
+    self->l4_proto = 0;
+
+    if (proto == CORD_ETH_P_IP && off + sizeof(cord_ipv4_hdr_t) <= len)
+    {
+        const cord_ipv4_hdr_t *ip = (const cord_ipv4_hdr_t *)(tmpl + off);
+        uint16_t ihl = ip->ihl * 4;
+
+        if (ip->version == 4 && ihl >= sizeof(cord_ipv4_hdr_t) && off + ihl <= len)
+        {
+            self->l3_offset = off;
+            self->l4_offset = off + ihl;
+            self->hdr_len = off + ihl;
+            self->tmpl_saddr = ip->saddr.addr;
+            self->tmpl_daddr = ip->daddr.addr;
+
+            const uint8_t *l4 = tmpl + self->l4_offset;
+            if (ip->protocol == CORD_IPPROTO_UDP && self->l4_offset + sizeof(cord_udp_hdr_t) <= len)
+            {
+                self->l4_proto = CORD_IPPROTO_UDP;
+                self->hdr_len = self->l4_offset + sizeof(cord_udp_hdr_t);
+            }
+            else if (ip->protocol == CORD_IPPROTO_TCP && self->l4_offset + sizeof(cord_tcp_hdr_t) <= len &&
+                     self->l4_offset + ((const cord_tcp_hdr_t *)l4)->doff * 4 <= len &&
+                     ((const cord_tcp_hdr_t *)l4)->doff * 4 >= (int)sizeof(cord_tcp_hdr_t))
+            {
+                self->l4_proto = CORD_IPPROTO_TCP;
+                self->hdr_len = self->l4_offset + ((const cord_tcp_hdr_t *)l4)->doff * 4;
+            }
+
+            if (self->l4_proto)
+            {
+                self->tmpl_sport = ((const cord_udp_hdr_t *)l4)->source;
+                self->tmpl_dport = ((const cord_udp_hdr_t *)l4)->dest;
+            }
+        }
+    }
+
+    bool vary_ip = (cfg->ipv4_src.mode != CORD_TRAFFIC_GEN_FIELD_FIXED) || (cfg->ipv4_dst.mode != CORD_TRAFFIC_GEN_FIELD_FIXED);
+    bool vary_port = (cfg->src_port.mode != CORD_TRAFFIC_GEN_FIELD_FIXED) || (cfg->dst_port.mode != CORD_TRAFFIC_GEN_FIELD_FIXED);
+
+    if ((vary_ip && !self->l3_offset) || (vary_port && !self->l4_proto))
+    {
+        CORD_LOG("[CordL2TrafficGenFlowPoint] Address / port variation needs an IPv4 / UDP or TCP template\n");
+        CORD_EXIT(EXIT_FAILURE);
+    }
+}
+
+// Full frame of the given size: template, then a byte counter pattern; lengths and checksums set
+static void cord_traffic_gen_build_frame(CordL2TrafficGenFlowPoint * const self, uint8_t *frame, uint16_t size)
+{
+    const cord_traffic_gen_cfg_t *cfg = &self->cfg;
+    uint16_t copy_len = (cfg->template_len < size) ? cfg->template_len : size;
+
+    memcpy(frame, cfg->template_pkt, copy_len);
+    for (uint16_t i = copy_len; i < size; i++)
+        frame[i] = (uint8_t)i;
+
+    if (!self->l3_offset)
+        return;
+
+    cord_ipv4_hdr_t *ip = (cord_ipv4_hdr_t *)(frame + self->l3_offset);
+    ip->tot_len = cord_htons(size - self->l3_offset);
+    ip->check = 0;
+    ip->check = cord_csum(ip, ip->ihl * 4);
+
+    uint16_t l4_len = size - self->l4_offset;
+    uint8_t *l4 = frame + self->l4_offset;
+
+    if (self->l4_proto == CORD_IPPROTO_UDP)
+    {
+        cord_udp_hdr_t *udp = (cord_udp_hdr_t *)l4;
+        udp->len = cord_htons(l4_len);
+
+        // A zero template checksum stays "none"
+        if (udp->check != 0)
+        {
+            udp->check = 0;
+            uint32_t sum = cord_csum_pseudo_ipv4(ip->saddr.addr, ip->daddr.addr, CORD_IPPROTO_UDP, l4_len);
+            uint16_t check = (uint16_t)~cord_csum_fold(cord_csum_partial(l4, l4_len, sum));
+            udp->check = check ? check : 0xFFFF;
+        }
+    }
+    else if (self->l4_proto == CORD_IPPROTO_TCP)
+    {
+        cord_tcp_hdr_t *tcp = (cord_tcp_hdr_t *)l4;
+        tcp->check = 0;
+        uint32_t sum = cord_csum_pseudo_ipv4(ip->saddr.addr, ip->daddr.addr, CORD_IPPROTO_TCP, l4_len);
+        tcp->check = (uint16_t)~cord_csum_fold(cord_csum_partial(l4, l4_len, sum));
+    }
+}
+
+static void cord_traffic_gen_build(CordL2TrafficGenFlowPoint * const self)
+{
+    cord_traffic_gen_cfg_t *cfg = &self->cfg;
+    uint16_t max_size = 0;
+    uint64_t total_weight = 0;
+
+    for (uint8_t k = 0; k < cfg->num_sizes; k++)
+    {
+        if (cfg->sizes[k].size < self->hdr_len || cfg->sizes[k].size > UINT16_MAX - CORD_RAW_HEADROOM)
+        {
+            CORD_LOG("[CordL2TrafficGenFlowPoint] Frame size %u out of range (headers: %u bytes)\n", cfg->sizes[k].size, self->hdr_len);
+            CORD_EXIT(EXIT_FAILURE);
+        }
+
+        if (cfg->sizes[k].size > max_size)
+            max_size = cfg->sizes[k].size;
+        total_weight += cfg->sizes[k].weight;
+        self->frame_len[k] = cfg->sizes[k].size;
+    }
+
+    if (total_weight == 0)
+    {
+        CORD_LOG("[CordL2TrafficGenFlowPoint] The size mix has no weight\n");
+        CORD_EXIT(EXIT_FAILURE);
+    }
+
+    self->pool = cord_pkt_pool_create(cfg->num_bufs, CORD_RAW_HEADROOM + max_size, 0);
+    self->slots = malloc(cfg->num_bufs * sizeof(cord_raw_pkt_desc_t *));
+    self->slot_size = malloc(cfg->num_bufs);
+    self->hdrs = malloc((size_t)cfg->num_sizes * self->hdr_len);
+    uint8_t *frame = malloc(max_size);
+
+    if (!self->pool || !self->slots || !self->slot_size || !self->hdrs || !frame)
+    {
+        CORD_ERROR("[CordL2TrafficGenFlowPoint] cord_pkt_pool_create() / malloc()");
+        CORD_EXIT(EXIT_FAILURE);
+    }
+
+    // The generator holds one reference on every buffer of the pool
+    if (cord_pkt_alloc_bulk(self->pool, self->slots, cfg->num_bufs) < 0)
+    {
+        CORD_LOG("[CordL2TrafficGenFlowPoint] cord_pkt_alloc_bulk() failed\n");
+        CORD_EXIT(EXIT_FAILURE);
+    }
+
+    // Exact shares of the size mix, shuffled so that the sizes interleave
+    uint64_t cum_weight = 0;
+    uint32_t slot = 0;
+    for (uint8_t k = 0; k < cfg->num_sizes; k++)
+    {
+        cum_weight += cfg->sizes[k].weight;
+        uint32_t end = (uint32_t)((cum_weight * cfg->num_bufs) / total_weight);
+        for (; slot < end; slot++)
+            self->slot_size[slot] = k;
+    }
+
+    for (uint32_t i = cfg->num_bufs - 1; i > 0; i--)
+    {
+        uint32_t j = (uint32_t)(cord_traffic_gen_rand(self) % (i + 1));
+        uint8_t tmp = self->slot_size[i];
+        self->slot_size[i] = self->slot_size[j];
+        self->slot_size[j] = tmp;
+    }
+
+    for (uint8_t k = 0; k < cfg->num_sizes; k++)
+    {
+        cord_traffic_gen_build_frame(self, frame, self->frame_len[k]);
+        memcpy(self->hdrs + (size_t)k * self->hdr_len, frame, self->hdr_len);
+
+        for (uint32_t i = 0; i < cfg->num_bufs; i++)
+        {
+            if (self->slot_size[i] != k)
+                continue;
+
+            cord_raw_pkt_desc_t *pkt = self->slots[i];
+            pkt->data = pkt->buf_addr + CORD_RAW_HEADROOM;
+            pkt->data_len = self->frame_len[k];
+            memcpy(pkt->data, frame, self->frame_len[k]);
+        }
+    }
+
+    free(frame);
+}
+
+static cord_retval_t CordL2TrafficGenFlowPoint_rx_(CordL2TrafficGenFlowPoint * const self, uint16_t queue_id, void *buffer, size_t len, ssize_t *rx_packets)
+{
+#ifdef CORD_FLOW_POINT_LOG
+    CORD_LOG("[CordL2TrafficGenFlowPoint] rx()\n");
+#endif
+
+    cord_raw_pkt_desc_t **pkts = (cord_raw_pkt_desc_t **)buffer;
+    uint64_t limit = len;
+    *rx_packets = 0;
+
+    if (self->cfg.max_pkts)
+    {
+        uint64_t remaining = CordL2TrafficGenFlowPoint_done(self) ? 0 : self->cfg.max_pkts - self->generated_pkts;
+        if (remaining < limit)
+            limit = remaining;
+    }
+
+    if (self->cfg.pps)
+    {
+        uint64_t elapsed_ns = cord_traffic_gen_now_ns() - self->start_ns;
+        uint64_t due = (uint64_t)((double)elapsed_ns * (double)self->cfg.pps / 1e9);
+        uint64_t budget = (due > self->generated_pkts) ? due - self->generated_pkts : 0;
+        if (budget < limit)
+            limit = budget;
+    }
+
+    const bool vary = (self->cfg.ipv4_src.mode | self->cfg.ipv4_dst.mode |
+                       self->cfg.src_port.mode | self->cfg.dst_port.mode) != CORD_TRAFFIC_GEN_FIELD_FIXED;
+    uint64_t rx_bytes = 0;
+    uint64_t count = 0;
+
+    while (count < limit)
+    {
+        uint32_t slot = self->next_slot;
+        cord_raw_pkt_desc_t *pkt = self->slots[slot];
+
+        // Still referenced by a consumer; acquire orders its last accesses before the rewrite
+        if (atomic_load_explicit(&cord_pkt_buf(pkt)->refcnt, memory_order_acquire) != 1)
+        {
+            CordFlowPoint_count_ring_full(&self->base, queue_id);
+            break;
+        }
+
+        uint8_t k = self->slot_size[slot];
+        pkt->data = pkt->buf_addr + CORD_RAW_HEADROOM;
+        pkt->data_len = self->frame_len[k];
+        memcpy(pkt->data, self->hdrs + (size_t)k * self->hdr_len, self->hdr_len);
+
+        if (vary)
+            cord_traffic_gen_vary(self, pkt->data);
+
+        cord_pkt_refcnt_inc(pkt);
+        pkts[count++] = pkt;
+        rx_bytes += pkt->data_len;
+        self->next_slot = (slot + 1) & self->slot_mask;
+    }
+
+    self->generated_pkts += count;
+    *rx_packets = (ssize_t)count;
+    CordFlowPoint_count_rx(&self->base, queue_id, count, rx_bytes);
+
+    return CORD_OK;
+}
+
+static cord_retval_t CordL2TrafficGenFlowPoint_tx_(CordL2TrafficGenFlowPoint * const self, uint16_t queue_id, void *buffer, size_t len, ssize_t *tx_packets)
+{
+#ifdef CORD_FLOW_POINT_LOG
+    CORD_LOG("[CordL2TrafficGenFlowPoint] tx()\n");
+#endif
+
+    cord_raw_pkt_desc_t **pkts = (cord_raw_pkt_desc_t **)buffer;
+    uint64_t tx_bytes = 0;
+
+    for (size_t i = 0; i < len; i++)
+        tx_bytes += pkts[i]->data_len;
+
+    cord_pkt_free_bulk(pkts, (uint32_t)len);
+    CordFlowPoint_count_tx(&self->base, queue_id, len, tx_bytes);
+
+    *tx_packets = (ssize_t)len;
+    return CORD_OK;
+}
+
+static cord_retval_t CordL2TrafficGenFlowPoint_attach_xBPF_(CordL2TrafficGenFlowPoint * const self, void *filter, void *params)
+{
+#ifdef CORD_FLOW_POINT_LOG
+    CORD_LOG("[CordL2TrafficGenFlowPoint] attach_xBPF()\n");
+#endif
+    (void)self;
+    (void)filter;
+    (void)params;
+
+    return CORD_ERR_UNSUPPORTED;
+}
+
+void CordL2TrafficGenFlowPoint_restart(CordL2TrafficGenFlowPoint * const self)
+{
+    self->generated_pkts = 0;
+    self->start_ns = cord_traffic_gen_now_ns();
+}
+
+void CordL2TrafficGenFlowPoint_ctor(CordL2TrafficGenFlowPoint * const self,
+                                    uint8_t id,
+                                    const cord_traffic_gen_cfg_t *cfg)
+{
+#ifdef CORD_FLOW_POINT_LOG
+    CORD_LOG("[CordL2TrafficGenFlowPoint] ctor()\n");
+#endif
+    static const CordFlowPointVtbl vtbl = {
+        .rx = (cord_retval_t (*)(CordFlowPoint * const self, uint16_t queue_id, void *buffer, size_t len, ssize_t *rx_packets))&CordL2TrafficGenFlowPoint_rx_,
+        .tx = (cord_retval_t (*)(CordFlowPoint * const self, uint16_t queue_id, void *buffer, size_t len, ssize_t *tx_packets))&CordL2TrafficGenFlowPoint_tx_,
+        .attach_xBPF = (cord_retval_t (*)(CordFlowPoint * const self, void *filter, void *params))&CordL2TrafficGenFlowPoint_attach_xBPF_,
+        .cleanup = (void     (*)(CordFlowPoint * const self))&CordL2TrafficGenFlowPoint_dtor,
+    };
+
+    CordFlowPoint_ctor(&self->base, id);
+    self->base.vptr = &vtbl;
+    self->base.io_handle = -1;
+    self->cfg = *cfg;
+
+    if (self->cfg.num_sizes == 0)
+    {
+        self->cfg.sizes[0].size = self->cfg.template_len;
+        self->cfg.sizes[0].weight = 1;
+        self->cfg.num_sizes = 1;
+    }
+    else if (self->cfg.num_sizes > CORD_TRAFFIC_GEN_MAX_SIZES)
+    {
+        CORD_LOG("[CordL2TrafficGenFlowPoint] At most %u sizes in the mix\n", CORD_TRAFFIC_GEN_MAX_SIZES);
+        CORD_EXIT(EXIT_FAILURE);
+    }
+
+    uint32_t num_bufs = self->cfg.num_bufs ? self->cfg.num_bufs : CORD_TRAFFIC_GEN_NUM_BUFS;
+    if (num_bufs > (1u << 31))
+        num_bufs = 1u << 31;
+    self->cfg.num_bufs = 1;
+    while (self->cfg.num_bufs < num_bufs)
+        self->cfg.num_bufs <<= 1;
+
+    self->slot_mask = self->cfg.num_bufs - 1;
+    self->next_slot = 0;
+    self->rng = self->cfg.seed ? self->cfg.seed : CORD_TRAFFIC_GEN_SEED;
+    memset(self->field_idx, 0, sizeof(self->field_idx));
+    self->tmpl_saddr = 0;
+    self->tmpl_daddr = 0;
+    self->tmpl_sport = 0;
+    self->tmpl_dport = 0;
+    self->params = NULL;
+
+    cord_traffic_gen_parse_template(self);
+    cord_traffic_gen_build(self);
+
+    CordL2TrafficGenFlowPoint_restart(self);
+}
+
+void CordL2TrafficGenFlowPoint_dtor(CordL2TrafficGenFlowPoint * const self)
+{
+#ifdef CORD_FLOW_POINT_LOG
+    CORD_LOG("[CordL2TrafficGenFlowPoint] dtor()\n");
+#endif
+    if (self->pool)
+    {
+        cord_pkt_free_bulk(self->slots, self->cfg.num_bufs);
+        cord_pkt_pool_destroy(self->pool);
+    }
+
+    free(self->slots);
+    free(self->slot_size);
+    free(self->hdrs);
+    CordFlowPoint_release(&self->base);
+    free(self);
+}
@@ -7,10 +7,22 @@ static cord_retval_t CordL3RawSocketFlowPoint_rx_(CordL3RawSocketFlowPoint * con
 #ifdef CORD_FLOW_POINT_LOG
     CORD_LOG("[CordL3RawSocketFlowPoint] rx()\n");
 #endif
-    //
-    // Implement the AF_PACKET/AF_INET rx() logic
-    //
+    // SOCK_DGRAM: the kernel strips the link layer header, the buffer starts at the IP header
+    struct sockaddr_ll src_addr;
+    socklen_t addr_len = sizeof(src_addr);
+    *rx_bytes = recvfrom(self->base.io_handle, buffer, len, 0, (struct sockaddr *)&src_addr, &addr_len);
+    if (*rx_bytes < 0)
+    {
+        CORD_ERROR("[CordL3RawSocketFlowPoint] rx : recvfrom()");
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            CordFlowPoint_count_rx(&self->base, queue_id, 0, 0);
+        else
+            CordFlowPoint_count_rx_error(&self->base, queue_id);
+        return CORD_ERR;
+    }
 
+    self->rx_pkttype = src_addr.sll_pkttype;
+    CordFlowPoint_count_rx(&self->base, queue_id, 1, *rx_bytes);
     return CORD_OK;
 }
 
@@ -19,10 +31,36 @@ static cord_retval_t CordL3RawSocketFlowPoint_tx_(CordL3RawSocketFlowPoint * con
 #ifdef CORD_FLOW_POINT_LOG
     CORD_LOG("[CordL3RawSocketFlowPoint] tx()\n");
 #endif
-    //
-    // Implement the AF_PACKET/AF_INET tx() logic
-    //
+    if (len == 0)
+    {
+        *tx_bytes = 0;
+        return CORD_ERR;
+    }
+
+    if (self->dst_addr.sll_halen == 0)
+    {
+        *tx_bytes = 0;
+        CordFlowPoint_count_tx_error(&self->base, queue_id);
+        return CORD_ERR_INVALID_PARAM;
+    }
 
+    // The kernel builds the link layer header: EtherType from the IP version, destination
+    // MAC from set_dst_mac()
+    struct sockaddr_ll dst_addr = self->dst_addr;
+    dst_addr.sll_protocol = ((((uint8_t *)buffer)[0] >> 4) == 6) ? htons(ETH_P_IPV6) : htons(ETH_P_IP);
+
+    *tx_bytes = sendto(self->base.io_handle, buffer, len, 0, (struct sockaddr *)&dst_addr, sizeof(dst_addr));
+    if (*tx_bytes < 0)
+    {
+        CORD_ERROR("[CordL3RawSocketFlowPoint] tx : sendto()");
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == ENOBUFS))
+            CordFlowPoint_count_ring_full(&self->base, queue_id);
+        else
+            CordFlowPoint_count_tx_error(&self->base, queue_id);
+        return CORD_ERR;
+    }
+
+    CordFlowPoint_count_tx(&self->base, queue_id, 1, *tx_bytes);
     return CORD_OK;
 }
 
@@ -116,6 +154,8 @@ void CordL3RawSocketFlowPoint_ctor(CordL3RawSocketFlowPoint * const self,
     self->anchor_bind_addr.sll_protocol = htons(ETH_P_ALL);
     self->anchor_bind_addr.sll_ifindex = anchor_iface_req.ifr_ifindex;
     self->anchor_bind_addr.sll_halen = ETH_ALEN;
+    memset(&(self->dst_addr), 0, sizeof(struct sockaddr_ll));
+    self->rx_pkttype = PACKET_HOST;
     if (bind(self->base.io_handle, (struct sockaddr *)&(self->anchor_bind_addr), sizeof(struct sockaddr_ll)) < 0)
     {
         CORD_ERROR("[CordL3RawSocketFlowPoint] bind()");
@@ -132,11 +172,21 @@ void CordL3RawSocketFlowPoint_ctor(CordL3RawSocketFlowPoint * const self,
     fcntl(self->base.io_handle, F_SETFL, O_NONBLOCK);
 }
 
+void CordL3RawSocketFlowPoint_set_dst_mac(CordL3RawSocketFlowPoint * const self, const uint8_t dst_mac[ETH_ALEN])
+{
+    memset(&(self->dst_addr), 0, sizeof(struct sockaddr_ll));
+    self->dst_addr.sll_family = AF_PACKET;
+    self->dst_addr.sll_ifindex = self->ifindex;
+    self->dst_addr.sll_halen = ETH_ALEN;
+    memcpy(self->dst_addr.sll_addr, dst_mac, ETH_ALEN);
+}
+
 void CordL3RawSocketFlowPoint_dtor(CordL3RawSocketFlowPoint * const self)
 {
 #ifdef CORD_FLOW_POINT_LOG
     CORD_LOG("[CordL3RawSocketFlowPoint] dtor()\n");
 #endif
     close(self->base.io_handle);
+    CordFlowPoint_release(&self->base);
     free(self);
 }
@@ -23,6 +23,14 @@ static cord_retval_t CordL3StackInjectFlowPoint_tx_(CordL3StackInjectFlowPoint *
     if (*tx_bytes < 0)
     {
         CORD_ERROR("[CordL3StackInjectFlowPoint] sendto()");
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == ENOBUFS))
+            CordFlowPoint_count_ring_full(&self->base, queue_id);
+        else
+            CordFlowPoint_count_tx_error(&self->base, queue_id);
+    }
+    else
+    {
+        CordFlowPoint_count_tx(&self->base, queue_id, 1, *tx_bytes);
     }
 
     return CORD_OK;
@@ -139,5 +147,6 @@ void CordL3StackInjectFlowPoint_dtor(CordL3StackInjectFlowPoint * const self)
     CORD_LOG("[CordL3StackInjectFlowPoint] dtor()\n");
 #endif
     close(self->base.io_handle);
+    CordFlowPoint_release(&self->base);
     free(self);
 }
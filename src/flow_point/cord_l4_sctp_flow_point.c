@@ -78,6 +78,7 @@ static cord_retval_t CordL4SctpFlowPoint_rx_(CordL4SctpFlowPoint * const self, u
             }
 
             CORD_ERROR("[CordL4SctpFlowPoint] _rx_ recv()");
+            CordFlowPoint_count_rx_error(&self->base, queue_id);
             CORD_CLOSE(self->base.aux_handles[CLIENT_CONN_AUX_HANDLE_INDEX]);
             self->server_mode_sctp_connection_state = CORD_SCTP_DISCONNECTED;
             return CORD_ERR;
@@ -149,6 +150,7 @@ static cord_retval_t CordL4SctpFlowPoint_rx_(CordL4SctpFlowPoint * const self, u
             }
 
             CORD_ERROR("[CordL4SctpFlowPoint] _rx_ recv()");
+            CordFlowPoint_count_rx_error(&self->base, queue_id);
             __recreate_defunct_socket(self);
             self->client_mode_sctp_connection_state = CORD_SCTP_DISCONNECTED;
             return CORD_ERR;
@@ -161,6 +163,7 @@ static cord_retval_t CordL4SctpFlowPoint_rx_(CordL4SctpFlowPoint * const self, u
         }
     }
 
+    CordFlowPoint_count_rx(&self->base, queue_id, 1, *rx_bytes);
     return CORD_OK;
 }
 
@@ -248,6 +251,11 @@ static cord_retval_t CordL4SctpFlowPoint_tx_(CordL4SctpFlowPoint * const self, u
         }
     }
 
+    if (*tx_bytes < 0)
+        CordFlowPoint_count_tx_error(&self->base, queue_id);
+    else
+        CordFlowPoint_count_tx(&self->base, queue_id, 1, *tx_bytes);
+
     return CORD_OK;
 }
 
@@ -419,5 +427,6 @@ void CordL4SctpFlowPoint_dtor(CordL4SctpFlowPoint * const self)
         CORD_CLOSE(self->base.aux_handles[CLIENT_CONN_AUX_HANDLE_INDEX]);
 
     CORD_CLOSE(self->base.io_handle);
+    CordFlowPoint_release(&self->base);
     free(self);
 }
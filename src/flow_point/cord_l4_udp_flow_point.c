@@ -11,6 +11,14 @@ static cord_retval_t CordL4UdpFlowPoint_rx_(CordL4UdpFlowPoint * const self, uin
     if (*rx_bytes < 0)
     {
         CORD_ERROR("[CordL4UdpFlowPoint] recvfrom()");
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            CordFlowPoint_count_rx(&self->base, queue_id, 0, 0);
+        else
+            CordFlowPoint_count_rx_error(&self->base, queue_id);
+    }
+    else
+    {
+        CordFlowPoint_count_rx(&self->base, queue_id, 1, *rx_bytes);
     }
 
     return CORD_OK;
@@ -25,6 +33,14 @@ static cord_retval_t CordL4UdpFlowPoint_tx_(CordL4UdpFlowPoint * const self, uin
     if (*tx_bytes < 0)
     {
         CORD_ERROR("[CordL4UdpFlowPoint] sendto()");
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == ENOBUFS))
+            CordFlowPoint_count_ring_full(&self->base, queue_id);
+        else
+            CordFlowPoint_count_tx_error(&self->base, queue_id);
+    }
+    else
+    {
+        CordFlowPoint_count_tx(&self->base, queue_id, 1, *tx_bytes);
     }
 
     return CORD_OK;
@@ -153,5 +169,6 @@ void CordL4UdpFlowPoint_dtor(CordL4UdpFlowPoint * const self)
     CORD_LOG("[CordL4UdpFlowPoint] dtor()\n");
 #endif
     close(self->base.io_handle);
+    CordFlowPoint_release(&self->base);
     free(self);
 }
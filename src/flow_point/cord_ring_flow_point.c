@@ -0,0 +1,101 @@
+#include <flow_point/cord_ring_flow_point.h>
+#include <cord_error.h>
+
+static cord_retval_t CordRingFlowPoint_rx_(CordRingFlowPoint * const self, uint16_t queue_id, void *buffer, size_t len, ssize_t *rx_packets)
+{
+#ifdef CORD_FLOW_POINT_LOG
+    CORD_LOG("[CordRingFlowPoint] rx()\n");
+#endif
+
+    cord_raw_pkt_desc_t **pkts = (cord_raw_pkt_desc_t **)buffer;
+    uint32_t n = cord_ring_dequeue_burst(self->ring, (void **)pkts, (uint32_t)len);
+    uint64_t rx_bytes = 0;
+
+    for (uint32_t i = 0; i < n; i++)
+        rx_bytes += pkts[i]->data_len;
+
+    *rx_packets = (ssize_t)n;
+    CordFlowPoint_count_rx(&self->base, queue_id, n, rx_bytes);
+
+    return CORD_OK;
+}
+
+static cord_retval_t CordRingFlowPoint_tx_(CordRingFlowPoint * const self, uint16_t queue_id, void *buffer, size_t len, ssize_t *tx_packets)
+{
+#ifdef CORD_FLOW_POINT_LOG
+    CORD_LOG("[CordRingFlowPoint] tx()\n");
+#endif
+
+    cord_raw_pkt_desc_t **pkts = (cord_raw_pkt_desc_t **)buffer;
+    uint64_t tx_bytes = 0;
+
+    // Sum before the enqueue: the consumer may already own and free the packets afterwards
+    for (size_t i = 0; i < len; i++)
+        tx_bytes += pkts[i]->data_len;
+
+    uint32_t n = cord_ring_enqueue_burst(self->ring, (void * const *)pkts, (uint32_t)len);
+    *tx_packets = (ssize_t)n;
+
+    if (n < len)
+    {
+        for (size_t i = n; i < len; i++)
+            tx_bytes -= pkts[i]->data_len;
+
+        CordFlowPoint_count_ring_full(&self->base, queue_id);
+        CordFlowPoint_count_tx(&self->base, queue_id, n, tx_bytes);
+        return CORD_ERR_AGAIN;
+    }
+
+    CordFlowPoint_count_tx(&self->base, queue_id, n, tx_bytes);
+    return CORD_OK;
+}
+
+static cord_retval_t CordRingFlowPoint_attach_xBPF_(CordRingFlowPoint * const self, void *filter, void *params)
+{
+#ifdef CORD_FLOW_POINT_LOG
+    CORD_LOG("[CordRingFlowPoint] attach_xBPF()\n");
+#endif
+    (void)self;
+    (void)filter;
+    (void)params;
+
+    return CORD_ERR_UNSUPPORTED;
+}
+
+void CordRingFlowPoint_ctor(CordRingFlowPoint * const self,
+                            uint8_t id,
+                            uint32_t count,
+                            cord_ring_mode_t mode)
+{
+#ifdef CORD_FLOW_POINT_LOG
+    CORD_LOG("[CordRingFlowPoint] ctor()\n");
+#endif
+    static const CordFlowPointVtbl vtbl = {
+        .rx = (cord_retval_t (*)(CordFlowPoint * const self, uint16_t queue_id, void *buffer, size_t len, ssize_t *rx_packets))&CordRingFlowPoint_rx_,
+        .tx = (cord_retval_t (*)(CordFlowPoint * const self, uint16_t queue_id, void *buffer, size_t len, ssize_t *tx_packets))&CordRingFlowPoint_tx_,
+        .attach_xBPF = (cord_retval_t (*)(CordFlowPoint * const self, void *filter, void *params))&CordRingFlowPoint_attach_xBPF_,
+        .cleanup = (void     (*)(CordFlowPoint * const self))&CordRingFlowPoint_dtor,
+    };
+
+    CordFlowPoint_ctor(&self->base, id);
+    self->base.vptr = &vtbl;
+    self->base.io_handle = -1;
+    self->params = NULL;
+
+    self->ring = cord_ring_create(count, mode);
+    if (!self->ring)
+    {
+        CORD_ERROR("[CordRingFlowPoint] cord_ring_create()");
+        CORD_EXIT(EXIT_FAILURE);
+    }
+}
+
+void CordRingFlowPoint_dtor(CordRingFlowPoint * const self)
+{
+#ifdef CORD_FLOW_POINT_LOG
+    CORD_LOG("[CordRingFlowPoint] dtor()\n");
+#endif
+    cord_ring_destroy(self->ring);
+    CordFlowPoint_release(&self->base);
+    free(self);
+}
@@ -3,6 +3,66 @@
 #include <flow_point/cord_xdp_flow_point.h>
 #include <cord_error.h>
 #include <string.h>
+#include <time.h>
+
+// Top the fill ring up from the socket's RX frame ring, one bulk alloc per batch
+static uint32_t cord_xdp_refill(struct cord_xdp_socket_info *xsk_info)
+{
+    uint64_t frames[CORD_XDP_FRAME_BATCH];
+    uint32_t stock_frames, filled = 0;
+    uint32_t idx_fq = 0;
+
+    stock_frames = xsk_prod_nb_free(&xsk_info->fq, cord_xdp_free_frames_rx_count(xsk_info));
+
+    while (filled < stock_frames)
+    {
+        uint32_t want = (stock_frames - filled < CORD_XDP_FRAME_BATCH) ? stock_frames - filled : CORD_XDP_FRAME_BATCH;
+        uint32_t got = cord_xdp_alloc_frames_rx(xsk_info, frames, want);
+        if (got == 0)
+            break;
+
+        uint32_t reserved = xsk_ring_prod__reserve(&xsk_info->fq, got, &idx_fq);
+        for (uint32_t i = 0; i < reserved; i++)
+            *xsk_ring_prod__fill_addr(&xsk_info->fq, idx_fq++) = frames[i];
+
+        xsk_ring_prod__submit(&xsk_info->fq, reserved);
+        filled += reserved;
+
+        if (reserved < got)
+        {
+            cord_xdp_free_frames_rx(xsk_info, frames + reserved, got - reserved);
+            break;
+        }
+    }
+
+    return filled;
+}
+
+// Reap the completion ring and return the frames to their owners in bulk
+static uint32_t cord_xdp_reap_completions(struct cord_xdp_socket_info *xsk_info)
+{
+    uint64_t addrs[CORD_XDP_FRAME_BATCH];
+    uint32_t idx_cq = 0;
+    uint32_t completed;
+
+    completed = xsk_ring_cons__peek(&xsk_info->cq, xsk_info->comp_ring_size, &idx_cq);
+    if (completed == 0)
+        return 0;
+
+    for (uint32_t i = 0; i < completed; i += CORD_XDP_FRAME_BATCH)
+    {
+        uint32_t n = (completed - i < CORD_XDP_FRAME_BATCH) ? completed - i : CORD_XDP_FRAME_BATCH;
+
+        for (uint32_t j = 0; j < n; j++)
+            addrs[j] = *xsk_ring_cons__comp_addr(&xsk_info->cq, idx_cq++);
+
+        cord_xdp_complete_frames(xsk_info, addrs, n);
+    }
+
+    xsk_ring_cons__release(&xsk_info->cq, completed);
+
+    return completed;
+}
 
 static cord_retval_t CordXdpFlowPoint_rx_(CordXdpFlowPoint * const self, uint16_t queue_id, void *buffer, size_t len, ssize_t *rx_packets)
 {
@@ -14,9 +74,9 @@ static cord_retval_t CordXdpFlowPoint_rx_(CordXdpFlowPoint * const self, uint16_
 
     struct cord_xdp_pkt_desc *pkt_descs = (struct cord_xdp_pkt_desc *)buffer;
     struct cord_xdp_socket_info *xsk_info = *(self->xsk_info);
-    uint32_t idx_rx = 0, idx_fq = 0;
-    uint32_t received, stock_frames;
-    int ret;
+    uint32_t idx_rx = 0;
+    uint32_t received;
+    uint64_t rx_bytes = 0;
 
     received = xsk_ring_cons__peek(&xsk_info->rx, len, &idx_rx);
 
@@ -29,83 +89,165 @@ static cord_retval_t CordXdpFlowPoint_rx_(CordXdpFlowPoint * const self, uint16_
             pkt_descs[i].len = rx_desc->len;
             pkt_descs[i].data = xsk_umem__get_data(xsk_info->umem_area, rx_desc->addr);
             pkt_descs[i].src_socket = xsk_info;
+            rx_bytes += rx_desc->len;
         }
 
         xsk_ring_cons__release(&xsk_info->rx, received);
     }
 
-    stock_frames = xsk_prod_nb_free(&xsk_info->fq, xsk_info->free_frames_rx);
-    if (stock_frames > 0)
-    {
-        ret = xsk_ring_prod__reserve(&xsk_info->fq, stock_frames, &idx_fq);
-        while ((uint32_t)ret != stock_frames)
-            ret = xsk_ring_prod__reserve(&xsk_info->fq, stock_frames, &idx_fq);
+    cord_xdp_refill(xsk_info);
 
-        for (uint32_t i = 0; i < stock_frames; i++)
-            *xsk_ring_prod__fill_addr(&xsk_info->fq, idx_fq++) = cord_xdp_alloc_frame_rx(xsk_info);
-
-        xsk_ring_prod__submit(&xsk_info->fq, stock_frames);
-    }
+    CordFlowPoint_count_rx(&self->base, xsk_info->queue_id, received, rx_bytes);
 
     *rx_packets = received;
     return CORD_OK;
 }
 
-static cord_retval_t CordXdpFlowPoint_tx_(CordXdpFlowPoint * const self, uint16_t queue_id, void *buffer, size_t len, ssize_t *tx_packets)
+// One pass over the TX ring: returns how many descriptors were posted (the first ones)
+static uint32_t cord_xdp_tx_burst(struct cord_xdp_socket_info *xsk_info, struct cord_xdp_pkt_desc *pkt_descs, uint32_t len)
 {
-#ifdef CORD_FLOW_POINT_LOG
-    CORD_LOG("[CordXdpFlowPoint] tx()\n");
-#endif
-
-    (void)queue_id;
+    uint64_t tx_frames[CORD_XDP_FRAME_BATCH];
+    uint32_t idx_tx = 0;
+    uint32_t ret, reserved;
+    uint32_t copies = 0, avail = 0, used = 0;
 
-    struct cord_xdp_pkt_desc *pkt_descs = (struct cord_xdp_pkt_desc *)buffer;
-    struct cord_xdp_socket_info *xsk_info = *(self->xsk_info);
-    uint32_t idx_tx = 0, idx_cq = 0;
-    uint32_t ret;
-    uint32_t completed;
+    cord_xdp_reap_completions(xsk_info);
 
-    completed = xsk_ring_cons__peek(&xsk_info->cq, xsk_info->comp_ring_size, &idx_cq);
-    if (completed > 0)
+    ret = xsk_ring_prod__reserve(&xsk_info->tx, len, &idx_tx);
+    if (ret == 0)
     {
-        for (uint32_t i = 0; i < completed; i++)
-            cord_xdp_free_frame_tx(xsk_info, *xsk_ring_cons__comp_addr(&xsk_info->cq, idx_cq++));
-
-        xsk_ring_cons__release(&xsk_info->cq, completed);
+        // Kick the kernel so the ring drains for the next attempt
+        sendto(xsk_socket__fd(xsk_info->xsk), NULL, 0, MSG_DONTWAIT, NULL, 0);
+        return 0;
     }
+    reserved = ret;
 
-    ret = xsk_ring_prod__reserve(&xsk_info->tx, len, &idx_tx);
-    if (ret == 0)
+    // TX frames are only needed for descriptors that have to be copied
+    for (uint32_t i = 0; i < ret; i++)
     {
-        *tx_packets = 0;
-        return CORD_OK;
+        if (!cord_xdp_same_umem(pkt_descs[i].src_socket, xsk_info))
+            copies++;
     }
 
     for (uint32_t i = 0; i < ret; i++)
     {
-        uint64_t tx_addr = cord_xdp_alloc_frame_tx(xsk_info);
-        if (tx_addr == UINT64_MAX)
+        struct xdp_desc *tx_desc;
+
+        if (cord_xdp_same_umem(pkt_descs[i].src_socket, xsk_info))
         {
-            ret = i;
-            break;
+            // Zero-copy: the RX frame itself goes out, and comes back through the completion ring
+            tx_desc = xsk_ring_prod__tx_desc(&xsk_info->tx, idx_tx++);
+            tx_desc->addr = (uint64_t)((uint8_t *)pkt_descs[i].data - (uint8_t *)xsk_info->umem_area);
+            tx_desc->len = pkt_descs[i].len;
+            continue;
+        }
+
+        if (used == avail)
+        {
+            avail = cord_xdp_alloc_frames_tx(xsk_info, tx_frames, (copies < CORD_XDP_FRAME_BATCH) ? copies : CORD_XDP_FRAME_BATCH);
+            used = 0;
+            if (avail == 0)
+            {
+                ret = i;
+                break;
+            }
         }
 
+        uint64_t tx_addr = tx_frames[used++];
+        copies--;
+
         memcpy(xsk_umem__get_data(xsk_info->umem_area, tx_addr),
                pkt_descs[i].data,
                pkt_descs[i].len);
 
-        cord_xdp_free_frame_rx(pkt_descs[i].src_socket, pkt_descs[i].addr);
+        if (pkt_descs[i].src_socket)
+            cord_xdp_free_frame_rx(pkt_descs[i].src_socket, pkt_descs[i].addr);
 
-        struct xdp_desc *tx_desc = xsk_ring_prod__tx_desc(&xsk_info->tx, idx_tx++);
+        tx_desc = xsk_ring_prod__tx_desc(&xsk_info->tx, idx_tx++);
         tx_desc->addr = tx_addr;
         tx_desc->len = pkt_descs[i].len;
     }
 
+    // Give back the reserved descriptors not used after running out of TX frames
+    if (ret < reserved)
+        xsk_info->tx.cached_prod -= reserved - ret;
+
     xsk_ring_prod__submit(&xsk_info->tx, ret);
 
     sendto(xsk_socket__fd(xsk_info->xsk), NULL, 0, MSG_DONTWAIT, NULL, 0);
 
-    *tx_packets = ret;
+    return ret;
+}
+
+// Bounded retries of the unsent tail; the frames of what is still left go back to their RX socket
+static uint32_t cord_xdp_tx_burst_retry(CordXdpFlowPoint * const self, struct cord_xdp_pkt_desc *pkt_descs, uint32_t count)
+{
+    struct cord_xdp_socket_info *xsk_info = *(self->xsk_info);
+    cord_xdp_tx_queue_t *txq = &self->tx_queue;
+    uint32_t sent = cord_xdp_tx_burst(xsk_info, pkt_descs, count);
+
+    uint64_t tx_bytes = 0;
+
+    for (uint16_t retry = 0; sent < count && retry < txq->max_retries; retry++)
+    {
+        sent += cord_xdp_tx_burst(xsk_info, pkt_descs + sent, count - sent);
+        CordFlowPoint_count_ring_full(&self->base, xsk_info->queue_id);
+    }
+
+    for (uint32_t i = sent; i < count; i++)
+    {
+        if (pkt_descs[i].src_socket)
+            cord_xdp_free_frame_rx(pkt_descs[i].src_socket, pkt_descs[i].addr);
+    }
+
+    for (uint32_t i = 0; i < sent; i++)
+        tx_bytes += pkt_descs[i].len;
+
+    CordFlowPoint_count_tx_dropped(&self->base, xsk_info->queue_id, count - sent);
+    CordFlowPoint_count_tx(&self->base, xsk_info->queue_id, sent, tx_bytes);
+
+    return sent;
+}
+
+static inline uint64_t cord_xdp_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static cord_retval_t CordXdpFlowPoint_tx_(CordXdpFlowPoint * const self, uint16_t queue_id, void *buffer, size_t len, ssize_t *tx_packets)
+{
+#ifdef CORD_FLOW_POINT_LOG
+    CORD_LOG("[CordXdpFlowPoint] tx()\n");
+#endif
+
+    (void)queue_id;
+
+    struct cord_xdp_pkt_desc *pkt_descs = (struct cord_xdp_pkt_desc *)buffer;
+    cord_xdp_tx_queue_t *txq = &self->tx_queue;
+
+    if (txq->threshold == 0)
+    {
+        *tx_packets = cord_xdp_tx_burst_retry(self, pkt_descs, len);
+        return CORD_OK;
+    }
+
+    // Buffered: the descriptors are accepted now and posted by a later flush
+    for (size_t i = 0; i < len; i++)
+    {
+        if (txq->count == 0)
+            txq->deadline_ns = cord_xdp_now_ns() + txq->timeout_ns;
+
+        txq->pkts[txq->count++] = pkt_descs[i];
+
+        if (txq->count >= txq->threshold)
+            CordXdpFlowPoint_tx_flush(self);
+    }
+
+    CordXdpFlowPoint_tx_flush_expired(self);
+
+    *tx_packets = len;
     return CORD_OK;
 }
 
@@ -114,9 +256,37 @@ static cord_retval_t CordXdpFlowPoint_attach_xBPF_(CordXdpFlowPoint * const self
 #ifdef CORD_FLOW_POINT_LOG
     CORD_LOG("[CordXdpFlowPoint] attach_xBPF()\n");
 #endif
-    //
-    // Implement the attach_xBPF logic
-    //
+    if (params != NULL)
+    {
+        // The params variable holds the filter type
+        cord_filter_type_t filter_type = *((cord_filter_type_t *)params);
+        if (filter_type == XDP_FILTER)
+        {
+            // The filter variable holds a (cord_xdp_prog_cfg_t *), NULL for the default steering program
+            struct cord_xdp_socket_info *xsk_info = *(self->xsk_info);
+
+            if (self->xdp_prog)
+                return CORD_ERR_ALREADY_EXISTS;
+
+            // Replace the libxdp default redirect program loaded with the socket
+            cord_xdp_prog_remove_xsk_default(xsk_info->ifindex);
+
+            self->xdp_prog = cord_xdp_prog_attach(xsk_info->ifindex, (const cord_xdp_prog_cfg_t *)filter);
+            if (!self->xdp_prog)
+                return CORD_ERR;
+
+            if (self->xdp_prog->xsks_map_fd >= 0 && cord_xdp_prog_register_socket(self->xdp_prog, xsk_info) != CORD_OK)
+            {
+                cord_xdp_prog_detach(self->xdp_prog);
+                self->xdp_prog = NULL;
+                return CORD_ERR;
+            }
+        }
+        else
+        {
+            return CORD_ERR_UNSUPPORTED;
+        }
+    }
 
     return CORD_OK;
 }
@@ -127,23 +297,7 @@ static cord_retval_t CordXdpFlowPoint_fill_(CordXdpFlowPoint * const self)
     CORD_LOG("[CordXdpFlowPoint] fill()\n");
 #endif
 
-    struct cord_xdp_socket_info *xsk_info = *(self->xsk_info);
-    uint32_t idx_fq = 0;
-    uint32_t stock_frames;
-    int ret;
-
-    stock_frames = xsk_prod_nb_free(&xsk_info->fq, xsk_info->free_frames_rx);
-    if (stock_frames == 0)
-        return CORD_OK;
-
-    ret = xsk_ring_prod__reserve(&xsk_info->fq, stock_frames, &idx_fq);
-    if (ret == 0)
-        return CORD_OK;
-
-    for (uint32_t i = 0; i < (uint32_t)ret; i++)
-        *xsk_ring_prod__fill_addr(&xsk_info->fq, idx_fq++) = cord_xdp_alloc_frame_rx(xsk_info);
-
-    xsk_ring_prod__submit(&xsk_info->fq, ret);
+    cord_xdp_refill(*(self->xsk_info));
 
     return CORD_OK;
 }
@@ -154,22 +308,60 @@ static cord_retval_t CordXdpFlowPoint_drain_completion_(CordXdpFlowPoint * const
     CORD_LOG("[CordXdpFlowPoint] drain_completion()\n");
 #endif
 
-    struct cord_xdp_socket_info *xsk_info = *(self->xsk_info);
-    uint32_t idx_cq = 0;
-    uint32_t completed;
+    cord_xdp_reap_completions(*(self->xsk_info));
 
-    completed = xsk_ring_cons__peek(&xsk_info->cq, xsk_info->comp_ring_size, &idx_cq);
-    if (completed == 0)
-        return CORD_OK;
+    return CORD_OK;
+}
 
-    for (uint32_t i = 0; i < completed; i++)
-        cord_xdp_free_frame_tx(xsk_info, *xsk_ring_cons__comp_addr(&xsk_info->cq, idx_cq++));
+//
+// TX buffering
+//
 
-    xsk_ring_cons__release(&xsk_info->cq, completed);
+cord_retval_t CordXdpFlowPoint_set_tx_buffer(CordXdpFlowPoint * const self, uint16_t threshold, uint32_t timeout_us, uint16_t max_retries)
+{
+    cord_xdp_tx_queue_t *txq = &self->tx_queue;
+
+    if (threshold > CORD_XDP_TX_BUFFER_MAX)
+        return CORD_ERR_INVALID_PARAM;
+
+    CordXdpFlowPoint_tx_flush(self);
+
+    if (threshold > 0 && !txq->pkts)
+    {
+        txq->pkts = calloc(CORD_XDP_TX_BUFFER_MAX, sizeof(struct cord_xdp_pkt_desc));
+        if (!txq->pkts)
+            return CORD_ERR_NO_MEMORY;
+    }
+
+    txq->threshold = threshold;
+    txq->max_retries = (max_retries == 0) ? CORD_XDP_TX_MAX_RETRIES : max_retries;
+    txq->timeout_ns = 1000ULL * ((timeout_us == 0) ? CORD_XDP_TX_TIMEOUT_US : timeout_us);
 
     return CORD_OK;
 }
 
+uint32_t CordXdpFlowPoint_tx_flush(CordXdpFlowPoint * const self)
+{
+    cord_xdp_tx_queue_t *txq = &self->tx_queue;
+    if (txq->count == 0)
+        return 0;
+
+    uint32_t sent = cord_xdp_tx_burst_retry(self, txq->pkts, txq->count);
+    txq->count = 0;
+    txq->tx_flushes++;
+
+    return sent;
+}
+
+uint32_t CordXdpFlowPoint_tx_flush_expired(CordXdpFlowPoint * const self)
+{
+    cord_xdp_tx_queue_t *txq = &self->tx_queue;
+    if (txq->count == 0 || cord_xdp_now_ns() < txq->deadline_ns)
+        return 0;
+
+    return CordXdpFlowPoint_tx_flush(self);
+}
+
 void CordXdpFlowPoint_ctor(CordXdpFlowPoint * const self,
                            uint8_t id,
                            struct cord_xdp_socket_info **xsk_info)
@@ -190,6 +382,12 @@ void CordXdpFlowPoint_ctor(CordXdpFlowPoint * const self,
     self->fill = &CordXdpFlowPoint_fill_;
     self->drain_completion = &CordXdpFlowPoint_drain_completion_;
     self->xsk_info = xsk_info;
+    self->xdp_prog = NULL;
+
+    // Unbuffered TX with retries until set_tx_buffer() is called
+    memset(&self->tx_queue, 0, sizeof(self->tx_queue));
+    self->tx_queue.max_retries = CORD_XDP_TX_MAX_RETRIES;
+    self->tx_queue.timeout_ns = 1000ULL * CORD_XDP_TX_TIMEOUT_US;
 
     self->base.io_handle = xsk_socket__fd((*xsk_info)->xsk);
 }
@@ -200,11 +398,24 @@ void CordXdpFlowPoint_dtor(CordXdpFlowPoint * const self)
     CORD_LOG("[CordXdpFlowPoint] dtor()\n");
 #endif
 
+    if (self->xsk_info && *(self->xsk_info))
+    {
+        CordXdpFlowPoint_tx_flush(self);
+    }
+
+    free(self->tx_queue.pkts);
+
+    if (self->xdp_prog)
+    {
+        cord_xdp_prog_detach(self->xdp_prog);
+    }
+
     if (self->xsk_info)
     {
         cord_xdp_socket_free(self->xsk_info);
     }
 
+    CordFlowPoint_release(&self->base);
     free(self);
 }
 
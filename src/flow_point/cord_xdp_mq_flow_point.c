@@ -0,0 +1,267 @@
+#ifdef ENABLE_XDP_DATAPLANE
+
+#include <flow_point/cord_xdp_mq_flow_point.h>
+#include <cord_error.h>
+#include <string.h>
+
+#define CORD_XDP_MQ_DEFAULT_FRAMES (2 * XSK_RING_PROD__DEFAULT_NUM_DESCS)
+
+// NUMA node of the NIC, CORD_NUMA_NODE_ANY if unknown (e.g. virtual devices)
+static int cord_xdp_mq_iface_numa_node(const char *ifname)
+{
+    char path[128];
+    int node = CORD_NUMA_NODE_ANY;
+
+    snprintf(path, sizeof(path), "/sys/class/net/%s/device/numa_node", ifname);
+
+    FILE *f = fopen(path, "r");
+    if (!f)
+        return CORD_NUMA_NODE_ANY;
+
+    if (fscanf(f, "%d", &node) != 1 || node < 0)
+        node = CORD_NUMA_NODE_ANY;
+
+    fclose(f);
+    return node;
+}
+
+static cord_retval_t CordXdpMqFlowPoint_rx_(CordXdpMqFlowPoint * const self, uint16_t queue_id, void *buffer, size_t len, ssize_t *rx_packets)
+{
+#ifdef CORD_FLOW_POINT_LOG
+    CORD_LOG("[CordXdpMqFlowPoint] rx()\n");
+#endif
+
+    if (cord_unlikely(queue_id >= self->queue_count))
+    {
+        *rx_packets = 0;
+        return CORD_ERR_INVALID_PARAM;
+    }
+
+    CordFlowPoint *queue = &self->queues[queue_id]->base;
+    return CORD_FLOW_POINT_RX_VCALL(queue, queue_id, buffer, len, rx_packets);
+}
+
+static cord_retval_t CordXdpMqFlowPoint_tx_(CordXdpMqFlowPoint * const self, uint16_t queue_id, void *buffer, size_t len, ssize_t *tx_packets)
+{
+#ifdef CORD_FLOW_POINT_LOG
+    CORD_LOG("[CordXdpMqFlowPoint] tx()\n");
+#endif
+
+    if (cord_unlikely(queue_id >= self->queue_count))
+    {
+        *tx_packets = 0;
+        return CORD_ERR_INVALID_PARAM;
+    }
+
+    CordFlowPoint *queue = &self->queues[queue_id]->base;
+    return CORD_FLOW_POINT_TX_VCALL(queue, queue_id, buffer, len, tx_packets);
+}
+
+static cord_retval_t CordXdpMqFlowPoint_attach_xBPF_(CordXdpMqFlowPoint * const self, void *filter, void *params)
+{
+#ifdef CORD_FLOW_POINT_LOG
+    CORD_LOG("[CordXdpMqFlowPoint] attach_xBPF()\n");
+#endif
+    if (params != NULL)
+    {
+        // The params variable holds the filter type
+        cord_filter_type_t filter_type = *((cord_filter_type_t *)params);
+        if (filter_type == XDP_FILTER)
+        {
+            // The filter variable holds a (cord_xdp_prog_cfg_t *), NULL for the default steering program
+            if (self->xdp_prog)
+                return CORD_ERR_ALREADY_EXISTS;
+
+            int ifindex = self->xsk_info[0]->ifindex;
+
+            // One program for the interface, replacing the libxdp default one
+            cord_xdp_prog_remove_xsk_default(ifindex);
+
+            self->xdp_prog = cord_xdp_prog_attach(ifindex, (const cord_xdp_prog_cfg_t *)filter);
+            if (!self->xdp_prog)
+                return CORD_ERR;
+
+            if (self->xdp_prog->xsks_map_fd < 0)
+                return CORD_OK;
+
+            for (uint16_t q = 0; q < self->queue_count; q++)
+            {
+                if (cord_xdp_prog_register_socket(self->xdp_prog, self->xsk_info[q]) != CORD_OK)
+                {
+                    cord_xdp_prog_detach(self->xdp_prog);
+                    self->xdp_prog = NULL;
+                    return CORD_ERR;
+                }
+            }
+        }
+        else
+        {
+            return CORD_ERR_UNSUPPORTED;
+        }
+    }
+
+    return CORD_OK;
+}
+
+static cord_retval_t CordXdpMqFlowPoint_fill_(CordXdpMqFlowPoint * const self, uint16_t queue_id)
+{
+    if (queue_id >= self->queue_count)
+        return CORD_ERR_INVALID_PARAM;
+
+    return CordXdpFlowPoint_fill_vcall(self->queues[queue_id]);
+}
+
+static cord_retval_t CordXdpMqFlowPoint_drain_completion_(CordXdpMqFlowPoint * const self, uint16_t queue_id)
+{
+    if (queue_id >= self->queue_count)
+        return CORD_ERR_INVALID_PARAM;
+
+    return CordXdpFlowPoint_drain_completion_vcall(self->queues[queue_id]);
+}
+
+cord_retval_t CordXdpMqFlowPoint_set_tx_buffer(CordXdpMqFlowPoint * const self, uint16_t threshold, uint32_t timeout_us, uint16_t max_retries)
+{
+    for (uint16_t q = 0; q < self->queue_count; q++)
+    {
+        cord_retval_t ret = CordXdpFlowPoint_set_tx_buffer(self->queues[q], threshold, timeout_us, max_retries);
+        if (ret != CORD_OK)
+            return ret;
+    }
+
+    return CORD_OK;
+}
+
+void CordXdpMqFlowPoint_ctor(CordXdpMqFlowPoint * const self,
+                             uint8_t id,
+                             const char *ifname,
+                             uint16_t queue_count,
+                             uint32_t num_frames,
+                             bool shared_umem)
+{
+#ifdef CORD_FLOW_POINT_LOG
+    CORD_LOG("[CordXdpMqFlowPoint] ctor()\n");
+#endif
+
+    static const CordFlowPointVtbl vtbl = {
+        .rx = (cord_retval_t (*)(CordFlowPoint * const self, uint16_t queue_id, void *buffer, size_t len, ssize_t *rx_packets))&CordXdpMqFlowPoint_rx_,
+        .tx = (cord_retval_t (*)(CordFlowPoint * const self, uint16_t queue_id, void *buffer, size_t len, ssize_t *tx_packets))&CordXdpMqFlowPoint_tx_,
+        .attach_xBPF = (cord_retval_t (*)(CordFlowPoint * const self, void *filter, void *params))&CordXdpMqFlowPoint_attach_xBPF_,
+        .cleanup = (void     (*)(CordFlowPoint * const self))&CordXdpMqFlowPoint_dtor,
+    };
+
+    CordFlowPoint_ctor(&self->base, id);
+    self->base.vptr = &vtbl;
+    self->fill = &CordXdpMqFlowPoint_fill_;
+    self->drain_completion = &CordXdpMqFlowPoint_drain_completion_;
+
+    if (queue_count == 0 || queue_count > CORD_XDP_MQ_MAX_QUEUES)
+    {
+        CORD_LOG("[CordXdpMqFlowPoint] Invalid queue count %u (max %u)\n", queue_count, CORD_XDP_MQ_MAX_QUEUES);
+        CORD_EXIT(EXIT_FAILURE);
+    }
+
+    // Half of the frames feed RX, which must cover the whole fill ring
+    if (num_frames < CORD_XDP_MQ_DEFAULT_FRAMES)
+        num_frames = CORD_XDP_MQ_DEFAULT_FRAMES;
+
+    memset(self->queues, 0, sizeof(self->queues));
+    self->ifname = ifname;
+    self->queue_count = queue_count;
+    self->num_frames = num_frames;
+    self->shared_umem = shared_umem;
+    self->socket_id = cord_xdp_mq_iface_numa_node(ifname);
+    self->xdp_prog = NULL;
+    self->params = NULL;
+
+    self->xsk_info = calloc(queue_count, sizeof(struct cord_xdp_socket_info *));
+    if (!self->xsk_info)
+    {
+        CORD_ERROR("[CordXdpMqFlowPoint] calloc");
+        CORD_EXIT(EXIT_FAILURE);
+    }
+
+    const uint32_t frame_size = XSK_UMEM__DEFAULT_FRAME_SIZE;
+    const uint64_t slice_size = (uint64_t)num_frames * frame_size;
+
+    for (uint16_t q = 0; q < queue_count; q++)
+    {
+        struct cord_xdp_socket_info *xsk = cord_xdp_socket_alloc_socket(ifname, q, num_frames, frame_size,
+                                                                       XSK_RING_CONS__DEFAULT_NUM_DESCS,
+                                                                       XSK_RING_PROD__DEFAULT_NUM_DESCS,
+                                                                       XSK_RING_PROD__DEFAULT_NUM_DESCS,
+                                                                       XSK_RING_CONS__DEFAULT_NUM_DESCS,
+                                                                       self->socket_id);
+        if (!xsk)
+        {
+            CORD_EXIT(EXIT_FAILURE);
+        }
+
+        self->xsk_info[q] = xsk;
+
+        if (shared_umem && q > 0)
+        {
+            // Queue q uses frames [q * num_frames, (q + 1) * num_frames) of queue 0's UMEM
+            xsk->umem_offset = q * slice_size;
+            cord_xdp_socket_init_shared(&self->xsk_info[q], &self->xsk_info[0]);
+        }
+        else
+        {
+            if (shared_umem)
+                xsk->umem_size = queue_count * slice_size;
+
+            cord_xdp_socket_init(&self->xsk_info[q]);
+        }
+
+        if (!xsk->xsk)
+        {
+            CORD_LOG("[CordXdpMqFlowPoint] Failed to create the XSK of %s queue %u\n", ifname, q);
+            CORD_EXIT(EXIT_FAILURE);
+        }
+
+        self->queues[q] = (CordXdpFlowPoint *) NEW_ON_HEAP(CordXdpFlowPoint, id, &self->xsk_info[q]);
+
+        // Every queue counts into its own block of the multi-queue flow point
+        CordFlowPoint_share_stats(&self->queues[q]->base, &self->base);
+    }
+
+    self->base.io_handle = self->queues[0]->base.io_handle;
+
+    for (uint16_t q = 1; q < queue_count && q <= MAX_AUX_HANDLE_COUNT; q++)
+        self->base.aux_handles[q - 1] = self->queues[q]->base.io_handle;
+}
+
+void CordXdpMqFlowPoint_dtor(CordXdpMqFlowPoint * const self)
+{
+#ifdef CORD_FLOW_POINT_LOG
+    CORD_LOG("[CordXdpMqFlowPoint] dtor()\n");
+#endif
+
+    if (self->xdp_prog)
+    {
+        cord_xdp_prog_detach(self->xdp_prog);
+        self->xdp_prog = NULL;
+    }
+
+    // Flush every queue first: dropped descriptors may return frames to another queue's socket
+    for (uint16_t q = 0; q < self->queue_count; q++)
+    {
+        if (self->queues[q])
+            CordXdpFlowPoint_tx_flush(self->queues[q]);
+    }
+
+    // Reverse order: sockets sharing queue 0's UMEM go before its owner
+    for (int q = (int)self->queue_count - 1; q >= 0; q--)
+    {
+        if (self->queues[q])
+        {
+            CordXdpFlowPoint_dtor(self->queues[q]);
+            self->queues[q] = NULL;
+        }
+    }
+
+    free(self->xsk_info);
+    CordFlowPoint_release(&self->base);
+    free(self);
+}
+
+#endif
@@ -0,0 +1,200 @@
+#include <memory/cord_arena.h>
+#include <cord_error.h>
+#include <stdlib.h>
+#include <string.h>
+
+static inline void cord_arena_lock(cord_arena_t *arena)
+{
+    while (atomic_flag_test_and_set_explicit(&arena->lock, memory_order_acquire))
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        __asm__ __volatile__("yield");
+#endif
+    }
+}
+
+static inline void cord_arena_unlock(cord_arena_t *arena)
+{
+    atomic_flag_clear_explicit(&arena->lock, memory_order_release);
+}
+
+static cord_arena_chunk_t *cord_arena_add_chunk(cord_arena_t *arena, size_t size)
+{
+    cord_arena_chunk_t *chunk = calloc(1, sizeof(cord_arena_chunk_t));
+    if (!chunk)
+    {
+        return NULL;
+    }
+
+    chunk->size = (size + arena->page_size - 1) / arena->page_size * arena->page_size;
+    chunk->base = cord_map_hugepage(chunk->size, arena->page_size, arena->numa_node, &chunk->backing_page_size);
+    if (!chunk->base)
+    {
+        free(chunk);
+        return NULL;
+    }
+
+    chunk->next = arena->chunks;
+    arena->chunks = chunk;
+    arena->mapped_bytes += chunk->size;
+    arena->num_chunks++;
+
+    return chunk;
+}
+
+//
+// Arena Create/Destroy
+//
+
+cord_arena_t *cord_arena_create(size_t chunk_size, size_t page_size, int numa_node)
+{
+    if (page_size != CORD_HUGE_PAGE_2MB && page_size != CORD_HUGE_PAGE_1GB)
+    {
+        return NULL;
+    }
+
+    if (numa_node != CORD_NUMA_NODE_ANY && (numa_node < 0 || numa_node >= CORD_NUMA_MAX_NODES))
+    {
+        return NULL;
+    }
+
+    cord_arena_t *arena = calloc(1, sizeof(cord_arena_t));
+    if (!arena)
+    {
+        return NULL;
+    }
+
+    atomic_flag_clear(&arena->lock);
+    arena->page_size = page_size;
+    arena->chunk_size = (chunk_size == 0) ? page_size : chunk_size;
+    arena->numa_node = numa_node;
+
+    // Map the first chunk up front so creation fails early
+    if (!cord_arena_add_chunk(arena, arena->chunk_size))
+    {
+        free(arena);
+        return NULL;
+    }
+
+    return arena;
+}
+
+void cord_arena_destroy(cord_arena_t *arena)
+{
+    if (!arena)
+    {
+        return;
+    }
+
+    cord_arena_chunk_t *chunk = arena->chunks;
+    while (chunk)
+    {
+        cord_arena_chunk_t *next = chunk->next;
+        cord_unmap_hugepage(chunk->base, chunk->size);
+        free(chunk);
+        chunk = next;
+    }
+
+    free(arena);
+}
+
+//
+// Allocation
+//
+
+void *cord_arena_alloc(cord_arena_t *arena, size_t size, size_t align)
+{
+    if (!arena || size == 0 || (align & (align - 1)) != 0)
+    {
+        return NULL;
+    }
+
+    if (align < CORD_ARENA_MIN_ALIGN)
+    {
+        align = CORD_ARENA_MIN_ALIGN;
+    }
+
+    cord_arena_lock(arena);
+
+    void *ptr = NULL;
+    for (cord_arena_chunk_t *chunk = arena->chunks; chunk; chunk = chunk->next)
+    {
+        size_t offset = (chunk->used + align - 1) & ~(align - 1);
+        if (offset <= chunk->size && size <= chunk->size - offset)
+        {
+            ptr = chunk->base + offset;
+            chunk->used = offset + size;
+            break;
+        }
+    }
+
+    if (!ptr)
+    {
+        // Mapping bases are page aligned, so any align up to the page size holds at offset 0
+        cord_arena_chunk_t *chunk = (align <= arena->page_size) ?
+            cord_arena_add_chunk(arena, (size > arena->chunk_size) ? size : arena->chunk_size) : NULL;
+        if (chunk)
+        {
+            ptr = chunk->base;
+            chunk->used = size;
+        }
+    }
+
+    if (ptr)
+    {
+        arena->used_bytes += size;
+        arena->num_allocs++;
+    }
+
+    cord_arena_unlock(arena);
+
+    return ptr;
+}
+
+bool cord_arena_owns(const cord_arena_t *arena, const void *ptr)
+{
+    if (!arena || !ptr)
+    {
+        return false;
+    }
+
+    const uint8_t *p = (const uint8_t *)ptr;
+    for (const cord_arena_chunk_t *chunk = arena->chunks; chunk; chunk = chunk->next)
+    {
+        if (p >= chunk->base && p < chunk->base + chunk->size)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//
+// Statistics
+//
+
+void cord_arena_print_stats(const cord_arena_t *arena)
+{
+    if (!arena)
+    {
+        return;
+    }
+
+    CORD_LOG("=== Arena Statistics ===\n");
+    CORD_LOG("NUMA node:        %d\n", arena->numa_node);
+    CORD_LOG("Chunks:           %u\n", arena->num_chunks);
+    CORD_LOG("Mapped:           %zu bytes\n", arena->mapped_bytes);
+    CORD_LOG("Used:             %zu bytes\n", arena->used_bytes);
+    CORD_LOG("Allocations:      %u\n", arena->num_allocs);
+
+    for (const cord_arena_chunk_t *chunk = arena->chunks; chunk; chunk = chunk->next)
+    {
+        CORD_LOG("  Chunk %p:  %zu / %zu bytes (%zu KB pages)\n",
+                 (void *)chunk->base, chunk->used, chunk->size, chunk->backing_page_size / 1024);
+    }
+
+    CORD_LOG("========================\n");
+}
@@ -1,4 +1,5 @@
 #include <memory/cord_memory.h>
+#include <memory/cord_ring.h>
 #include <cord_error.h>
 #include <stdlib.h>
 #include <string.h>
@@ -10,56 +11,245 @@
 #include <linux/if_ether.h>
 #include <net/if.h>
 #include <sys/socket.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+#include <sched.h>
 
-// Huge page allocation with fallback to calloc
-void *cord_alloc_hugepage(size_t size)
+//
+// NUMA placement
+//
+
+int cord_numa_bind(void *addr, size_t len, int numa_node)
 {
-    if (size == 0)
+    if (numa_node == CORD_NUMA_NODE_ANY)
+    {
+        return 0;
+    }
+
+    if (!addr || numa_node < 0 || numa_node >= CORD_NUMA_MAX_NODES)
+    {
+        return -1;
+    }
+
+    unsigned long nodemask[CORD_NUMA_MAX_NODES / (8 * sizeof(unsigned long))] = {0};
+    nodemask[numa_node / (8 * sizeof(unsigned long))] = 1UL << (numa_node % (8 * sizeof(unsigned long)));
+
+    // Preferred rather than strict: a node without free huge pages must not SIGBUS on fault
+    if (syscall(SYS_mbind, addr, len, MPOL_PREFERRED, nodemask, CORD_NUMA_MAX_NODES + 1, 0) != 0)
+    {
+        CORD_ERROR("[cord_numa_bind] mbind");
+        return -1;
+    }
+
+    return 0;
+}
+
+int cord_numa_set_preferred(int numa_node)
+{
+    if (numa_node == CORD_NUMA_NODE_ANY)
+    {
+        return (syscall(SYS_set_mempolicy, MPOL_DEFAULT, NULL, 0) == 0) ? 0 : -1;
+    }
+
+    if (numa_node < 0 || numa_node >= CORD_NUMA_MAX_NODES)
+    {
+        return -1;
+    }
+
+    unsigned long nodemask[CORD_NUMA_MAX_NODES / (8 * sizeof(unsigned long))] = {0};
+    nodemask[numa_node / (8 * sizeof(unsigned long))] = 1UL << (numa_node % (8 * sizeof(unsigned long)));
+
+    if (syscall(SYS_set_mempolicy, MPOL_PREFERRED, nodemask, CORD_NUMA_MAX_NODES + 1) != 0)
+    {
+        CORD_ERROR("[cord_numa_set_preferred] set_mempolicy");
+        return -1;
+    }
+
+    return 0;
+}
+
+int cord_numa_policy_save(cord_numa_policy_t *policy)
+{
+    if (!policy)
+    {
+        return -1;
+    }
+
+    memset(policy, 0, sizeof(*policy));
+
+    // Fails with EINVAL if the kernel knows more nodes than the mask holds
+    if (syscall(SYS_get_mempolicy, &policy->mode, policy->nodemask, CORD_NUMA_MAX_NODES, NULL, 0UL) != 0)
+    {
+        CORD_ERROR("[cord_numa_policy_save] get_mempolicy");
+        return -1;
+    }
+
+    return 0;
+}
+
+int cord_numa_policy_restore(const cord_numa_policy_t *policy)
+{
+    if (!policy)
+    {
+        return -1;
+    }
+
+    // The mode carries the MPOL_F_* mode flags get_mempolicy() reported
+    if (syscall(SYS_set_mempolicy, policy->mode, policy->nodemask, CORD_NUMA_MAX_NODES + 1) != 0)
+    {
+        CORD_ERROR("[cord_numa_policy_restore] set_mempolicy");
+        return -1;
+    }
+
+    return 0;
+}
+
+int cord_numa_node_self(void)
+{
+    unsigned int cpu = 0;
+    unsigned int node = 0;
+
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) != 0 || node >= CORD_NUMA_MAX_NODES)
+    {
+        return 0;
+    }
+
+    return (int)node;
+}
+
+int cord_numa_num_nodes(void)
+{
+    // Node list such as "0" or "0-1": the last number is the highest online node
+    FILE *f = fopen("/sys/devices/system/node/online", "r");
+    if (!f)
+    {
+        return 1;
+    }
+
+    char buf[256];
+    int num_nodes = 1;
+
+    if (fgets(buf, sizeof(buf), f))
+    {
+        char *p = buf + strcspn(buf, "\n");
+        while (p > buf && (p[-1] >= '0' && p[-1] <= '9'))
+        {
+            p--;
+        }
+
+        num_nodes = atoi(p) + 1;
+    }
+
+    fclose(f);
+
+    if (num_nodes < 1 || num_nodes > CORD_NUMA_MAX_NODES)
+    {
+        num_nodes = (num_nodes < 1) ? 1 : CORD_NUMA_MAX_NODES;
+    }
+
+    return num_nodes;
+}
+
+//
+// Huge page mappings
+//
+
+static inline void *cord_mmap_anon(size_t size, int flags)
+{
+    void *ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+    return (ptr == MAP_FAILED) ? NULL : ptr;
+}
+
+void *cord_map_hugepage(size_t size, size_t page_size, int numa_node, size_t *backing_page_size)
+{
+    if (size == 0 || (page_size != CORD_HUGE_PAGE_2MB && page_size != CORD_HUGE_PAGE_1GB) || size % page_size != 0)
     {
         return NULL;
     }
 
-    // Align size to huge page boundary
-    size_t aligned_size = CORD_ALIGN_TO_HUGE_PAGE(size);
+    // Pages are faulted in only after the NUMA policy is set
+    int populate = (numa_node == CORD_NUMA_NODE_ANY) ? MAP_POPULATE : 0;
+    size_t backing = page_size;
 
-    // Try to allocate using huge pages
-    void *ptr = mmap(NULL, aligned_size, PROT_READ | PROT_WRITE,
-                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE, -1, 0);
+    void *ptr = cord_mmap_anon(size, MAP_HUGETLB | (__builtin_ctzl(page_size) << MAP_HUGE_SHIFT) | populate);
 
-    if (ptr != MAP_FAILED)
+    if (!ptr && page_size == CORD_HUGE_PAGE_1GB)
     {
-        // Success with huge pages
-        return ptr;
+        backing = CORD_HUGE_PAGE_2MB;
+        ptr = cord_mmap_anon(size, MAP_HUGETLB | (__builtin_ctzl(CORD_HUGE_PAGE_2MB) << MAP_HUGE_SHIFT) | populate);
     }
 
-    // Huge page allocation failed, fall back to calloc
-    ptr = calloc(1, size);
     if (!ptr)
     {
-        CORD_ERROR("[cord_alloc_hugepage] calloc fallback failed");
-        return NULL;
+        // No reserved huge pages: regular pages, asking for transparent huge pages
+        backing = CORD_PAGE_SIZE;
+        ptr = cord_mmap_anon(size, 0);
+        if (!ptr)
+        {
+            CORD_ERROR("[cord_map_hugepage] mmap");
+            return NULL;
+        }
+        madvise(ptr, size, MADV_HUGEPAGE);
+        populate = 0;
+    }
+
+    cord_numa_bind(ptr, size, numa_node);
+
+    if (!populate)
+    {
+        // Prefault so the data path never takes a page fault
+        for (size_t off = 0; off < size; off += backing)
+        {
+            ((volatile uint8_t *)ptr)[off] = 0;
+        }
+    }
+
+    if (backing_page_size)
+    {
+        *backing_page_size = backing;
     }
 
     return ptr;
 }
 
-void cord_free_hugepage(void *ptr, size_t size)
+void cord_unmap_hugepage(void *ptr, size_t size)
 {
     if (!ptr || size == 0)
     {
         return;
     }
 
-    // Try to determine if this was allocated with mmap or calloc
-    // We'll attempt munmap first - if it fails, we'll use free
-    size_t aligned_size = CORD_ALIGN_TO_HUGE_PAGE(size);
+    if (munmap(ptr, size) != 0)
+    {
+        CORD_ERROR("[cord_unmap_hugepage] munmap");
+    }
+}
 
-    if (munmap(ptr, aligned_size) == -1)
+// Huge page allocation; every path is an anonymous mapping of the rounded size,
+// so cord_free_hugepage() always releases it with munmap()
+void *cord_alloc_hugepage(size_t size)
+{
+    return cord_alloc_hugepage_node(size, CORD_NUMA_NODE_ANY);
+}
+
+void *cord_alloc_hugepage_node(size_t size, int numa_node)
+{
+    if (size == 0)
     {
-        // munmap failed, this was likely allocated with calloc
-        free(ptr);
+        return NULL;
     }
-    // If munmap succeeded, we're done (it was huge page allocation)
+
+    return cord_map_hugepage(CORD_ALIGN_TO_HUGE_PAGE(size), CORD_HUGE_PAGE_SIZE, numa_node, NULL);
+}
+
+void cord_free_hugepage(void *ptr, size_t size)
+{
+    if (!ptr || size == 0)
+    {
+        return;
+    }
+
+    cord_unmap_hugepage(ptr, CORD_ALIGN_TO_HUGE_PAGE(size));
 }
 
 #ifdef ENABLE_DPDK_DATAPLANE
@@ -90,6 +280,21 @@ void cord_pktmbuf_mpool_free(struct rte_mempool **mbuf_pool)
 
 struct cord_tpacketv3_ring *cord_tpacketv3_ring_alloc(uint32_t block_size, uint32_t frame_size, uint32_t block_num)
 {
+    return cord_tpacketv3_ring_alloc_socket(block_size, frame_size, block_num, cord_numa_node_self());
+}
+
+// socket_id selects the node the kernel allocates the ring blocks on (at PACKET_RX_RING time)
+struct cord_tpacketv3_ring *cord_tpacketv3_ring_alloc_socket(uint32_t block_size, uint32_t frame_size, uint32_t block_num,
+                                                             int socket_id)
+{
+    // The kernel takes the ring size as 32-bit frame and block counts
+    uint64_t ring_bytes = (uint64_t)block_size * block_num;
+    if (frame_size == 0 || ring_bytes / frame_size > UINT32_MAX)
+    {
+        CORD_LOG("[cord_tpacketv3_ring_alloc] Invalid ring geometry\n");
+        return NULL;
+    }
+
     struct cord_tpacketv3_ring *ring = calloc(1, sizeof(struct cord_tpacketv3_ring));
     if (ring == NULL)
     {
@@ -97,11 +302,13 @@ struct cord_tpacketv3_ring *cord_tpacketv3_ring_alloc(uint32_t block_size, uint3
         return NULL;
     }
 
+    ring->socket_id = socket_id;
+
     memset(&ring->req, 0, sizeof(ring->req));
     ring->req.tp_block_size = block_size;
     ring->req.tp_frame_size = frame_size;
     ring->req.tp_block_nr = block_num;
-    ring->req.tp_frame_nr = (block_size * block_num) / frame_size;
+    ring->req.tp_frame_nr = (uint32_t)(ring_bytes / frame_size);
     ring->req.tp_retire_blk_tov = 1;
     ring->req.tp_feature_req_word = TP_FT_REQ_FILL_RXHASH;
 
@@ -177,6 +384,22 @@ struct cord_xdp_socket_info *cord_xdp_socket_alloc(const char *ifname, uint16_t
                                                    uint32_t frame_size, uint16_t rx_ring_size, uint16_t tx_ring_size,
                                                    uint16_t fill_ring_size, uint16_t comp_ring_size)
 {
+    return cord_xdp_socket_alloc_socket(ifname, queue_id, num_frames, frame_size, rx_ring_size, tx_ring_size,
+                                        fill_ring_size, comp_ring_size, cord_numa_node_self());
+}
+
+struct cord_xdp_socket_info *cord_xdp_socket_alloc_socket(const char *ifname, uint16_t queue_id, uint32_t num_frames,
+                                                          uint32_t frame_size, uint16_t rx_ring_size, uint16_t tx_ring_size,
+                                                          uint16_t fill_ring_size, uint16_t comp_ring_size, int socket_id)
+{
+    // Both factors are 32-bit: multiply in 64 bits, the UMEM can exceed 4 GiB
+    uint64_t umem_size = (uint64_t)num_frames * frame_size;
+    if (num_frames == 0 || frame_size == 0 || umem_size > SIZE_MAX)
+    {
+        CORD_LOG("[cord_xdp_socket_alloc] Invalid UMEM geometry\n");
+        return NULL;
+    }
+
     struct cord_xdp_socket_info *xsk_info = calloc(1, sizeof(struct cord_xdp_socket_info));
     if (xsk_info == NULL)
     {
@@ -185,6 +408,7 @@ struct cord_xdp_socket_info *cord_xdp_socket_alloc(const char *ifname, uint16_t
     }
 
     xsk_info->ifname = ifname;
+    xsk_info->socket_id = socket_id;
     xsk_info->queue_id = queue_id;
     xsk_info->num_frames = num_frames;
     xsk_info->frame_size = frame_size;
@@ -192,7 +416,7 @@ struct cord_xdp_socket_info *cord_xdp_socket_alloc(const char *ifname, uint16_t
     xsk_info->tx_ring_size = tx_ring_size;
     xsk_info->fill_ring_size = fill_ring_size;
     xsk_info->comp_ring_size = comp_ring_size;
-    xsk_info->umem_size = num_frames * frame_size;
+    xsk_info->umem_size = (size_t)umem_size;
     xsk_info->ifindex = if_nametoindex(ifname);
 
     if (xsk_info->ifindex == 0)
@@ -210,161 +434,272 @@ void cord_xdp_socket_init(struct cord_xdp_socket_info **xsk_info)
     cord_xdp_socket_init_shared(xsk_info, NULL);
 }
 
+//
+// UMEM frame ring
+//
+
+struct cord_xdp_frame_ring *cord_xdp_frame_ring_create(uint32_t capacity)
+{
+    uint32_t size = 1;
+    while (size < capacity)
+        size <<= 1;
+
+    size_t bytes = CORD_ALIGN_TO_CACHE_LINE(sizeof(struct cord_xdp_frame_ring) + (size_t)size * sizeof(uint64_t));
+    struct cord_xdp_frame_ring *ring = aligned_alloc(CORD_CACHE_LINE_SIZE, bytes);
+    if (!ring)
+        return NULL;
+
+    atomic_init(&ring->prod_head, 0);
+    atomic_init(&ring->prod_tail, 0);
+    atomic_init(&ring->cons_head, 0);
+    atomic_init(&ring->cons_tail, 0);
+    ring->capacity = size;
+    ring->mask = size - 1;
+
+    return ring;
+}
+
+void cord_xdp_frame_ring_destroy(struct cord_xdp_frame_ring *ring)
+{
+    free(ring);
+}
+
+uint32_t cord_xdp_frame_ring_enqueue_burst(struct cord_xdp_frame_ring *ring, const uint64_t *frames, uint32_t count)
+{
+    uint32_t head;
+    uint32_t n = cord_ring_move_head(&ring->prod_head, &ring->cons_tail, ring->capacity, count, false, &head);
+
+    if (n == 0)
+        return 0;
+
+    for (uint32_t i = 0; i < n; i++)
+        ring->frames[(head + i) & ring->mask] = frames[i];
+
+    cord_ring_publish_tail(&ring->prod_tail, head, head + n);
+
+    return n;
+}
+
+uint32_t cord_xdp_frame_ring_dequeue_burst(struct cord_xdp_frame_ring *ring, uint64_t *frames, uint32_t count)
+{
+    uint32_t head;
+    uint32_t n = cord_ring_move_head(&ring->cons_head, &ring->prod_tail, 0, count, false, &head);
+
+    if (n == 0)
+        return 0;
+
+    for (uint32_t i = 0; i < n; i++)
+        frames[i] = ring->frames[(head + i) & ring->mask];
+
+    cord_ring_publish_tail(&ring->cons_tail, head, head + n);
+
+    return n;
+}
+
+static void cord_xdp_frame_ring_seed(struct cord_xdp_frame_ring *ring, uint64_t base, uint32_t count, uint32_t frame_size)
+{
+    uint64_t frames[CORD_XDP_FRAME_BATCH];
+
+    for (uint32_t i = 0; i < count; i += CORD_XDP_FRAME_BATCH)
+    {
+        uint32_t n = (count - i < CORD_XDP_FRAME_BATCH) ? count - i : CORD_XDP_FRAME_BATCH;
+
+        for (uint32_t j = 0; j < n; j++)
+            frames[j] = base + (uint64_t)(i + j) * frame_size;
+
+        cord_xdp_frame_ring_enqueue_burst(ring, frames, n);
+    }
+}
+
+// Split the socket's UMEM slice into RX / TX frame rings and post RX frames to the fill ring
+static int cord_xdp_socket_frames_init(struct cord_xdp_socket_info *xsk_info)
+{
+    uint32_t rx_frames = xsk_info->num_frames / 2;
+    uint32_t tx_frames = xsk_info->num_frames - rx_frames;
+    uint64_t frames[CORD_XDP_FRAME_BATCH];
+    uint32_t idx;
+
+    xsk_info->umem_frames_rx = cord_xdp_frame_ring_create(rx_frames);
+    xsk_info->umem_frames_tx = cord_xdp_frame_ring_create(tx_frames);
+
+    if (!xsk_info->umem_frames_rx || !xsk_info->umem_frames_tx)
+    {
+        CORD_ERROR("[cord_xdp_socket_init] cord_xdp_frame_ring_create");
+        goto err;
+    }
+
+    for (uint32_t i = 0; i < xsk_info->num_frames; i++)
+        xsk_info->frame_owner[xsk_info->umem_offset / xsk_info->frame_size + i] = xsk_info;
+
+    // Lower half of the slice is the RX pool, upper half the TX pool (see cord_xdp_complete_frame)
+    cord_xdp_frame_ring_seed(xsk_info->umem_frames_rx, xsk_info->umem_offset, rx_frames, xsk_info->frame_size);
+    cord_xdp_frame_ring_seed(xsk_info->umem_frames_tx,
+                             xsk_info->umem_offset + (uint64_t)rx_frames * xsk_info->frame_size,
+                             tx_frames, xsk_info->frame_size);
+
+    uint32_t fill = (rx_frames < xsk_info->fill_ring_size) ? rx_frames : xsk_info->fill_ring_size;
+
+    if (xsk_ring_prod__reserve(&xsk_info->fq, fill, &idx) != fill)
+    {
+        CORD_ERROR("[cord_xdp_socket_init] xsk_ring_prod__reserve(fq)");
+        goto err;
+    }
+
+    for (uint32_t i = 0; i < fill; i += CORD_XDP_FRAME_BATCH)
+    {
+        uint32_t n = cord_xdp_alloc_frames_rx(xsk_info, frames, (fill - i < CORD_XDP_FRAME_BATCH) ? fill - i : CORD_XDP_FRAME_BATCH);
+
+        for (uint32_t j = 0; j < n; j++)
+            *xsk_ring_prod__fill_addr(&xsk_info->fq, idx++) = frames[j];
+    }
+
+    xsk_ring_prod__submit(&xsk_info->fq, fill);
+
+    return 0;
+
+err:
+    cord_xdp_frame_ring_destroy(xsk_info->umem_frames_rx);
+    cord_xdp_frame_ring_destroy(xsk_info->umem_frames_tx);
+    xsk_info->umem_frames_rx = NULL;
+    xsk_info->umem_frames_tx = NULL;
+    return -1;
+}
+
+// Zero-copy first, then copy mode, then generic (SKB) XDP
+static int cord_xdp_socket_create(struct cord_xdp_socket_info *xsk_info, struct xsk_socket_config *xsk_cfg, bool shared)
+{
+    int ret = -1;
+
+    for (int attempt = 0; attempt < 3; attempt++)
+    {
+        if (attempt == 1)
+        {
+            xsk_cfg->bind_flags = XDP_USE_NEED_WAKEUP | XDP_COPY;
+        }
+        else if (attempt == 2)
+        {
+            xsk_cfg->xdp_flags = XDP_FLAGS_UPDATE_IF_NOEXIST | XDP_FLAGS_SKB_MODE;
+        }
+
+        // Sockets sharing a UMEM need their own fill / completion rings
+        if (shared)
+            ret = xsk_socket__create_shared(&xsk_info->xsk, xsk_info->ifname, xsk_info->queue_id, xsk_info->umem,
+                                            &xsk_info->rx, &xsk_info->tx, &xsk_info->fq, &xsk_info->cq, xsk_cfg);
+        else
+            ret = xsk_socket__create(&xsk_info->xsk, xsk_info->ifname, xsk_info->queue_id, xsk_info->umem,
+                                     &xsk_info->rx, &xsk_info->tx, xsk_cfg);
+
+        if (ret == 0)
+            break;
+    }
+
+    return ret;
+}
+
 void cord_xdp_socket_init_shared(struct cord_xdp_socket_info **xsk_info,
                                  struct cord_xdp_socket_info **shared_umem_socket)
 {
-    struct xsk_umem_config umem_cfg = {.fill_size = (*xsk_info)->fill_ring_size,
-                                       .comp_size = (*xsk_info)->comp_ring_size,
-                                       .frame_size = (*xsk_info)->frame_size,
+    struct cord_xdp_socket_info *xsk = *xsk_info;
+    bool shared = shared_umem_socket && *shared_umem_socket;
+
+    struct xsk_umem_config umem_cfg = {.fill_size = xsk->fill_ring_size,
+                                       .comp_size = xsk->comp_ring_size,
+                                       .frame_size = xsk->frame_size,
                                        .frame_headroom = XSK_UMEM__DEFAULT_FRAME_HEADROOM,
                                        .flags = 0};
 
-    struct xsk_socket_config xsk_cfg = {.rx_size = (*xsk_info)->rx_ring_size,
-                                        .tx_size = (*xsk_info)->tx_ring_size,
-                                        .libbpf_flags = 0,
+    struct xsk_socket_config xsk_cfg = {.rx_size = xsk->rx_ring_size,
+                                        .tx_size = xsk->tx_ring_size,
+                                        .libxdp_flags = xsk->inhibit_prog_load ? XSK_LIBXDP_FLAGS__INHIBIT_PROG_LOAD : 0,
                                         .xdp_flags = XDP_FLAGS_UPDATE_IF_NOEXIST,
                                         .bind_flags = XDP_USE_NEED_WAKEUP | XDP_ZEROCOPY};
 
     int ret;
-    uint32_t idx;
 
-    if (shared_umem_socket && *shared_umem_socket)
+    if (shared)
     {
-        (*xsk_info)->umem_area = (*shared_umem_socket)->umem_area;
-        (*xsk_info)->umem_size = (*shared_umem_socket)->umem_size;
-        (*xsk_info)->umem = (*shared_umem_socket)->umem;
-        (*xsk_info)->umem_frames_rx = (*shared_umem_socket)->umem_frames_rx;
-        (*xsk_info)->umem_frames_tx = (*shared_umem_socket)->umem_frames_tx;
-        (*xsk_info)->free_frames_rx = (*shared_umem_socket)->free_frames_rx;
-        (*xsk_info)->free_frames_tx = (*shared_umem_socket)->free_frames_tx;
-        (*xsk_info)->umem_owner = *shared_umem_socket;
+        // Same UMEM, own slice of it (umem_offset set by the caller) and own frame lists
+        xsk->umem_area = (*shared_umem_socket)->umem_area;
+        xsk->umem_size = (*shared_umem_socket)->umem_size;
+        xsk->umem = (*shared_umem_socket)->umem;
+        xsk->umem_owner = *shared_umem_socket;
+        xsk->frame_owner = (*shared_umem_socket)->frame_owner;
+
+        if (xsk->umem_offset + (uint64_t)xsk->num_frames * xsk->frame_size > xsk->umem_size)
+        {
+            CORD_LOG("[cord_xdp_socket_init] UMEM slice of queue %u exceeds the shared UMEM\n", xsk->queue_id);
+            return;
+        }
 
-        memset(&(*xsk_info)->fq, 0, sizeof((*xsk_info)->fq));
-        memset(&(*xsk_info)->cq, 0, sizeof((*xsk_info)->cq));
+        memset(&xsk->fq, 0, sizeof(xsk->fq));
+        memset(&xsk->cq, 0, sizeof(xsk->cq));
     }
     else
     {
-        ret = posix_memalign(&(*xsk_info)->umem_area, getpagesize(), (*xsk_info)->umem_size);
-        if (ret)
+        // Huge page backed, on the NUMA node of the queue's worker
+        xsk->umem_area = cord_alloc_hugepage_node(xsk->umem_size, xsk->socket_id);
+        if (!xsk->umem_area)
         {
-            CORD_ERROR("[cord_xdp_socket_init] posix_memalign");
+            CORD_ERROR("[cord_xdp_socket_init] cord_alloc_hugepage_node");
             return;
         }
 
-        ret = xsk_umem__create(&(*xsk_info)->umem, (*xsk_info)->umem_area, (*xsk_info)->umem_size, &(*xsk_info)->fq,
-                               &(*xsk_info)->cq, &umem_cfg);
-        if (ret)
+        xsk->frame_owner = calloc(xsk->umem_size / xsk->frame_size, sizeof(struct cord_xdp_socket_info *));
+        if (!xsk->frame_owner)
         {
-            CORD_ERROR("[cord_xdp_socket_init] xsk_umem__create");
-            free((*xsk_info)->umem_area);
+            CORD_ERROR("[cord_xdp_socket_init] calloc");
+            cord_free_hugepage(xsk->umem_area, xsk->umem_size);
+            xsk->umem_area = NULL;
             return;
         }
 
-        (*xsk_info)->umem_owner = NULL;
-    }
-
-    if (shared_umem_socket && *shared_umem_socket)
-    {
-        xsk_cfg.bind_flags |= XDP_SHARED_UMEM;
-        ret = xsk_socket__create(&(*xsk_info)->xsk, (*xsk_info)->ifname, (*xsk_info)->queue_id, (*xsk_info)->umem,
-                                 &(*xsk_info)->rx, &(*xsk_info)->tx, &xsk_cfg);
+        ret = xsk_umem__create(&xsk->umem, xsk->umem_area, xsk->umem_size, &xsk->fq, &xsk->cq, &umem_cfg);
         if (ret)
         {
-            xsk_cfg.bind_flags = XDP_USE_NEED_WAKEUP | XDP_COPY | XDP_SHARED_UMEM;
-            ret = xsk_socket__create(&(*xsk_info)->xsk, (*xsk_info)->ifname, (*xsk_info)->queue_id, (*xsk_info)->umem,
-                                     &(*xsk_info)->rx, &(*xsk_info)->tx, &xsk_cfg);
-            if (ret)
-            {
-                xsk_cfg.xdp_flags = XDP_FLAGS_UPDATE_IF_NOEXIST | XDP_FLAGS_SKB_MODE;
-                xsk_cfg.bind_flags = XDP_USE_NEED_WAKEUP | XDP_COPY | XDP_SHARED_UMEM;
-                ret = xsk_socket__create(&(*xsk_info)->xsk, (*xsk_info)->ifname, (*xsk_info)->queue_id,
-                                         (*xsk_info)->umem, &(*xsk_info)->rx, &(*xsk_info)->tx, &xsk_cfg);
-                if (ret)
-                {
-                    CORD_ERROR("[cord_xdp_socket_init] xsk_socket__create");
-                    return;
-                }
-            }
+            CORD_ERROR("[cord_xdp_socket_init] xsk_umem__create");
+            free(xsk->frame_owner);
+            cord_free_hugepage(xsk->umem_area, xsk->umem_size);
+            xsk->frame_owner = NULL;
+            xsk->umem_area = NULL;
+            return;
         }
+
+        xsk->umem_owner = NULL;
     }
-    else
+
+    ret = cord_xdp_socket_create(xsk, &xsk_cfg, shared);
+    if (ret)
     {
-        ret = xsk_socket__create(&(*xsk_info)->xsk, (*xsk_info)->ifname, (*xsk_info)->queue_id, (*xsk_info)->umem,
-                                 &(*xsk_info)->rx, &(*xsk_info)->tx, &xsk_cfg);
-        if (ret)
-        {
-            xsk_cfg.bind_flags = XDP_USE_NEED_WAKEUP | XDP_COPY;
-            ret = xsk_socket__create(&(*xsk_info)->xsk, (*xsk_info)->ifname, (*xsk_info)->queue_id, (*xsk_info)->umem,
-                                     &(*xsk_info)->rx, &(*xsk_info)->tx, &xsk_cfg);
-            if (ret)
-            {
-                xsk_cfg.xdp_flags = XDP_FLAGS_UPDATE_IF_NOEXIST | XDP_FLAGS_SKB_MODE;
-                ret = xsk_socket__create(&(*xsk_info)->xsk, (*xsk_info)->ifname, (*xsk_info)->queue_id,
-                                         (*xsk_info)->umem, &(*xsk_info)->rx, &(*xsk_info)->tx, &xsk_cfg);
-                if (ret)
-                {
-                    CORD_ERROR("[cord_xdp_socket_init] xsk_socket__create");
-                    xsk_umem__delete((*xsk_info)->umem);
-                    free((*xsk_info)->umem_area);
-                    return;
-                }
-            }
-        }
+        CORD_ERROR("[cord_xdp_socket_init] xsk_socket__create");
+        goto err_umem;
     }
 
-    int sockfd = xsk_socket__fd((*xsk_info)->xsk);
+    int sockfd = xsk_socket__fd(xsk->xsk);
     int flags = fcntl(sockfd, F_GETFL, 0);
     if (flags != -1)
     {
         fcntl(sockfd, F_SETFL, flags | O_NONBLOCK);
     }
 
-    if (!shared_umem_socket || !*shared_umem_socket)
+    if (cord_xdp_socket_frames_init(xsk) != 0)
     {
-        uint32_t rx_frames = (*xsk_info)->num_frames / 2;
-        uint32_t tx_frames = (*xsk_info)->num_frames - rx_frames;
-
-        (*xsk_info)->umem_frames_rx = malloc(rx_frames * sizeof(uint64_t));
-        (*xsk_info)->umem_frames_tx = malloc(tx_frames * sizeof(uint64_t));
-
-        if (!(*xsk_info)->umem_frames_rx || !(*xsk_info)->umem_frames_tx)
-        {
-            CORD_ERROR("[cord_xdp_socket_init] malloc");
-            free((*xsk_info)->umem_frames_rx);
-            free((*xsk_info)->umem_frames_tx);
-            xsk_socket__delete((*xsk_info)->xsk);
-            xsk_umem__delete((*xsk_info)->umem);
-            free((*xsk_info)->umem_area);
-            return;
-        }
-
-        for (uint32_t i = 0; i < rx_frames; i++)
-            (*xsk_info)->umem_frames_rx[i] = i * (*xsk_info)->frame_size;
-
-        for (uint32_t i = 0; i < tx_frames; i++)
-            (*xsk_info)->umem_frames_tx[i] = (rx_frames + i) * (*xsk_info)->frame_size;
-
-        (*xsk_info)->free_frames_rx = rx_frames;
-        (*xsk_info)->free_frames_tx = tx_frames;
-
-        ret = xsk_ring_prod__reserve(&(*xsk_info)->fq, (*xsk_info)->fill_ring_size, &idx);
-        if (ret != (*xsk_info)->fill_ring_size)
-        {
-            CORD_ERROR("[cord_xdp_socket_init] xsk_ring_prod__reserve(fq)");
-            free((*xsk_info)->umem_frames_rx);
-            free((*xsk_info)->umem_frames_tx);
-            xsk_socket__delete((*xsk_info)->xsk);
-            xsk_umem__delete((*xsk_info)->umem);
-            free((*xsk_info)->umem_area);
-            return;
-        }
+        xsk_socket__delete(xsk->xsk);
+        xsk->xsk = NULL;
+        goto err_umem;
+    }
 
-        for (uint16_t i = 0; i < (*xsk_info)->fill_ring_size; i++)
-            *xsk_ring_prod__fill_addr(&(*xsk_info)->fq, idx++) = cord_xdp_alloc_frame_rx(*xsk_info);
+    return;
 
-        xsk_ring_prod__submit(&(*xsk_info)->fq, (*xsk_info)->fill_ring_size);
+err_umem:
+    if (!shared)
+    {
+        xsk_umem__delete(xsk->umem);
+        free(xsk->frame_owner);
+        cord_free_hugepage(xsk->umem_area, xsk->umem_size);
+        xsk->umem = NULL;
+        xsk->frame_owner = NULL;
+        xsk->umem_area = NULL;
     }
-
     return;
 }
 
@@ -376,17 +711,24 @@ void cord_xdp_socket_free(struct cord_xdp_socket_info **xsk_info)
     if ((*xsk_info)->xsk)
         xsk_socket__delete((*xsk_info)->xsk);
 
-    if ((*xsk_info)->umem)
-        xsk_umem__delete((*xsk_info)->umem);
-
     if ((*xsk_info)->umem_frames_rx)
-        free((*xsk_info)->umem_frames_rx);
+        cord_xdp_frame_ring_destroy((*xsk_info)->umem_frames_rx);
 
     if ((*xsk_info)->umem_frames_tx)
-        free((*xsk_info)->umem_frames_tx);
+        cord_xdp_frame_ring_destroy((*xsk_info)->umem_frames_tx);
+
+    // The UMEM belongs to the owner socket when shared (free sharers first)
+    if (!(*xsk_info)->umem_owner)
+    {
+        if ((*xsk_info)->umem)
+            xsk_umem__delete((*xsk_info)->umem);
+
+        if ((*xsk_info)->frame_owner)
+            free((*xsk_info)->frame_owner);
 
-    if ((*xsk_info)->umem_area)
-        free((*xsk_info)->umem_area);
+        if ((*xsk_info)->umem_area)
+            cord_free_hugepage((*xsk_info)->umem_area, (*xsk_info)->umem_size);
+    }
 
     free(*xsk_info);
     *xsk_info = NULL;
@@ -396,32 +738,95 @@ void cord_xdp_socket_free(struct cord_xdp_socket_info **xsk_info)
 
 uint64_t cord_xdp_alloc_frame_rx(struct cord_xdp_socket_info *xsk_info)
 {
-    if (xsk_info->free_frames_rx == 0)
+    uint64_t frame;
+
+    if (cord_xdp_frame_ring_dequeue_burst(xsk_info->umem_frames_rx, &frame, 1) == 0)
         return UINT64_MAX;
 
-    uint64_t frame = xsk_info->umem_frames_rx[--xsk_info->free_frames_rx];
-    xsk_info->umem_frames_rx[xsk_info->free_frames_rx] = UINT64_MAX;
     return frame;
 }
 
 void cord_xdp_free_frame_rx(struct cord_xdp_socket_info *xsk_info, uint64_t frame)
 {
-    xsk_info->umem_frames_rx[xsk_info->free_frames_rx++] = frame;
+    cord_xdp_frame_ring_enqueue_burst(xsk_info->umem_frames_rx, &frame, 1);
 }
 
 uint64_t cord_xdp_alloc_frame_tx(struct cord_xdp_socket_info *xsk_info)
 {
-    if (xsk_info->free_frames_tx == 0)
+    uint64_t frame;
+
+    if (cord_xdp_frame_ring_dequeue_burst(xsk_info->umem_frames_tx, &frame, 1) == 0)
         return UINT64_MAX;
 
-    uint64_t frame = xsk_info->umem_frames_tx[--xsk_info->free_frames_tx];
-    xsk_info->umem_frames_tx[xsk_info->free_frames_tx] = UINT64_MAX;
     return frame;
 }
 
 void cord_xdp_free_frame_tx(struct cord_xdp_socket_info *xsk_info, uint64_t frame)
 {
-    xsk_info->umem_frames_tx[xsk_info->free_frames_tx++] = frame;
+    cord_xdp_frame_ring_enqueue_burst(xsk_info->umem_frames_tx, &frame, 1);
+}
+
+uint32_t cord_xdp_alloc_frames_rx(struct cord_xdp_socket_info *xsk_info, uint64_t *frames, uint32_t n)
+{
+    return cord_xdp_frame_ring_dequeue_burst(xsk_info->umem_frames_rx, frames, n);
+}
+
+// The rings are sized for every frame of the socket's slice, so a free always fits
+void cord_xdp_free_frames_rx(struct cord_xdp_socket_info *xsk_info, const uint64_t *frames, uint32_t n)
+{
+    cord_xdp_frame_ring_enqueue_burst(xsk_info->umem_frames_rx, frames, n);
+}
+
+uint32_t cord_xdp_alloc_frames_tx(struct cord_xdp_socket_info *xsk_info, uint64_t *frames, uint32_t n)
+{
+    return cord_xdp_frame_ring_dequeue_burst(xsk_info->umem_frames_tx, frames, n);
+}
+
+void cord_xdp_free_frames_tx(struct cord_xdp_socket_info *xsk_info, const uint64_t *frames, uint32_t n)
+{
+    cord_xdp_frame_ring_enqueue_burst(xsk_info->umem_frames_tx, frames, n);
+}
+
+static inline struct cord_xdp_frame_ring *cord_xdp_frame_home(struct cord_xdp_socket_info *xsk_info, uint64_t frame)
+{
+    struct cord_xdp_socket_info *owner = xsk_info->frame_owner[frame / xsk_info->frame_size];
+
+    // The upper half of each socket's slice is its TX (copy) frame pool
+    uint64_t tx_base = owner->umem_offset + (uint64_t)(owner->num_frames / 2) * owner->frame_size;
+
+    return (frame >= tx_base) ? owner->umem_frames_tx : owner->umem_frames_rx;
+}
+
+void cord_xdp_complete_frame(struct cord_xdp_socket_info *xsk_info, uint64_t addr)
+{
+    uint64_t frame = addr - (addr % xsk_info->frame_size);
+
+    cord_xdp_frame_ring_enqueue_burst(cord_xdp_frame_home(xsk_info, frame), &frame, 1);
+}
+
+void cord_xdp_complete_frames(struct cord_xdp_socket_info *xsk_info, const uint64_t *addrs, uint32_t n)
+{
+    uint64_t frames[CORD_XDP_FRAME_BATCH];
+    struct cord_xdp_frame_ring *run_ring = NULL;
+    uint32_t run_len = 0;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        uint64_t frame = addrs[i] - (addrs[i] % xsk_info->frame_size);
+        struct cord_xdp_frame_ring *ring = cord_xdp_frame_home(xsk_info, frame);
+
+        if ((ring != run_ring || run_len == CORD_XDP_FRAME_BATCH) && run_len > 0)
+        {
+            cord_xdp_frame_ring_enqueue_burst(run_ring, frames, run_len);
+            run_len = 0;
+        }
+
+        run_ring = ring;
+        frames[run_len++] = frame;
+    }
+
+    if (run_len > 0)
+        cord_xdp_frame_ring_enqueue_burst(run_ring, frames, run_len);
 }
 
 #endif // ENABLE_XDP_DATAPLANE
@@ -0,0 +1,504 @@
+#include <memory/cord_pkt_pool.h>
+#include <cord_error.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+_Static_assert(CORD_PKT_POOL_MAX_THREADS <= 64, "cache slots are tracked in a 64-bit map");
+
+// Thread slot in the per-pool cache array, assigned on first use (-1 = none yet) and
+// returned to the free map when the thread exits
+static _Atomic uint64_t cord_pkt_pool_slot_map = 0;
+static _Thread_local int cord_pkt_pool_slot = -1;
+static pthread_key_t cord_pkt_pool_slot_key;
+static pthread_once_t cord_pkt_pool_slot_once = PTHREAD_ONCE_INIT;
+
+static inline cord_pkt_buf_t *cord_pkt_pool_elt(const cord_pkt_pool_t *pool, uint32_t index)
+{
+    return (cord_pkt_buf_t *)(pool->arena + (size_t)index * pool->elt_size);
+}
+
+static inline void cord_pkt_pool_lock(cord_pkt_pool_t *pool)
+{
+    while (atomic_flag_test_and_set_explicit(&pool->lock, memory_order_acquire))
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        __asm__ __volatile__("yield");
+#endif
+    }
+}
+
+static inline void cord_pkt_pool_unlock(cord_pkt_pool_t *pool)
+{
+    atomic_flag_clear_explicit(&pool->lock, memory_order_release);
+}
+
+// Thread exit: hand the slot to the next thread. Buffers left in its caches are not lost,
+// the next owner of the slot allocates them.
+static void cord_pkt_pool_slot_release(void *arg)
+{
+    uint64_t bit = 1ULL << ((uintptr_t)arg - 1);
+    atomic_fetch_and_explicit(&cord_pkt_pool_slot_map, ~bit, memory_order_release);
+}
+
+static void cord_pkt_pool_slot_key_init(void)
+{
+    pthread_key_create(&cord_pkt_pool_slot_key, cord_pkt_pool_slot_release);
+}
+
+static int cord_pkt_pool_slot_acquire(void)
+{
+    pthread_once(&cord_pkt_pool_slot_once, cord_pkt_pool_slot_key_init);
+
+    uint64_t map = atomic_load_explicit(&cord_pkt_pool_slot_map, memory_order_relaxed);
+    uint64_t all = (CORD_PKT_POOL_MAX_THREADS == 64) ? ~0ULL : (1ULL << CORD_PKT_POOL_MAX_THREADS) - 1;
+
+    while ((map & all) != all)
+    {
+        int slot = __builtin_ctzll(~map);
+        if (atomic_compare_exchange_weak_explicit(&cord_pkt_pool_slot_map, &map, map | (1ULL << slot),
+                                                  memory_order_acquire, memory_order_relaxed))
+        {
+            // Key values must be non-NULL for the destructor to run
+            pthread_setspecific(cord_pkt_pool_slot_key, (void *)(uintptr_t)(slot + 1));
+            return slot;
+        }
+    }
+
+    return CORD_PKT_POOL_MAX_THREADS;
+}
+
+// Returns the calling thread's cache, or NULL if the thread has none (caches disabled / out of slots)
+static cord_pkt_pool_cache_t *cord_pkt_pool_get_cache(cord_pkt_pool_t *pool)
+{
+    if (pool->cache_size == 0)
+    {
+        return NULL;
+    }
+
+    if (cord_pkt_pool_slot < 0)
+    {
+        cord_pkt_pool_slot = cord_pkt_pool_slot_acquire();
+    }
+
+    if (cord_pkt_pool_slot >= CORD_PKT_POOL_MAX_THREADS)
+    {
+        return NULL;
+    }
+
+    cord_pkt_pool_cache_t *cache = &pool->caches[cord_pkt_pool_slot];
+    if (!cache->objs)
+    {
+        // Only the owning thread ever touches its slot
+        cache->objs = malloc(2 * (size_t)pool->cache_size * sizeof(void *));
+        if (!cache->objs)
+        {
+            return NULL;
+        }
+    }
+
+    return cache;
+}
+
+// Move up to count elements from the shared stack into objs, returns the number moved
+static uint32_t cord_pkt_pool_stack_get(cord_pkt_pool_t *pool, void **objs, uint32_t count, bool exact)
+{
+    cord_pkt_pool_lock(pool);
+
+    if (pool->stack_len < count)
+    {
+        if (exact)
+        {
+            cord_pkt_pool_unlock(pool);
+            return 0;
+        }
+        count = pool->stack_len;
+    }
+
+    pool->stack_len -= count;
+    memcpy(objs, &pool->stack[pool->stack_len], (size_t)count * sizeof(void *));
+
+    cord_pkt_pool_unlock(pool);
+    return count;
+}
+
+static void cord_pkt_pool_stack_put(cord_pkt_pool_t *pool, void * const *objs, uint32_t count)
+{
+    cord_pkt_pool_lock(pool);
+
+    memcpy(&pool->stack[pool->stack_len], objs, (size_t)count * sizeof(void *));
+    pool->stack_len += count;
+
+    cord_pkt_pool_unlock(pool);
+}
+
+//
+// Packet Pool Create/Destroy
+//
+
+static cord_pkt_pool_t *cord_pkt_pool_create_common(cord_arena_t *arena, uint32_t num_bufs,
+                                                    uint32_t buf_size, uint32_t cache_size)
+{
+    if (buf_size == 0)
+    {
+        buf_size = CORD_RAW_BUF_SIZE;
+    }
+
+    if (num_bufs == 0 || buf_size <= CORD_RAW_HEADROOM || buf_size - CORD_RAW_HEADROOM > UINT16_MAX ||
+        cache_size > CORD_PKT_POOL_CACHE_MAX)
+    {
+        return NULL;
+    }
+
+    // A cache larger than the pool would strand buffers in a single thread
+    if (cache_size > num_bufs / 2)
+    {
+        cache_size = num_bufs / 2;
+    }
+
+    cord_pkt_pool_t *pool = aligned_alloc(CORD_CACHE_LINE_SIZE, sizeof(cord_pkt_pool_t));
+    if (!pool)
+    {
+        return NULL;
+    }
+
+    memset(pool, 0, sizeof(cord_pkt_pool_t));
+    atomic_flag_clear(&pool->lock);
+
+    pool->elt_size = (uint32_t)CORD_ALIGN_TO_CACHE_LINE(sizeof(cord_pkt_buf_t) + buf_size);
+    pool->buf_size = buf_size;
+    pool->num_bufs = num_bufs;
+    pool->cache_size = cache_size;
+    pool->arena_size = (size_t)num_bufs * pool->elt_size;
+
+    pool->from_arena = (arena != NULL);
+    pool->arena = arena ? cord_arena_alloc(arena, pool->arena_size, CORD_CACHE_LINE_SIZE)
+                        : cord_alloc_hugepage(pool->arena_size);
+    if (!pool->arena)
+    {
+        free(pool);
+        return NULL;
+    }
+
+    pool->stack = malloc((size_t)num_bufs * sizeof(void *));
+    if (!pool->stack)
+    {
+        if (!pool->from_arena)
+        {
+            cord_free_hugepage(pool->arena, pool->arena_size);
+        }
+        free(pool);
+        return NULL;
+    }
+
+    // Push in reverse so the first allocations walk the arena in address order
+    for (uint32_t i = 0; i < num_bufs; i++)
+    {
+        uint32_t index = num_bufs - 1 - i;
+        cord_pkt_buf_t *elt = cord_pkt_pool_elt(pool, index);
+
+        cord_raw_pkt_init(&elt->desc, (uint8_t *)elt + sizeof(cord_pkt_buf_t));
+        elt->pool = pool;
+        elt->index = index;
+        atomic_init(&elt->refcnt, 0);
+
+        pool->stack[i] = elt;
+    }
+    pool->stack_len = num_bufs;
+
+    return pool;
+}
+
+cord_pkt_pool_t *cord_pkt_pool_create(uint32_t num_bufs, uint32_t buf_size, uint32_t cache_size)
+{
+    return cord_pkt_pool_create_common(NULL, num_bufs, buf_size, cache_size);
+}
+
+// Elements live in the arena and are released with it, not by cord_pkt_pool_destroy()
+cord_pkt_pool_t *cord_pkt_pool_create_arena(cord_arena_t *arena, uint32_t num_bufs, uint32_t buf_size, uint32_t cache_size)
+{
+    if (!arena)
+    {
+        return NULL;
+    }
+
+    return cord_pkt_pool_create_common(arena, num_bufs, buf_size, cache_size);
+}
+
+void cord_pkt_pool_destroy(cord_pkt_pool_t *pool)
+{
+    if (!pool)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < CORD_PKT_POOL_MAX_THREADS; i++)
+    {
+        free(pool->caches[i].objs);
+    }
+
+    free(pool->stack);
+    if (!pool->from_arena)
+    {
+        cord_free_hugepage(pool->arena, pool->arena_size);
+    }
+    free(pool);
+}
+
+//
+// Allocation
+//
+
+static inline cord_raw_pkt_desc_t *cord_pkt_pool_prepare(cord_pkt_buf_t *elt)
+{
+    cord_raw_pkt_reset(&elt->desc);
+    atomic_store_explicit(&elt->refcnt, 1, memory_order_relaxed);
+    return &elt->desc;
+}
+
+cord_raw_pkt_desc_t *cord_pkt_alloc(cord_pkt_pool_t *pool)
+{
+    cord_raw_pkt_desc_t *pkt;
+
+    if (cord_pkt_alloc_bulk(pool, &pkt, 1) != 0)
+    {
+        return NULL;
+    }
+
+    return pkt;
+}
+
+int cord_pkt_alloc_bulk(cord_pkt_pool_t *pool, cord_raw_pkt_desc_t **pkts, uint32_t count)
+{
+    if (!pool || !pkts || count == 0)
+    {
+        return -1;
+    }
+
+    cord_pkt_pool_cache_t *cache = cord_pkt_pool_get_cache(pool);
+
+    // Requests larger than the cache go straight to the shared stack
+    if (!cache || count > pool->cache_size)
+    {
+        if (cord_pkt_pool_stack_get(pool, (void **)pkts, count, true) == 0)
+        {
+            if (cache)
+            {
+                cache->alloc_fail_count++;
+            }
+            return -1;
+        }
+    }
+    else
+    {
+        if (cache->len < count)
+        {
+            // Refill by one cache_size worth, on top of what is left
+            cache->len += cord_pkt_pool_stack_get(pool, &cache->objs[cache->len], pool->cache_size, false);
+            if (cache->len < count)
+            {
+                cache->alloc_fail_count++;
+                return -1;
+            }
+        }
+
+        // Hand out the most recently freed (cache-hot) buffers first
+        for (uint32_t i = 0; i < count; i++)
+        {
+            pkts[i] = cache->objs[--cache->len];
+        }
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        cord_pkt_pool_prepare((cord_pkt_buf_t *)pkts[i]);
+    }
+
+    if (cache)
+    {
+        cache->alloc_count += count;
+    }
+
+    return 0;
+}
+
+//
+// Release
+//
+
+// Drop one reference, returns true if the caller released the last one
+static inline bool cord_pkt_put_ref(cord_pkt_buf_t *elt)
+{
+    // Sole owner: no other thread can race on the counter
+    if (atomic_load_explicit(&elt->refcnt, memory_order_acquire) == 1)
+    {
+        atomic_store_explicit(&elt->refcnt, 0, memory_order_relaxed);
+        return true;
+    }
+
+    return atomic_fetch_sub_explicit(&elt->refcnt, 1, memory_order_acq_rel) == 1;
+}
+
+// Largest batch returned through the thread cache
+static inline uint32_t cord_pkt_pool_put_max(const cord_pkt_pool_t *pool)
+{
+    return (pool->cache_size + 1) / 2;
+}
+
+static void cord_pkt_pool_put(cord_pkt_pool_t *pool, void * const *objs, uint32_t count)
+{
+    cord_pkt_pool_cache_t *cache = cord_pkt_pool_get_cache(pool);
+
+    if (cache)
+    {
+        cache->free_count += count;
+    }
+
+    // Bounded so the cache never exceeds its 2 * cache_size slots before flushing
+    if (!cache || count > cord_pkt_pool_put_max(pool))
+    {
+        cord_pkt_pool_stack_put(pool, objs, count);
+        return;
+    }
+
+    memcpy(&cache->objs[cache->len], objs, (size_t)count * sizeof(void *));
+    cache->len += count;
+
+    // Flush the oldest entries back, keeping cache_size hot buffers
+    if (cache->len > pool->cache_size + pool->cache_size / 2)
+    {
+        uint32_t excess = cache->len - pool->cache_size;
+
+        cord_pkt_pool_stack_put(pool, cache->objs, excess);
+        memmove(cache->objs, &cache->objs[excess], (size_t)pool->cache_size * sizeof(void *));
+        cache->len = pool->cache_size;
+    }
+}
+
+void cord_pkt_free(cord_raw_pkt_desc_t *pkt)
+{
+    if (!pkt)
+    {
+        return;
+    }
+
+    cord_pkt_buf_t *elt = cord_pkt_buf(pkt);
+    if (cord_pkt_put_ref(elt))
+    {
+        void *obj = elt;
+        cord_pkt_pool_put(elt->pool, &obj, 1);
+    }
+}
+
+void cord_pkt_free_bulk(cord_raw_pkt_desc_t **pkts, uint32_t count)
+{
+    void *objs[CORD_PKT_POOL_CACHE_MAX];
+    cord_pkt_pool_t *pool = NULL;
+    uint32_t n = 0;
+
+    if (!pkts)
+    {
+        return;
+    }
+
+    // Batch consecutive packets of the same pool
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (!pkts[i])
+        {
+            continue;
+        }
+
+        cord_pkt_buf_t *elt = cord_pkt_buf(pkts[i]);
+        if (!cord_pkt_put_ref(elt))
+        {
+            continue;
+        }
+
+        if (n > 0 && (elt->pool != pool || n == cord_pkt_pool_put_max(pool) || n == CORD_PKT_POOL_CACHE_MAX))
+        {
+            cord_pkt_pool_put(pool, objs, n);
+            n = 0;
+        }
+
+        pool = elt->pool;
+        objs[n++] = elt;
+    }
+
+    if (n > 0)
+    {
+        cord_pkt_pool_put(pool, objs, n);
+    }
+}
+
+void cord_pkt_pool_cache_flush(cord_pkt_pool_t *pool)
+{
+    if (!pool)
+    {
+        return;
+    }
+
+    cord_pkt_pool_cache_t *cache = cord_pkt_pool_get_cache(pool);
+    if (!cache || cache->len == 0)
+    {
+        return;
+    }
+
+    cord_pkt_pool_stack_put(pool, cache->objs, cache->len);
+    cache->len = 0;
+}
+
+//
+// Statistics
+//
+
+uint32_t cord_pkt_pool_avail_count(cord_pkt_pool_t *pool)
+{
+    if (!pool)
+    {
+        return 0;
+    }
+
+    cord_pkt_pool_lock(pool);
+    uint32_t avail = pool->stack_len;
+    cord_pkt_pool_unlock(pool);
+
+    for (uint32_t i = 0; i < CORD_PKT_POOL_MAX_THREADS; i++)
+    {
+        avail += pool->caches[i].len;
+    }
+
+    return avail;
+}
+
+// Counters are kept per thread cache; threads without a cache slot are not counted
+void cord_pkt_pool_print_stats(cord_pkt_pool_t *pool)
+{
+    if (!pool)
+    {
+        return;
+    }
+
+    uint64_t alloc_count = 0;
+    uint64_t free_count = 0;
+    uint64_t alloc_fail_count = 0;
+
+    for (uint32_t i = 0; i < CORD_PKT_POOL_MAX_THREADS; i++)
+    {
+        alloc_count += pool->caches[i].alloc_count;
+        free_count += pool->caches[i].free_count;
+        alloc_fail_count += pool->caches[i].alloc_fail_count;
+    }
+
+    CORD_LOG("=== Packet Pool Statistics ===\n");
+    CORD_LOG("Buffers:          %u (%u bytes each)\n", pool->num_bufs, pool->buf_size);
+    CORD_LOG("Available:        %u\n", cord_pkt_pool_avail_count(pool));
+    CORD_LOG("Arena:            %zu bytes\n", pool->arena_size);
+    CORD_LOG("Cache size:       %u\n", pool->cache_size);
+    CORD_LOG("Allocated:        %lu\n", alloc_count);
+    CORD_LOG("Released:         %lu\n", free_count);
+    CORD_LOG("Alloc failures:   %lu\n", alloc_fail_count);
+    CORD_LOG("==============================\n");
+}
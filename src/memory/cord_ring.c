@@ -0,0 +1,217 @@
+#include <memory/cord_ring.h>
+#include <stdlib.h>
+#include <string.h>
+
+static inline void cord_ring_copy_in(cord_ring_t *ring, uint32_t head, void * const *objs, uint32_t n)
+{
+    uint32_t idx = head & ring->mask;
+
+    if (idx + n <= ring->capacity)
+    {
+        memcpy(&ring->objs[idx], objs, n * sizeof(void *));
+    }
+    else
+    {
+        uint32_t first = ring->capacity - idx;
+        memcpy(&ring->objs[idx], objs, first * sizeof(void *));
+        memcpy(&ring->objs[0], objs + first, (n - first) * sizeof(void *));
+    }
+}
+
+static inline void cord_ring_copy_out(const cord_ring_t *ring, uint32_t head, void **objs, uint32_t n)
+{
+    uint32_t idx = head & ring->mask;
+
+    if (idx + n <= ring->capacity)
+    {
+        memcpy(objs, &ring->objs[idx], n * sizeof(void *));
+    }
+    else
+    {
+        uint32_t first = ring->capacity - idx;
+        memcpy(objs, &ring->objs[idx], first * sizeof(void *));
+        memcpy(objs + first, &ring->objs[0], (n - first) * sizeof(void *));
+    }
+}
+
+static cord_ring_t *cord_ring_create_common(cord_arena_t *arena, uint32_t count, cord_ring_mode_t mode)
+{
+    if (count == 0 || count > (1u << 31) || mode > CORD_RING_MPMC)
+    {
+        return NULL;
+    }
+
+    uint32_t size = 1;
+    while (size < count)
+    {
+        size <<= 1;
+    }
+
+    size_t bytes = CORD_ALIGN_TO_CACHE_LINE(sizeof(cord_ring_t) + (size_t)size * sizeof(void *));
+    cord_ring_t *ring = arena ? cord_arena_alloc(arena, bytes, CORD_CACHE_LINE_SIZE)
+                              : aligned_alloc(CORD_CACHE_LINE_SIZE, bytes);
+    if (!ring)
+    {
+        return NULL;
+    }
+
+    memset(ring, 0, sizeof(cord_ring_t));
+    atomic_init(&ring->prod_head, 0);
+    atomic_init(&ring->prod_tail, 0);
+    atomic_init(&ring->cons_head, 0);
+    atomic_init(&ring->cons_tail, 0);
+
+    ring->capacity = size;
+    ring->mask = size - 1;
+    ring->mode = mode;
+    ring->prod_single = (mode == CORD_RING_SPSC || mode == CORD_RING_SPMC);
+    ring->cons_single = (mode == CORD_RING_SPSC || mode == CORD_RING_MPSC);
+    ring->from_arena = (arena != NULL);
+
+    return ring;
+}
+
+cord_ring_t *cord_ring_create(uint32_t count, cord_ring_mode_t mode)
+{
+    return cord_ring_create_common(NULL, count, mode);
+}
+
+cord_ring_t *cord_ring_create_arena(cord_arena_t *arena, uint32_t count, cord_ring_mode_t mode)
+{
+    if (!arena)
+    {
+        return NULL;
+    }
+
+    return cord_ring_create_common(arena, count, mode);
+}
+
+void cord_ring_destroy(cord_ring_t *ring)
+{
+    if (ring && !ring->from_arena)
+    {
+        free(ring);
+    }
+}
+
+static inline uint32_t cord_ring_enqueue(cord_ring_t *ring, void * const *objs, uint32_t count, bool all)
+{
+    uint32_t head;
+    uint32_t next;
+    uint32_t n;
+
+    if (ring->prod_single)
+    {
+        head = atomic_load_explicit(&ring->prod_head, memory_order_relaxed);
+
+        // Look at the consumer's cache line only when the cached view is not enough
+        uint32_t free_slots = ring->capacity + ring->prod_cons_tail - head;
+        if (free_slots < count)
+        {
+            ring->prod_cons_tail = atomic_load_explicit(&ring->cons_tail, memory_order_acquire);
+            free_slots = ring->capacity + ring->prod_cons_tail - head;
+        }
+
+        n = cord_ring_grant(count, free_slots, all);
+        if (n == 0)
+        {
+            return 0;
+        }
+
+        next = head + n;
+        atomic_store_explicit(&ring->prod_head, next, memory_order_relaxed);
+    }
+    else
+    {
+        n = cord_ring_move_head(&ring->prod_head, &ring->cons_tail, ring->capacity, count, all, &head);
+        if (n == 0)
+        {
+            return 0;
+        }
+        next = head + n;
+    }
+
+    cord_ring_copy_in(ring, head, objs, n);
+
+    // Publish in reservation order
+    if (ring->prod_single)
+    {
+        atomic_store_explicit(&ring->prod_tail, next, memory_order_release);
+    }
+    else
+    {
+        cord_ring_publish_tail(&ring->prod_tail, head, next);
+    }
+
+    return n;
+}
+
+static inline uint32_t cord_ring_dequeue(cord_ring_t *ring, void **objs, uint32_t count, bool all)
+{
+    uint32_t head;
+    uint32_t next;
+    uint32_t n;
+
+    if (ring->cons_single)
+    {
+        head = atomic_load_explicit(&ring->cons_head, memory_order_relaxed);
+
+        uint32_t entries = ring->cons_prod_tail - head;
+        if (entries < count)
+        {
+            ring->cons_prod_tail = atomic_load_explicit(&ring->prod_tail, memory_order_acquire);
+            entries = ring->cons_prod_tail - head;
+        }
+
+        n = cord_ring_grant(count, entries, all);
+        if (n == 0)
+        {
+            return 0;
+        }
+
+        next = head + n;
+        atomic_store_explicit(&ring->cons_head, next, memory_order_relaxed);
+    }
+    else
+    {
+        n = cord_ring_move_head(&ring->cons_head, &ring->prod_tail, 0, count, all, &head);
+        if (n == 0)
+        {
+            return 0;
+        }
+        next = head + n;
+    }
+
+    cord_ring_copy_out(ring, head, objs, n);
+
+    if (ring->cons_single)
+    {
+        atomic_store_explicit(&ring->cons_tail, next, memory_order_release);
+    }
+    else
+    {
+        cord_ring_publish_tail(&ring->cons_tail, head, next);
+    }
+
+    return n;
+}
+
+uint32_t cord_ring_enqueue_burst(cord_ring_t *ring, void * const *objs, uint32_t n)
+{
+    return cord_ring_enqueue(ring, objs, n, false);
+}
+
+uint32_t cord_ring_dequeue_burst(cord_ring_t *ring, void **objs, uint32_t n)
+{
+    return cord_ring_dequeue(ring, objs, n, false);
+}
+
+uint32_t cord_ring_enqueue_bulk(cord_ring_t *ring, void * const *objs, uint32_t n)
+{
+    return cord_ring_enqueue(ring, objs, n, true);
+}
+
+uint32_t cord_ring_dequeue_bulk(cord_ring_t *ring, void **objs, uint32_t n)
+{
+    return cord_ring_dequeue(ring, objs, n, true);
+}
@@ -0,0 +1,556 @@
+#include <pipeline/cord_pipeline.h>
+#include <match/cord_match.h>
+#include <action/cord_action.h>
+#include <telemetry/cord_cycles.h>
+#include <string.h>
+
+//
+// Multi-stage Match-Action Pipeline Implementation
+//
+// Burst execution:
+// 1. Parse every packet once into cord_pipeline_md_t
+// 2. For each stage: gather the packets scheduled on it, run one batched lookup,
+//    then apply the selected action lists
+//
+
+//
+// Internal Helper Functions
+//
+
+static void pipeline_parse(cord_pipeline_pkt_t *pkt, cord_pipeline_md_t *md)
+{
+    uint8_t *data = cord_pipeline_pkt_data(pkt);
+    uint32_t len = cord_pipeline_pkt_len(pkt);
+
+    md->eth = NULL;
+    md->vlan = NULL;
+    md->ipv4 = NULL;
+    md->vlan_id = 0;
+    md->l4_offset = 0;
+    md->l4_len = 0;
+
+    if (cord_unlikely(len < sizeof(cord_eth_hdr_t)))
+    {
+        return;
+    }
+
+    md->eth = (cord_eth_hdr_t *)data;
+    uint16_t eth_type = cord_ntohs(md->eth->h_proto);
+    uint32_t l3_offset = sizeof(cord_eth_hdr_t);
+
+    if (eth_type == CORD_ETH_P_8021Q || eth_type == CORD_ETH_P_8021AD)
+    {
+        if (cord_unlikely(len < l3_offset + sizeof(cord_vlan_hdr_t)))
+        {
+            return;
+        }
+
+        md->vlan = (cord_vlan_hdr_t *)(data + l3_offset);
+        md->vlan_id = cord_ntohs(md->vlan->tci) & 0x0FFF;
+        eth_type = cord_ntohs(md->vlan->h_proto);
+        l3_offset += sizeof(cord_vlan_hdr_t);
+    }
+
+    if (eth_type != CORD_ETH_P_IP || len < l3_offset + sizeof(cord_ipv4_hdr_t))
+    {
+        return;
+    }
+
+    // Only a well-formed header is exposed to the stages: version 4, IHL >= 5
+    // and a total length that covers the header and fits in the frame
+    cord_ipv4_hdr_t *ip = (cord_ipv4_hdr_t *)(data + l3_offset);
+    uint32_t ihl_bytes = ip->ihl * 4u;
+    uint32_t tot_len = cord_ntohs(ip->tot_len);
+
+    if (cord_unlikely(ip->version != 4 || ip->ihl < 5 ||
+                      tot_len < ihl_bytes || tot_len > len - l3_offset))
+    {
+        return;
+    }
+
+    md->ipv4 = ip;
+    md->l4_offset = (uint16_t)(l3_offset + ihl_bytes);
+    md->l4_len = (uint16_t)(tot_len - ihl_bytes);
+}
+
+static int pipeline_copy_actions(cord_pipeline_action_list_t *list,
+                                 const cord_pipeline_action_t *actions, uint8_t count)
+{
+    if (count > CORD_PIPELINE_MAX_ACTIONS || (count && !actions))
+    {
+        return -1;
+    }
+
+    memcpy(list->actions, actions, count * sizeof(cord_pipeline_action_t));
+    list->count = count;
+    return 0;
+}
+
+static inline const cord_pipeline_action_list_t *pipeline_select_actions(const cord_pipeline_stage_t *stage,
+                                                                        uint32_t result)
+{
+    if (result == CORD_PIPELINE_MISS)
+    {
+        return &stage->miss_actions;
+    }
+
+    if (result < stage->num_entry_actions && stage->entry_actions[result].count)
+    {
+        return &stage->entry_actions[result];
+    }
+
+    return &stage->hit_actions;
+}
+
+static void pipeline_apply_actions(cord_pipeline_t *pipeline, uint8_t stage_idx,
+                                   const cord_pipeline_action_list_t *list,
+                                   cord_pipeline_pkt_t *pkt, cord_pipeline_md_t *md)
+{
+    for (uint8_t a = 0; a < list->count && !md->drop; a++)
+    {
+        const cord_pipeline_action_t *action = &list->actions[a];
+
+        switch (action->type)
+        {
+            case CORD_PIPELINE_ACTION_OUTPUT:
+                md->out_port = (action->port == CORD_PIPELINE_PORT_FROM_TABLE) ? md->table_result : action->port;
+                break;
+
+            case CORD_PIPELINE_ACTION_DROP:
+                md->drop = 1;
+                break;
+
+            case CORD_PIPELINE_ACTION_GOTO_STAGE:
+                // Forward-only jumps keep the pipeline loop free
+                md->next_stage = (action->stage > stage_idx && action->stage < pipeline->num_stages) ?
+                                 action->stage : CORD_PIPELINE_STAGE_END;
+                break;
+
+            case CORD_PIPELINE_ACTION_SET_ETH_SRC:
+                if (md->eth)
+                {
+                    cord_set_field_eth_src_addr(md->eth, &action->mac);
+                }
+                break;
+
+            case CORD_PIPELINE_ACTION_SET_ETH_DST:
+                if (md->eth)
+                {
+                    cord_set_field_eth_dst_addr(md->eth, &action->mac);
+                }
+                break;
+
+            case CORD_PIPELINE_ACTION_DEC_IPV4_TTL:
+                if (md->ipv4)
+                {
+                    if (md->ipv4->ttl <= 1)
+                    {
+                        md->drop = 1;
+                        break;
+                    }
+                    cord_set_field_ipv4_ttl_csum(md->ipv4, md->ipv4->ttl - 1);
+                }
+                break;
+
+            case CORD_PIPELINE_ACTION_SET_IPV4_DSCP:
+                if (md->ipv4)
+                {
+                    cord_set_field_ipv4_dscp_csum(md->ipv4, action->dscp);
+                }
+                break;
+
+            case CORD_PIPELINE_ACTION_PUSH_VLAN:
+                if (cord_push_vlan(pkt, action->vlan.vlan_id, action->vlan.pcp,
+                                   action->vlan.dei, action->vlan.ethertype) == CORD_OK)
+                {
+                    pipeline_parse(pkt, md);
+                }
+                break;
+
+            case CORD_PIPELINE_ACTION_POP_VLAN:
+                if (cord_pop_vlan(pkt) == CORD_OK)
+                {
+                    pipeline_parse(pkt, md);
+                }
+                break;
+
+            case CORD_PIPELINE_ACTION_SET_METADATA:
+                md->metadata = action->metadata;
+                break;
+
+            case CORD_PIPELINE_ACTION_CUSTOM:
+                if (action->custom.fn)
+                {
+                    action->custom.fn(pkt, md, action->custom.ctx);
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+// One batched lookup for all packets scheduled on this stage
+static void pipeline_stage_lookup(cord_pipeline_stage_t *stage, cord_pipeline_pkt_t **pkts,
+                                  cord_pipeline_md_t *md, const uint32_t *idx,
+                                  uint32_t *results, uint32_t n)
+{
+    switch (stage->type)
+    {
+        case CORD_PIPELINE_STAGE_L2_CAM:
+        {
+            const cord_mac_addr_t *macs[CORD_PIPELINE_BURST_SIZE];
+            uint16_t vlan_ids[CORD_PIPELINE_BURST_SIZE];
+            uint32_t lookup_idx[CORD_PIPELINE_BURST_SIZE];
+            uint32_t ports[CORD_PIPELINE_BURST_SIZE];
+            uint32_t num_lookups = 0;
+
+            for (uint32_t i = 0; i < n; i++)
+            {
+                results[i] = CORD_PIPELINE_MISS;
+                if (md[idx[i]].eth)
+                {
+                    macs[num_lookups] = &md[idx[i]].eth->h_dest;
+                    vlan_ids[num_lookups] = md[idx[i]].vlan_id;
+                    lookup_idx[num_lookups++] = i;
+                }
+            }
+
+            cord_l2_cam_lookup_batch((cord_l2_cam_t *)stage->table, macs, vlan_ids, ports, num_lookups);
+
+            for (uint32_t j = 0; j < num_lookups; j++)
+            {
+                results[lookup_idx[j]] = (ports[j] == CORD_L2_CAM_INVALID_PORT) ? CORD_PIPELINE_MISS : ports[j];
+            }
+            break;
+        }
+
+        case CORD_PIPELINE_STAGE_IPV4_LPM:
+        {
+            uint32_t ips[CORD_PIPELINE_BURST_SIZE];
+            uint32_t lookup_idx[CORD_PIPELINE_BURST_SIZE];
+            uint32_t next_hops[CORD_PIPELINE_BURST_SIZE];
+            uint32_t num_lookups = 0;
+
+            for (uint32_t i = 0; i < n; i++)
+            {
+                results[i] = CORD_PIPELINE_MISS;
+                if (md[idx[i]].ipv4)
+                {
+                    ips[num_lookups] = cord_get_field_ipv4_dst_addr_ntohl(md[idx[i]].ipv4);
+                    lookup_idx[num_lookups++] = i;
+                }
+            }
+
+            cord_ipv4_lpm_lookup_batch((const cord_ipv4_lpm_t *)stage->table, ips, next_hops, num_lookups);
+
+            for (uint32_t j = 0; j < num_lookups; j++)
+            {
+                results[lookup_idx[j]] = (next_hops[j] == CORD_IPV4_LPM_INVALID_NEXT_HOP) ? CORD_PIPELINE_MISS : next_hops[j];
+            }
+            break;
+        }
+
+        case CORD_PIPELINE_STAGE_IPV4_ACL:
+        {
+            const cord_acl_t *acl = (const cord_acl_t *)stage->table;
+            cord_acl_key_t keys[CORD_PIPELINE_BURST_SIZE];
+            uint32_t lookup_idx[CORD_PIPELINE_BURST_SIZE];
+            uint32_t rule_ids[CORD_PIPELINE_BURST_SIZE];
+            uint32_t num_lookups = 0;
+
+            for (uint32_t i = 0; i < n; i++)
+            {
+                results[i] = CORD_PIPELINE_MISS;
+                if (md[idx[i]].ipv4)
+                {
+                    const cord_pipeline_md_t *m = &md[idx[i]];
+                    uint32_t l3_len = (m->ipv4->ihl * 4u) + m->l4_len;
+                    cord_acl_key_from_ipv4(m->ipv4, l3_len, &keys[num_lookups]);
+                    lookup_idx[num_lookups++] = i;
+                }
+            }
+
+            cord_acl_classify_batch(acl, keys, rule_ids, num_lookups);
+
+            for (uint32_t j = 0; j < num_lookups; j++)
+            {
+                results[lookup_idx[j]] = cord_acl_rule_action(acl, rule_ids[j]);
+            }
+            break;
+        }
+
+        case CORD_PIPELINE_STAGE_CUSTOM:
+        default:
+        {
+            CORD_CYCLES_START(cycles);
+            for (uint32_t i = 0; i < n; i++)
+            {
+                results[i] = stage->lookup ? stage->lookup(stage->table, pkts[idx[i]], &md[idx[i]]) : CORD_PIPELINE_MISS;
+            }
+            CORD_CYCLES_STOP(cycles, CORD_CYCLES_STAGE_CUSTOM_LOOKUP);
+            break;
+        }
+    }
+}
+
+static void pipeline_run_burst(cord_pipeline_t *pipeline, cord_pipeline_pkt_t **pkts,
+                               cord_pipeline_md_t *md, uint32_t count)
+{
+    uint32_t idx[CORD_PIPELINE_BURST_SIZE];
+    uint32_t results[CORD_PIPELINE_BURST_SIZE];
+
+    // Prefetch packet headers, then parse
+    CORD_CYCLES_START(parse_cycles);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        __builtin_prefetch(cord_pipeline_pkt_data(pkts[i]), 1, 3);
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        pipeline_parse(pkts[i], &md[i]);
+        md[i].next_stage = pipeline->num_stages ? 0 : CORD_PIPELINE_STAGE_END;
+        md[i].drop = 0;
+        md[i].out_port = CORD_PIPELINE_PORT_NONE;
+        md[i].table_result = CORD_PIPELINE_MISS;
+        md[i].metadata = 0;
+    }
+    CORD_CYCLES_STOP(parse_cycles, CORD_CYCLES_STAGE_PARSE);
+
+    for (uint8_t s = 0; s < pipeline->num_stages; s++)
+    {
+        cord_pipeline_stage_t *stage = &pipeline->stages[s];
+
+        // Gather the packets scheduled on this stage
+        uint32_t n = 0;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (md[i].next_stage == s && !md[i].drop)
+            {
+                idx[n++] = i;
+            }
+        }
+
+        if (n == 0)
+        {
+            continue;
+        }
+
+        pipeline_stage_lookup(stage, pkts, md, idx, results, n);
+
+        CORD_CYCLES_START(action_cycles);
+        for (uint32_t i = 0; i < n; i++)
+        {
+            cord_pipeline_md_t *pkt_md = &md[idx[i]];
+
+            pkt_md->table_result = results[i];
+            pkt_md->next_stage = stage->next_stage;
+
+            if (results[i] == CORD_PIPELINE_MISS)
+            {
+                stage->miss_count++;
+            }
+            else
+            {
+                stage->hit_count++;
+            }
+
+            pipeline_apply_actions(pipeline, s, pipeline_select_actions(stage, results[i]), pkts[idx[i]], pkt_md);
+
+            if (pkt_md->drop)
+            {
+                pkt_md->next_stage = CORD_PIPELINE_STAGE_END;
+                pipeline->drop_count++;
+            }
+        }
+        CORD_CYCLES_STOP(action_cycles, CORD_CYCLES_STAGE_ACTIONS);
+    }
+
+    pipeline->packet_count += count;
+}
+
+//
+// Pipeline Create/Destroy
+//
+
+cord_pipeline_t *cord_pipeline_create(void)
+{
+    cord_pipeline_t *pipeline = calloc(1, sizeof(cord_pipeline_t));
+    if (!pipeline)
+    {
+        return NULL;
+    }
+
+    pipeline->num_stages = 0;
+    pipeline->packet_count = 0;
+    pipeline->drop_count = 0;
+
+    return pipeline;
+}
+
+void cord_pipeline_destroy(cord_pipeline_t *pipeline)
+{
+    if (!pipeline)
+    {
+        return;
+    }
+
+    for (uint8_t s = 0; s < pipeline->num_stages; s++)
+    {
+        free(pipeline->stages[s].entry_actions);
+    }
+
+    free(pipeline);
+}
+
+//
+// Stage Management
+//
+
+int cord_pipeline_add_stage(cord_pipeline_t *pipeline, cord_pipeline_stage_type_t type,
+                            void *table, cord_pipeline_custom_lookup_fn lookup)
+{
+    if (!pipeline || pipeline->num_stages >= CORD_PIPELINE_MAX_STAGES)
+    {
+        return -1;
+    }
+
+    if ((type == CORD_PIPELINE_STAGE_CUSTOM && !lookup) || (type != CORD_PIPELINE_STAGE_CUSTOM && !table))
+    {
+        return -1;
+    }
+
+    uint8_t s = pipeline->num_stages;
+    cord_pipeline_stage_t *stage = &pipeline->stages[s];
+    memset(stage, 0, sizeof(cord_pipeline_stage_t));
+
+    stage->type = type;
+    stage->table = table;
+    stage->lookup = lookup;
+    stage->next_stage = CORD_PIPELINE_STAGE_END;
+
+    // Chain the previous stage to this one unless it was explicitly redirected
+    if (s > 0 && pipeline->stages[s - 1].next_stage == CORD_PIPELINE_STAGE_END)
+    {
+        pipeline->stages[s - 1].next_stage = s;
+    }
+
+    pipeline->num_stages++;
+    return s;
+}
+
+int cord_pipeline_set_entry_actions(cord_pipeline_t *pipeline, uint8_t stage, uint32_t entry_id,
+                                    const cord_pipeline_action_t *actions, uint8_t count)
+{
+    if (!pipeline || stage >= pipeline->num_stages || entry_id == CORD_PIPELINE_MISS)
+    {
+        return -1;
+    }
+
+    cord_pipeline_stage_t *st = &pipeline->stages[stage];
+
+    // Grow the per-entry table on demand
+    if (entry_id >= st->num_entry_actions)
+    {
+        uint32_t new_size = st->num_entry_actions ? st->num_entry_actions : 16;
+        while (new_size <= entry_id)
+        {
+            new_size *= 2;
+        }
+
+        cord_pipeline_action_list_t *lists = realloc(st->entry_actions, new_size * sizeof(cord_pipeline_action_list_t));
+        if (!lists)
+        {
+            return -1;
+        }
+
+        memset(&lists[st->num_entry_actions], 0,
+               (new_size - st->num_entry_actions) * sizeof(cord_pipeline_action_list_t));
+        st->entry_actions = lists;
+        st->num_entry_actions = new_size;
+    }
+
+    return pipeline_copy_actions(&st->entry_actions[entry_id], actions, count);
+}
+
+int cord_pipeline_set_hit_actions(cord_pipeline_t *pipeline, uint8_t stage,
+                                  const cord_pipeline_action_t *actions, uint8_t count)
+{
+    if (!pipeline || stage >= pipeline->num_stages)
+    {
+        return -1;
+    }
+
+    return pipeline_copy_actions(&pipeline->stages[stage].hit_actions, actions, count);
+}
+
+int cord_pipeline_set_miss_actions(cord_pipeline_t *pipeline, uint8_t stage,
+                                   const cord_pipeline_action_t *actions, uint8_t count)
+{
+    if (!pipeline || stage >= pipeline->num_stages)
+    {
+        return -1;
+    }
+
+    return pipeline_copy_actions(&pipeline->stages[stage].miss_actions, actions, count);
+}
+
+int cord_pipeline_set_next_stage(cord_pipeline_t *pipeline, uint8_t stage, uint8_t next_stage)
+{
+    if (!pipeline || stage >= pipeline->num_stages)
+    {
+        return -1;
+    }
+
+    // Only forward chaining to a stage that has been added
+    if (next_stage != CORD_PIPELINE_STAGE_END && (next_stage <= stage || next_stage >= pipeline->num_stages))
+    {
+        return -1;
+    }
+
+    pipeline->stages[stage].next_stage = next_stage;
+    return 0;
+}
+
+//
+// Pipeline Execution
+//
+
+void cord_pipeline_run(cord_pipeline_t *pipeline, cord_pipeline_pkt_t **pkts,
+                       cord_pipeline_md_t *md, uint32_t count)
+{
+    for (uint32_t base = 0; base < count; base += CORD_PIPELINE_BURST_SIZE)
+    {
+        uint32_t n = (count - base < CORD_PIPELINE_BURST_SIZE) ? count - base : CORD_PIPELINE_BURST_SIZE;
+        pipeline_run_burst(pipeline, &pkts[base], &md[base], n);
+    }
+}
+
+//
+// Statistics
+//
+
+void cord_pipeline_print_stats(const cord_pipeline_t *pipeline)
+{
+    if (!pipeline)
+    {
+        return;
+    }
+
+    static const char *stage_names[] = { "L2 CAM", "IPv4 LPM", "IPv4 ACL", "Custom" };
+
+    CORD_LOG("=== Pipeline Statistics ===\n");
+    CORD_LOG("Stages:           %u\n", pipeline->num_stages);
+    CORD_LOG("Packets:          %lu\n", pipeline->packet_count);
+    CORD_LOG("Dropped:          %lu\n", pipeline->drop_count);
+    for (uint8_t s = 0; s < pipeline->num_stages; s++)
+    {
+        const cord_pipeline_stage_t *stage = &pipeline->stages[s];
+        CORD_LOG("Stage %u (%s): hits %lu, misses %lu, next %d\n", s, stage_names[stage->type],
+                 stage->hit_count, stage->miss_count,
+                 stage->next_stage == CORD_PIPELINE_STAGE_END ? -1 : (int)stage->next_stage);
+    }
+    CORD_LOG("===========================\n");
+}
@@ -0,0 +1,545 @@
+#include <table/cord_acl.h>
+#include <match/cord_match.h>
+#include <memory/cord_memory.h>
+#include <telemetry/cord_cycles.h>
+#include <string.h>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+//
+// IPv4 5-tuple ACL Implementation - Bit-Vector Algorithm
+//
+// Build:    rules -> per-field elementary intervals -> per-interval rule bitmaps
+// Classify: interval search per field -> AND of 5 bitmaps -> first set bit
+//
+
+#define CORD_ACL_BATCH_SIZE 32
+
+// Field value domains (inclusive upper bound)
+static const uint32_t acl_field_max[CORD_ACL_FIELD_COUNT] = {
+    [CORD_ACL_FIELD_SRC_IPV4] = 0xFFFFFFFF,
+    [CORD_ACL_FIELD_DST_IPV4] = 0xFFFFFFFF,
+    [CORD_ACL_FIELD_SRC_PORT] = 0xFFFF,
+    [CORD_ACL_FIELD_DST_PORT] = 0xFFFF,
+    [CORD_ACL_FIELD_PROTO]    = 0xFF,
+};
+
+//
+// Internal Helper Functions
+//
+
+static inline void acl_prefix_to_range(uint32_t ip, uint8_t depth, uint32_t *lo, uint32_t *hi)
+{
+    uint32_t mask = (depth == 0) ? 0 : (depth >= 32) ? 0xFFFFFFFF : ~(0xFFFFFFFF >> depth);
+    *lo = ip & mask;
+    *hi = *lo | ~mask;
+}
+
+// Rule -> inclusive [lo, hi] range for one field
+static void acl_rule_range(const cord_acl_rule_t *rule, cord_acl_field_id_t field, uint32_t *lo, uint32_t *hi)
+{
+    switch (field)
+    {
+        case CORD_ACL_FIELD_SRC_IPV4:
+            acl_prefix_to_range(rule->src_ip, rule->src_depth, lo, hi);
+            break;
+        case CORD_ACL_FIELD_DST_IPV4:
+            acl_prefix_to_range(rule->dst_ip, rule->dst_depth, lo, hi);
+            break;
+        case CORD_ACL_FIELD_SRC_PORT:
+            *lo = rule->src_port_min;
+            *hi = rule->src_port_max;
+            break;
+        case CORD_ACL_FIELD_DST_PORT:
+            *lo = rule->dst_port_min;
+            *hi = rule->dst_port_max;
+            break;
+        case CORD_ACL_FIELD_PROTO:
+        default:
+            *lo = rule->proto_any ? 0 : rule->proto;
+            *hi = rule->proto_any ? 0xFF : rule->proto;
+            break;
+    }
+}
+
+static int acl_cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Index of the interval containing value (largest i with bounds[i] <= value)
+static inline uint32_t acl_interval_search(const cord_acl_field_t *f, uint32_t value)
+{
+    uint32_t lo = 0;
+    uint32_t hi = f->num_intervals - 1;
+
+    while (lo < hi)
+    {
+        uint32_t mid = (lo + hi + 1) >> 1;
+        if (f->bounds[mid] <= value)
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid - 1;
+        }
+    }
+
+    return lo;
+}
+
+static void acl_field_free(cord_acl_field_t *f)
+{
+    free(f->bounds);
+    free(f->direct);
+    free(f->bitmaps);
+    memset(f, 0, sizeof(cord_acl_field_t));
+}
+
+static int acl_field_build(cord_acl_t *acl, cord_acl_field_id_t field)
+{
+    cord_acl_field_t *f = &acl->fields[field];
+    uint32_t max = acl_field_max[field];
+
+    // Collect interval start points: 0, every lo and every hi + 1
+    uint32_t *points = malloc((2 * acl->num_rules + 1) * sizeof(uint32_t));
+    if (!points)
+    {
+        return -1;
+    }
+
+    uint32_t num_points = 0;
+    points[num_points++] = 0;
+    for (uint32_t r = 0; r < acl->num_rules; r++)
+    {
+        uint32_t lo, hi;
+        acl_rule_range(&acl->rules[r], field, &lo, &hi);
+        points[num_points++] = lo;
+        if (hi < max)
+        {
+            points[num_points++] = hi + 1;
+        }
+    }
+
+    qsort(points, num_points, sizeof(uint32_t), acl_cmp_u32);
+
+    uint32_t num_intervals = 1;
+    for (uint32_t i = 1; i < num_points; i++)
+    {
+        if (points[i] != points[num_intervals - 1])
+        {
+            points[num_intervals++] = points[i];
+        }
+    }
+
+    f->bounds = points;
+    f->num_intervals = num_intervals;
+
+    // Rule bitmaps, one cache-aligned row per interval
+    f->bitmaps_size = CORD_ALIGN_TO_CACHE_LINE((size_t)num_intervals * acl->word_stride * sizeof(uint64_t));
+    f->bitmaps = aligned_alloc(CORD_CACHE_LINE_SIZE, f->bitmaps_size);
+    if (!f->bitmaps)
+    {
+        acl_field_free(f);
+        return -1;
+    }
+    memset(f->bitmaps, 0, f->bitmaps_size);
+
+    for (uint32_t r = 0; r < acl->num_rules; r++)
+    {
+        uint32_t lo, hi;
+        acl_rule_range(&acl->rules[r], field, &lo, &hi);
+
+        uint32_t first = acl_interval_search(f, lo);
+        uint32_t last = acl_interval_search(f, hi);
+        uint64_t bit = 1ULL << (r % CORD_ACL_WORD_BITS);
+
+        for (uint32_t i = first; i <= last; i++)
+        {
+            f->bitmaps[(size_t)i * acl->word_stride + r / CORD_ACL_WORD_BITS] |= bit;
+        }
+    }
+
+    // Small domains (ports, protocol) resolve the interval with a direct index
+    if (max <= 0xFFFF)
+    {
+        f->direct = malloc(((size_t)max + 1) * sizeof(uint16_t));
+        if (!f->direct)
+        {
+            acl_field_free(f);
+            return -1;
+        }
+
+        uint32_t interval = 0;
+        for (uint32_t v = 0; v <= max; v++)
+        {
+            if (interval + 1 < num_intervals && f->bounds[interval + 1] == v)
+            {
+                interval++;
+            }
+            f->direct[v] = (uint16_t)interval;
+        }
+    }
+
+    return 0;
+}
+
+static inline const uint64_t *acl_field_bitmap(const cord_acl_t *acl, cord_acl_field_id_t field, uint32_t value)
+{
+    const cord_acl_field_t *f = &acl->fields[field];
+    uint32_t interval = f->direct ? f->direct[value] : acl_interval_search(f, value);
+    return f->bitmaps + (size_t)interval * acl->word_stride;
+}
+
+static inline void acl_resolve_bitmaps(const cord_acl_t *acl, const cord_acl_key_t *key,
+                                       const uint64_t *bm[CORD_ACL_FIELD_COUNT])
+{
+    bm[CORD_ACL_FIELD_SRC_IPV4] = acl_field_bitmap(acl, CORD_ACL_FIELD_SRC_IPV4, key->src_ip);
+    bm[CORD_ACL_FIELD_DST_IPV4] = acl_field_bitmap(acl, CORD_ACL_FIELD_DST_IPV4, key->dst_ip);
+    bm[CORD_ACL_FIELD_SRC_PORT] = acl_field_bitmap(acl, CORD_ACL_FIELD_SRC_PORT, key->src_port);
+    bm[CORD_ACL_FIELD_DST_PORT] = acl_field_bitmap(acl, CORD_ACL_FIELD_DST_PORT, key->dst_port);
+    bm[CORD_ACL_FIELD_PROTO]    = acl_field_bitmap(acl, CORD_ACL_FIELD_PROTO, key->proto);
+}
+
+static inline uint32_t acl_word_match(const uint64_t *bm[CORD_ACL_FIELD_COUNT], uint32_t w)
+{
+    uint64_t word = bm[0][w] & bm[1][w] & bm[2][w] & bm[3][w] & bm[4][w];
+    return word ? w * CORD_ACL_WORD_BITS + (uint32_t)__builtin_ctzll(word) : CORD_ACL_NO_MATCH;
+}
+
+// AND the field bitmaps and return the lowest set bit (highest priority rule)
+static inline uint32_t acl_first_match(const cord_acl_t *acl, const uint64_t *bm[CORD_ACL_FIELD_COUNT])
+{
+#if defined(__AVX512F__)
+    for (uint32_t w = 0; w < acl->word_stride; w += 8)
+    {
+        __m512i v = _mm512_load_si512((const void *)(bm[0] + w));
+        v = _mm512_and_si512(v, _mm512_load_si512((const void *)(bm[1] + w)));
+        v = _mm512_and_si512(v, _mm512_load_si512((const void *)(bm[2] + w)));
+        v = _mm512_and_si512(v, _mm512_load_si512((const void *)(bm[3] + w)));
+        v = _mm512_and_si512(v, _mm512_load_si512((const void *)(bm[4] + w)));
+
+        __mmask8 nonzero = _mm512_test_epi64_mask(v, v);
+        if (nonzero)
+        {
+            return acl_word_match(bm, w + (uint32_t)__builtin_ctz(nonzero));
+        }
+    }
+    return CORD_ACL_NO_MATCH;
+#elif defined(__AVX2__)
+    for (uint32_t w = 0; w < acl->word_stride; w += 4)
+    {
+        __m256i v = _mm256_load_si256((const __m256i *)(bm[0] + w));
+        v = _mm256_and_si256(v, _mm256_load_si256((const __m256i *)(bm[1] + w)));
+        v = _mm256_and_si256(v, _mm256_load_si256((const __m256i *)(bm[2] + w)));
+        v = _mm256_and_si256(v, _mm256_load_si256((const __m256i *)(bm[3] + w)));
+        v = _mm256_and_si256(v, _mm256_load_si256((const __m256i *)(bm[4] + w)));
+
+        if (!_mm256_testz_si256(v, v))
+        {
+            // One bit per 64-bit lane that holds a match
+            uint32_t nonzero = (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(
+                _mm256_cmpeq_epi64(v, _mm256_setzero_si256()))) ^ 0xF;
+            return acl_word_match(bm, w + (uint32_t)__builtin_ctz(nonzero));
+        }
+    }
+    return CORD_ACL_NO_MATCH;
+#else
+    for (uint32_t w = 0; w < acl->num_words; w++)
+    {
+        uint32_t rule_id = acl_word_match(bm, w);
+        if (rule_id != CORD_ACL_NO_MATCH)
+        {
+            return rule_id;
+        }
+    }
+    return CORD_ACL_NO_MATCH;
+#endif
+}
+
+//
+// ACL Create/Destroy
+//
+
+cord_acl_t *cord_acl_create(uint32_t max_rules)
+{
+    if (max_rules == 0 || max_rules > CORD_ACL_MAX_RULES)
+    {
+        return NULL;
+    }
+
+    cord_acl_t *acl = calloc(1, sizeof(cord_acl_t));
+    if (!acl)
+    {
+        return NULL;
+    }
+
+    acl->rules = calloc(max_rules, sizeof(cord_acl_rule_t));
+    if (!acl->rules)
+    {
+        free(acl);
+        return NULL;
+    }
+
+    acl->max_rules = max_rules;
+    acl->num_rules = 0;
+    acl->built = false;
+
+    return acl;
+}
+
+void cord_acl_destroy(cord_acl_t *acl)
+{
+    if (!acl)
+    {
+        return;
+    }
+
+    for (uint32_t f = 0; f < CORD_ACL_FIELD_COUNT; f++)
+    {
+        acl_field_free(&acl->fields[f]);
+    }
+
+    free(acl->rules);
+    free(acl);
+}
+
+//
+// ACL Rule Management
+//
+
+int cord_acl_add(cord_acl_t *acl, const cord_acl_rule_t *rule)
+{
+    if (!acl || !rule)
+    {
+        return -1;
+    }
+
+    if (acl->num_rules >= acl->max_rules)
+    {
+        return -1; // Table full
+    }
+
+    if (rule->src_depth > 32 || rule->dst_depth > 32 ||
+        rule->src_port_min > rule->src_port_max ||
+        rule->dst_port_min > rule->dst_port_max)
+    {
+        return -1;
+    }
+
+    acl->rules[acl->num_rules++] = *rule;
+    acl->built = false;
+
+    return 0;
+}
+
+int cord_acl_build(cord_acl_t *acl)
+{
+    if (!acl)
+    {
+        return -1;
+    }
+
+    for (uint32_t f = 0; f < CORD_ACL_FIELD_COUNT; f++)
+    {
+        acl_field_free(&acl->fields[f]);
+    }
+
+    acl->built = false;
+    acl->num_words = (acl->num_rules + CORD_ACL_WORD_BITS - 1) / CORD_ACL_WORD_BITS;
+    acl->word_stride = (acl->num_words + CORD_ACL_WORD_ALIGN - 1) & ~(CORD_ACL_WORD_ALIGN - 1);
+
+    if (acl->num_rules == 0)
+    {
+        return 0;
+    }
+
+    for (uint32_t f = 0; f < CORD_ACL_FIELD_COUNT; f++)
+    {
+        if (acl_field_build(acl, (cord_acl_field_id_t)f) != 0)
+        {
+            for (uint32_t i = 0; i < CORD_ACL_FIELD_COUNT; i++)
+            {
+                acl_field_free(&acl->fields[i]);
+            }
+            return -1;
+        }
+    }
+
+    acl->built = true;
+    return 0;
+}
+
+void cord_acl_clear(cord_acl_t *acl)
+{
+    if (!acl)
+    {
+        return;
+    }
+
+    for (uint32_t f = 0; f < CORD_ACL_FIELD_COUNT; f++)
+    {
+        acl_field_free(&acl->fields[f]);
+    }
+
+    acl->num_rules = 0;
+    acl->num_words = 0;
+    acl->word_stride = 0;
+    acl->built = false;
+}
+
+//
+// ACL Classification
+//
+
+uint32_t cord_acl_classify(const cord_acl_t *acl, const cord_acl_key_t *key)
+{
+    // Increment lookup counter (cast away const for statistics)
+    ((cord_acl_t *)acl)->lookup_count++;
+
+    if (cord_unlikely(!acl->built))
+    {
+        return CORD_ACL_NO_MATCH;
+    }
+
+    const uint64_t *bm[CORD_ACL_FIELD_COUNT];
+    acl_resolve_bitmaps(acl, key, bm);
+
+    uint32_t rule_id = acl_first_match(acl, bm);
+    if (rule_id != CORD_ACL_NO_MATCH)
+    {
+        ((cord_acl_t *)acl)->match_count++;
+    }
+
+    return rule_id;
+}
+
+void cord_acl_classify_batch(const cord_acl_t *acl, const cord_acl_key_t *keys,
+                             uint32_t *rule_ids, uint32_t count)
+{
+    ((cord_acl_t *)acl)->lookup_count += count;
+
+    if (cord_unlikely(!acl->built))
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            rule_ids[i] = CORD_ACL_NO_MATCH;
+        }
+        return;
+    }
+
+    const uint64_t *bm[CORD_ACL_BATCH_SIZE][CORD_ACL_FIELD_COUNT];
+    uint64_t matches = 0;
+    CORD_CYCLES_START(cycles);
+
+    for (uint32_t base = 0; base < count; base += CORD_ACL_BATCH_SIZE)
+    {
+        uint32_t n = (count - base < CORD_ACL_BATCH_SIZE) ? count - base : CORD_ACL_BATCH_SIZE;
+
+        // Stage 1: resolve intervals for the whole burst and prefetch the bitmaps
+        for (uint32_t i = 0; i < n; i++)
+        {
+            acl_resolve_bitmaps(acl, &keys[base + i], bm[i]);
+            for (uint32_t f = 0; f < CORD_ACL_FIELD_COUNT; f++)
+            {
+                __builtin_prefetch(bm[i][f], 0, 3);
+            }
+        }
+
+        // Stage 2: AND the bitmaps
+        for (uint32_t i = 0; i < n; i++)
+        {
+            rule_ids[base + i] = acl_first_match(acl, bm[i]);
+            matches += (rule_ids[base + i] != CORD_ACL_NO_MATCH);
+        }
+    }
+
+    ((cord_acl_t *)acl)->match_count += matches;
+    CORD_CYCLES_STOP(cycles, CORD_CYCLES_STAGE_ACL);
+}
+
+//
+// Convenience Functions
+//
+
+void cord_acl_key_from_ipv4(const cord_ipv4_hdr_t *ip, uint32_t l3_len, cord_acl_key_t *key)
+{
+    if (l3_len < sizeof(cord_ipv4_hdr_t))
+    {
+        memset(key, 0, sizeof(*key));
+        return;
+    }
+
+    key->src_ip = cord_get_field_ipv4_src_addr_ntohl(ip);
+    key->dst_ip = cord_get_field_ipv4_dst_addr_ntohl(ip);
+    key->proto = ip->protocol;
+    key->src_port = 0;
+    key->dst_port = 0;
+
+    // Non-first fragments carry no L4 header
+    if (cord_ntohs(ip->frag_off) & 0x1FFF)
+    {
+        return;
+    }
+
+    // The ports only when the header length is sane and they are inside the packet
+    uint32_t ihl_bytes = ip->ihl * 4u;
+    if (ip->ihl < 5 || ihl_bytes + 4 > l3_len)
+    {
+        return;
+    }
+
+    if (ip->protocol == CORD_IPPROTO_TCP || ip->protocol == CORD_IPPROTO_UDP ||
+        ip->protocol == CORD_IPPROTO_SCTP)
+    {
+        // TCP, UDP and SCTP share the leading source/destination port layout
+        const cord_udp_hdr_t *l4 = (const cord_udp_hdr_t *)((const uint8_t *)ip + ihl_bytes);
+        key->src_port = cord_ntohs(l4->source);
+        key->dst_port = cord_ntohs(l4->dest);
+    }
+}
+
+//
+// Statistics
+//
+
+void cord_acl_print_stats(const cord_acl_t *acl)
+{
+    if (!acl)
+    {
+        return;
+    }
+
+    static const char *field_names[CORD_ACL_FIELD_COUNT] = {
+        "src ipv4", "dst ipv4", "src port", "dst port", "protocol"
+    };
+
+    CORD_LOG("=== ACL Statistics ===\n");
+    CORD_LOG("Rules:            %u / %u\n", acl->num_rules, acl->max_rules);
+    CORD_LOG("Built:            %s\n", acl->built ? "yes" : "no");
+    CORD_LOG("Bitmap words:     %u (stride %u)\n", acl->num_words, acl->word_stride);
+    for (uint32_t f = 0; f < CORD_ACL_FIELD_COUNT; f++)
+    {
+        CORD_LOG("Intervals (%s): %u\n", field_names[f], acl->fields[f].num_intervals);
+    }
+    CORD_LOG("Lookups:          %lu\n", acl->lookup_count);
+    CORD_LOG("Matches:          %lu\n", acl->match_count);
+    if (acl->lookup_count > 0)
+    {
+        CORD_LOG("Match rate:       %.2f%%\n",
+                 (double)acl->match_count * 100.0 / acl->lookup_count);
+    }
+#if defined(__AVX512F__)
+    CORD_LOG("Bitmap AND:       AVX-512\n");
+#elif defined(__AVX2__)
+    CORD_LOG("Bitmap AND:       AVX2\n");
+#else
+    CORD_LOG("Bitmap AND:       scalar\n");
+#endif
+    CORD_LOG("======================\n");
+}
@@ -2,6 +2,7 @@
 #include <table/cord_lpm.h>
 #include <match/cord_match.h>
 #include <action/cord_action.h>
+#include <telemetry/cord_cycles.h>
 #include <string.h>
 
 //
@@ -41,6 +42,16 @@ static inline bool mac_equal(const cord_mac_addr_t *a, const cord_mac_addr_t *b)
 
 cord_l2_cam_t *cord_l2_cam_create(uint32_t num_buckets, uint32_t max_entries)
 {
+    return cord_l2_cam_create_socket(num_buckets, max_entries, cord_numa_node_self());
+}
+
+cord_l2_cam_t *cord_l2_cam_create_socket(uint32_t num_buckets, uint32_t max_entries, int socket_id)
+{
+    if (num_buckets == 0)
+    {
+        return NULL;
+    }
+
     cord_l2_cam_t *cam = calloc(1, sizeof(cord_l2_cam_t));
     if (!cam)
     {
@@ -53,14 +64,22 @@ cord_l2_cam_t *cord_l2_cam_create(uint32_t num_buckets, uint32_t max_entries)
     cam->lookup_count = 0;
     cam->hit_count = 0;
     cam->miss_count = 0;
+    cam->socket_id = socket_id;
 
-    cam->buckets = calloc(num_buckets, sizeof(cord_l2_cam_entry_t *));
-    if (!cam->buckets)
+    // Buckets and all entries in one huge page mapping on the requested node
+    size_t buckets_size = CORD_ALIGN_TO_CACHE_LINE((size_t)num_buckets * sizeof(cord_l2_cam_entry_t *));
+    cam->mem_size = buckets_size + (size_t)max_entries * sizeof(cord_l2_cam_entry_t);
+    cam->mem = cord_alloc_hugepage_node(cam->mem_size, socket_id);
+    if (!cam->mem)
     {
         free(cam);
         return NULL;
     }
 
+    cam->buckets = (cord_l2_cam_entry_t **)cam->mem;
+    cam->entry_pool = (cord_l2_cam_entry_t *)((uint8_t *)cam->mem + buckets_size);
+    cord_l2_cam_clear(cam);
+
     return cam;
 }
 
@@ -71,20 +90,28 @@ void cord_l2_cam_destroy(cord_l2_cam_t *cam)
         return;
     }
 
-    // Free all entries in all buckets
-    for (uint32_t i = 0; i < cam->num_buckets; i++)
+    cord_free_hugepage(cam->mem, cam->mem_size);
+    free(cam);
+}
+
+// Entries come from the preallocated pool
+static inline cord_l2_cam_entry_t *cam_entry_alloc(cord_l2_cam_t *cam)
+{
+    cord_l2_cam_entry_t *entry = cam->free_entries;
+    if (entry)
     {
-        cord_l2_cam_entry_t *entry = cam->buckets[i];
-        while (entry)
-        {
-            cord_l2_cam_entry_t *next = entry->next;
-            free(entry);
-            entry = next;
-        }
+        cam->free_entries = entry->next;
+        memset(entry, 0, sizeof(cord_l2_cam_entry_t));
     }
 
-    free(cam->buckets);
-    free(cam);
+    return entry;
+}
+
+static inline void cam_entry_free(cord_l2_cam_t *cam, cord_l2_cam_entry_t *entry)
+{
+    entry->valid = 0;
+    entry->next = cam->free_entries;
+    cam->free_entries = entry;
 }
 
 //
@@ -119,7 +146,7 @@ int cord_l2_cam_add(cord_l2_cam_t *cam, const cord_mac_addr_t *mac, uint32_t por
     }
 
     // Create new entry
-    entry = calloc(1, sizeof(cord_l2_cam_entry_t));
+    entry = cam_entry_alloc(cam);
     if (!entry)
     {
         return -1;
@@ -165,7 +192,7 @@ int cord_l2_cam_delete(cord_l2_cam_t *cam, const cord_mac_addr_t *mac, uint16_t
                 cam->buckets[bucket_idx] = entry->next;
             }
 
-            free(entry);
+            cam_entry_free(cam, entry);
             cam->num_entries--;
             return 0;
         }
@@ -203,6 +230,67 @@ uint32_t cord_l2_cam_lookup(cord_l2_cam_t *cam, const cord_mac_addr_t *mac, uint
     return CORD_L2_CAM_INVALID_PORT;
 }
 
+void cord_l2_cam_lookup_batch(cord_l2_cam_t *cam, const cord_mac_addr_t * const *macs,
+                              const uint16_t *vlan_ids, uint32_t *port_ids, uint32_t count)
+{
+    uint32_t bucket_idx[CORD_L2_CAM_BATCH_SIZE];
+    CORD_CYCLES_START(cycles);
+
+    for (uint32_t base = 0; base < count; base += CORD_L2_CAM_BATCH_SIZE)
+    {
+        uint32_t n = (count - base < CORD_L2_CAM_BATCH_SIZE) ? count - base : CORD_L2_CAM_BATCH_SIZE;
+
+        // Stage 1: hash and prefetch the bucket heads
+        for (uint32_t i = 0; i < n; i++)
+        {
+            bucket_idx[i] = mac_hash(macs[base + i], vlan_ids[base + i], cam->num_buckets);
+            __builtin_prefetch(&cam->buckets[bucket_idx[i]], 0, 3);
+        }
+
+        // Stage 2: prefetch the first entry of every chain
+        for (uint32_t i = 0; i < n; i++)
+        {
+            cord_l2_cam_entry_t *entry = cam->buckets[bucket_idx[i]];
+            if (entry)
+            {
+                __builtin_prefetch(entry, 0, 3);
+            }
+        }
+
+        // Stage 3: walk the chains
+        for (uint32_t i = 0; i < n; i++)
+        {
+            const cord_mac_addr_t *mac = macs[base + i];
+            uint16_t vlan_id = vlan_ids[base + i];
+            uint32_t port_id = CORD_L2_CAM_INVALID_PORT;
+
+            cord_l2_cam_entry_t *entry = cam->buckets[bucket_idx[i]];
+            while (entry)
+            {
+                if (entry->valid && entry->vlan_id == vlan_id && mac_equal(&entry->mac, mac))
+                {
+                    port_id = entry->port_id;
+                    break;
+                }
+                entry = entry->next;
+            }
+
+            port_ids[base + i] = port_id;
+            if (port_id != CORD_L2_CAM_INVALID_PORT)
+            {
+                cam->hit_count++;
+            }
+            else
+            {
+                cam->miss_count++;
+            }
+        }
+    }
+
+    cam->lookup_count += count;
+    CORD_CYCLES_STOP(cycles, CORD_CYCLES_STAGE_L2_CAM);
+}
+
 //
 // Convenience Functions for Packet Processing
 //
@@ -283,20 +371,132 @@ void cord_l2_cam_clear(cord_l2_cam_t *cam)
         return;
     }
 
-    // Free all entries
-    for (uint32_t i = 0; i < cam->num_buckets; i++)
+    memset(cam->buckets, 0, (size_t)cam->num_buckets * sizeof(cord_l2_cam_entry_t *));
+
+    // Rebuild the free list in address order
+    cam->free_entries = NULL;
+    for (uint32_t i = cam->max_entries; i > 0; i--)
     {
-        cord_l2_cam_entry_t *entry = cam->buckets[i];
-        while (entry)
+        cam_entry_free(cam, &cam->entry_pool[i - 1]);
+    }
+
+    cam->num_entries = 0;
+}
+
+//
+// Per-NUMA-Node Replicas
+//
+
+cord_l2_cam_replicated_t *cord_l2_cam_replicated_create(uint32_t num_buckets, uint32_t max_entries)
+{
+    cord_l2_cam_replicated_t *rcam = calloc(1, sizeof(cord_l2_cam_replicated_t));
+    if (!rcam)
+    {
+        return NULL;
+    }
+
+    rcam->num_nodes = cord_numa_num_nodes();
+    for (int node = 0; node < rcam->num_nodes; node++)
+    {
+        rcam->replicas[node] = cord_l2_cam_create_socket(num_buckets, max_entries, node);
+        if (!rcam->replicas[node])
         {
-            cord_l2_cam_entry_t *next = entry->next;
-            free(entry);
-            entry = next;
+            cord_l2_cam_replicated_destroy(rcam);
+            return NULL;
         }
-        cam->buckets[i] = NULL;
     }
 
-    cam->num_entries = 0;
+    return rcam;
+}
+
+void cord_l2_cam_replicated_destroy(cord_l2_cam_replicated_t *rcam)
+{
+    if (!rcam)
+    {
+        return;
+    }
+
+    for (int node = 0; node < rcam->num_nodes; node++)
+    {
+        cord_l2_cam_destroy(rcam->replicas[node]);
+    }
+
+    free(rcam);
+}
+
+// Current port of an entry without touching the lookup statistics
+static uint32_t cord_l2_cam_find_port(const cord_l2_cam_t *cam, const cord_mac_addr_t *mac, uint16_t vlan_id)
+{
+    const cord_l2_cam_entry_t *entry = cam->buckets[mac_hash(mac, vlan_id, cam->num_buckets)];
+    while (entry)
+    {
+        if (entry->valid && entry->vlan_id == vlan_id && mac_equal(&entry->mac, mac))
+        {
+            return entry->port_id;
+        }
+        entry = entry->next;
+    }
+
+    return CORD_L2_CAM_INVALID_PORT;
+}
+
+// Put the entry of the replicas before failed_node back to its previous state
+static void cord_l2_cam_replicated_rollback(cord_l2_cam_replicated_t *rcam, int failed_node,
+                                            const cord_mac_addr_t *mac, uint32_t prev_port, uint16_t vlan_id)
+{
+    for (int node = 0; node < failed_node; node++)
+    {
+        if (prev_port == CORD_L2_CAM_INVALID_PORT)
+        {
+            cord_l2_cam_delete(rcam->replicas[node], mac, vlan_id);
+        }
+        else
+        {
+            cord_l2_cam_add(rcam->replicas[node], mac, prev_port, vlan_id);
+        }
+    }
+}
+
+int cord_l2_cam_replicated_add(cord_l2_cam_replicated_t *rcam, const cord_mac_addr_t *mac, uint32_t port_id, uint16_t vlan_id)
+{
+    if (!rcam || !mac)
+    {
+        return -1;
+    }
+
+    uint32_t prev_port = cord_l2_cam_find_port(rcam->replicas[0], mac, vlan_id);
+
+    for (int node = 0; node < rcam->num_nodes; node++)
+    {
+        if (cord_l2_cam_add(rcam->replicas[node], mac, port_id, vlan_id) != 0)
+        {
+            cord_l2_cam_replicated_rollback(rcam, node, mac, prev_port, vlan_id);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+int cord_l2_cam_replicated_delete(cord_l2_cam_replicated_t *rcam, const cord_mac_addr_t *mac, uint16_t vlan_id)
+{
+    if (!rcam || !mac)
+    {
+        return -1;
+    }
+
+    uint32_t prev_port = cord_l2_cam_find_port(rcam->replicas[0], mac, vlan_id);
+
+    for (int node = 0; node < rcam->num_nodes; node++)
+    {
+        if (cord_l2_cam_delete(rcam->replicas[node], mac, vlan_id) != 0)
+        {
+            cord_l2_cam_replicated_rollback(rcam, node, mac, prev_port, vlan_id);
+            return -1;
+        }
+    }
+
+    return 0;
 }
 
 //
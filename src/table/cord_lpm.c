@@ -1,5 +1,6 @@
 #include <table/cord_lpm.h>
 #include <memory/cord_memory.h>
+#include <telemetry/cord_cycles.h>
 #include <string.h>
 
 //
@@ -21,14 +22,9 @@ static int ipv4_tbl8_alloc(cord_ipv4_lpm_t *lpm, uint16_t *group_idx)
     // Pop a free group from the stack
     *group_idx = lpm->tbl8_free_list[--lpm->tbl8_free_count];
 
-    // Allocate memory for this group
-    lpm->tbl8_groups[*group_idx] = calloc(CORD_IPV4_LPM_TBL8_SIZE, sizeof(cord_ipv4_lpm_entry_t));
-    if (!lpm->tbl8_groups[*group_idx])
-    {
-        // Restore to free list on allocation failure
-        lpm->tbl8_free_list[lpm->tbl8_free_count++] = *group_idx;
-        return -1;
-    }
+    // Groups are carved from the pool mapped with TBL24, on the same NUMA node
+    lpm->tbl8_groups[*group_idx] = lpm->tbl8_pool + (size_t)*group_idx * CORD_IPV4_LPM_TBL8_SIZE;
+    memset(lpm->tbl8_groups[*group_idx], 0, CORD_IPV4_LPM_TBL8_SIZE * sizeof(cord_ipv4_lpm_entry_t));
 
     lpm->tbl8_used_count++;
     return 0;
@@ -41,11 +37,7 @@ static void ipv4_tbl8_free(cord_ipv4_lpm_t *lpm, uint16_t group_idx)
         return;
     }
 
-    if (lpm->tbl8_groups[group_idx])
-    {
-        free(lpm->tbl8_groups[group_idx]);
-        lpm->tbl8_groups[group_idx] = NULL;
-    }
+    lpm->tbl8_groups[group_idx] = NULL;
 
     // Push back to free list
     lpm->tbl8_free_list[lpm->tbl8_free_count++] = group_idx;
@@ -74,6 +66,11 @@ static bool ipv4_tbl8_can_reclaim(cord_ipv4_lpm_t *lpm, uint16_t group_idx, uint
 //
 
 cord_ipv4_lpm_t *cord_ipv4_lpm_create(uint32_t max_routes)
+{
+    return cord_ipv4_lpm_create_socket(max_routes, cord_numa_node_self());
+}
+
+cord_ipv4_lpm_t *cord_ipv4_lpm_create_socket(uint32_t max_routes, int socket_id)
 {
     cord_ipv4_lpm_t *lpm = calloc(1, sizeof(cord_ipv4_lpm_t));
     if (!lpm)
@@ -82,16 +79,19 @@ cord_ipv4_lpm_t *cord_ipv4_lpm_create(uint32_t max_routes)
     }
 
     lpm->max_routes = max_routes;
+    lpm->socket_id = socket_id;
 
-    // Allocate TBL24 using huge pages for performance
+    // Allocate TBL24 and the TBL8 pool in one huge page mapping on the requested node
     size_t tbl24_size = CORD_IPV4_LPM_TBL24_SIZE * sizeof(cord_ipv4_lpm_entry_t);
-    lpm->tbl24 = cord_alloc_hugepage(tbl24_size);
+    lpm->tbl24 = cord_alloc_hugepage_node(tbl24_size + CORD_IPV4_LPM_TBL8_POOL_SIZE, socket_id);
     if (!lpm->tbl24)
     {
         free(lpm);
         return NULL;
     }
 
+    lpm->tbl8_pool = lpm->tbl24 + CORD_IPV4_LPM_TBL24_SIZE;
+
     // Initialize all TBL24 entries as invalid
     memset(lpm->tbl24, 0, tbl24_size);
 
@@ -99,7 +99,7 @@ cord_ipv4_lpm_t *cord_ipv4_lpm_create(uint32_t max_routes)
     lpm->tbl8_groups = calloc(CORD_IPV4_LPM_TBL8_MAX_GROUPS, sizeof(cord_ipv4_lpm_entry_t *));
     if (!lpm->tbl8_groups)
     {
-        cord_free_hugepage(lpm->tbl24, tbl24_size);
+        cord_free_hugepage(lpm->tbl24, tbl24_size + CORD_IPV4_LPM_TBL8_POOL_SIZE);
         free(lpm);
         return NULL;
     }
@@ -125,19 +125,11 @@ void cord_ipv4_lpm_destroy(cord_ipv4_lpm_t *lpm)
         return;
     }
 
-    // Free all allocated TBL8 groups
-    for (uint32_t i = 0; i < CORD_IPV4_LPM_TBL8_MAX_GROUPS; i++)
-    {
-        if (lpm->tbl8_groups[i])
-        {
-            free(lpm->tbl8_groups[i]);
-        }
-    }
-
+    // TBL8 groups live in the TBL24 mapping
     free(lpm->tbl8_groups);
 
     size_t tbl24_size = CORD_IPV4_LPM_TBL24_SIZE * sizeof(cord_ipv4_lpm_entry_t);
-    cord_free_hugepage(lpm->tbl24, tbl24_size);
+    cord_free_hugepage(lpm->tbl24, tbl24_size + CORD_IPV4_LPM_TBL8_POOL_SIZE);
 
     free(lpm);
 }
@@ -367,14 +359,10 @@ int cord_ipv4_lpm_delete_all(cord_ipv4_lpm_t *lpm)
     size_t tbl24_size = CORD_IPV4_LPM_TBL24_SIZE * sizeof(cord_ipv4_lpm_entry_t);
     memset(lpm->tbl24, 0, tbl24_size);
 
-    // Free all TBL8 groups
+    // Release all TBL8 groups
     for (uint32_t i = 0; i < CORD_IPV4_LPM_TBL8_MAX_GROUPS; i++)
     {
-        if (lpm->tbl8_groups[i])
-        {
-            free(lpm->tbl8_groups[i]);
-            lpm->tbl8_groups[i] = NULL;
-        }
+        lpm->tbl8_groups[i] = NULL;
     }
 
     // Reset free list
@@ -396,10 +384,20 @@ int cord_ipv4_lpm_delete_all(cord_ipv4_lpm_t *lpm)
 void cord_ipv4_lpm_lookup_batch(const cord_ipv4_lpm_t *lpm, const uint32_t *ips,
                                  uint32_t *next_hops, uint32_t count)
 {
+    CORD_CYCLES_START(cycles);
+
+    // Prefetch the TBL24 entries of the whole batch before resolving any of them
+    for (uint32_t i = 0; i < count; i++)
+    {
+        __builtin_prefetch(&lpm->tbl24[ips[i] >> 8], 0, 3);
+    }
+
     for (uint32_t i = 0; i < count; i++)
     {
         next_hops[i] = cord_ipv4_lpm_lookup(lpm, ips[i]);
     }
+
+    CORD_CYCLES_STOP(cycles, CORD_CYCLES_STAGE_IPV4_LPM);
 }
 
 //
@@ -574,6 +572,12 @@ static void ipv6_tbl8_try_reclaim_from_tbl24(cord_ipv6_lpm_t *lpm, uint32_t tbl2
 //
 
 cord_ipv6_lpm_t *cord_ipv6_lpm_create(uint32_t max_routes)
+{
+    return cord_ipv6_lpm_create_socket(max_routes, cord_numa_node_self());
+}
+
+// Only the root level is node-bound; TBL8 groups are allocated on demand by the updating thread
+cord_ipv6_lpm_t *cord_ipv6_lpm_create_socket(uint32_t max_routes, int socket_id)
 {
     cord_ipv6_lpm_t *lpm = calloc(1, sizeof(cord_ipv6_lpm_t));
     if (!lpm)
@@ -582,10 +586,11 @@ cord_ipv6_lpm_t *cord_ipv6_lpm_create(uint32_t max_routes)
     }
 
     lpm->max_routes = max_routes;
+    lpm->socket_id = socket_id;
 
     // Allocate TBL24 (root level)
     size_t tbl24_size = CORD_IPV6_LPM_TBL24_SIZE * sizeof(cord_ipv6_lpm_entry_t);
-    lpm->tbl24 = cord_alloc_hugepage(tbl24_size);
+    lpm->tbl24 = cord_alloc_hugepage_node(tbl24_size, socket_id);
     if (!lpm->tbl24)
     {
         free(lpm);
@@ -1066,10 +1071,14 @@ uint32_t cord_ipv6_lpm_lookup(const cord_ipv6_lpm_t *lpm, const cord_ipv6_addr_t
 void cord_ipv6_lpm_lookup_batch(const cord_ipv6_lpm_t *lpm, const cord_ipv6_addr_t *ips,
                                  uint32_t *next_hops, uint32_t count)
 {
+    CORD_CYCLES_START(cycles);
+
     for (uint32_t i = 0; i < count; i++)
     {
         next_hops[i] = cord_ipv6_lpm_lookup(lpm, &ips[i]);
     }
+
+    CORD_CYCLES_STOP(cycles, CORD_CYCLES_STAGE_IPV6_LPM);
 }
 
 //
@@ -1130,6 +1139,156 @@ void cord_ipv6_lpm_print_stats(const cord_ipv6_lpm_t *lpm)
     CORD_LOG("===========================\n");
 }
 
+//
+// Per-NUMA-Node Replicas
+//
+
+cord_ipv4_lpm_replicated_t *cord_ipv4_lpm_replicated_create(uint32_t max_routes)
+{
+    cord_ipv4_lpm_replicated_t *rlpm = calloc(1, sizeof(cord_ipv4_lpm_replicated_t));
+    if (!rlpm)
+    {
+        return NULL;
+    }
+
+    rlpm->num_nodes = cord_numa_num_nodes();
+    for (int node = 0; node < rlpm->num_nodes; node++)
+    {
+        rlpm->replicas[node] = cord_ipv4_lpm_create_socket(max_routes, node);
+        if (!rlpm->replicas[node])
+        {
+            cord_ipv4_lpm_replicated_destroy(rlpm);
+            return NULL;
+        }
+    }
+
+    return rlpm;
+}
+
+void cord_ipv4_lpm_replicated_destroy(cord_ipv4_lpm_replicated_t *rlpm)
+{
+    if (!rlpm)
+    {
+        return;
+    }
+
+    for (int node = 0; node < rlpm->num_nodes; node++)
+    {
+        cord_ipv4_lpm_destroy(rlpm->replicas[node]);
+    }
+
+    free(rlpm);
+}
+
+int cord_ipv4_lpm_replicated_add(cord_ipv4_lpm_replicated_t *rlpm, uint32_t ip, uint8_t depth, uint32_t next_hop)
+{
+    if (!rlpm)
+    {
+        return -1;
+    }
+
+    for (int node = 0; node < rlpm->num_nodes; node++)
+    {
+        if (cord_ipv4_lpm_add(rlpm->replicas[node], ip, depth, next_hop) != 0)
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+int cord_ipv4_lpm_replicated_delete(cord_ipv4_lpm_replicated_t *rlpm, uint32_t ip, uint8_t depth)
+{
+    if (!rlpm)
+    {
+        return -1;
+    }
+
+    for (int node = 0; node < rlpm->num_nodes; node++)
+    {
+        if (cord_ipv4_lpm_delete(rlpm->replicas[node], ip, depth) != 0)
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+cord_ipv6_lpm_replicated_t *cord_ipv6_lpm_replicated_create(uint32_t max_routes)
+{
+    cord_ipv6_lpm_replicated_t *rlpm = calloc(1, sizeof(cord_ipv6_lpm_replicated_t));
+    if (!rlpm)
+    {
+        return NULL;
+    }
+
+    rlpm->num_nodes = cord_numa_num_nodes();
+    for (int node = 0; node < rlpm->num_nodes; node++)
+    {
+        rlpm->replicas[node] = cord_ipv6_lpm_create_socket(max_routes, node);
+        if (!rlpm->replicas[node])
+        {
+            cord_ipv6_lpm_replicated_destroy(rlpm);
+            return NULL;
+        }
+    }
+
+    return rlpm;
+}
+
+void cord_ipv6_lpm_replicated_destroy(cord_ipv6_lpm_replicated_t *rlpm)
+{
+    if (!rlpm)
+    {
+        return;
+    }
+
+    for (int node = 0; node < rlpm->num_nodes; node++)
+    {
+        cord_ipv6_lpm_destroy(rlpm->replicas[node]);
+    }
+
+    free(rlpm);
+}
+
+int cord_ipv6_lpm_replicated_add(cord_ipv6_lpm_replicated_t *rlpm, const cord_ipv6_addr_t *ip, uint8_t depth, uint32_t next_hop)
+{
+    if (!rlpm)
+    {
+        return -1;
+    }
+
+    for (int node = 0; node < rlpm->num_nodes; node++)
+    {
+        if (cord_ipv6_lpm_add(rlpm->replicas[node], ip, depth, next_hop) != 0)
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+int cord_ipv6_lpm_replicated_delete(cord_ipv6_lpm_replicated_t *rlpm, const cord_ipv6_addr_t *ip, uint8_t depth)
+{
+    if (!rlpm)
+    {
+        return -1;
+    }
+
+    for (int node = 0; node < rlpm->num_nodes; node++)
+    {
+        if (cord_ipv6_lpm_delete(rlpm->replicas[node], ip, depth) != 0)
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
 //
 // MAC Address Helper Functions (for MAC-based LPM research)
 //
@@ -0,0 +1,476 @@
+#include <table/cord_nexthop.h>
+#include <action/cord_action.h>
+#include <telemetry/cord_cycles.h>
+#include <string.h>
+
+#define CORD_NEXTHOP_BURST_SIZE     64      // LPM lookup chunk of cord_nexthop_route_burst()
+
+//
+// Next Hop Table Create/Destroy
+//
+
+cord_nexthop_table_t *cord_nexthop_table_create(uint32_t max_entries)
+{
+    if (max_entries == 0)
+    {
+        return NULL;
+    }
+
+    cord_nexthop_table_t *table = calloc(1, sizeof(cord_nexthop_table_t));
+    if (!table)
+    {
+        return NULL;
+    }
+
+    table->entries = aligned_alloc(CORD_NEXTHOP_L2_HDR_MAX, (size_t)max_entries * sizeof(cord_nexthop_t));
+    if (!table->entries)
+    {
+        free(table);
+        return NULL;
+    }
+
+    memset(table->entries, 0, (size_t)max_entries * sizeof(cord_nexthop_t));
+    table->max_entries = max_entries;
+
+    return table;
+}
+
+void cord_nexthop_table_destroy(cord_nexthop_table_t *table)
+{
+    if (!table)
+    {
+        return;
+    }
+
+    free(table->entries);
+    free(table);
+}
+
+//
+// Next Hop Management
+//
+
+int cord_nexthop_set(cord_nexthop_table_t *table, uint32_t nh_id,
+                     const cord_mac_addr_t *src_mac, const cord_mac_addr_t *dst_mac,
+                     uint16_t vlan_id, uint8_t pcp, CordFlowPoint *egress)
+{
+    if (!table || !src_mac || !dst_mac || nh_id >= table->max_entries || vlan_id > 0x0FFF || pcp > 7)
+    {
+        return -1;
+    }
+
+    cord_nexthop_t *nh = &table->entries[nh_id];
+    uint8_t *hdr = nh->l2_hdr;
+
+    memset(hdr, 0, sizeof(nh->l2_hdr));
+    memcpy(hdr, dst_mac->addr, CORD_ETH_ALEN);
+    memcpy(hdr + CORD_ETH_ALEN, src_mac->addr, CORD_ETH_ALEN);
+
+    uint16_t ipv4_type = cord_htons(CORD_ETH_P_IP);
+
+    if (vlan_id)
+    {
+        uint16_t tpid = cord_htons(CORD_ETH_P_8021Q);
+        uint16_t tci = cord_htons(((uint16_t)pcp << 13) | vlan_id);
+        memcpy(hdr + 12, &tpid, sizeof(tpid));
+        memcpy(hdr + 14, &tci, sizeof(tci));
+        memcpy(hdr + 16, &ipv4_type, sizeof(ipv4_type));
+        nh->l2_len = sizeof(cord_eth_hdr_t) + sizeof(cord_vlan_hdr_t);
+    }
+    else
+    {
+        memcpy(hdr + 12, &ipv4_type, sizeof(ipv4_type));
+        nh->l2_len = sizeof(cord_eth_hdr_t);
+    }
+
+    nh->egress = egress;
+    nh->tx_count = 0;
+
+    if (!nh->valid)
+    {
+        nh->valid = true;
+        table->num_entries++;
+    }
+
+    return 0;
+}
+
+int cord_nexthop_delete(cord_nexthop_table_t *table, uint32_t nh_id)
+{
+    if (!table || nh_id >= table->max_entries || !table->entries[nh_id].valid)
+    {
+        return -1;
+    }
+
+    table->entries[nh_id].valid = false;
+    table->entries[nh_id].egress = NULL;
+    table->num_entries--;
+
+    return 0;
+}
+
+//
+// Forwarding
+//
+
+// L2 header length in front of an IPv4 packet, 0 if the frame is not IPv4
+static inline uint32_t nexthop_ipv4_l2_len(const uint8_t *data, uint32_t len)
+{
+    uint32_t l2_len = sizeof(cord_eth_hdr_t);
+
+    if (len < l2_len)
+    {
+        return 0;
+    }
+
+    uint16_t eth_proto = ((const cord_eth_hdr_t *)data)->h_proto;
+
+    if (eth_proto == cord_htons(CORD_ETH_P_8021Q) || eth_proto == cord_htons(CORD_ETH_P_8021AD))
+    {
+        if (len < l2_len + sizeof(cord_vlan_hdr_t))
+        {
+            return 0;
+        }
+
+        eth_proto = ((const cord_vlan_hdr_t *)(data + l2_len))->h_proto;
+        l2_len += sizeof(cord_vlan_hdr_t);
+    }
+
+    if (eth_proto != cord_htons(CORD_ETH_P_IP) || len < l2_len + sizeof(cord_ipv4_hdr_t))
+    {
+        return 0;
+    }
+
+    return l2_len;
+}
+
+// Rewrite the frame for the next hop; *shift is how far the frame start moves forward
+static inline cord_retval_t nexthop_rewrite(cord_nexthop_table_t *table, uint32_t nh_id,
+                                            uint8_t *data, uint32_t len, size_t headroom, int32_t *shift)
+{
+    if (nh_id >= table->max_entries || !table->entries[nh_id].valid)
+    {
+        table->invalid_count++;
+        return CORD_ERR_NOT_FOUND;
+    }
+
+    cord_nexthop_t *nh = &table->entries[nh_id];
+    uint32_t l2_len = nexthop_ipv4_l2_len(data, len);
+
+    if (l2_len == 0)
+    {
+        table->invalid_count++;
+        return CORD_ERR_INVALID;
+    }
+
+    cord_ipv4_hdr_t *ip = (cord_ipv4_hdr_t *)(data + l2_len);
+
+    if (ip->ttl <= 1)
+    {
+        table->ttl_expired_count++;
+        return CORD_ERR_INVALID;
+    }
+
+    int32_t delta = (int32_t)l2_len - (int32_t)nh->l2_len;
+    if (delta < 0 && headroom < (size_t)(-delta))
+    {
+        table->invalid_count++;
+        return CORD_ERR_NO_MEMORY;
+    }
+
+    cord_set_field_ipv4_ttl_csum(ip, ip->ttl - 1);
+
+    // Fixed-size copies of the prebuilt header, right in front of the IPv4 header
+    uint8_t *l2 = (uint8_t *)ip - nh->l2_len;
+    if (nh->l2_len == sizeof(cord_eth_hdr_t))
+    {
+        memcpy(l2, nh->l2_hdr, sizeof(cord_eth_hdr_t));
+    }
+    else
+    {
+        memcpy(l2, nh->l2_hdr, sizeof(cord_eth_hdr_t) + sizeof(cord_vlan_hdr_t));
+    }
+
+    nh->tx_count++;
+    table->forward_count++;
+    *shift = delta;
+
+    return CORD_OK;
+}
+
+static inline CordFlowPoint *nexthop_egress(const cord_nexthop_table_t *table, uint32_t nh_id)
+{
+    return table->entries[nh_id].egress;
+}
+
+// Destination address (host byte order) of an IPv4 frame
+static inline bool nexthop_ipv4_dst(const uint8_t *data, uint32_t len, uint32_t *dst)
+{
+    uint32_t l2_len = nexthop_ipv4_l2_len(data, len);
+
+    if (l2_len == 0)
+    {
+        return false;
+    }
+
+    *dst = cord_ntohl(((const cord_ipv4_hdr_t *)(data + l2_len))->daddr.addr);
+    return true;
+}
+
+// Default dataplane (L2 raw socket)
+#if !defined(ENABLE_DPDK_DATAPLANE) && !defined(ENABLE_XDP_DATAPLANE)
+
+cord_retval_t cord_nexthop_forward(cord_nexthop_table_t *table, uint32_t nh_id, cord_raw_pkt_desc_t *pkt)
+{
+    int32_t shift = 0;
+    cord_retval_t ret = nexthop_rewrite(table, nh_id, pkt->data, pkt->data_len, cord_raw_pkt_headroom(pkt), &shift);
+
+    if (ret != CORD_OK)
+    {
+        return ret;
+    }
+
+    if (shift > 0)
+    {
+        cord_raw_pkt_adj(pkt, shift);
+    }
+    else if (shift < 0)
+    {
+        cord_raw_pkt_prepend(pkt, -shift);
+    }
+
+    return CORD_OK;
+}
+
+uint32_t cord_nexthop_forward_burst(cord_nexthop_table_t *table, const uint32_t *nh_ids,
+                                    cord_raw_pkt_desc_t **pkts, CordFlowPoint **egress, uint32_t count)
+{
+    uint32_t done = 0;
+    CORD_CYCLES_START(cycles);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (i + CORD_NEXTHOP_PREFETCH < count)
+        {
+            __builtin_prefetch(pkts[i + CORD_NEXTHOP_PREFETCH]->data, 1);
+        }
+
+        if (cord_nexthop_forward(table, nh_ids[i], pkts[i]) == CORD_OK)
+        {
+            egress[i] = nexthop_egress(table, nh_ids[i]);
+            done++;
+        }
+        else
+        {
+            egress[i] = NULL;
+        }
+    }
+
+    CORD_CYCLES_STOP(cycles, CORD_CYCLES_STAGE_NEXTHOP);
+    return done;
+}
+
+uint32_t cord_nexthop_route_burst(cord_nexthop_table_t *table, const cord_ipv4_lpm_t *lpm,
+                                  cord_raw_pkt_desc_t **pkts, CordFlowPoint **egress, uint32_t count)
+{
+    uint32_t done = 0;
+
+    for (uint32_t base = 0; base < count; base += CORD_NEXTHOP_BURST_SIZE)
+    {
+        uint32_t n = (count - base < CORD_NEXTHOP_BURST_SIZE) ? count - base : CORD_NEXTHOP_BURST_SIZE;
+        uint32_t ips[CORD_NEXTHOP_BURST_SIZE];
+        uint32_t nh_ids[CORD_NEXTHOP_BURST_SIZE];
+
+        for (uint32_t i = 0; i < n; i++)
+        {
+            // Non-IPv4 frames get a lookup of 0.0.0.0; nexthop_rewrite() rejects them anyway
+            if (!nexthop_ipv4_dst(pkts[base + i]->data, pkts[base + i]->data_len, &ips[i]))
+            {
+                ips[i] = 0;
+            }
+        }
+
+        cord_ipv4_lpm_lookup_batch(lpm, ips, nh_ids, n);
+        done += cord_nexthop_forward_burst(table, nh_ids, pkts + base, egress + base, n);
+    }
+
+    return done;
+}
+
+#endif // Default dataplane
+
+#ifdef ENABLE_DPDK_DATAPLANE
+
+cord_retval_t cord_nexthop_forward(cord_nexthop_table_t *table, uint32_t nh_id, struct rte_mbuf *mbuf)
+{
+    int32_t shift = 0;
+    cord_retval_t ret = nexthop_rewrite(table, nh_id, rte_pktmbuf_mtod(mbuf, uint8_t *),
+                                        rte_pktmbuf_data_len(mbuf), rte_pktmbuf_headroom(mbuf), &shift);
+
+    if (ret != CORD_OK)
+    {
+        return ret;
+    }
+
+    if (shift > 0)
+    {
+        rte_pktmbuf_adj(mbuf, shift);
+    }
+    else if (shift < 0)
+    {
+        rte_pktmbuf_prepend(mbuf, -shift);
+    }
+
+    return CORD_OK;
+}
+
+uint32_t cord_nexthop_forward_burst(cord_nexthop_table_t *table, const uint32_t *nh_ids,
+                                    struct rte_mbuf **mbufs, CordFlowPoint **egress, uint32_t count)
+{
+    uint32_t done = 0;
+    CORD_CYCLES_START(cycles);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (i + CORD_NEXTHOP_PREFETCH < count)
+        {
+            rte_prefetch0(rte_pktmbuf_mtod(mbufs[i + CORD_NEXTHOP_PREFETCH], void *));
+        }
+
+        if (cord_nexthop_forward(table, nh_ids[i], mbufs[i]) == CORD_OK)
+        {
+            egress[i] = nexthop_egress(table, nh_ids[i]);
+            done++;
+        }
+        else
+        {
+            egress[i] = NULL;
+        }
+    }
+
+    CORD_CYCLES_STOP(cycles, CORD_CYCLES_STAGE_NEXTHOP);
+    return done;
+}
+
+uint32_t cord_nexthop_route_burst(cord_nexthop_table_t *table, const cord_ipv4_lpm_t *lpm,
+                                  struct rte_mbuf **mbufs, CordFlowPoint **egress, uint32_t count)
+{
+    uint32_t done = 0;
+
+    for (uint32_t base = 0; base < count; base += CORD_NEXTHOP_BURST_SIZE)
+    {
+        uint32_t n = (count - base < CORD_NEXTHOP_BURST_SIZE) ? count - base : CORD_NEXTHOP_BURST_SIZE;
+        uint32_t ips[CORD_NEXTHOP_BURST_SIZE];
+        uint32_t nh_ids[CORD_NEXTHOP_BURST_SIZE];
+
+        for (uint32_t i = 0; i < n; i++)
+        {
+            struct rte_mbuf *mbuf = mbufs[base + i];
+            if (!nexthop_ipv4_dst(rte_pktmbuf_mtod(mbuf, uint8_t *), rte_pktmbuf_data_len(mbuf), &ips[i]))
+            {
+                ips[i] = 0;
+            }
+        }
+
+        cord_ipv4_lpm_lookup_batch(lpm, ips, nh_ids, n);
+        done += cord_nexthop_forward_burst(table, nh_ids, mbufs + base, egress + base, n);
+    }
+
+    return done;
+}
+
+#endif // ENABLE_DPDK_DATAPLANE
+
+#ifdef ENABLE_XDP_DATAPLANE
+
+cord_retval_t cord_nexthop_forward(cord_nexthop_table_t *table, uint32_t nh_id, struct cord_xdp_pkt_desc *pkt)
+{
+    int32_t shift = 0;
+    cord_retval_t ret = nexthop_rewrite(table, nh_id, (uint8_t *)pkt->data, pkt->len,
+                                        cord_xdp_pkt_headroom(pkt), &shift);
+
+    if (ret != CORD_OK)
+    {
+        return ret;
+    }
+
+    pkt->data = (void *)((uint8_t *)pkt->data + shift);
+    pkt->len -= shift;
+
+    return CORD_OK;
+}
+
+uint32_t cord_nexthop_forward_burst(cord_nexthop_table_t *table, const uint32_t *nh_ids,
+                                    struct cord_xdp_pkt_desc **pkts, CordFlowPoint **egress, uint32_t count)
+{
+    uint32_t done = 0;
+    CORD_CYCLES_START(cycles);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (i + CORD_NEXTHOP_PREFETCH < count)
+        {
+            __builtin_prefetch(pkts[i + CORD_NEXTHOP_PREFETCH]->data, 1);
+        }
+
+        if (cord_nexthop_forward(table, nh_ids[i], pkts[i]) == CORD_OK)
+        {
+            egress[i] = nexthop_egress(table, nh_ids[i]);
+            done++;
+        }
+        else
+        {
+            egress[i] = NULL;
+        }
+    }
+
+    CORD_CYCLES_STOP(cycles, CORD_CYCLES_STAGE_NEXTHOP);
+    return done;
+}
+
+uint32_t cord_nexthop_route_burst(cord_nexthop_table_t *table, const cord_ipv4_lpm_t *lpm,
+                                  struct cord_xdp_pkt_desc **pkts, CordFlowPoint **egress, uint32_t count)
+{
+    uint32_t done = 0;
+
+    for (uint32_t base = 0; base < count; base += CORD_NEXTHOP_BURST_SIZE)
+    {
+        uint32_t n = (count - base < CORD_NEXTHOP_BURST_SIZE) ? count - base : CORD_NEXTHOP_BURST_SIZE;
+        uint32_t ips[CORD_NEXTHOP_BURST_SIZE];
+        uint32_t nh_ids[CORD_NEXTHOP_BURST_SIZE];
+
+        for (uint32_t i = 0; i < n; i++)
+        {
+            if (!nexthop_ipv4_dst((const uint8_t *)pkts[base + i]->data, pkts[base + i]->len, &ips[i]))
+            {
+                ips[i] = 0;
+            }
+        }
+
+        cord_ipv4_lpm_lookup_batch(lpm, ips, nh_ids, n);
+        done += cord_nexthop_forward_burst(table, nh_ids, pkts + base, egress + base, n);
+    }
+
+    return done;
+}
+
+#endif // ENABLE_XDP_DATAPLANE
+
+//
+// Statistics
+//
+
+void cord_nexthop_print_stats(const cord_nexthop_table_t *table)
+{
+    if (!table)
+    {
+        return;
+    }
+
+    CORD_LOG("=== Next Hop Statistics ===\n");
+    CORD_LOG("Entries:          %u / %u\n", table->num_entries, table->max_entries);
+    CORD_LOG("Forwarded:        %lu\n", table->forward_count);
+    CORD_LOG("TTL expired:      %lu\n", table->ttl_expired_count);
+    CORD_LOG("Invalid:          %lu\n", table->invalid_count);
+    CORD_LOG("===========================\n");
+}
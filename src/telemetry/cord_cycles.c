@@ -0,0 +1,166 @@
+#include <telemetry/cord_cycles.h>
+#include <cord_error.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+_Thread_local cord_cycles_thread_t *cord_cycles_self = NULL;
+
+// Blocks of the registered threads; slots are published once and never released
+static cord_cycles_thread_t *cord_cycles_threads[CORD_CYCLES_MAX_THREADS];
+static atomic_uint cord_cycles_next_slot = 0;
+
+// Threads beyond CORD_CYCLES_MAX_THREADS share it; it is never read
+static cord_cycles_thread_t cord_cycles_discard;
+
+static const char *cord_cycles_stage_names[CORD_CYCLES_STAGE_COUNT] = {
+    "rx", "parse", "l2_cam", "ipv4_lpm", "ipv6_lpm", "acl", "custom_lookup", "actions", "nexthop", "tx"
+};
+
+cord_cycles_thread_t *cord_cycles_thread_register(void)
+{
+    cord_cycles_thread_t *block = &cord_cycles_discard;
+
+    unsigned int slot = atomic_fetch_add_explicit(&cord_cycles_next_slot, 1, memory_order_relaxed);
+    if (slot < CORD_CYCLES_MAX_THREADS)
+    {
+        cord_cycles_thread_t *own = aligned_alloc(CORD_CACHE_LINE_SIZE, sizeof(cord_cycles_thread_t));
+        if (own)
+        {
+            memset(own, 0, sizeof(cord_cycles_thread_t));
+            __atomic_store_n(&cord_cycles_threads[slot], own, __ATOMIC_RELEASE);
+            block = own;
+        }
+        else
+        {
+            CORD_ERROR("[cord_cycles_thread_register] aligned_alloc");
+        }
+    }
+
+    cord_cycles_self = block;
+    return block;
+}
+
+//
+// Readers
+//
+
+void cord_cycles_get(cord_cycles_stage_t stage, cord_cycles_hist_t *hist)
+{
+    memset(hist, 0, sizeof(cord_cycles_hist_t));
+
+    if (stage >= CORD_CYCLES_STAGE_COUNT)
+        return;
+
+    for (uint32_t t = 0; t < CORD_CYCLES_MAX_THREADS; t++)
+    {
+        const volatile cord_cycles_hist_t *src;
+        cord_cycles_thread_t *block = __atomic_load_n(&cord_cycles_threads[t], __ATOMIC_ACQUIRE);
+        if (!block)
+            continue;
+
+        src = &block->stages[stage];
+        hist->count += src->count;
+        hist->total += src->total;
+        if (src->max > hist->max)
+            hist->max = src->max;
+        for (uint32_t b = 0; b < CORD_CYCLES_BUCKETS; b++)
+            hist->buckets[b] += src->buckets[b];
+    }
+}
+
+uint64_t cord_cycles_percentile(const cord_cycles_hist_t *hist, double fraction)
+{
+    // The buckets are summed without a lock, so rank against them rather than count
+    uint64_t count = 0;
+    for (uint32_t b = 0; b < CORD_CYCLES_BUCKETS; b++)
+        count += hist->buckets[b];
+
+    if (count == 0)
+        return 0;
+
+    if (fraction < 0.0)
+        fraction = 0.0;
+    if (fraction > 1.0)
+        fraction = 1.0;
+
+    uint64_t rank = (uint64_t)(fraction * (double)count);
+    if (rank == 0)
+        rank = 1;
+
+    uint64_t seen = 0;
+    for (uint32_t b = 0; b < CORD_CYCLES_BUCKETS; b++)
+    {
+        seen += hist->buckets[b];
+        if (seen >= rank)
+            return cord_cycles_bucket_floor(b);
+    }
+
+    return hist->max;
+}
+
+const char *cord_cycles_stage_name(cord_cycles_stage_t stage)
+{
+    return (stage < CORD_CYCLES_STAGE_COUNT) ? cord_cycles_stage_names[stage] : "unknown";
+}
+
+uint64_t cord_cycles_hz(void)
+{
+    static atomic_uint_fast64_t hz = 0;
+
+    uint64_t cached = atomic_load_explicit(&hz, memory_order_relaxed);
+    if (cached)
+        return cached;
+
+    // 10 ms against the monotonic clock: good to ~0.1%, enough for ns conversions
+    struct timespec ts_start, ts_end, period = { .tv_sec = 0, .tv_nsec = 10000000L };
+    clock_gettime(CLOCK_MONOTONIC, &ts_start);
+    uint64_t start = cord_cycles_now();
+    nanosleep(&period, NULL);
+    uint64_t end = cord_cycles_now();
+    clock_gettime(CLOCK_MONOTONIC, &ts_end);
+
+    uint64_t ns = (uint64_t)(ts_end.tv_sec - ts_start.tv_sec) * 1000000000ULL + (uint64_t)ts_end.tv_nsec - (uint64_t)ts_start.tv_nsec;
+    cached = ns ? (uint64_t)((double)(end - start) * 1e9 / (double)ns) : 1000000000ULL;
+    if (cached == 0)
+        cached = 1000000000ULL;
+
+    atomic_store_explicit(&hz, cached, memory_order_relaxed);
+    return cached;
+}
+
+void cord_cycles_reset(void)
+{
+    for (uint32_t t = 0; t < CORD_CYCLES_MAX_THREADS; t++)
+    {
+        cord_cycles_thread_t *block = __atomic_load_n(&cord_cycles_threads[t], __ATOMIC_ACQUIRE);
+        if (block)
+            memset(block->stages, 0, sizeof(block->stages));
+    }
+}
+
+void cord_cycles_print_stats(void)
+{
+    double ns_per_cycle = 1e9 / (double)cord_cycles_hz();
+
+    CORD_LOG("=== Cycle Statistics (%.2f GHz) ===\n", 1.0 / ns_per_cycle);
+#ifndef CORD_FLOW_CYCLES
+    CORD_LOG("Not recorded:     build with ENABLE_CORD_FLOW_CYCLES\n");
+#endif
+    CORD_LOG("%-16s %12s %10s %10s %10s %10s %10s\n", "Stage", "Bursts", "Mean", "p50", "p99", "p99.9", "Max");
+
+    for (uint32_t s = 0; s < CORD_CYCLES_STAGE_COUNT; s++)
+    {
+        cord_cycles_hist_t hist;
+        cord_cycles_get(s, &hist);
+        if (hist.count == 0)
+            continue;
+
+        CORD_LOG("%-16s %12lu %10lu %10lu %10lu %10lu %10lu\n",
+                 cord_cycles_stage_name(s), hist.count, hist.total / hist.count,
+                 cord_cycles_percentile(&hist, 0.50), cord_cycles_percentile(&hist, 0.99),
+                 cord_cycles_percentile(&hist, 0.999), hist.max);
+    }
+
+    CORD_LOG("(cycles per burst; 1 cycle = %.3f ns)\n", ns_per_cycle);
+}
@@ -0,0 +1,859 @@
+#include <telemetry/cord_telemetry.h>
+#include <conntrack/cord_conntrack.h>
+#include <telemetry/cord_cycles.h>
+#include <cord_error.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/mman.h>
+
+static inline void cord_telemetry_lock(cord_telemetry_t *telemetry)
+{
+    while (atomic_flag_test_and_set_explicit(&telemetry->lock, memory_order_acquire))
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        __asm__ __volatile__("yield");
+#endif
+    }
+}
+
+static inline void cord_telemetry_unlock(cord_telemetry_t *telemetry)
+{
+    atomic_flag_clear_explicit(&telemetry->lock, memory_order_release);
+}
+
+static inline uint64_t cord_telemetry_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+//
+// Seqlock (single writer: the caller holds telemetry->lock)
+//
+
+static inline void cord_telemetry_write_begin(cord_telemetry_segment_t *segment)
+{
+    uint64_t seq = atomic_load_explicit(&segment->header.seq, memory_order_relaxed);
+    atomic_store_explicit(&segment->header.seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+}
+
+static inline void cord_telemetry_write_end(cord_telemetry_segment_t *segment)
+{
+    uint64_t seq = atomic_load_explicit(&segment->header.seq, memory_order_relaxed);
+    atomic_store_explicit(&segment->header.seq, seq + 1, memory_order_release);
+}
+
+//
+// Create / Destroy
+//
+
+cord_telemetry_t *cord_telemetry_create(const char *shm_name, uint32_t interval_ms)
+{
+    const char *name = shm_name ? shm_name : CORD_TELEMETRY_DEFAULT_NAME;
+
+    cord_telemetry_t *telemetry = calloc(1, sizeof(cord_telemetry_t));
+    if (!telemetry)
+    {
+        CORD_ERROR("[cord_telemetry_create] calloc");
+        return NULL;
+    }
+
+    snprintf(telemetry->shm_name, sizeof(telemetry->shm_name), "%s", name);
+    telemetry->interval_ms = interval_ms ? interval_ms : CORD_TELEMETRY_DEFAULT_INTERVAL_MS;
+    atomic_flag_clear(&telemetry->lock);
+    atomic_init(&telemetry->running, false);
+
+    // A segment left behind by a crashed publisher is taken over
+    int fd = shm_open(telemetry->shm_name, O_CREAT | O_RDWR, 0644);
+    if (fd < 0)
+    {
+        CORD_ERROR("[cord_telemetry_create] shm_open");
+        free(telemetry);
+        return NULL;
+    }
+
+    if (ftruncate(fd, sizeof(cord_telemetry_segment_t)) < 0)
+    {
+        CORD_ERROR("[cord_telemetry_create] ftruncate");
+        close(fd);
+        shm_unlink(telemetry->shm_name);
+        free(telemetry);
+        return NULL;
+    }
+
+    telemetry->segment = mmap(NULL, sizeof(cord_telemetry_segment_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (telemetry->segment == MAP_FAILED)
+    {
+        CORD_ERROR("[cord_telemetry_create] mmap");
+        shm_unlink(telemetry->shm_name);
+        free(telemetry);
+        return NULL;
+    }
+
+    cord_telemetry_segment_t *segment = telemetry->segment;
+
+    // Readers of a reused segment see an odd sequence until the header is valid again
+    atomic_store_explicit(&segment->header.seq, 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    memset(segment->sources, 0, sizeof(segment->sources));
+    segment->header.magic = CORD_TELEMETRY_MAGIC;
+    segment->header.version = CORD_TELEMETRY_VERSION;
+    segment->header.segment_size = sizeof(cord_telemetry_segment_t);
+    segment->header.interval_ms = telemetry->interval_ms;
+    segment->header.timestamp_ns = cord_telemetry_now_ns();
+    segment->header.snapshot_count = 0;
+    segment->header.num_sources = 0;
+    segment->header.pid = (uint32_t)getpid();
+    atomic_store_explicit(&segment->header.seq, 2, memory_order_release);
+
+    return telemetry;
+}
+
+void cord_telemetry_destroy(cord_telemetry_t *telemetry)
+{
+    if (!telemetry)
+    {
+        return;
+    }
+
+    cord_telemetry_stop(telemetry);
+
+    munmap(telemetry->segment, sizeof(cord_telemetry_segment_t));
+    shm_unlink(telemetry->shm_name);
+    free(telemetry);
+}
+
+//
+// Publishing
+//
+
+void cord_telemetry_publish(cord_telemetry_t *telemetry)
+{
+    if (!telemetry)
+    {
+        return;
+    }
+
+    cord_telemetry_segment_t *segment = telemetry->segment;
+
+    cord_telemetry_lock(telemetry);
+
+    // Collect outside the write section, so readers only retry for the copy itself
+    uint32_t num_sources = segment->header.num_sources;
+    for (uint32_t i = 0; i < num_sources; i++)
+    {
+        cord_telemetry_binding_t *binding = &telemetry->bindings[i];
+
+        memset(telemetry->staging[i], 0, sizeof(telemetry->staging[i]));
+        if (binding->collect)
+        {
+            binding->collect(binding->obj, telemetry->staging[i]);
+        }
+    }
+
+    cord_telemetry_write_begin(segment);
+    for (uint32_t i = 0; i < num_sources; i++)
+    {
+        memcpy(segment->sources[i].values, telemetry->staging[i], sizeof(telemetry->staging[i]));
+    }
+    segment->header.timestamp_ns = cord_telemetry_now_ns();
+    segment->header.snapshot_count++;
+    cord_telemetry_write_end(segment);
+
+    cord_telemetry_unlock(telemetry);
+}
+
+static void *cord_telemetry_thread(void *arg)
+{
+    cord_telemetry_t *telemetry = (cord_telemetry_t *)arg;
+    struct timespec period = {
+        .tv_sec = telemetry->interval_ms / 1000,
+        .tv_nsec = (long)(telemetry->interval_ms % 1000) * 1000000L,
+    };
+
+    while (atomic_load_explicit(&telemetry->running, memory_order_acquire))
+    {
+        cord_telemetry_publish(telemetry);
+        nanosleep(&period, NULL);
+    }
+
+    return NULL;
+}
+
+int cord_telemetry_start(cord_telemetry_t *telemetry)
+{
+    if (!telemetry || atomic_load(&telemetry->running))
+    {
+        return -1;
+    }
+
+    atomic_store(&telemetry->running, true);
+
+    if (pthread_create(&telemetry->thread, NULL, cord_telemetry_thread, telemetry) != 0)
+    {
+        CORD_ERROR("[cord_telemetry_start] pthread_create");
+        atomic_store(&telemetry->running, false);
+        return -1;
+    }
+
+    return 0;
+}
+
+void cord_telemetry_stop(cord_telemetry_t *telemetry)
+{
+    if (!telemetry || !atomic_load(&telemetry->running))
+    {
+        return;
+    }
+
+    atomic_store(&telemetry->running, false);
+    pthread_join(telemetry->thread, NULL);
+}
+
+//
+// Registration
+//
+
+int cord_telemetry_register(cord_telemetry_t *telemetry, const char *name, cord_telemetry_source_type_t type,
+                            const cord_telemetry_counter_desc_t *counters, uint32_t num_counters,
+                            cord_telemetry_collect_fn collect, const void *obj)
+{
+    if (!telemetry || !name || !counters || !collect || !obj ||
+        num_counters == 0 || num_counters > CORD_TELEMETRY_MAX_COUNTERS || type >= CORD_TELEMETRY_SOURCE_TYPE_COUNT)
+    {
+        return -1;
+    }
+
+    cord_telemetry_segment_t *segment = telemetry->segment;
+    int ret = -1;
+
+    cord_telemetry_lock(telemetry);
+
+    // Reuse a slot freed by cord_telemetry_unregister() before growing
+    uint32_t slot = segment->header.num_sources;
+    for (uint32_t i = 0; i < segment->header.num_sources; i++)
+    {
+        if (!telemetry->bindings[i].collect)
+        {
+            slot = i;
+            break;
+        }
+    }
+
+    if (slot < CORD_TELEMETRY_MAX_SOURCES)
+    {
+        cord_telemetry_source_t *source = &segment->sources[slot];
+
+        cord_telemetry_write_begin(segment);
+        memset(source, 0, sizeof(cord_telemetry_source_t));
+        snprintf(source->name, sizeof(source->name), "%s", name);
+        source->type = type;
+        source->num_counters = num_counters;
+        memcpy(source->counters, counters, num_counters * sizeof(cord_telemetry_counter_desc_t));
+        if (slot == segment->header.num_sources)
+        {
+            segment->header.num_sources++;
+        }
+        cord_telemetry_write_end(segment);
+
+        telemetry->bindings[slot].obj = obj;
+        telemetry->bindings[slot].collect = collect;
+        ret = 0;
+    }
+
+    cord_telemetry_unlock(telemetry);
+
+    return ret;
+}
+
+int cord_telemetry_unregister(cord_telemetry_t *telemetry, const void *obj)
+{
+    if (!telemetry || !obj)
+    {
+        return -1;
+    }
+
+    cord_telemetry_segment_t *segment = telemetry->segment;
+    int ret = -1;
+
+    cord_telemetry_lock(telemetry);
+
+    for (uint32_t i = 0; i < segment->header.num_sources; i++)
+    {
+        if (telemetry->bindings[i].collect && telemetry->bindings[i].obj == obj)
+        {
+            cord_telemetry_write_begin(segment);
+            memset(&segment->sources[i], 0, sizeof(cord_telemetry_source_t));
+            cord_telemetry_write_end(segment);
+
+            telemetry->bindings[i].obj = NULL;
+            telemetry->bindings[i].collect = NULL;
+            ret = 0;
+        }
+    }
+
+    cord_telemetry_unlock(telemetry);
+
+    return ret;
+}
+
+//
+// Library sources
+//
+// Counters are read with plain loads, as the print_stats() functions do: each one
+// is written by a single thread, so a snapshot may be a few packets behind, never torn
+//
+
+#define CORD_TELEMETRY_C(n)         { .name = n, .label = "", .kind = CORD_TELEMETRY_COUNTER }
+#define CORD_TELEMETRY_G(n)         { .name = n, .label = "", .kind = CORD_TELEMETRY_GAUGE }
+#define CORD_TELEMETRY_CL(n, l)     { .name = n, .label = l, .kind = CORD_TELEMETRY_COUNTER }
+#define CORD_TELEMETRY_GL(n, l)     { .name = n, .label = l, .kind = CORD_TELEMETRY_GAUGE }
+#define CORD_TELEMETRY_COUNT(descs) (uint32_t)(sizeof(descs) / sizeof((descs)[0]))
+
+// Flow points
+
+static const cord_telemetry_counter_desc_t flow_point_counters[] = {
+    CORD_TELEMETRY_C("rx_packets"),
+    CORD_TELEMETRY_C("rx_bytes"),
+    CORD_TELEMETRY_C("tx_packets"),
+    CORD_TELEMETRY_C("tx_bytes"),
+    CORD_TELEMETRY_C("rx_dropped"),
+    CORD_TELEMETRY_C("tx_dropped"),
+    CORD_TELEMETRY_C("rx_errors"),
+    CORD_TELEMETRY_C("tx_errors"),
+    CORD_TELEMETRY_C("ring_full"),
+    CORD_TELEMETRY_CL("rx_batches", "size=\"0\""),
+    CORD_TELEMETRY_CL("rx_batches", "size=\"1\""),
+    CORD_TELEMETRY_CL("rx_batches", "size=\"2-3\""),
+    CORD_TELEMETRY_CL("rx_batches", "size=\"4-7\""),
+    CORD_TELEMETRY_CL("rx_batches", "size=\"8-15\""),
+    CORD_TELEMETRY_CL("rx_batches", "size=\"16-31\""),
+    CORD_TELEMETRY_CL("rx_batches", "size=\"32-63\""),
+    CORD_TELEMETRY_CL("rx_batches", "size=\"64+\""),
+    CORD_TELEMETRY_CL("tx_batches", "size=\"0\""),
+    CORD_TELEMETRY_CL("tx_batches", "size=\"1\""),
+    CORD_TELEMETRY_CL("tx_batches", "size=\"2-3\""),
+    CORD_TELEMETRY_CL("tx_batches", "size=\"4-7\""),
+    CORD_TELEMETRY_CL("tx_batches", "size=\"8-15\""),
+    CORD_TELEMETRY_CL("tx_batches", "size=\"16-31\""),
+    CORD_TELEMETRY_CL("tx_batches", "size=\"32-63\""),
+    CORD_TELEMETRY_CL("tx_batches", "size=\"64+\""),
+};
+
+_Static_assert(CORD_FLOW_POINT_BATCH_BUCKETS == 8, "flow_point_counters lists 8 batch buckets");
+
+static void cord_telemetry_collect_flow_point(const void *obj, uint64_t *values)
+{
+    CordFlowPointQueueStats total;
+    CordFlowPoint_get_queue_stats_total((const CordFlowPoint *)obj, &total);
+
+    values[0] = total.rx_packets;
+    values[1] = total.rx_bytes;
+    values[2] = total.tx_packets;
+    values[3] = total.tx_bytes;
+    values[4] = total.rx_dropped;
+    values[5] = total.tx_dropped;
+    values[6] = total.rx_errors;
+    values[7] = total.tx_errors;
+    values[8] = total.ring_full;
+    for (uint32_t b = 0; b < CORD_FLOW_POINT_BATCH_BUCKETS; b++)
+    {
+        values[9 + b] = total.rx_batch_hist[b];
+        values[9 + CORD_FLOW_POINT_BATCH_BUCKETS + b] = total.tx_batch_hist[b];
+    }
+}
+
+int cord_telemetry_register_flow_point(cord_telemetry_t *telemetry, const char *name, const CordFlowPoint *fp)
+{
+    return cord_telemetry_register(telemetry, name, CORD_TELEMETRY_SOURCE_FLOW_POINT,
+                                   flow_point_counters, CORD_TELEMETRY_COUNT(flow_point_counters),
+                                   cord_telemetry_collect_flow_point, fp);
+}
+
+// L2 CAM
+
+static const cord_telemetry_counter_desc_t l2_cam_counters[] = {
+    CORD_TELEMETRY_G("entries"),
+    CORD_TELEMETRY_G("max_entries"),
+    CORD_TELEMETRY_C("lookups"),
+    CORD_TELEMETRY_C("hits"),
+    CORD_TELEMETRY_C("misses"),
+};
+
+static void cord_telemetry_collect_l2_cam(const void *obj, uint64_t *values)
+{
+    const volatile cord_l2_cam_t *cam = obj;
+
+    values[0] = cam->num_entries;
+    values[1] = cam->max_entries;
+    values[2] = cam->lookup_count;
+    values[3] = cam->hit_count;
+    values[4] = cam->miss_count;
+}
+
+int cord_telemetry_register_l2_cam(cord_telemetry_t *telemetry, const char *name, const cord_l2_cam_t *cam)
+{
+    return cord_telemetry_register(telemetry, name, CORD_TELEMETRY_SOURCE_L2_CAM,
+                                   l2_cam_counters, CORD_TELEMETRY_COUNT(l2_cam_counters),
+                                   cord_telemetry_collect_l2_cam, cam);
+}
+
+// LPM
+
+static const cord_telemetry_counter_desc_t lpm_counters[] = {
+    CORD_TELEMETRY_G("routes"),
+    CORD_TELEMETRY_G("max_routes"),
+    CORD_TELEMETRY_G("tbl8_groups_used"),
+    CORD_TELEMETRY_C("lookups"),
+};
+
+static void cord_telemetry_collect_ipv4_lpm(const void *obj, uint64_t *values)
+{
+    const volatile cord_ipv4_lpm_t *lpm = obj;
+
+    values[0] = lpm->routes_count;
+    values[1] = lpm->max_routes;
+    values[2] = lpm->tbl8_used_count;
+    values[3] = lpm->lookup_count;
+}
+
+static void cord_telemetry_collect_ipv6_lpm(const void *obj, uint64_t *values)
+{
+    const volatile cord_ipv6_lpm_t *lpm = obj;
+
+    values[0] = lpm->routes_count;
+    values[1] = lpm->max_routes;
+    values[2] = lpm->tbl8_used_count;
+    values[3] = lpm->lookup_count;
+}
+
+int cord_telemetry_register_ipv4_lpm(cord_telemetry_t *telemetry, const char *name, const cord_ipv4_lpm_t *lpm)
+{
+    return cord_telemetry_register(telemetry, name, CORD_TELEMETRY_SOURCE_IPV4_LPM,
+                                   lpm_counters, CORD_TELEMETRY_COUNT(lpm_counters),
+                                   cord_telemetry_collect_ipv4_lpm, lpm);
+}
+
+int cord_telemetry_register_ipv6_lpm(cord_telemetry_t *telemetry, const char *name, const cord_ipv6_lpm_t *lpm)
+{
+    return cord_telemetry_register(telemetry, name, CORD_TELEMETRY_SOURCE_IPV6_LPM,
+                                   lpm_counters, CORD_TELEMETRY_COUNT(lpm_counters),
+                                   cord_telemetry_collect_ipv6_lpm, lpm);
+}
+
+// ACL
+
+static const cord_telemetry_counter_desc_t acl_counters[] = {
+    CORD_TELEMETRY_G("rules"),
+    CORD_TELEMETRY_G("max_rules"),
+    CORD_TELEMETRY_C("lookups"),
+    CORD_TELEMETRY_C("matches"),
+};
+
+static void cord_telemetry_collect_acl(const void *obj, uint64_t *values)
+{
+    const volatile cord_acl_t *acl = obj;
+
+    values[0] = acl->num_rules;
+    values[1] = acl->max_rules;
+    values[2] = acl->lookup_count;
+    values[3] = acl->match_count;
+}
+
+int cord_telemetry_register_acl(cord_telemetry_t *telemetry, const char *name, const cord_acl_t *acl)
+{
+    return cord_telemetry_register(telemetry, name, CORD_TELEMETRY_SOURCE_ACL,
+                                   acl_counters, CORD_TELEMETRY_COUNT(acl_counters),
+                                   cord_telemetry_collect_acl, acl);
+}
+
+// Next hop
+
+static const cord_telemetry_counter_desc_t nexthop_counters[] = {
+    CORD_TELEMETRY_G("entries"),
+    CORD_TELEMETRY_G("max_entries"),
+    CORD_TELEMETRY_C("forwarded"),
+    CORD_TELEMETRY_C("ttl_expired"),
+    CORD_TELEMETRY_C("invalid"),
+};
+
+static void cord_telemetry_collect_nexthop(const void *obj, uint64_t *values)
+{
+    const volatile cord_nexthop_table_t *table = obj;
+
+    values[0] = table->num_entries;
+    values[1] = table->max_entries;
+    values[2] = table->forward_count;
+    values[3] = table->ttl_expired_count;
+    values[4] = table->invalid_count;
+}
+
+int cord_telemetry_register_nexthop(cord_telemetry_t *telemetry, const char *name, const cord_nexthop_table_t *table)
+{
+    return cord_telemetry_register(telemetry, name, CORD_TELEMETRY_SOURCE_NEXTHOP,
+                                   nexthop_counters, CORD_TELEMETRY_COUNT(nexthop_counters),
+                                   cord_telemetry_collect_nexthop, table);
+}
+
+// Pipeline: packets, drops, then hits / misses of every stage slot
+
+#define CORD_TELEMETRY_STAGE(s) \
+    CORD_TELEMETRY_CL("stage_hits", "stage=\"" #s "\""), CORD_TELEMETRY_CL("stage_misses", "stage=\"" #s "\"")
+
+static const cord_telemetry_counter_desc_t pipeline_counters[] = {
+    CORD_TELEMETRY_C("packets"),
+    CORD_TELEMETRY_C("dropped"),
+    CORD_TELEMETRY_G("stages"),
+    CORD_TELEMETRY_STAGE(0),  CORD_TELEMETRY_STAGE(1),  CORD_TELEMETRY_STAGE(2),  CORD_TELEMETRY_STAGE(3),
+    CORD_TELEMETRY_STAGE(4),  CORD_TELEMETRY_STAGE(5),  CORD_TELEMETRY_STAGE(6),  CORD_TELEMETRY_STAGE(7),
+    CORD_TELEMETRY_STAGE(8),  CORD_TELEMETRY_STAGE(9),  CORD_TELEMETRY_STAGE(10), CORD_TELEMETRY_STAGE(11),
+    CORD_TELEMETRY_STAGE(12), CORD_TELEMETRY_STAGE(13), CORD_TELEMETRY_STAGE(14), CORD_TELEMETRY_STAGE(15),
+};
+
+_Static_assert(CORD_PIPELINE_MAX_STAGES == 16, "pipeline_counters lists 16 stages");
+
+static void cord_telemetry_collect_pipeline(const void *obj, uint64_t *values)
+{
+    const volatile cord_pipeline_t *pipeline = obj;
+
+    values[0] = pipeline->packet_count;
+    values[1] = pipeline->drop_count;
+    values[2] = pipeline->num_stages;
+    for (uint32_t s = 0; s < CORD_PIPELINE_MAX_STAGES; s++)
+    {
+        values[3 + 2 * s] = pipeline->stages[s].hit_count;
+        values[4 + 2 * s] = pipeline->stages[s].miss_count;
+    }
+}
+
+int cord_telemetry_register_pipeline(cord_telemetry_t *telemetry, const char *name, const cord_pipeline_t *pipeline)
+{
+    return cord_telemetry_register(telemetry, name, CORD_TELEMETRY_SOURCE_PIPELINE,
+                                   pipeline_counters, CORD_TELEMETRY_COUNT(pipeline_counters),
+                                   cord_telemetry_collect_pipeline, pipeline);
+}
+
+// Packet pool (per-thread cache counters summed)
+
+static const cord_telemetry_counter_desc_t pkt_pool_counters[] = {
+    CORD_TELEMETRY_G("buffers"),
+    CORD_TELEMETRY_G("available"),
+    CORD_TELEMETRY_C("allocated"),
+    CORD_TELEMETRY_C("released"),
+    CORD_TELEMETRY_C("alloc_failures"),
+};
+
+static void cord_telemetry_collect_pkt_pool(const void *obj, uint64_t *values)
+{
+    const volatile cord_pkt_pool_t *pool = obj;
+
+    values[0] = pool->num_bufs;
+    values[1] = cord_pkt_pool_avail_count((cord_pkt_pool_t *)obj);
+    for (uint32_t i = 0; i < CORD_PKT_POOL_MAX_THREADS; i++)
+    {
+        values[2] += pool->caches[i].alloc_count;
+        values[3] += pool->caches[i].free_count;
+        values[4] += pool->caches[i].alloc_fail_count;
+    }
+}
+
+int cord_telemetry_register_pkt_pool(cord_telemetry_t *telemetry, const char *name, const cord_pkt_pool_t *pool)
+{
+    return cord_telemetry_register(telemetry, name, CORD_TELEMETRY_SOURCE_PKT_POOL,
+                                   pkt_pool_counters, CORD_TELEMETRY_COUNT(pkt_pool_counters),
+                                   cord_telemetry_collect_pkt_pool, pool);
+}
+
+// Arena
+
+static const cord_telemetry_counter_desc_t arena_counters[] = {
+    CORD_TELEMETRY_G("chunks"),
+    CORD_TELEMETRY_G("mapped_bytes"),
+    CORD_TELEMETRY_G("used_bytes"),
+    CORD_TELEMETRY_G("allocations"),
+};
+
+static void cord_telemetry_collect_arena(const void *obj, uint64_t *values)
+{
+    const volatile cord_arena_t *arena = obj;
+
+    values[0] = arena->num_chunks;
+    values[1] = arena->mapped_bytes;
+    values[2] = arena->used_bytes;
+    values[3] = arena->num_allocs;
+}
+
+int cord_telemetry_register_arena(cord_telemetry_t *telemetry, const char *name, const cord_arena_t *arena)
+{
+    return cord_telemetry_register(telemetry, name, CORD_TELEMETRY_SOURCE_ARENA,
+                                   arena_counters, CORD_TELEMETRY_COUNT(arena_counters),
+                                   cord_telemetry_collect_arena, arena);
+}
+
+// Conntrack
+
+static const cord_telemetry_counter_desc_t conntrack_counters[] = {
+    CORD_TELEMETRY_G("connections"),
+    CORD_TELEMETRY_G("max_connections"),
+};
+
+static void cord_telemetry_collect_conntrack(const void *obj, uint64_t *values)
+{
+    const volatile cord_connection_tracker_t *tracker = obj;
+
+    uint64_t connections = 0;
+
+    // Occupied slots (sources_index is only the next slot to reuse)
+    for (uint32_t i = 0; i < CONNTRACK_MAX_CONNTRACK_SOURCES; i++)
+        connections += (tracker->sources[i].iov != NULL);
+
+    values[0] = connections;
+    values[1] = CONNTRACK_MAX_CONNTRACK_SOURCES;
+}
+
+int cord_telemetry_register_conntrack(cord_telemetry_t *telemetry, const char *name, const struct cord_connection_tracker_t *tracker)
+{
+    return cord_telemetry_register(telemetry, name, CORD_TELEMETRY_SOURCE_CONNTRACK,
+                                   conntrack_counters, CORD_TELEMETRY_COUNT(conntrack_counters),
+                                   cord_telemetry_collect_conntrack, tracker);
+}
+
+// Cycles (process wide): bursts, cycles, p50 / p99 of every stage
+
+#define CORD_TELEMETRY_CYCLES(s) \
+    CORD_TELEMETRY_CL("bursts", "stage=\"" s "\""),  CORD_TELEMETRY_CL("cycles", "stage=\"" s "\""), \
+    CORD_TELEMETRY_GL("p50_cycles", "stage=\"" s "\""), CORD_TELEMETRY_GL("p99_cycles", "stage=\"" s "\"")
+
+static const cord_telemetry_counter_desc_t cycles_counters[] = {
+    CORD_TELEMETRY_CYCLES("rx"),            CORD_TELEMETRY_CYCLES("parse"),
+    CORD_TELEMETRY_CYCLES("l2_cam"),        CORD_TELEMETRY_CYCLES("ipv4_lpm"),
+    CORD_TELEMETRY_CYCLES("ipv6_lpm"),      CORD_TELEMETRY_CYCLES("acl"),
+    CORD_TELEMETRY_CYCLES("custom_lookup"), CORD_TELEMETRY_CYCLES("actions"),
+    CORD_TELEMETRY_CYCLES("nexthop"),       CORD_TELEMETRY_CYCLES("tx"),
+};
+
+_Static_assert(CORD_CYCLES_STAGE_COUNT == 10, "cycles_counters lists 10 stages");
+
+// Registration key: the histograms are not tied to an object
+static const char cord_telemetry_cycles_key;
+
+static void cord_telemetry_collect_cycles(const void *obj, uint64_t *values)
+{
+    (void)obj;
+
+    for (uint32_t s = 0; s < CORD_CYCLES_STAGE_COUNT; s++)
+    {
+        cord_cycles_hist_t hist;
+        cord_cycles_get(s, &hist);
+
+        values[4 * s + 0] = hist.count;
+        values[4 * s + 1] = hist.total;
+        values[4 * s + 2] = cord_cycles_percentile(&hist, 0.50);
+        values[4 * s + 3] = cord_cycles_percentile(&hist, 0.99);
+    }
+}
+
+int cord_telemetry_register_cycles(cord_telemetry_t *telemetry, const char *name)
+{
+    return cord_telemetry_register(telemetry, name, CORD_TELEMETRY_SOURCE_CYCLES,
+                                   cycles_counters, CORD_TELEMETRY_COUNT(cycles_counters),
+                                   cord_telemetry_collect_cycles, &cord_telemetry_cycles_key);
+}
+
+int cord_telemetry_unregister_cycles(cord_telemetry_t *telemetry)
+{
+    return cord_telemetry_unregister(telemetry, &cord_telemetry_cycles_key);
+}
+
+//
+// Reader
+//
+
+const cord_telemetry_segment_t *cord_telemetry_attach(const char *shm_name)
+{
+    const char *name = shm_name ? shm_name : CORD_TELEMETRY_DEFAULT_NAME;
+
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+
+    const cord_telemetry_segment_t *segment = mmap(NULL, sizeof(cord_telemetry_segment_t), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (segment == MAP_FAILED)
+    {
+        return NULL;
+    }
+
+    if (segment->header.magic != CORD_TELEMETRY_MAGIC ||
+        segment->header.version != CORD_TELEMETRY_VERSION ||
+        segment->header.segment_size != sizeof(cord_telemetry_segment_t))
+    {
+        munmap((void *)segment, sizeof(cord_telemetry_segment_t));
+        return NULL;
+    }
+
+    return segment;
+}
+
+void cord_telemetry_detach(const cord_telemetry_segment_t *segment)
+{
+    if (segment)
+    {
+        munmap((void *)segment, sizeof(cord_telemetry_segment_t));
+    }
+}
+
+int cord_telemetry_read(const cord_telemetry_segment_t *segment, cord_telemetry_segment_t *snapshot)
+{
+    // The seq member is only loaded atomically, so a read-only mapping is enough
+    _Atomic uint64_t *seq_ptr = (_Atomic uint64_t *)&segment->header.seq;
+
+    for (uint32_t retry = 0; retry < CORD_TELEMETRY_READ_RETRIES; retry++)
+    {
+        uint64_t seq = atomic_load_explicit(seq_ptr, memory_order_acquire);
+        if (seq & 1)
+        {
+            sched_yield();
+            continue;
+        }
+
+        memcpy(snapshot, segment, sizeof(cord_telemetry_segment_t));
+        atomic_thread_fence(memory_order_acquire);
+
+        if (atomic_load_explicit(seq_ptr, memory_order_relaxed) == seq)
+        {
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+const char *cord_telemetry_source_type_name(uint32_t type)
+{
+    static const char *type_names[CORD_TELEMETRY_SOURCE_TYPE_COUNT] = {
+        "flow_point", "l2_cam", "ipv4_lpm", "ipv6_lpm", "acl", "nexthop",
+        "pipeline", "pkt_pool", "arena", "conntrack", "custom", "cycles"
+    };
+
+    return (type < CORD_TELEMETRY_SOURCE_TYPE_COUNT) ? type_names[type] : "unknown";
+}
+
+// True if (type, name) was already emitted by an earlier source / counter
+static bool cord_telemetry_family_seen(const cord_telemetry_segment_t *snapshot, uint32_t src, uint32_t cnt)
+{
+    const cord_telemetry_source_t *source = &snapshot->sources[src];
+    const char *name = source->counters[cnt].name;
+
+    for (uint32_t s = 0; s <= src; s++)
+    {
+        const cord_telemetry_source_t *other = &snapshot->sources[s];
+        if (other->type != source->type)
+        {
+            continue;
+        }
+
+        uint32_t limit = (s == src) ? cnt : other->num_counters;
+        for (uint32_t c = 0; c < limit; c++)
+        {
+            if (strcmp(other->counters[c].name, name) == 0)
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+int cord_telemetry_write_prometheus(const cord_telemetry_segment_t *snapshot, const char *path)
+{
+    char tmp_path[4096];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+
+    FILE *file = fopen(tmp_path, "w");
+    if (!file)
+    {
+        CORD_ERROR("[cord_telemetry_write_prometheus] fopen");
+        return -1;
+    }
+
+    uint32_t num_sources = snapshot->header.num_sources;
+    if (num_sources > CORD_TELEMETRY_MAX_SOURCES)
+    {
+        num_sources = CORD_TELEMETRY_MAX_SOURCES;
+    }
+
+    // One family per (source type, counter name), all its samples together
+    for (uint32_t src = 0; src < num_sources; src++)
+    {
+        const cord_telemetry_source_t *source = &snapshot->sources[src];
+
+        for (uint32_t cnt = 0; cnt < source->num_counters; cnt++)
+        {
+            if (cord_telemetry_family_seen(snapshot, src, cnt))
+            {
+                continue;
+            }
+
+            const cord_telemetry_counter_desc_t *desc = &source->counters[cnt];
+            const char *type_name = cord_telemetry_source_type_name(source->type);
+            bool is_counter = (desc->kind == CORD_TELEMETRY_COUNTER);
+
+            fprintf(file, "# TYPE cord_%s_%s%s %s\n", type_name, desc->name,
+                    is_counter ? "_total" : "", is_counter ? "counter" : "gauge");
+
+            for (uint32_t s = src; s < num_sources; s++)
+            {
+                const cord_telemetry_source_t *other = &snapshot->sources[s];
+                if (other->type != source->type)
+                {
+                    continue;
+                }
+
+                for (uint32_t c = 0; c < other->num_counters; c++)
+                {
+                    const cord_telemetry_counter_desc_t *other_desc = &other->counters[c];
+                    if (strcmp(other_desc->name, desc->name) != 0)
+                    {
+                        continue;
+                    }
+
+                    fprintf(file, "cord_%s_%s%s{name=\"%.*s\"%s%s} %lu\n", type_name, desc->name,
+                            is_counter ? "_total" : "",
+                            CORD_TELEMETRY_NAME_LEN, other->name,
+                            other_desc->label[0] ? "," : "", other_desc->label,
+                            other->values[c]);
+                }
+            }
+        }
+    }
+
+    if (fclose(file) != 0)
+    {
+        CORD_ERROR("[cord_telemetry_write_prometheus] fclose");
+        unlink(tmp_path);
+        return -1;
+    }
+
+    if (rename(tmp_path, path) < 0)
+    {
+        CORD_ERROR("[cord_telemetry_write_prometheus] rename");
+        unlink(tmp_path);
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,155 @@
+//
+// cord_flow_telemetry - reader of the CORD-FLOW telemetry segment
+//
+// Maps the segment of a running application read-only and prints every source with
+// its counter values and per-second rates; optionally (re)writes a Prometheus text
+// file each interval for the node_exporter textfile collector.
+//
+// Usage: cord_flow_telemetry [-n shm_name] [-i interval_ms] [-c count] [-p prom_file] [-q]
+//
+
+#include <telemetry/cord_telemetry.h>
+#include <cord_error.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <getopt.h>
+
+static void usage(const char *prog)
+{
+    CORD_LOG("Usage: %s [-n shm_name] [-i interval_ms] [-c count] [-p prom_file] [-q]\n", prog);
+    CORD_LOG("  -n  Shared memory segment (default %s)\n", CORD_TELEMETRY_DEFAULT_NAME);
+    CORD_LOG("  -i  Refresh interval in milliseconds (default %u)\n", CORD_TELEMETRY_DEFAULT_INTERVAL_MS);
+    CORD_LOG("  -c  Number of refreshes, 0 = until interrupted (default 0)\n");
+    CORD_LOG("  -p  Write a Prometheus text file on every refresh\n");
+    CORD_LOG("  -q  Do not print the tables (with -p)\n");
+}
+
+static void print_snapshot(const cord_telemetry_segment_t *cur, const cord_telemetry_segment_t *prev)
+{
+    double dt = 0.0;
+    if (prev && cur->header.timestamp_ns > prev->header.timestamp_ns)
+        dt = (double)(cur->header.timestamp_ns - prev->header.timestamp_ns) / 1e9;
+
+    CORD_LOG("=== CORD-FLOW Telemetry (pid %u, snapshot %lu) ===\n", cur->header.pid, cur->header.snapshot_count);
+
+    for (uint32_t s = 0; s < cur->header.num_sources && s < CORD_TELEMETRY_MAX_SOURCES; s++)
+    {
+        const cord_telemetry_source_t *source = &cur->sources[s];
+        if (source->num_counters == 0)
+            continue;
+
+        // Rates only against the same registration in the previous snapshot
+        const cord_telemetry_source_t *before = NULL;
+        if (prev && dt > 0.0 && prev->sources[s].type == source->type &&
+            strncmp(prev->sources[s].name, source->name, CORD_TELEMETRY_NAME_LEN) == 0)
+            before = &prev->sources[s];
+
+        CORD_LOG("[%s] %.*s\n", cord_telemetry_source_type_name(source->type), CORD_TELEMETRY_NAME_LEN, source->name);
+
+        for (uint32_t c = 0; c < source->num_counters && c < CORD_TELEMETRY_MAX_COUNTERS; c++)
+        {
+            const cord_telemetry_counter_desc_t *desc = &source->counters[c];
+            char label[CORD_TELEMETRY_NAME_LEN + CORD_TELEMETRY_LABEL_LEN + 4];
+
+            if (desc->label[0])
+                snprintf(label, sizeof(label), "%.*s{%.*s}", CORD_TELEMETRY_NAME_LEN, desc->name, CORD_TELEMETRY_LABEL_LEN, desc->label);
+            else
+                snprintf(label, sizeof(label), "%.*s", CORD_TELEMETRY_NAME_LEN, desc->name);
+
+            if (desc->kind == CORD_TELEMETRY_COUNTER && before)
+            {
+                double rate = (double)(source->values[c] - before->values[c]) / dt;
+                CORD_LOG("  %-36s %20lu %16.1f/s\n", label, source->values[c], rate);
+            }
+            else
+            {
+                CORD_LOG("  %-36s %20lu\n", label, source->values[c]);
+            }
+        }
+    }
+
+    CORD_LOG("\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *shm_name = CORD_TELEMETRY_DEFAULT_NAME;
+    const char *prom_path = NULL;
+    uint32_t interval_ms = CORD_TELEMETRY_DEFAULT_INTERVAL_MS;
+    uint64_t count = 0;
+    bool quiet = false;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:i:c:p:qh")) != -1)
+    {
+        switch (opt)
+        {
+            case 'n': shm_name = optarg; break;
+            case 'i': interval_ms = (uint32_t)strtoul(optarg, NULL, 10); break;
+            case 'c': count = strtoull(optarg, NULL, 10); break;
+            case 'p': prom_path = optarg; break;
+            case 'q': quiet = true; break;
+            default:
+                usage(argv[0]);
+                return (opt == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if (interval_ms == 0)
+        interval_ms = CORD_TELEMETRY_DEFAULT_INTERVAL_MS;
+
+    const cord_telemetry_segment_t *segment = cord_telemetry_attach(shm_name);
+    if (!segment)
+    {
+        CORD_LOG("Cannot attach to the telemetry segment %s (not running, or another layout version)\n", shm_name);
+        return EXIT_FAILURE;
+    }
+
+    // Snapshots are ~200KB: keep them off the stack
+    cord_telemetry_segment_t *cur = malloc(sizeof(cord_telemetry_segment_t));
+    cord_telemetry_segment_t *prev = malloc(sizeof(cord_telemetry_segment_t));
+    if (!cur || !prev)
+    {
+        CORD_ERROR("malloc");
+        cord_telemetry_detach(segment);
+        return EXIT_FAILURE;
+    }
+
+    struct timespec period = {
+        .tv_sec = interval_ms / 1000,
+        .tv_nsec = (long)(interval_ms % 1000) * 1000000L,
+    };
+    bool have_prev = false;
+
+    for (uint64_t n = 0; count == 0 || n < count; n++)
+    {
+        if (n > 0)
+            nanosleep(&period, NULL);
+
+        if (cord_telemetry_read(segment, cur) != 0)
+        {
+            CORD_LOG("Telemetry segment busy, skipping this refresh\n");
+            continue;
+        }
+
+        if (!quiet)
+            print_snapshot(cur, have_prev ? prev : NULL);
+
+        if (prom_path && cord_telemetry_write_prometheus(cur, prom_path) != 0)
+            CORD_LOG("Failed to write %s\n", prom_path);
+
+        cord_telemetry_segment_t *tmp = prev;
+        prev = cur;
+        cur = tmp;
+        have_prev = true;
+    }
+
+    free(cur);
+    free(prev);
+    cord_telemetry_detach(segment);
+
+    return EXIT_SUCCESS;
+}